@@ -0,0 +1,131 @@
+/* circular-main-menu
+ * Copyright (C) 2008 - Cole Anstey
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ * See http://code.google.com/p/circular-application-menu/
+ */
+#include "cmmbudget.h"
+
+/* Local data. */
+static const gchar* g_level_names[QUALITY_LEVELS] =
+{
+    "full",
+    "no-reflection",
+    "no-overlap",
+    "tabbed-only",
+    "no-preview",
+};
+
+/**
+ * ca_budget_init:
+ * @budget: The budget to initialise.
+ * @paint_budget: The milliseconds each frame may spend painting; otherwise 0 to keep full quality.
+ *
+ * Initialises a budget at full quality.
+ **/
+void
+ca_budget_init(CaBudget* budget, gdouble paint_budget)
+{
+    budget->paint_budget = (gint64)(paint_budget * 1000.0);
+    budget->level = QUALITY_FULL;
+    budget->average = 0.0;
+    budget->over_frames = 0;
+    budget->under_frames = 0;
+}
+
+/**
+ * ca_budget_add_frame:
+ * @budget: The budget of the painted frames.
+ * @elapsed: The microseconds spent painting the frame.
+ *
+ * Adds the paint time of a frame.  The next feature is shed once the smoothed paint time has
+ * exceeded the budget for BUDGET_STEP_DOWN_FRAMES frames, and the last shed feature is restored
+ * once it has stayed below BUDGET_HEADROOM of the budget for BUDGET_STEP_UP_FRAMES frames; the
+ * gap between the two stops the level flapping around the budget.
+ *
+ * Returns: TRUE if the quality level has changed; otherwise FALSE.
+ **/
+gboolean
+ca_budget_add_frame(CaBudget* budget, gint64 elapsed)
+{
+    if (budget->paint_budget <= 0)
+        return FALSE;
+
+    if (budget->average == 0.0)
+    {
+        budget->average = (gdouble)elapsed;
+    }
+    else
+    {
+        budget->average += ((gdouble)elapsed - budget->average) * BUDGET_SMOOTHING;
+    }
+
+    if (budget->average > budget->paint_budget)
+    {
+        budget->under_frames = 0;
+
+        if ((++budget->over_frames >= BUDGET_STEP_DOWN_FRAMES) &&
+            (budget->level < QUALITY_LEVELS - 1))
+        {
+            budget->level++;
+            budget->over_frames = 0;
+
+            /* Measure the cheaper frames afresh. */
+            budget->average = 0.0;
+
+            return TRUE;
+        }
+    }
+    else if (budget->average < budget->paint_budget * BUDGET_HEADROOM)
+    {
+        budget->over_frames = 0;
+
+        if ((++budget->under_frames >= BUDGET_STEP_UP_FRAMES) &&
+            (budget->level > QUALITY_FULL))
+        {
+            budget->level--;
+            budget->under_frames = 0;
+            budget->average = 0.0;
+
+            return TRUE;
+        }
+    }
+    else
+    {
+        /* Within the hysteresis band; hold the level. */
+        budget->over_frames = 0;
+        budget->under_frames = 0;
+    }
+
+    return FALSE;
+}
+
+/**
+ * ca_budget_get_level_name:
+ * @level: A quality level.
+ *
+ * Retrieves the name of a quality level, as written to the replay report.
+ *
+ * Returns: The name of the level.
+ **/
+const gchar*
+ca_budget_get_level_name(QualityLevel level)
+{
+    g_return_val_if_fail(level < QUALITY_LEVELS, NULL);
+
+    return g_level_names[level];
+}
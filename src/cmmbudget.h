@@ -0,0 +1,66 @@
+/* circular-main-menu
+ * Copyright (C) 2008 - Cole Anstey
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ * See http://code.google.com/p/circular-application-menu/
+ */
+#ifndef __CA_BUDGET_H__
+#define __CA_BUDGET_H__
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/* Constants. */
+#define BUDGET_SMOOTHING                0.25    /* The weight of each new paint time within the average. */
+#define BUDGET_STEP_DOWN_FRAMES         4       /* The consecutive frames over budget before a feature is shed. */
+#define BUDGET_STEP_UP_FRAMES           60      /* The consecutive frames with headroom before a feature is restored. */
+#define BUDGET_HEADROOM                 0.5     /* The fraction of the budget below which there is headroom. */
+
+/* The expensive features, shed in this order whilst frames exceed the budget. */
+typedef enum
+{
+    QUALITY_FULL,
+    QUALITY_NO_REFLECTION,
+    QUALITY_NO_OVERLAP,                 /* No overlap translucency. */
+    QUALITY_TABBED_ONLY,                /* Only the tabbed file-leaf is shown. */
+    QUALITY_NO_PREVIEW,
+    QUALITY_LEVELS
+} QualityLevel;
+
+typedef struct _CaBudget CaBudget;
+
+/* Steps the render quality down and up from the measured paint times. */
+struct _CaBudget
+{
+    gint64 paint_budget;                /* The microseconds per frame; otherwise 0 if the quality is fixed. */
+    QualityLevel level;
+    gdouble average;                    /* The smoothed paint time in microseconds. */
+    gint over_frames;                   /* The consecutive frames whose average exceeds the budget. */
+    gint under_frames;                  /* The consecutive frames whose average is within the headroom. */
+};
+
+/* Construction */
+void ca_budget_init(CaBudget* budget, gdouble paint_budget);
+
+/* Implementation */
+gboolean ca_budget_add_frame(CaBudget* budget, gint64 elapsed);
+const gchar* ca_budget_get_level_name(QualityLevel level);
+
+G_END_DECLS
+
+#endif
@@ -0,0 +1,260 @@
+/* circular-main-menu
+ * Copyright (C) 2008 - Cole Anstey
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ * See http://code.google.com/p/circular-application-menu/
+ */
+#include "cmmcache.h"
+
+struct _CaCache
+{
+    gint _ref_count;
+    GHashTable* _icons;                 /* "size:icon" to GdkPixbuf. */
+    GHashTable* _resources;             /* The resource path to GdkPixbuf. */
+    GMenuTree* _menu_tree;              /* The loaded menu tree; otherwise NULL. */
+    GMenuTreeDirectory* _menu_root;
+};
+
+/* Local data; the cache is only used from the main thread. */
+static CaCache* g_default_cache = NULL;
+
+/**
+ * _ca_cache_icon_key:
+ * @icon: The GIcon of a file-item.
+ * @size: The size the icon is decoded at.
+ *
+ * Retrieves the key of an icon in the cache.
+ *
+ * Returns: A newly allocated key; otherwise NULL if the icon cannot be serialized.
+ **/
+static gchar*
+_ca_cache_icon_key(GIcon* icon, gint size)
+{
+    gchar* name;
+    gchar* key;
+
+    if ((name = g_icon_to_string(icon)) == NULL)
+        return NULL;
+
+    key = g_strdup_printf("%d:%s", size, name);
+    g_free((gpointer)name);
+
+    return key;
+}
+
+/**
+ * ca_cache_get_default:
+ *
+ * Retrieves the cache shared by every menu in the process, creating it if required.
+ *
+ * Returns: A new reference to the cache; release it with ca_cache_unref().
+ **/
+CaCache*
+ca_cache_get_default(void)
+{
+    if (g_default_cache != NULL)
+    {
+        return ca_cache_ref(g_default_cache);
+    }
+
+    g_default_cache = g_new0(CaCache, 1);
+    g_default_cache->_ref_count = 1;
+    g_default_cache->_icons = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_object_unref);
+    g_default_cache->_resources = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_object_unref);
+    g_default_cache->_menu_tree = NULL;
+    g_default_cache->_menu_root = NULL;
+
+    return g_default_cache;
+}
+
+/**
+ * ca_cache_ref:
+ * @cache: The cache.
+ *
+ * Adds a reference to the cache.
+ *
+ * Returns: The cache.
+ **/
+CaCache*
+ca_cache_ref(CaCache* cache)
+{
+    g_return_val_if_fail(cache != NULL, NULL);
+
+    cache->_ref_count++;
+
+    return cache;
+}
+
+/**
+ * ca_cache_unref:
+ * @cache: The cache.
+ *
+ * Releases a reference to the cache; the icons, glyphs and menu tree are freed with the last one.
+ **/
+void
+ca_cache_unref(CaCache* cache)
+{
+    g_return_if_fail(cache != NULL);
+    g_return_if_fail(cache->_ref_count > 0);
+
+    if (--cache->_ref_count > 0)
+        return;
+
+    g_hash_table_destroy(cache->_icons);
+    g_hash_table_destroy(cache->_resources);
+
+    if (cache->_menu_root != NULL)
+    {
+        gmenu_tree_item_unref(cache->_menu_root);
+    }
+
+    if (cache->_menu_tree != NULL)
+    {
+        g_object_unref(cache->_menu_tree);
+    }
+
+    if (cache == g_default_cache)
+    {
+        g_default_cache = NULL;
+    }
+
+    g_free((gpointer)cache);
+}
+
+/**
+ * ca_cache_lookup_icon:
+ * @cache: The cache.
+ * @icon: The GIcon of a file-item.
+ * @size: The size the icon is decoded at.
+ *
+ * Retrieves an icon which has already been decoded by any menu.
+ *
+ * Returns: A new reference to the pixbuf; otherwise NULL.
+ **/
+GdkPixbuf*
+ca_cache_lookup_icon(CaCache* cache, GIcon* icon, gint size)
+{
+    GdkPixbuf* pixbuf;
+    gchar* key;
+
+    if ((icon == NULL) ||
+        ((key = _ca_cache_icon_key(icon, size)) == NULL))
+        return NULL;
+
+    pixbuf = (GdkPixbuf*)g_hash_table_lookup(cache->_icons, key);
+    g_free((gpointer)key);
+
+    return (pixbuf != NULL) ? g_object_ref(pixbuf) : NULL;
+}
+
+/**
+ * ca_cache_insert_icon:
+ * @cache: The cache.
+ * @icon: The GIcon of a file-item.
+ * @size: The size the icon was decoded at.
+ * @pixbuf: The decoded pixbuf.
+ *
+ * Adds a decoded icon so it is shared rather than decoded again.
+ **/
+void
+ca_cache_insert_icon(CaCache* cache, GIcon* icon, gint size, GdkPixbuf* pixbuf)
+{
+    gchar* key;
+
+    if ((icon == NULL) ||
+        (pixbuf == NULL) ||
+        ((key = _ca_cache_icon_key(icon, size)) == NULL))
+        return;
+
+    g_hash_table_replace(cache->_icons, key, g_object_ref(pixbuf));
+}
+
+/**
+ * ca_cache_load_resource:
+ * @cache: The cache.
+ * @resource: The path of the resource to load.
+ *
+ * Loads a glyph from the compiled-in resources; it is only decoded once per process.
+ *
+ * Returns: A new reference to the pixbuf; otherwise NULL.
+ **/
+GdkPixbuf*
+ca_cache_load_resource(CaCache* cache, const gchar* resource)
+{
+    GdkPixbuf* pixbuf;
+    GError* error = NULL;
+
+    if ((pixbuf = (GdkPixbuf*)g_hash_table_lookup(cache->_resources, resource)) != NULL)
+    {
+        return g_object_ref(pixbuf);
+    }
+
+    if ((pixbuf = gdk_pixbuf_new_from_resource(resource, &error)) == NULL)
+    {
+        g_warning ("Resource not found: %s\n", error->message);
+        g_clear_error (&error); /* g_error_free */
+
+        return NULL;
+    }
+
+    g_hash_table_insert(cache->_resources, g_strdup(resource), g_object_ref(pixbuf));
+
+    return pixbuf;
+}
+
+/**
+ * ca_cache_set_menu_tree:
+ * @cache: The cache.
+ * @tree: A loaded GMenuTree.
+ *
+ * Shares a loaded menu tree, so every menu shows the same snapshot rather than loading its own.
+ **/
+void
+ca_cache_set_menu_tree(CaCache* cache, GMenuTree* tree)
+{
+    if (cache->_menu_root != NULL)
+    {
+        gmenu_tree_item_unref(cache->_menu_root);
+        cache->_menu_root = NULL;
+    }
+
+    if (cache->_menu_tree != NULL)
+    {
+        g_object_unref(cache->_menu_tree);
+        cache->_menu_tree = NULL;
+    }
+
+    if (tree != NULL)
+    {
+        cache->_menu_tree = g_object_ref(tree);
+        cache->_menu_root = gmenu_tree_get_root_directory(tree);
+    }
+}
+
+/**
+ * ca_cache_get_menu_root:
+ * @cache: The cache.
+ *
+ * Retrieves the root directory of the shared menu tree.
+ *
+ * Returns: The root directory, owned by the cache; otherwise NULL.
+ **/
+GMenuTreeDirectory*
+ca_cache_get_menu_root(CaCache* cache)
+{
+    return cache->_menu_root;
+}
@@ -0,0 +1,49 @@
+/* circular-main-menu
+ * Copyright (C) 2008 - Cole Anstey
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ * See http://code.google.com/p/circular-application-menu/
+ */
+#ifndef __CA_CACHE_H__
+#define __CA_CACHE_H__
+
+#include <gio/gio.h>
+#include <gdk-pixbuf/gdk-pixbuf.h>
+
+#define GMENU_I_KNOW_THIS_IS_UNSTABLE
+#include <gnome-menus-3.0/gmenu-tree.h>
+
+G_BEGIN_DECLS
+
+/* The decoded icons, glyphs and menu tree shared by every menu in the process. */
+typedef struct _CaCache CaCache;
+
+/* Construction */
+CaCache* ca_cache_get_default(void);
+CaCache* ca_cache_ref(CaCache* cache);
+void ca_cache_unref(CaCache* cache);
+
+/* Implementation */
+GdkPixbuf* ca_cache_lookup_icon(CaCache* cache, GIcon* icon, gint size);
+void ca_cache_insert_icon(CaCache* cache, GIcon* icon, gint size, GdkPixbuf* pixbuf);
+GdkPixbuf* ca_cache_load_resource(CaCache* cache, const gchar* resource);
+void ca_cache_set_menu_tree(CaCache* cache, GMenuTree* tree);
+GMenuTreeDirectory* ca_cache_get_menu_root(CaCache* cache);
+
+G_END_DECLS
+
+#endif
@@ -21,6 +21,17 @@
  *     https://github.com/GNOME/gnome-menus/blob/mainline/libmenu/gmenu-tree.c
  */
 #include "cmmcircularmainmenu.h"
+#include "cmmbudget.h"
+#include "cmmcache.h"
+#include "cmmcore.h"
+#include "cmmgeometry.h"
+#include "cmmmenuleaf.h"
+#include "cmmrender.h"
+#include "cmmprofiler.h"
+#include "cmmraster.h"
+#include "cmmscheduler.h"
+#include "cmmtiles.h"
+#include "cmmtrace.h"
 
 #include <gtk/gtk.h>
 #include <gdk/gdkkeysyms.h>
@@ -51,61 +62,121 @@ static gboolean _ca_circular_application_menu_button_press(GtkWidget* widget, Gd
 static gboolean _ca_circular_application_menu_button_release(GtkWidget* widget, GdkEventButton* event);
 static gboolean _ca_circular_application_menu_key_release(GtkWidget* widget, GdkEventKey* event);
 static gboolean _ca_circular_application_menu_motion_notify(GtkWidget* widget, GdkEventMotion* event);
+static gboolean _ca_circular_application_menu_scroll(GtkWidget* widget, GdkEventScroll* event);
 static void _ca_circular_application_menu_set_property (GObject* object, guint param_id, const GValue* value, GParamSpec* pspec);
 static gint _ca_circular_application_menu_on_fade_tick(gpointer data);
+static void _ca_circular_application_menu_invalidate(CaCircularApplicationMenu* circular_application_menu);
+static gboolean _ca_circular_application_menu_draw_view_cache(CaCircularApplicationMenu* circular_application_menu, const CaRenderContext* context, cairo_t* cr);
+static void _ca_circular_application_menu_hierarchy_changed(GtkWidget* widget, GtkWidget* previous_toplevel);
 
 /* Private functions. */
-static void _ca_get_point_from_source_offset(gint source_x, gint source_y, gdouble angle, gdouble radius, gint* destination_x, gint* destination_y);
-static gdouble _ca_circular_application_menu_point_distance(gint x1, gint y1, gint x2, gint y2);
-static gboolean _ca_circular_application_menu_circle_contains_point(gint point_x, gint point_y, gint circle_x, gint circle_y, gint radius);
-static gboolean _ca_circular_application_menu_segment_contains_point(CaCircularApplicationMenu* circular_application_menu, gint point_x, gint point_y, CaFileItem* fileitem);
-static gdouble _ca_circular_application_menu_circumference_from_radius(gdouble radius);
-static gdouble _ca_circular_application_menu_calculate_radius(CaCircularApplicationMenu* circular_application_menu, CaFileLeaf* fileleaf);
-static void _ca_circular_application_menu_position_fileleaf_files(CaCircularApplicationMenu* circular_application_menu, CaFileLeaf* fileleaf, gdouble radius, gdouble angle);
-static void _ca_circular_application_menu_render(CaCircularApplicationMenu* circular_application_menu, cairo_t* cr);
-static void _ca_circular_application_menu_render_fileleaf(CaCircularApplicationMenu* circular_application_menu, CaFileLeaf* fileleaf, cairo_t* cr);
-static void _ca_circular_application_menu_render_centred_text(CaCircularApplicationMenu* circular_application_menu, gint y, const gchar* text, cairo_t* cr);
-static GlyphType _ca_circular_application_menu_hittest(CaCircularApplicationMenu* circular_application_menu, gint x, gint y, CaFileLeaf** found_fileleaf, CaFileItem** found_fileitem);
-static GlyphType _ca_circular_application_menu_hittest_fileleaf(CaCircularApplicationMenu* circular_application_menu, CaFileLeaf* fileleaf, gint x, gint y, CaFileLeaf** found_fileleaf, CaFileItem** found_fileitem);
-static CaFileLeaf* _ca_circular_application_menu_show_fileitem(CaCircularApplicationMenu* circular_application_menu, GMenuTreeDirectory* menutreedirectory, LeafType leaftype, CaFileItem* fileitem, gboolean disassociated);
-static void _ca_circular_application_menu_view_centre_fileleaf(CaCircularApplicationMenu* circular_application_menu, CaFileLeaf* fileleaf, gint x, gint y);
-static void _ca_circular_application_menu_close_menu(CaCircularApplicationMenu* circular_application_menu, CaFileLeaf* fileleaf);
-static gdouble _ca_circular_application_menu_calculate_angle_offset(gdouble angle, gdouble offset);
-static gdouble _ca_circular_application_menu_angle_between_points(gdouble x1, gdouble y1, gdouble x2, gdouble y2);
-static gboolean _ca_circular_application_menu_is_angle_between_angles(gdouble angle, gdouble angle_lower, gdouble angle_higher);
-static void _ca_circular_applications_menu_get_segment_angles(CaFileItem* fileitem, gint radius, gdouble* from_angle, gdouble* to_angle);
+static void _ca_circular_application_menu_attach_fileleaf(CaCircularApplicationMenu* circular_application_menu, CaFileLeaf* fileleaf, CaFileItem* fileitem, gboolean disassociated);
+static void _ca_circular_application_menu_open_fileitem(CaCircularApplicationMenu* circular_application_menu, CaFileItem* fileitem);
+static void _ca_circular_application_menu_cancel_open(CaCircularApplicationMenu* circular_application_menu);
+static void _ca_circular_application_menu_build_fileleaf(CaCircularApplicationMenu* circular_application_menu, CaFileItem* fileitem, JobClass job_class, GCancellable* cancellable, CaJobDoneFunc done_func);
+static gpointer _ca_circular_application_menu_build_fileleaf_job(gpointer data, GCancellable* cancellable);
+static void _ca_circular_application_menu_build_fileleaf_free(gpointer data);
+static void _ca_circular_application_menu_on_fileleaf_built(gpointer result, gboolean cancelled, gpointer data);
+static void _ca_circular_application_menu_resolve_fileleaf(CaCircularApplicationMenu* circular_application_menu, CaFileLeaf* fileleaf);
+static void _ca_circular_application_menu_schedule_preview(CaCircularApplicationMenu* circular_application_menu, CaFileItem* fileitem);
+static void _ca_circular_application_menu_cancel_preview(CaCircularApplicationMenu* circular_application_menu);
+static gboolean _ca_circular_application_menu_on_preview_dwell(gpointer data);
+static void _ca_circular_application_menu_on_preview_built(gpointer result, gboolean cancelled, gpointer data);
+static gboolean _ca_circular_application_menu_on_preview_confirmed(gpointer data);
+static void _ca_circular_application_menu_on_fileleaf_closing(gpointer data, gpointer user_data);
+static void _ca_circular_application_menu_page_fileleaf(CaCircularApplicationMenu* circular_application_menu, CaFileLeaf* fileleaf, gint page, gint x, gint y);
+static void _ca_circular_application_menu_track_motion(CaCircularApplicationMenu* circular_application_menu, gint x, gint y);
+static gboolean _ca_circular_application_menu_on_motion_settled(gpointer data);
+static gboolean _ca_circular_application_menu_on_quality_changed(gpointer data);
+static void _ca_circular_application_menu_get_render_context(CaCircularApplicationMenu* circular_application_menu, CaRenderContext* context);
+static void _ca_circular_application_menu_update_canvas(CaCircularApplicationMenu* circular_application_menu);
+static void _ca_circular_application_menu_apply_canvas(CaCircularApplicationMenu* circular_application_menu);
+static void _ca_circular_application_menu_update_shape(CaCircularApplicationMenu* circular_application_menu);
+static void _ca_circular_application_menu_apply_shape(CaCircularApplicationMenu* circular_application_menu);
+static void _ca_circular_application_menu_invalidate_current(CaCircularApplicationMenu* circular_application_menu, cairo_region_t* previous);
+static void _ca_circular_application_menu_queue_damage(CaCircularApplicationMenu* circular_application_menu, cairo_region_t* damage);
+static void _ca_circular_application_menu_count_damage(CaCircularApplicationMenu* circular_application_menu, cairo_t* cr);
+static gboolean _ca_circular_application_menu_on_rasterized(gpointer data);
 static GdkPixbuf* _ca_circular_applications_menu_get_pixbuf_from_name(GtkIconInfo* icon_info, gint width, gint height);
 static const gchar* _ca_circular_applications_menu_imagefinder_path(const gchar* path);
 static void _ca_circular_applications_menu_update_highlight(CaCircularApplicationMenu* circular_application_menu, gint x, gint y);
-static gint _ca_circular_applications_menu_get_centre_iconsize(CaCircularApplicationMenu* circular_application_menu, CaFileLeaf* fileleaf);
 static void _ca_circular_applications_menu_update_emblem(CaCircularApplicationMenu* circular_application_menu, gchar* emblems);
-static void _ca_circular_application_menu_render_reflection(CaCircularApplicationMenu* circular_application_menu, cairo_t* cr);
 static void _ca_circular_application_menu_device_warp(CaCircularApplicationMenu* circular_application_menu);
+static void _ca_circular_application_menu_resolve_fileitem(CaCircularApplicationMenu* circular_application_menu, CaFileItem* fileitem);
+static gboolean _ca_circular_application_menu_on_resolve_tick(GtkWidget* widget, GdkFrameClock* frame_clock, gpointer data);
 
 typedef struct _CaCircularApplicationMenuPrivate CaCircularApplicationMenuPrivate;
+typedef struct _BuildFileLeaf BuildFileLeaf;
+
+/* A file-leaf being built by a worker; only read by the worker thread. */
+struct _BuildFileLeaf
+{
+    CaCircularApplicationMenu* circular_application_menu;  /* A reference; only used on the main thread. */
+    GMenuTreeDirectory* menutreedirectory;
+    gint page_size;
+};
 
 struct _CaCircularApplicationMenuPrivate
 {
-    gint view_x_offset;            /* See: OFFSET_2_SCREEN. */
-    gint view_y_offset;            /* See: OFFSET_2_SCREEN. */
-    gint view_width;
-    gint view_height;
+    CaCore core;                        /* The layout, view and navigation state. */
+    CaCache* cache;                     /* The icons and glyphs shared with every other menu. */
+    CaScheduler* scheduler;             /* Builds file-leaves and rasterizes segments; shared with every other menu. */
+    CaRaster* raster;                   /* Rasterizes the segments of each file-leaf on worker threads. */
+    CaTiles* tiles;                     /* Renders the full frames in tiles on several threads; otherwise NULL. */
+    GList* unresolved_fileleaves;       /* Most recently shown first. */
     gint _fade_timer;
-    gint icon_width;
-    gint icon_height;
-    gint normal_iconsize;
-    gint tab_width;
-    gint tab_height;
+    guint resolve_tick_id;
+    GCancellable* open_cancellable;     /* The file-leaf being built; otherwise NULL. */
+    CaFileItem* opening_fileitem;       /* The file-item whose file-leaf is being built. */
+    guint preview_timeout_id;           /* The dwell or confirmation timeout of the preview. */
+    GCancellable* preview_cancellable;  /* The preview being built; otherwise NULL. */
+    CaFileItem* preview_fileitem;       /* The hovered file-item being previewed. */
+    guint scene_serial;                 /* Changes whenever anything other than the shown view changes. */
+    guint drawn_serial;                 /* The scene serial of the last frame drawn. */
+    cairo_surface_t* view_cache;        /* The scene covering the shown view and its destination; otherwise NULL. */
+    guint view_cache_serial;
+    gint view_cache_x_offset;           /* See: OFFSET_2_SCREEN. */
+    gint view_cache_y_offset;
+    gint view_cache_width;
+    gint view_cache_height;
+    gboolean render_fast;               /* The pointer is moving quickly; see: _ca_circular_application_menu_track_motion. */
+    guint settle_timeout_id;            /* Renders a full quality frame once the pointer slows. */
+    guint quality_idle_id;              /* Applies a change of quality level after the frame which measured it. */
+    gint64 motion_time;                 /* The monotonic time of the last pointer motion; otherwise 0. */
+    gint motion_x;
+    gint motion_y;
+    gboolean animating;                 /* A file-leaf or the view was animated by the last fade tick. */
+    CaBudget budget;                    /* The features shed to keep the paint time within the budget. */
+    GdkRectangle canvas;                /* The part of the view the window covers, in view co-ordinates. */
+    gint view_origin_x;                 /* The screen position of the view when the canvas is bounded. */
+    gint view_origin_y;
+    cairo_region_t* shape;              /* The shape last given to the window, in window co-ordinates; otherwise NULL. */
+    cairo_rectangle_int_t scene_extents;/* The extents of the scene last invalidated, in view co-ordinates; see: ca_render_get_extents. */
+    gint64 damage_pixels;               /* The window pixels drawn since the damage was last reported. */
+    gint damage_frames;
+    gint64 damage_since;                /* The monotonic time the damage was last reported; otherwise 0. */
     GdkPixbuf* light_pixbuf;
+    GdkPixbuf* close_normal_pixbuf;
+    GdkPixbuf* close_prelight_pixbuf;
+    GdkPixbuf* open_normal_pixbuf;
+    GdkPixbuf* open_prelight_pixbuf;
 
     /*< Options >*/
     gboolean hide_preview;
     gboolean xwarp_mouse_pointer;
     gboolean render_reflection_off;
+    gboolean render_tabbed_only;        /* The core may also be made tabbed only by the budget. */
     gint glyph_size;
+    gint page_size;                     /* The most file-items shown at once; otherwise 0 if unpaged. */
+    gint motion_threshold;              /* The pointer speed in pixels per second rendered fast; otherwise 0. */
+    gint settle_interval;               /* The milliseconds after a fast motion before a full quality frame. */
+    gboolean bounded_canvas;            /* The window only covers the open file-leaves and the text; see: ca_render_get_canvas. */
+    gboolean shape_window;              /* The window input and shape follow the open file-leaves; see: ca_render_get_shape. */
+    gboolean opaque;                    /* The window has no alpha channel; it is shaped and rendered without translucency. */
+    gboolean remote;                    /* The window is on a remote display; only the damage is drawn, without animation. */
+    gint tile_threads;                  /* The threads a full frame is rendered with in tiles; otherwise 0. */
     GdkPixbuf* emblem_normal;
     GdkPixbuf* emblem_prelight;
-    gboolean render_tabbed_only;
 };
 
 static gchar* image_paths[] = {
@@ -127,70 +198,15 @@ static gchar* image_paths[] = {
     NULL
 };
 
-typedef struct _RGBA RGBA;
-
-struct _RGBA
-{
-    gdouble _r;
-    gdouble _g;
-    gdouble _b;
-    gdouble _a_pen;
-    gdouble _a_fill;
-    gdouble _line_width;
-};
-
-#define CRGB(x)                 (x / 255.0)
-
-/* Defines the colours etc.         Red        Green      Blue       Apen   Afill   lwidth   */
-//RGBA g_normal_segment_rgba      = { CRGB(205), CRGB(233), CRGB(241), 0.8,   0.8,    0.0 };
-//RGBA g_prelight_segment_rgba    = { CRGB(205), CRGB(233), CRGB(241), 1.0,   0.9,    0.0 };
-//RGBA g_outer_inner_rgba         = { CRGB(205), CRGB(233), CRGB(241), 1.0,   0.8,    1.0 };
-
-RGBA g_normal_segment_rgba      = { CRGB(0), CRGB(0), CRGB(0), 0.8,   0.8,    1.0 };
-RGBA g_prelight_segment_rgba    = { CRGB(0), CRGB(0), CRGB(0), 1.0,   0.9,    1.0 };
-RGBA g_outer_inner_rgba         = { CRGB(0), CRGB(0), CRGB(0), 1.0,   0.8,    1.0 };
-
-RGBA g_outer1_rgba              = { CRGB(0),   CRGB(0),   CRGB(0),   1.0,   0.0,    0.0 };  /* Aline + lwidth unused. */
-RGBA g_outer2_rgba              = { CRGB(255), CRGB(255), CRGB(255), 0.5,   0.0,    0.0 };  /* Aline + lwidth unused. */
-
-RGBA g_text_box_rgba            = { CRGB(0),   CRGB(0),   CRGB(0),   0.0,   0.8,    0.0 };
-RGBA g_text_rgba                = { CRGB(255), CRGB(255), CRGB(255), 0.0,   1.0,    0.0 };
-
 /* Constants. */
 #define FADE_TIMER_INTERVAL        		15		/* The interval used for fading the menus. */
-#define FADE_PERCENTAGE_INCREMENT       5		/* The percentacge increment when fading. */
-#define OVERLAP_TRANSLUCENCY            0.75    /* The translucency for overlapped parent menus. */
-#define TEXT_BOUNDARY                   1.0     /* The boundary surrounding the text. */
-#define RADIUS_SPACER                   4.0
-#define CENTRE_ICONSIZE                 24.0
-#define SEGMENT_ARROW_WIDTH             6.0     /* The width of an arrow. */
-#define SEGMENT_ARROW_HEIGHT            16.0    /* The height of an arrow. */
-#define SEGMENT_CIRCLE_RADIUS           3.0     /* The bevel of a fileitem segment. */
-#define CIRCULAR_SEPERATOR              4.0
-#define SPOKE_SEPERATOR                 RADIUS_SPACER
-#define SPOKE_LENGTH(x)                 SPOKE_SEPERATOR + CLOSEST_TAB_CIRCLE_RADIUS + x + CLOSEST_TAB_CIRCLE_RADIUS + RADIUS_SPACER
-#define RADIUS_SEPERATOR                CIRCULAR_SEPERATOR
-#define RADIUS_ICON_SPACER              10.0
-#define CIRCULAR_ICON_SPACER            10.0
-#define SEGMENT_INNER_SPACER(x)         ((x / 2) + CIRCULAR_ICON_SPACER)
-#define SEGMENT_OUTER_SPACER(x)         ((x / 2) + CIRCULAR_ICON_SPACER + SEGMENT_ARROW_HEIGHT)
-#define MIN_RADIUS_ICONAREA(x)          (RADIUS_ICON_SPACER + x + RADIUS_ICON_SPACER);
-#define INITIAL_RADIUS(x)               CIRCULAR_ICON_SPACER + CIRCULAR_SEPERATOR + SEGMENT_INNER_SPACER(x)
-
-#define CLOSEST_TAB_CIRCLE_RADIUS       10.0    /* The innermost tab bevel. */
-#define FARTHEST_TAB_CIRCLE_RADIUS      10.0    /* The outermost tab bevel. */
-
-#define MAX_FILEITEMS_PER_FILELEAF      15
-#define CA_VIEW_X_OFFSET_START          16384
-#define CA_VIEW_Y_OFFSET_START          16384
-#define OFFSET_2_SCREEN(xy, offset_xy)  (xy - offset_xy)
-#define SCREEN_2_OFFSET(xy, offset_xy)  (xy + offset_xy)
-#define CLOSE_MENU_TEXT                 "close the menu"
-#define CLOSE_SUB_MENU_TEXT             "close the sub menu"
-#define RADIAN_2_DEGREE(radian)         (radian * (180.0 / M_PI))
-#define DEGREE_2_RADIAN(degree)         (degree * (M_PI / 180.0))
-
 #define MAX_EMBLEM                      255
+#define ICON_RESOLVE_BUDGET             4000    /* The microseconds per frame spent resolving icons. */
+#define PREVIEW_DWELL_INTERVAL          60      /* The hover before a preview silhouette is built. */
+#define PREVIEW_CONFIRM_INTERVAL        200     /* The further hover before the preview icons are resolved. */
+#define VIEW_CACHE_MAX_VIEWS            4       /* The largest view cache as a multiple of the view area. */
+#define CANVAS_SHRINK_FACTOR            2       /* A canvas shrinks once it is this multiple of the area needed. */
+#define DAMAGE_REPORT_INTERVAL          1000    /* The milliseconds between reports of the pixels drawn. */
 
 /* Local data. */
 static GtkWidgetClass* parent_class = NULL;
@@ -207,16 +223,17 @@ enum
     PROP_EMBLEM,
     PROP_RENDER_REFLECTION,
     PROP_RENDER_TABBED_ONLY,
+    PROP_PAGE_SIZE,
+    PROP_MOTION_THRESHOLD,
+    PROP_SETTLE_INTERVAL,
+    PROP_PAINT_BUDGET,
+    PROP_BOUNDED_CANVAS,
+    PROP_SHAPE_WINDOW,
+    PROP_OPAQUE,
+    PROP_REMOTE,
+    PROP_TILE_THREADS,
 };
 
-static CaFileLeaf* g_root_fileleaf = NULL;
-static CaFileLeaf* g_last_opened_fileleaf = NULL;
-static CaFileLeaf* g_tabbed_fileleaf = NULL;
-static CaFileLeaf* g_current_fileleaf = NULL;
-static CaFileItem* g_current_fileitem = NULL;
-static GlyphType g_current_type = GLYPH_UNKNOWN;
-static CaFileLeaf* g_disassociated_fileleaf = NULL;
-
 /**
  * _ca_circular_application_menu_get_instance_private:
  * @circular_application_menu: A CaCircularApplicationMenu pointer to the circular-application-menu widget instance.
@@ -239,6 +256,15 @@ _ca_circular_application_menu_get_instance_private (CaCircularApplicationMenu* w
  * @emblem: A gchar pointer to the root menu emblem to use.
  * @render_reflection: A boolean that specifies whether the reflection should be rendered.
  * @render_tabbed_only: A boolean that specifies whether rendering only occurrs for the currently tabbed menu.
+ * @page_size: An integer that specifies the most items shown at once by a menu, or 0 for no limit.
+ * @motion_threshold: An integer that specifies the pointer speed in pixels per second above which frames are rendered fast, or 0 for never.
+ * @settle_interval: An integer that specifies the milliseconds after a fast motion before a full quality frame is rendered.
+ * @paint_budget: A double that specifies the milliseconds a frame may paint for before features are shed, or 0 for never.
+ * @bounded_canvas: A boolean that specifies whether the window is sized to the open menus rather than the screen.
+ * @shape_window: A boolean that specifies whether the window only takes input and is only composited over the open menus.
+ * @opaque: A boolean that specifies whether the window has no alpha channel, as without a compositor; it is then always shaped.
+ * @remote: A boolean that specifies whether the window is on a remote display, so only what changes is drawn, without animations or the reflection.
+ * @tile_threads: The threads a full frame is rendered with in tiles; otherwise 0 to render it directly.
  *
  * Constructs a new dockband widget.
  *
@@ -251,7 +277,16 @@ ca_circular_application_menu_new (
 	gint glyph_size,
 	gchar* emblem,
 	gboolean render_reflection,
-	gboolean render_tabbed_only)
+	gboolean render_tabbed_only,
+	gint page_size,
+	gint motion_threshold,
+	gint settle_interval,
+	gdouble paint_budget,
+	gboolean bounded_canvas,
+	gboolean shape_window,
+	gboolean opaque,
+	gboolean remote,
+	gint tile_threads)
 {
     GObject* object;
 
@@ -268,6 +303,15 @@ ca_circular_application_menu_new (
         "emblem", emblem,
         "render-reflection", render_reflection,
         "render-tabbed-only", render_tabbed_only,
+        "page-size", page_size,
+        "motion-threshold", motion_threshold,
+        "settle-interval", settle_interval,
+        "paint-budget", paint_budget,
+        "bounded-canvas", bounded_canvas,
+        "shape-window", shape_window,
+        "opaque", opaque,
+        "remote", remote,
+        "tile-threads", tile_threads,
         NULL);
 
     return GTK_WIDGET(object);
@@ -301,7 +345,7 @@ ca_circular_application_menu(
         _ca_circular_application_menu_device_warp(circular_application_menu);
 
         /* Update the highlighted item at the given coordinates. */
-        _ca_circular_applications_menu_update_highlight(circular_application_menu, private->view_width / 2, private->view_height / 2);
+        _ca_circular_applications_menu_update_highlight(circular_application_menu, private->core.view_width / 2, private->core.view_height / 2);
     }
 
     return fileleaf;
@@ -417,7 +461,6 @@ _ca_circular_application_menu_constructor (
     CaCircularApplicationMenu* circular_application_menu;
     CaCircularApplicationMenuPrivate* private;
     gint param;
-    GError* error = NULL;
 
     /* Call base functionality. */
     object = G_OBJECT_CLASS (parent_class)->constructor(type, n_construct_params, construct_params);
@@ -425,8 +468,37 @@ _ca_circular_application_menu_constructor (
     circular_application_menu = CA_CIRCULAR_APPLICATION_MENU(object);
     private = _ca_circular_application_menu_get_instance_private(circular_application_menu);
 
+    ca_core_init(&private->core);
+    private->core.closing_func = _ca_circular_application_menu_on_fileleaf_closing;
+    private->core.closing_data = (gpointer)circular_application_menu;
+
+    private->cache = ca_cache_get_default();
+    private->scheduler = ca_scheduler_get_default();
+    private->raster = NULL;
+    private->tiles = NULL;
+    private->tile_threads = 0;
+    private->unresolved_fileleaves = NULL;
     private->emblem_normal = NULL;
     private->emblem_prelight = NULL;
+    private->resolve_tick_id = 0;
+    private->open_cancellable = NULL;
+    private->opening_fileitem = NULL;
+    private->preview_timeout_id = 0;
+    private->preview_cancellable = NULL;
+    private->preview_fileitem = NULL;
+    private->render_fast = FALSE;
+    private->settle_timeout_id = 0;
+    private->quality_idle_id = 0;
+    private->motion_time = 0;
+    private->animating = FALSE;
+    private->scene_extents.x = 0;
+    private->scene_extents.y = 0;
+    private->scene_extents.width = 0;
+    private->scene_extents.height = 0;
+    private->damage_pixels = 0;
+    private->damage_frames = 0;
+    private->damage_since = 0;
+    ca_budget_init(&private->budget, PAINT_BUDGET);
 
     /* The construct_params array, contains all available GObjectConstructParams in a unspecified order. */
     for(param = 0; param < (gint)n_construct_params; param++)
@@ -440,13 +512,13 @@ _ca_circular_application_menu_constructor (
         {
             case PROP_WIDTH:
             {
-                private->view_width = g_value_get_int (construct_params[param].value);
+                private->core.view_width = g_value_get_int (construct_params[param].value);
 
                 break;
             }
             case PROP_HEIGHT:
             {
-                private->view_height = g_value_get_int (construct_params[param].value);
+                private->core.view_height = g_value_get_int (construct_params[param].value);
 
                 break;
             }
@@ -497,26 +569,126 @@ _ca_circular_application_menu_constructor (
             case PROP_RENDER_TABBED_ONLY:
             {
                 private->render_tabbed_only = g_value_get_boolean (construct_params[param].value);
+                private->core.tabbed_only = private->render_tabbed_only;
+
+                break;
+            }
+            case PROP_PAGE_SIZE:
+            {
+                private->page_size = g_value_get_int (construct_params[param].value);
+
+                break;
+            }
+            case PROP_MOTION_THRESHOLD:
+            {
+                private->motion_threshold = g_value_get_int (construct_params[param].value);
+
+                break;
+            }
+            case PROP_SETTLE_INTERVAL:
+            {
+                private->settle_interval = g_value_get_int (construct_params[param].value);
+
+                break;
+            }
+            case PROP_PAINT_BUDGET:
+            {
+                ca_budget_init(&private->budget, g_value_get_double (construct_params[param].value));
+
+                break;
+            }
+            case PROP_BOUNDED_CANVAS:
+            {
+                private->bounded_canvas = g_value_get_boolean (construct_params[param].value);
+
+                break;
+            }
+            case PROP_SHAPE_WINDOW:
+            {
+                private->shape_window = private->shape_window || g_value_get_boolean (construct_params[param].value);
+
+                break;
+            }
+            case PROP_OPAQUE:
+            {
+                /* Only the shape of an opaque window is seen. */
+                private->opaque = g_value_get_boolean (construct_params[param].value);
+                private->shape_window = private->shape_window || private->opaque;
+
+                break;
+            }
+            case PROP_REMOTE:
+            {
+                private->remote = g_value_get_boolean (construct_params[param].value);
+
+                break;
+            }
+            case PROP_TILE_THREADS:
+            {
+                private->tile_threads = g_value_get_int (construct_params[param].value);
 
                 break;
             }
         }
     }
 
+    if (TRUE == private->remote)
+    {
+        /* Every pixel drawn is sent to the display; the reflection and fast frames change the whole scene. */
+        private->render_reflection_off = TRUE;
+        private->motion_threshold = 0;
+    }
+    else
+    {
+        /* The segments rasterized by workers are uploaded to the display as images. */
+        private->raster = ca_raster_new(private->scheduler, _ca_circular_application_menu_on_rasterized, (gpointer)circular_application_menu);
+
+        /* The tiles render the whole frame, so are not used when only the damage of a remote display is drawn. */
+        if (private->tile_threads > 0)
+        {
+            private->tiles = ca_tiles_new(private->tile_threads, TILE_DEFAULT_SIZE);
+        }
+    }
+
 	/* Assign the fade tick. */
     private->_fade_timer = g_timeout_add(
 		FADE_TIMER_INTERVAL,
 		_ca_circular_application_menu_on_fade_tick,
 		(gpointer)object);
 
-	/* Assign the default offset. */
-    private->view_x_offset = CA_VIEW_X_OFFSET_START - (private->view_width / 2);
-    private->view_y_offset = CA_VIEW_Y_OFFSET_START - (private->view_height / 2);
+	/* Assign the default offset; later changes of view are animated unless the display is remote. */
+    ca_core_centre_view(&private->core, NULL, CA_VIEW_X_OFFSET_START, CA_VIEW_Y_OFFSET_START);
+    private->core.animate_view = !private->remote;
+
+    /* The window covers the whole view unless it is bounded to the open file-leaves. */
+    private->canvas.x = 0;
+    private->canvas.y = 0;
+    private->canvas.width = private->core.view_width;
+    private->canvas.height = private->core.view_height;
+    private->view_origin_x = 0;
+    private->view_origin_y = 0;
+    private->shape = NULL;
+
+    if (TRUE == private->bounded_canvas)
+    {
+        GdkRectangle workarea = {0};
+
+        gdk_monitor_get_workarea(gdk_display_get_primary_monitor(gdk_display_get_default()), &workarea);
+
+        private->view_origin_x = workarea.x;
+        private->view_origin_y = workarea.y;
+        private->canvas.width = 0;
+        private->canvas.height = 0;
+
+        _ca_circular_application_menu_update_canvas(circular_application_menu);
+    }
 
     /* Assign the icon size. */
     {
         GtkIconSize icon_size;
-        gint hypotenuse;
+        gint icon_width;
+        gint icon_height;
+        gint root_centre_iconsize;
 
         switch(private->glyph_size)
         {
@@ -531,34 +703,33 @@ _ca_circular_application_menu_constructor (
             break;
         }
 
-        if (!gtk_icon_size_lookup (icon_size, &private->icon_width, &private->icon_height))
+        if (!gtk_icon_size_lookup (icon_size, &icon_width, &icon_height))
         {
             g_warning("Invalid icon size\n");
         }
 
-        /* Work out the hypotenuse so a square image fits onto a tab. */
-        hypotenuse = MAX(private->icon_width * private->icon_width, private->icon_height * private->icon_height);
-
-		/* Use the smaller side as not worried about any overlap. */
-        private->normal_iconsize = MAX(private->icon_width, private->icon_height);
-
-        private->tab_width =
-        	RADIUS_ICON_SPACER +
-        	RADIUS_ICON_SPACER +
-        	sqrt(hypotenuse * 2);	/* Use the larger hypotenuse so there is no overlap. */
+        if ((private->emblem_normal != NULL) &&
+            (private->emblem_prelight != NULL))
+        {
+            root_centre_iconsize = MAX(gdk_pixbuf_get_width(private->emblem_normal), gdk_pixbuf_get_width(private->emblem_prelight));
+        }
+        else
+        {
+            root_centre_iconsize = CENTRE_ICONSIZE;
+        }
 
-		private->tab_height =
-			((RADIUS_ICON_SPACER + private->normal_iconsize + RADIUS_ICON_SPACER) -
-			(RADIUS_SPACER + CLOSEST_TAB_CIRCLE_RADIUS + FARTHEST_TAB_CIRCLE_RADIUS));
+        ca_geometry_init(&private->core.geometry, icon_width, icon_height, root_centre_iconsize);
 
         /* Load the light reflection pixbuf. */
-        if ((private->light_pixbuf = gdk_pixbuf_new_from_resource(RESOURCE_PATH"reflection.png", &error)) == NULL)
-        {
-            g_warning ("Resource not found: %s\n", error->message);
-            g_clear_error (&error); /* g_error_free */
-        }
+        private->light_pixbuf = ca_cache_load_resource(private->cache, RESOURCE_PATH"reflection.png");
                 
         g_assert(private->light_pixbuf != NULL);
+
+        /* The glyph pixbufs are decoded once per process rather than on every render. */
+        private->close_normal_pixbuf = ca_cache_load_resource(private->cache, RESOURCE_PATH"close-menu-normal.png");
+        private->close_prelight_pixbuf = ca_cache_load_resource(private->cache, RESOURCE_PATH"close-menu-prelight.png");
+        private->open_normal_pixbuf = ca_cache_load_resource(private->cache, RESOURCE_PATH"open-sub-menu-normal.png");
+        private->open_prelight_pixbuf = ca_cache_load_resource(private->cache, RESOURCE_PATH"open-sub-menu-prelight.png");
     }
 
     return object;
@@ -582,6 +753,49 @@ _ca_circular_application_menu_destroy(GtkWidget* object)
     circular_application_menu = CA_CIRCULAR_APPLICATION_MENU(object);
     private = _ca_circular_application_menu_get_instance_private(circular_application_menu);
 
+    if (private->resolve_tick_id != 0)
+    {
+        gtk_widget_remove_tick_callback(object, private->resolve_tick_id);
+        private->resolve_tick_id = 0;
+    }
+
+    /* Abandon any file-leaf being built. */
+    _ca_circular_application_menu_cancel_open(circular_application_menu);
+    _ca_circular_application_menu_cancel_preview(circular_application_menu);
+
+    if (private->settle_timeout_id != 0)
+    {
+        g_source_remove(private->settle_timeout_id);
+        private->settle_timeout_id = 0;
+    }
+
+    if (private->quality_idle_id != 0)
+    {
+        g_source_remove(private->quality_idle_id);
+        private->quality_idle_id = 0;
+    }
+
+    if (private->_fade_timer != 0)
+    {
+        g_source_remove(private->_fade_timer);
+        private->_fade_timer = 0;
+    }
+
+    /* The file-leaves cancel any of their surfaces still held, so are closed before the raster is freed. */
+    ca_core_clear(&private->core);
+
+    if (private->raster != NULL)
+    {
+        ca_raster_free(private->raster);
+        private->raster = NULL;
+    }
+
+    if (private->tiles != NULL)
+    {
+        ca_tiles_free(private->tiles);
+        private->tiles = NULL;
+    }
+
     if (private->emblem_normal != NULL)
     {
         g_object_unref(private->emblem_normal);
@@ -600,6 +814,57 @@ _ca_circular_application_menu_destroy(GtkWidget* object)
         private->light_pixbuf = NULL;
     }
 
+    if (private->close_normal_pixbuf != NULL)
+    {
+        g_object_unref(private->close_normal_pixbuf);
+        private->close_normal_pixbuf = NULL;
+    }
+
+    if (private->close_prelight_pixbuf != NULL)
+    {
+        g_object_unref(private->close_prelight_pixbuf);
+        private->close_prelight_pixbuf = NULL;
+    }
+
+    if (private->open_normal_pixbuf != NULL)
+    {
+        g_object_unref(private->open_normal_pixbuf);
+        private->open_normal_pixbuf = NULL;
+    }
+
+    if (private->open_prelight_pixbuf != NULL)
+    {
+        g_object_unref(private->open_prelight_pixbuf);
+        private->open_prelight_pixbuf = NULL;
+    }
+
+    g_list_free(private->unresolved_fileleaves);
+    private->unresolved_fileleaves = NULL;
+
+    if (private->view_cache != NULL)
+    {
+        cairo_surface_destroy(private->view_cache);
+        private->view_cache = NULL;
+    }
+
+    if (private->shape != NULL)
+    {
+        cairo_region_destroy(private->shape);
+        private->shape = NULL;
+    }
+
+    if (private->cache != NULL)
+    {
+        ca_cache_unref(private->cache);
+        private->cache = NULL;
+    }
+
+    if (private->scheduler != NULL)
+    {
+        ca_scheduler_unref(private->scheduler);
+        private->scheduler = NULL;
+    }
+
     /* Call base functionality. */
     if (GTK_WIDGET_CLASS (parent_class)->destroy)
     {
@@ -676,6 +941,7 @@ _ca_circular_application_menu_class_init (CaCircularApplicationMenuClass* klass)
     widget_class->destroy = _ca_circular_application_menu_destroy; 
 
     widget_class->draw = _ca_circular_application_menu_draw;
+    widget_class->hierarchy_changed = _ca_circular_application_menu_hierarchy_changed;
 
     widget_class->get_preferred_width = _ca_circular_application_menu_get_preferred_width;
     widget_class->get_preferred_height = _ca_circular_application_menu_get_preferred_height;
@@ -684,6 +950,7 @@ _ca_circular_application_menu_class_init (CaCircularApplicationMenuClass* klass)
     widget_class->button_release_event = _ca_circular_application_menu_button_release;
     widget_class->key_release_event = _ca_circular_application_menu_key_release;
     widget_class->motion_notify_event = _ca_circular_application_menu_motion_notify;
+    widget_class->scroll_event = _ca_circular_application_menu_scroll;
 
     /* Install the widgets class child properties. */
 
@@ -774,6 +1041,106 @@ _ca_circular_application_menu_class_init (CaCircularApplicationMenuClass* klass)
             FALSE,
             G_PARAM_WRITABLE|G_PARAM_CONSTRUCT_ONLY));
 
+    g_object_class_install_property (
+        gobject_class,
+        PROP_PAGE_SIZE,
+        g_param_spec_int (
+            "page-size",
+            "Page Size",
+            "Page Size.",
+            0,
+            G_MAXINT,
+            MAX_FILEITEMS_PER_FILELEAF,
+            G_PARAM_WRITABLE|G_PARAM_CONSTRUCT_ONLY));
+
+    g_object_class_install_property (
+        gobject_class,
+        PROP_MOTION_THRESHOLD,
+        g_param_spec_int (
+            "motion-threshold",
+            "Motion Threshold",
+            "Motion Threshold.",
+            0,
+            G_MAXINT,
+            MOTION_FAST_THRESHOLD,
+            G_PARAM_WRITABLE|G_PARAM_CONSTRUCT_ONLY));
+
+    g_object_class_install_property (
+        gobject_class,
+        PROP_SETTLE_INTERVAL,
+        g_param_spec_int (
+            "settle-interval",
+            "Settle Interval",
+            "Settle Interval.",
+            1,
+            G_MAXINT,
+            MOTION_SETTLE_INTERVAL,
+            G_PARAM_WRITABLE|G_PARAM_CONSTRUCT_ONLY));
+
+    g_object_class_install_property (
+        gobject_class,
+        PROP_PAINT_BUDGET,
+        g_param_spec_double (
+            "paint-budget",
+            "Paint Budget",
+            "Paint Budget.",
+            0.0,
+            G_MAXDOUBLE,
+            PAINT_BUDGET,
+            G_PARAM_WRITABLE|G_PARAM_CONSTRUCT_ONLY));
+
+    g_object_class_install_property (
+        gobject_class,
+        PROP_BOUNDED_CANVAS,
+        g_param_spec_boolean (
+            "bounded-canvas",
+            "Bounded Canvas",
+            "Bounded Canvas.",
+            FALSE,
+            G_PARAM_WRITABLE|G_PARAM_CONSTRUCT_ONLY));
+
+    g_object_class_install_property (
+        gobject_class,
+        PROP_SHAPE_WINDOW,
+        g_param_spec_boolean (
+            "shape-window",
+            "Shape Window",
+            "Shape Window.",
+            FALSE,
+            G_PARAM_WRITABLE|G_PARAM_CONSTRUCT_ONLY));
+
+    g_object_class_install_property (
+        gobject_class,
+        PROP_OPAQUE,
+        g_param_spec_boolean (
+            "opaque",
+            "Opaque",
+            "Opaque.",
+            FALSE,
+            G_PARAM_WRITABLE|G_PARAM_CONSTRUCT_ONLY));
+
+    g_object_class_install_property (
+        gobject_class,
+        PROP_REMOTE,
+        g_param_spec_boolean (
+            "remote",
+            "Remote",
+            "Remote.",
+            FALSE,
+            G_PARAM_WRITABLE|G_PARAM_CONSTRUCT_ONLY));
+
+    g_object_class_install_property (
+        gobject_class,
+        PROP_TILE_THREADS,
+        g_param_spec_int (
+            "tile-threads",
+            "Tile Threads",
+            "Tile Threads.",
+            0,
+            TILE_MAX_THREADS,
+            0,
+            G_PARAM_WRITABLE|G_PARAM_CONSTRUCT_ONLY));
+
   if (_ca_circular_application_menu_private_offset != 0)
   {
     g_type_class_adjust_private_offset (klass, &_ca_circular_application_menu_private_offset);
@@ -801,7 +1168,8 @@ _ca_circular_application_menu_init (CaCircularApplicationMenu* widget)
         GDK_POINTER_MOTION_HINT_MASK|
         GDK_POINTER_MOTION_MASK|
         GDK_BUTTON_PRESS_MASK|
-        GDK_BUTTON_RELEASE_MASK);
+        GDK_BUTTON_RELEASE_MASK|
+        GDK_SCROLL_MASK);
 }
 
 /**
@@ -816,7 +1184,8 @@ _ca_circular_application_menu_draw (GtkWidget* widget, cairo_t* cr)
 {
     CaCircularApplicationMenu* circular_application_menu;
     CaCircularApplicationMenuPrivate* private;
-    gint y;
+    CaRenderContext context;
+    gint64 start;
 
     g_return_val_if_fail(GTK_WIDGET(widget) != NULL, FALSE);
     g_return_val_if_fail(CA_IS_CIRCULAR_APPLICATION_MENU(widget), FALSE);
@@ -824,131 +1193,46 @@ _ca_circular_application_menu_draw (GtkWidget* widget, cairo_t* cr)
     circular_application_menu = CA_CIRCULAR_APPLICATION_MENU(widget);
     private = _ca_circular_application_menu_get_instance_private(circular_application_menu);
 
-    cairo_set_fill_rule (cr, CAIRO_FILL_RULE_EVEN_ODD);
-
-    /* draw the background */
-    cairo_set_operator (cr, CAIRO_OPERATOR_CLEAR);
-    cairo_paint (cr);
-    cairo_set_operator (cr, CAIRO_OPERATOR_OVER);
-
-    /* VM - Non transparent debug. */
-    /*
-    cairo_rectangle (cr, 0, 0, widget->allocation.width, widget->allocation.height);
-    cairo_set_source_rgba (cr, 0.8, 0.8, 0.8, 1.0);
-    cairo_fill (cr);
-    */
-
-    /* Draw a gradient circle. */
-    /* FIXME: Bit slow this and not working quite right.  Turn off for now.
-    {
-        cairo_set_source_rgba(cr, 1, 1, 1, 0.9);
-        cairo_rectangle(cr, 0, 0, 500, 500);
-        cairo_fill(cr);
-        cairo_stroke(cr);
-
-        cairo_pattern_t* pattern;
+    _ca_circular_application_menu_get_render_context(circular_application_menu, &context);
 
-        pattern = cairo_pattern_create_radial(
-            widget->allocation.width / 2,
-            widget->allocation.height / 2,
-            widget->allocation.height / 8,
-            widget->allocation.width / 2,
-            widget->allocation.height / 2,
-            widget->allocation.height);
+    /* Count the window pixels this frame draws. */
+    _ca_circular_application_menu_count_damage(circular_application_menu, cr);
 
-        cairo_pattern_add_color_stop_rgba (pattern, 0.0, 0.0, 0.0, 0.0, 1.0);
-        cairo_pattern_add_color_stop_rgba (pattern, 1.0, 0.0, 0.0, 0.1, 0.0);
+    /* The window only covers the canvas of the view. */
+    cairo_translate(cr, -private->canvas.x, -private->canvas.y);
 
-        cairo_set_source (cr, pattern);
-        cairo_mask (cr, pattern);
-
-        cairo_pattern_destroy (pattern);
-    }
-    */
-
-    cairo_rectangle (
-        cr,
-        0,
-        0,
-        private->view_width,
-        private->view_height);
-
-    cairo_clip (cr);
-    
 	/* Render the circular-application-menu to a cairo context. */
-    _ca_circular_application_menu_render (circular_application_menu, cr);
-
-    /* Render text. */
-
-    /* Calculate the text position. */
-    y = private->view_height - (private->view_height / 7);
+    start = ca_trace_timestamp();
 
-    if (g_current_type == GLYPH_ROOT_CENTRE)
+    if (!_ca_circular_application_menu_draw_view_cache(circular_application_menu, &context, cr))
     {
-		/* Render the text to a cairo context. */
-        _ca_circular_application_menu_render_centred_text(
-            circular_application_menu,
-            y,
-            CLOSE_MENU_TEXT,
-            cr);
-    }
-    else if (g_current_type == GLYPH_FILE_MENU_CENTRE)
-    {
-		/* Render the text to a cairo context. */
-        _ca_circular_application_menu_render_centred_text(
-            circular_application_menu,
-            y,
-            CLOSE_SUB_MENU_TEXT,
-            cr);
-    }
-    else if ((g_current_type != GLYPH_UNKNOWN) &&
-        (g_current_fileitem != NULL) &&
-        (g_current_fileitem->_menutreeitem != NULL) &&
-        (g_current_fileleaf != g_disassociated_fileleaf))
-    {
-        const gchar* name;
-        const gchar* comment;
+        gint64 paint_start;
 
-        name = NULL;
-        comment = NULL;
+        paint_start = g_get_monotonic_time();
 
-        if (g_current_type == GLYPH_FILE_MENU)
+        if (private->tiles != NULL)
         {
-            name = gmenu_tree_directory_get_name(g_current_fileitem->_menutreeitem);
-            comment = gmenu_tree_directory_get_comment(g_current_fileitem->_menutreeitem);
+            ca_tiles_render_frame(private->tiles, &context, cr);
         }
         else
         {
-            /* https://github.com/frida/glib/blob/master/gio/gdesktopappinfo.c */
-            GDesktopAppInfo* desktop_app_info;
-
-            desktop_app_info = gmenu_tree_entry_get_app_info(g_current_fileitem->_menutreeitem);
-
-            name = g_desktop_app_info_get_string(desktop_app_info, "Name");
-            comment = g_desktop_app_info_get_string(desktop_app_info, "Comment");
+            ca_render_frame(&context, cr);
         }
 
-        /* Name. */
-
-        /* Render the text to a cairo context. */
-        _ca_circular_application_menu_render_centred_text(
-            circular_application_menu,
-            y,
-            (name != NULL) ? name : "",
-            cr);
-
-        y += 25;
-
-        /* Comment. */
-
-        /* Render the text to a cairo context. */
-        _ca_circular_application_menu_render_centred_text(
-            circular_application_menu,
-            y,
-            (comment != NULL) ? comment : "",
-            cr);
+        /* Only full quality frames measure the budget; fast frames and view cache blits are cheaper. */
+        if ((FALSE == context.render_fast) &&
+            (TRUE == ca_budget_add_frame(&private->budget, g_get_monotonic_time() - paint_start)) &&
+            (private->quality_idle_id == 0))
+        {
+            /* The scene and the window are only changed once the frame has been painted. */
+            private->quality_idle_id = g_idle_add(
+                _ca_circular_application_menu_on_quality_changed,
+                (gpointer)circular_application_menu);
+        }
     }
 
+    ca_trace_frame(start);
+
     return FALSE;
 }
 
@@ -971,8 +1255,8 @@ _ca_circular_application_menu_size_request(GtkWidget* widget, GtkRequisition* re
     circular_application_menu = CA_CIRCULAR_APPLICATION_MENU(widget);
     private = _ca_circular_application_menu_get_instance_private(circular_application_menu);
 
-    requisition->width = private->view_width;
-    requisition->height = private->view_height;
+    requisition->width = private->canvas.width;
+    requisition->height = private->canvas.height;
 }
 
 /**
@@ -1026,6 +1310,7 @@ static gboolean
 _ca_circular_application_menu_key_release(GtkWidget* widget, GdkEventKey* event)
 {
     CaCircularApplicationMenu* circular_application_menu;
+    CaCircularApplicationMenuPrivate* private;
     CaFileLeaf* position_fileleaf;
 
     g_return_val_if_fail(GTK_WIDGET(widget) != NULL, FALSE);
@@ -1033,6 +1318,7 @@ _ca_circular_application_menu_key_release(GtkWidget* widget, GdkEventKey* event)
     g_return_val_if_fail(event != NULL, FALSE);
 
     circular_application_menu = CA_CIRCULAR_APPLICATION_MENU(widget);
+    private = _ca_circular_application_menu_get_instance_private(circular_application_menu);
 
     position_fileleaf = NULL;
 
@@ -1044,76 +1330,53 @@ _ca_circular_application_menu_key_release(GtkWidget* widget, GdkEventKey* event)
 
             return FALSE;
         case GDK_KEY_Down:
+            /* Nothing to close until a sub menu is open; the menu tree may still be loading. */
+            if ((NULL == private->core.tabbed_fileleaf) ||
+                (private->core.tabbed_fileleaf == private->core.root_fileleaf))
+                return FALSE;
+
             /* Close the current menu. */
+            _ca_circular_application_menu_cancel_open(circular_application_menu);
 
-            _ca_circular_application_menu_close_menu(circular_application_menu, g_tabbed_fileleaf);
+            ca_core_close_menu(&private->core, private->core.tabbed_fileleaf);
 
             /* Invalidate the widget. */
-            gtk_widget_queue_draw(widget);
-
-            /* Handle any pending events. */
-            while (gtk_events_pending())
-            {
-                /* Process all events currently in the queue. */
-                gtk_main_iteration();
-            }
+            _ca_circular_application_menu_invalidate(circular_application_menu);
 
             return FALSE;
         case GDK_KEY_Home:
             /* Move to the last opened fileleaf. */
-            position_fileleaf = g_last_opened_fileleaf;
+            position_fileleaf = ca_core_get_navigation_fileleaf(&private->core, NAVIGATE_LAST_OPENED);
 
             break;
         case GDK_KEY_End:
             /* Move to the root fileleaf. */
-            position_fileleaf = g_root_fileleaf;
+            position_fileleaf = ca_core_get_navigation_fileleaf(&private->core, NAVIGATE_ROOT);
 
             break;
         case GDK_KEY_Page_Up:
-        {
             /* Move to the next fileleaf. */
-            if (g_tabbed_fileleaf == g_last_opened_fileleaf)
-                position_fileleaf = g_root_fileleaf;
-            else
-                position_fileleaf = g_tabbed_fileleaf->_child_fileleaf;
+            position_fileleaf = ca_core_get_navigation_fileleaf(&private->core, NAVIGATE_NEXT);
 
             break;
-        }
         case GDK_KEY_Page_Down:
-        {
             /* Move to the previous fileleaf. */
-            if (g_tabbed_fileleaf == g_root_fileleaf)
-                position_fileleaf = g_last_opened_fileleaf;
-            else
-                position_fileleaf = g_tabbed_fileleaf->_parent_fileleaf;
+            position_fileleaf = ca_core_get_navigation_fileleaf(&private->core, NAVIGATE_PREVIOUS);
 
             break;
-        }
     }
 
 	/* Check whether a new file-leaf should be positioned. */
     if (position_fileleaf != NULL)
     {
-        /* Position view at the tabbed file-leaf. */
+        /* Navigating away abandons any file-leaf being built. */
+        _ca_circular_application_menu_cancel_open(circular_application_menu);
 
-        g_tabbed_fileleaf = position_fileleaf;
-
-        /* Centre the view around the given file-leaf. */
-        _ca_circular_application_menu_view_centre_fileleaf(
-			circular_application_menu,
-			g_tabbed_fileleaf,
-			-1,
-			-1);
+        /* Position view at the tabbed file-leaf. */
+        ca_core_tab_fileleaf(&private->core, position_fileleaf);
 
         /* Invalidate the widget. */
-        gtk_widget_queue_draw(widget);
-
-        /* Handle any pending events. */
-        while (gtk_events_pending())
-        {
-            /* Process all events currently in the queue. */
-            gtk_main_iteration();
-        }
+        _ca_circular_application_menu_invalidate(circular_application_menu);
     }
 
     return FALSE;
@@ -1135,9 +1398,9 @@ _ca_circular_application_menu_motion_notify(GtkWidget* widget, GdkEventMotion* e
     CaCircularApplicationMenuPrivate* private;
     gint x, y;
     GdkModifierType state;
-    CaFileLeaf* previous_fileleaf;
-    CaFileItem* previous_fileitem;
-    GlyphType previous_type;
+    gboolean changed;
+    CaFileLeaf* disassociated_fileleaf;
+    cairo_region_t* previous;
 
     g_return_val_if_fail(GTK_WIDGET(widget) != NULL, FALSE);
     g_return_val_if_fail(CA_IS_CIRCULAR_APPLICATION_MENU(widget), FALSE);
@@ -1172,74 +1435,73 @@ _ca_circular_application_menu_motion_notify(GtkWidget* widget, GdkEventMotion* e
         state = event->state;
     }
 
-    /* Update the current item. */
-    previous_fileleaf = g_current_fileleaf;
-    previous_fileitem = g_current_fileitem;
-    previous_type = g_current_type;
+    /* The window only covers the canvas of the view. */
+    x += private->canvas.x;
+    y += private->canvas.y;
 
-    /* Retrieve the glyph-type, file-leaf and file-item at the specified mouse co-ordinate. */
-    g_current_type = _ca_circular_application_menu_hittest(
-        circular_application_menu,
-        SCREEN_2_OFFSET((gint)event->x, private->view_x_offset),
-        SCREEN_2_OFFSET((gint)event->y, private->view_y_offset),
-        &g_current_fileleaf,
-        &g_current_fileitem);
+    /* Render coarsely whilst the pointer is moving quickly. */
+    _ca_circular_application_menu_track_motion(circular_application_menu, x, y);
+
+    /* On a remote display only the glyph prelit before and after the pointer moved is drawn. */
+    previous = NULL;
+    disassociated_fileleaf = private->core.disassociated_fileleaf;
+
+    if (TRUE == private->remote)
+    {
+        CaRenderContext context;
+
+        _ca_circular_application_menu_get_render_context(circular_application_menu, &context);
+
+        previous = cairo_region_create();
+        ca_render_add_current_damage(&context, previous);
+    }
+
+    /* Update the glyph-type, file-leaf and file-item under the pointer. */
+    changed = ca_core_update_current(&private->core, x, y);
 
     /* Display a disassociated fileleaf. */
-    if (GLYPH_TAB == g_current_type)
+    if (GLYPH_TAB == private->core.current_type)
     {
         /* Invalidate the widget. */
-        gtk_widget_queue_draw(widget);
-
-        /* Handle any pending events. */
-        while (gtk_events_pending())
-        {
-            /* Process all events currently in the queue. */
-            gtk_main_iteration();
-        }
+        _ca_circular_application_menu_invalidate(circular_application_menu);
     }
-    else if ((g_current_fileleaf != previous_fileleaf) ||
-             (g_current_fileitem != previous_fileitem) ||
-             (g_current_type != previous_type))
+    else if (TRUE == changed)
     {
         /* The selected item has changed. */
 
-        if (FALSE == private->hide_preview)
+        if ((FALSE == private->hide_preview) &&
+            (private->budget.level < QUALITY_NO_PREVIEW))
         {
-            if (g_disassociated_fileleaf != NULL)
-            {
-                /* Close the disassociated fileleaf. */
+            /* Abandon the preview of the previously hovered item. */
+            _ca_circular_application_menu_cancel_preview(circular_application_menu);
 
-                _ca_circular_application_menu_close_menu(circular_application_menu, g_disassociated_fileleaf);
-                g_disassociated_fileleaf = NULL;
-            }
+            /* Close the disassociated fileleaf. */
+            ca_core_close_preview(&private->core);
 
-            if ((g_current_fileitem != NULL) &&
-                (g_current_fileitem->_type == GLYPH_FILE_MENU))
+            if ((private->core.current_fileitem != NULL) &&
+                (private->core.current_fileitem->_type == GLYPH_FILE_MENU))
             {
-                /* Show the disassociated fileleaf. */
-
-                g_assert(g_disassociated_fileleaf == NULL);
-                g_disassociated_fileleaf = _ca_circular_application_menu_show_fileitem(
-                    circular_application_menu, 
-                    g_current_fileitem->_menutreeitem,
-                    GLYPH_FILE_MENU_CENTRE,
-                    g_current_fileitem,
-                    TRUE);
+                /* Show the disassociated fileleaf once the item has been hovered over. */
+                _ca_circular_application_menu_schedule_preview(circular_application_menu, private->core.current_fileitem);
             }
         }
 
-        /* Invalidate the widget. */
-        gtk_widget_queue_draw(widget);
-
-        /* Handle any pending events. */
-        while (gtk_events_pending())
+        /* Invalidate the widget; only the prelight has changed unless the preview was closed. */
+        if (disassociated_fileleaf == private->core.disassociated_fileleaf)
+        {
+            _ca_circular_application_menu_invalidate_current(circular_application_menu, previous);
+        }
+        else
         {
-            /* Process all events currently in the queue. */
-            gtk_main_iteration();
+            _ca_circular_application_menu_invalidate(circular_application_menu);
         }
     }
 
+    if (previous != NULL)
+    {
+        cairo_region_destroy(previous);
+    }
+
     return TRUE;
 }
 /**
@@ -1265,7 +1527,8 @@ _ca_circular_application_menu_button_press(GtkWidget* widget, GdkEventButton* ev
     if ((event->type == GDK_2BUTTON_PRESS) ||
         (event->type == GDK_3BUTTON_PRESS))
     {
-        /* Double clicked. */
+        /* Double clicked; abandon the file-leaf the first click started building. */
+        _ca_circular_application_menu_cancel_open(circular_application_menu);
     }
 
     return FALSE;
@@ -1287,6 +1550,7 @@ _ca_circular_application_menu_button_release(GtkWidget* widget, GdkEventButton*
     CaCircularApplicationMenuPrivate* private;
     CaFileLeaf* fileleaf;
     CaFileItem* fileitem;
+    gint x, y;
 
     g_return_val_if_fail(GTK_WIDGET(widget) != NULL, FALSE);
     g_return_val_if_fail(CA_IS_CIRCULAR_APPLICATION_MENU(widget), FALSE);
@@ -1295,42 +1559,32 @@ _ca_circular_application_menu_button_release(GtkWidget* widget, GdkEventButton*
     circular_application_menu = CA_CIRCULAR_APPLICATION_MENU(widget);
     private = _ca_circular_application_menu_get_instance_private(circular_application_menu);
 
+    /* The window only covers the canvas of the view. */
+    x = (gint)event->x + private->canvas.x;
+    y = (gint)event->y + private->canvas.y;
+
     /* Copy if changed during a 'motion-notify'. */
-    fileleaf = g_current_fileleaf;
-    fileitem = g_current_fileitem;
+    fileleaf = private->core.current_fileleaf;
+    fileitem = private->core.current_fileitem;
 
     /* Check for a right click. */
     if (event->button == 3) /* None=0, Left=1, Middle=2, Right=3 */
     {
         /* Position current show menu at mouse. */
 
-        if (g_tabbed_fileleaf != NULL)
+        if (private->core.tabbed_fileleaf != NULL)
         {
-            gint x;
-            gint y;
+            /* Navigating away abandons any file-leaf being built. */
+            _ca_circular_application_menu_cancel_open(circular_application_menu);
 
-            x = g_tabbed_fileleaf->x + ((private->view_width / 2) - event->x);
-            y = g_tabbed_fileleaf->y + ((private->view_height / 2) - event->y);
-
-            /* Centre the view around the given file-leaf. */
-            _ca_circular_application_menu_view_centre_fileleaf(
-                circular_application_menu,
-                g_tabbed_fileleaf,
-                x,
-                y);
+            /* Centre the tabbed file-leaf at the mouse. */
+            ca_core_move_tabbed_fileleaf(&private->core, x, y);
 
             /* Update the highlighted item at the given coordinates. */
-            _ca_circular_applications_menu_update_highlight(circular_application_menu, event->x, event->y);
+            _ca_circular_applications_menu_update_highlight(circular_application_menu, x, y);
 
             /* Invalidate the widget. */
-            gtk_widget_queue_draw(widget);
-
-            /* Handle any pending events. */
-            while (gtk_events_pending())
-            {
-                /* Process all events currently in the queue. */
-                gtk_main_iteration();
-            }
+            _ca_circular_application_menu_invalidate(circular_application_menu);
         }
 
         return FALSE;
@@ -1343,83 +1597,27 @@ _ca_circular_application_menu_button_release(GtkWidget* widget, GdkEventButton*
         if (fileitem->_type == GLYPH_FILE_MENU)
         {
             /* Open the current menu. */
-            CaFileLeaf* sub_fileleaf;
-
-            if (g_disassociated_fileleaf != NULL)
-            {
-                /* Close the disassociated fileleaf. */
-
-                _ca_circular_application_menu_close_menu(circular_application_menu, g_disassociated_fileleaf);
-                g_disassociated_fileleaf = NULL;
-            }
-
-            sub_fileleaf = _ca_circular_application_menu_show_fileitem(
-                circular_application_menu,
-                fileitem->_menutreeitem,
-                GLYPH_FILE_MENU_CENTRE,
-                fileitem,
-                FALSE);
-
-            g_current_fileitem = sub_fileleaf->_central_glyph;    /* Disassociated current fileitem so the text changes. */
 
-            /* Centre the view around the given file-leaf. */
-            _ca_circular_application_menu_view_centre_fileleaf(circular_application_menu, sub_fileleaf, -1, -1);
+            /* Close the disassociated fileleaf. */
+            ca_core_close_preview(&private->core);
 
-            /* Update the current navigational fileleafs. */
-            g_last_opened_fileleaf = sub_fileleaf;
-            g_tabbed_fileleaf = sub_fileleaf;
-
-            /* Update to reflect the new view position. */
-
-            /* Retrieve the glyph-type, file-leaf and file-item at the specified mouse co-ordinate. */
-            g_current_type = _ca_circular_application_menu_hittest(
-                circular_application_menu,
-                SCREEN_2_OFFSET((gint)event->x, private->view_x_offset),
-                SCREEN_2_OFFSET((gint)event->y, private->view_y_offset),
-                &g_current_fileleaf,
-                &g_current_fileitem);
+            /* The file-leaf is built asynchronously and shown once it is ready. */
+            _ca_circular_application_menu_open_fileitem(circular_application_menu, fileitem);
 
             /* Invalidate the widget. */
-            gtk_widget_queue_draw(widget);
-
-            /* Handle any pending events. */
-            while (gtk_events_pending())
-            {
-                /* Process all events currently in the queue. */
-                gtk_main_iteration();
-            }
-
-            /* Move the mouse pointer to the centre of the screen. */
-            if (FALSE == private->xwarp_mouse_pointer)
-            {
-                /* Move the pointer to the centre of the screen. */
-                _ca_circular_application_menu_device_warp(circular_application_menu);
-            }
+            _ca_circular_application_menu_invalidate(circular_application_menu);
         }
         else if (fileitem->_type == GLYPH_FILE_MENU_CENTRE)
         {
             /* Close the current menu. */
-            _ca_circular_application_menu_close_menu(circular_application_menu, fileleaf);
+            _ca_circular_application_menu_cancel_open(circular_application_menu);
+            ca_core_close_menu(&private->core, fileleaf);
 
             /* Update to reflect the new view position. */
-
-            /* Retrieve the glyph-type, file-leaf and file-item at the specified mouse co-ordinate. */
-            g_current_type = _ca_circular_application_menu_hittest(
-                circular_application_menu,
-                SCREEN_2_OFFSET((gint)event->x, private->view_x_offset),
-                SCREEN_2_OFFSET((gint)event->y, private->view_y_offset),
-                &g_current_fileleaf,
-                &g_current_fileitem);
+            ca_core_update_current(&private->core, x, y);
 
             /* Invalidate the widget. */
-            gtk_widget_queue_draw(widget);
-
-            /* Handle any pending events. */
-            while (gtk_events_pending())
-            {
-                /* Process all events currently in the queue. */
-                gtk_main_iteration();
-            }
+            _ca_circular_application_menu_invalidate(circular_application_menu);
 
             /* Move the mouse pointer to the centre of the screen. */
 
@@ -1438,7 +1636,7 @@ _ca_circular_application_menu_button_release(GtkWidget* widget, GdkEventButton*
             GdkAppLaunchContext* context;
             const gchar* desktopfile;
 
-            desktopfile = gmenu_tree_entry_get_desktop_file_path(fileitem->_menutreeitem);
+            desktopfile = gmenu_tree_entry_get_desktop_file_path(CA_MENU_FILEITEM(fileitem)->menutreeitem);
             g_assert(NULL != desktopfile);
 
 			desktopitem = g_desktop_app_info_new_from_filename (desktopfile);
@@ -1456,13 +1654,18 @@ _ca_circular_application_menu_button_release(GtkWidget* widget, GdkEventButton*
             /* Quit out of application. */
             gtk_main_quit();
         }
+        else if (fileitem->_type == GLYPH_PAGE)
+        {
+            /* Show the next page of the file-leaf. */
+            _ca_circular_application_menu_page_fileleaf(circular_application_menu, fileleaf, fileleaf->_page + 1, x, y);
+        }
         else if (fileitem->_type == GLYPH_ROOT_CENTRE)
         {
             /* Quit out of application. */
             gtk_main_quit();
         }
     }
-    else if (g_current_fileleaf == NULL)
+    else if (private->core.current_fileleaf == NULL)
     {
         /* Nothing hit. */
 
@@ -1474,2482 +1677,1611 @@ _ca_circular_application_menu_button_release(GtkWidget* widget, GdkEventButton*
 }
 
 /**
- * _ca_circular_application_menu_close_menu:
- * @circular_application_menu: A CaCircularApplicationMenu pointer to the circular-application-menu widget instance.
- * @fileleaf: A CaFileLeaf pointer to close.
+ * _ca_circular_application_menu_scroll:
+ * @widget: a GtkWidget pointer to the current widget.
+ * @event: a pointer to the current event structure.
  *
- * Closes the specified circular-application-menu's file leaf.
- */
-static void
-_ca_circular_application_menu_close_menu(CaCircularApplicationMenu* circular_application_menu, CaFileLeaf* fileleaf)
+ * Generated 'scroll_event' caused when the mouse wheel is turned; the pages of an overflowing
+ * file-leaf under the pointer are rotated through.
+ *
+ * Returns: TRUE if the event is handled; otherwise FALSE.
+ **/
+static gboolean
+_ca_circular_application_menu_scroll(GtkWidget* widget, GdkEventScroll* event)
 {
-    CaFileLeaf* parent_fileleaf;
+    CaCircularApplicationMenu* circular_application_menu;
+    CaCircularApplicationMenuPrivate* private;
+    CaFileLeaf* fileleaf;
+
+    g_return_val_if_fail(GTK_WIDGET(widget) != NULL, FALSE);
+    g_return_val_if_fail(CA_IS_CIRCULAR_APPLICATION_MENU(widget), FALSE);
+    g_return_val_if_fail(event != NULL, FALSE);
 
-    parent_fileleaf = fileleaf->_parent_fileleaf;
-    g_assert(parent_fileleaf != NULL);
+    circular_application_menu = CA_CIRCULAR_APPLICATION_MENU(widget);
+    private = _ca_circular_application_menu_get_instance_private(circular_application_menu);
 
-    ca_circular_application_menu_close_fileleaf(fileleaf);
+    fileleaf = private->core.current_fileleaf;
 
-    g_current_fileitem = parent_fileleaf->_central_glyph;    /* Disassociated current fileitem so the text changes. */
-    g_current_fileleaf = parent_fileleaf->_central_glyph->_assigned_fileleaf;
-    g_current_type = GLYPH_UNKNOWN;
+    if ((fileleaf == NULL) ||
+        (fileleaf->_page_count <= 1) ||
+        (fileleaf == private->core.disassociated_fileleaf))
+        return FALSE;
 
-    if (fileleaf != g_disassociated_fileleaf)
+    switch (event->direction)
     {
-        _ca_circular_application_menu_view_centre_fileleaf(circular_application_menu, parent_fileleaf, -1, -1);
+        case GDK_SCROLL_UP:
+            _ca_circular_application_menu_page_fileleaf(circular_application_menu, fileleaf, fileleaf->_page - 1, (gint)event->x + private->canvas.x, (gint)event->y + private->canvas.y);
 
-        /* Update the current navigational fileleafs. */
-        g_last_opened_fileleaf = parent_fileleaf;
+            return TRUE;
+        case GDK_SCROLL_DOWN:
+            _ca_circular_application_menu_page_fileleaf(circular_application_menu, fileleaf, fileleaf->_page + 1, (gint)event->x + private->canvas.x, (gint)event->y + private->canvas.y);
+
+            return TRUE;
+        default:
+            break;
     }
 
-    g_tabbed_fileleaf = parent_fileleaf;
+    return FALSE;
 }
 
 /**
- * _ca_circular_application_menu_hittest:
+ * ca_circular_application_menu_show_leaf:
  * @circular_application_menu: A CaCircularApplicationMenu pointer to the circular-application-menu widget instance.
- * @x: An Integer X co-ordinate to test.
- * @y: An Integer Y co-ordinate to test.
- * @found_fileleaf: A found file-leaf; otherwise NULL.
- * @found_fileitem: A found file-item; otherwise NULL.
+ * @menutreedirectory: A GMenuTreeDirectory pointer to display as a menu.
+ * @leaftype: The leaf-type of the menu being shown.
+ * @fileitem: The file-item to show.
+ * @disassociated: Specifies whether the file-item will be shown as a preview.
  *
- * Retrieves the glyph-type, file-leaf and file-item at the specified mouse co-ordinate.
+ * Shows a given file-item as a given leaf type.
  *
- * Returns: The found GlyphType.
+ * Returns: The newly created shown file-leaf.
  */
-static GlyphType
-_ca_circular_application_menu_hittest(
-	CaCircularApplicationMenu* circular_application_menu,
-	gint x,
-	gint y,
-	CaFileLeaf** found_fileleaf,
-	CaFileItem** found_fileitem)
+CaFileLeaf*
+ca_circular_application_menu_show_leaf(
+    CaCircularApplicationMenu* circular_application_menu,
+	GMenuTreeDirectory* menutreedirectory,
+	LeafType leaftype,
+	CaFileItem* fileitem,
+	gboolean disassociated)
 {
+    /* TODO: make this private. */
     CaCircularApplicationMenuPrivate* private;
+    CaFileLeaf* fileleaf;
 
-    private = _ca_circular_application_menu_get_instance_private(circular_application_menu);
-
-    *found_fileleaf = NULL;
-    *found_fileitem = NULL;
-
-    if (NULL != g_root_fileleaf)
+    if (menutreedirectory == NULL)
     {
-        /* Render all fileleafs. */
-        CaFileLeaf* current_fileleaf;
-        GlyphType hit_type;
-
-        /* There should always at least one fileleaf. */
-        g_assert(NULL != g_last_opened_fileleaf);
-
-        /* Walk from the last opened fileleaf to the root fileleaf so overlapped */
-        /* fileitems take precedence. */
-        current_fileleaf = g_last_opened_fileleaf;
-        /* Iterate the fileleafs. */
-        do
-        {
-            gboolean allow_hitest;
-            GList* sub_list;
-
-            allow_hitest = TRUE;
-
-            if (private->render_tabbed_only)
-            {
-                if (current_fileleaf != g_tabbed_fileleaf)
-                {
-                    allow_hitest = FALSE;
-                }
-            }
-
-            /* Check whether the fileleaf allows a hittest. */
-            if (allow_hitest)
-            {
-                /* Retrieve the glyph-type, file-leaf and file-item at the specified mouse co-ordinate; for a given parent file-leaf. */
-                hit_type = _ca_circular_application_menu_hittest_fileleaf(
-				    circular_application_menu,
-				    current_fileleaf,
-				    x,
-				    y,
-				    found_fileleaf,
-				    found_fileitem);
-
-                if (GLYPH_UNKNOWN != hit_type)
-                    return hit_type;    /* Found. */
-            }
+        return NULL;
+    }
 
-            /* Iterate the sub fileleafs. */
-            sub_list = g_list_first(current_fileleaf->_sub_fileleaves_list);
+    private = _ca_circular_application_menu_get_instance_private(circular_application_menu);
 
-            while (sub_list)
-            {
-                CaFileLeaf* sub_fileleaf;
+    fileleaf = ca_menu_fileleaf_new(menutreedirectory, leaftype, private->page_size, NULL);
 
-                sub_fileleaf = (CaFileLeaf*)sub_list->data;
-                g_assert(sub_fileleaf != NULL);
+    _ca_circular_application_menu_attach_fileleaf(circular_application_menu, fileleaf, fileitem, disassociated);
 
-                allow_hitest = TRUE;
+    return fileleaf;
+}
 
-                if (private->render_tabbed_only)
-                {
-                    if (sub_fileleaf != g_tabbed_fileleaf)
-                    {
-                        allow_hitest = FALSE;
-                    }
-                }
+/**
+ * _ca_circular_application_menu_attach_fileleaf:
+ * @circular_application_menu: A CaCircularApplicationMenu pointer to the circular-application-menu widget instance.
+ * @fileleaf: A file-leaf created by ca_fileleaf_new().
+ * @fileitem: The file-item to show.
+ * @disassociated: Specifies whether the file-item will be shown as a preview.
+ *
+ * Attaches a newly created file-leaf to the file-item it is shown from, positions it and starts
+ * resolving its icons.
+ */
+static void
+_ca_circular_application_menu_attach_fileleaf(
+    CaCircularApplicationMenu* circular_application_menu,
+	CaFileLeaf* fileleaf,
+	CaFileItem* fileitem,
+	gboolean disassociated)
+{
+    CaCircularApplicationMenuPrivate* private;
 
-                /* Check whether the fileleaf allows a hittest. */
-                if (allow_hitest)
-                {
-                    /* Retrieve the glyph-type, file-leaf and file-item at the specified mouse co-ordinate; for a given parent file-leaf. */
-                    hit_type = _ca_circular_application_menu_hittest_fileleaf(
-					    circular_application_menu,
-					    sub_fileleaf,
-					    x,
-					    y,
-					    found_fileleaf,
-					    found_fileitem);
-
-                    if (GLYPH_UNKNOWN != hit_type)
-                        return hit_type;    /* Found. */
-                }
+    private = _ca_circular_application_menu_get_instance_private(circular_application_menu);
 
-                sub_list = g_list_next(sub_list);
-            }
+    /* Position a file-leaf and all child segments. */
+    ca_core_attach_fileleaf(&private->core, fileleaf, fileitem, disassociated);
+    ca_trace_fileleaf_built();
 
-            /* Get next child fileleaf. */
-            current_fileleaf = current_fileleaf->_parent_fileleaf;
-        }
-        while (current_fileleaf != NULL);
+    /* A preview is only a silhouette until the hover has been confirmed. */
+    if (FALSE == disassociated)
+    {
+        _ca_circular_application_menu_resolve_fileleaf(circular_application_menu, fileleaf);
     }
-
-    return GLYPH_UNKNOWN;   /* Not found. */
 }
 
 /**
- * _ca_circular_application_menu_hittest_fileleaf:
+ * _ca_circular_application_menu_resolve_fileleaf:
  * @circular_application_menu: A CaCircularApplicationMenu pointer to the circular-application-menu widget instance.
- * @x: An Integer X co-ordinate to test.
- * @y: An Integer Y co-ordinate to test.
- * @found_fileleaf: A found file-leaf; otherwise NULL.
- * @found_fileitem: A found file-item; otherwise NULL.
+ * @fileleaf: A positioned file-leaf.
  *
- * Retrieves the glyph-type, file-leaf and file-item at the specified mouse co-ordinate; for a given parent file-leaf.
- *
- * Returns: The found GlyphType.
+ * Queues the icons of a file-leaf to be resolved.  The file-leaf is rendered from its layout
+ * alone; the icons stream in over the following frames.
  */
-static GlyphType
-_ca_circular_application_menu_hittest_fileleaf(CaCircularApplicationMenu* circular_application_menu, CaFileLeaf* fileleaf, gint x, gint y, CaFileLeaf** found_fileleaf, CaFileItem** found_fileitem)
+static void
+_ca_circular_application_menu_resolve_fileleaf(CaCircularApplicationMenu* circular_application_menu, CaFileLeaf* fileleaf)
 {
     CaCircularApplicationMenuPrivate* private;
-    GList* file_list;
-    CaFileItem* associated_fileitem;
-    gint tab_x;
-    gint tab_y;
 
     private = _ca_circular_application_menu_get_instance_private(circular_application_menu);
 
-    if (NULL != fileleaf->_central_glyph->_associated_fileitem)
+    if (fileleaf->_fileitem_list != NULL)
     {
-        /* Check the fileleaf. */
-        if (_ca_circular_application_menu_circle_contains_point(
-            x,
-            y,
-            fileleaf->_central_glyph->x,
-            fileleaf->_central_glyph->y,
-            fileleaf->radius + (gint)(RADIUS_SPACER + CLOSEST_TAB_CIRCLE_RADIUS + private->tab_height + FARTHEST_TAB_CIRCLE_RADIUS)))
-        {
-            /* Check the fileleaf tab. */
-            _ca_get_point_from_source_offset(
-                fileleaf->_central_glyph->x,
-                fileleaf->_central_glyph->y,
-                fileleaf->_central_glyph->_parent_angle,
-                fileleaf->radius + ((RADIUS_SPACER + CLOSEST_TAB_CIRCLE_RADIUS + private->tab_height + FARTHEST_TAB_CIRCLE_RADIUS) / 2),
-                &tab_x,
-                &tab_y);
-
-            if (_ca_circular_application_menu_circle_contains_point(
-				x,
-				y,
-				tab_x,
-				tab_y,
-				fileleaf->_central_glyph->_associated_fileitem->size))
-            {
-                *found_fileitem = fileleaf->_central_glyph->_associated_fileitem;
+        fileleaf->_unresolved_fileitem_list = g_list_first(fileleaf->_fileitem_list);
+        private->unresolved_fileleaves = g_list_prepend(private->unresolved_fileleaves, fileleaf);
 
-                return GLYPH_TAB;   /* Found. */
-            }
+        if (private->resolve_tick_id == 0)
+        {
+            private->resolve_tick_id = gtk_widget_add_tick_callback(
+                GTK_WIDGET(circular_application_menu),
+                _ca_circular_application_menu_on_resolve_tick,
+                NULL,
+                NULL);
         }
     }
-
-    /* Check the fileleaf. */
-    if (_ca_circular_application_menu_circle_contains_point(x, y, fileleaf->x, fileleaf->y, fileleaf->radius))
+    else if (private->unresolved_fileleaves == NULL)
     {
-        *found_fileleaf = fileleaf;
-
-        /* Check the fileleaf central glyph. */
-        if (_ca_circular_application_menu_circle_contains_point(
-			x,
-			y,
-			fileleaf->_central_glyph->x,
-			fileleaf->_central_glyph->y,
-			fileleaf->_central_glyph->size))
-        {
-            *found_fileitem = fileleaf->_central_glyph;
-
-            return (*found_fileitem)->_type;    /* Found. */
-        }
-
-        /* Retieve the fileleafs associated sub fileitem. */
-        if (fileleaf->_child_fileleaf != NULL)
-        {
-            associated_fileitem = fileleaf->_child_fileleaf->_central_glyph->_associated_fileitem;
-        }
-        else
-        {
-            associated_fileitem = NULL;
-        }
-
-        /* Iterate the fileleaf fileitems. */
-        file_list = g_list_first(fileleaf->_fileitem_list);
-
-        while (file_list)
-        {
-            CaFileItem* fileitem;
-
-            fileitem = (CaFileItem*)file_list->data;
-            g_assert(fileitem != NULL);
-
-            if (associated_fileitem != fileitem)	/* Do not render as it is a sub fileleaf. */
-            {
-                /* Check the fileleaf fileitems. */
-                if (_ca_circular_application_menu_segment_contains_point(circular_application_menu, x, y, fileitem))
-                {
-                    *found_fileitem = fileitem;
-
-                    return (*found_fileitem)->_type;    /* Found. */
-                }
-            }
-
-            file_list = g_list_next(file_list);
-        }
+        ca_profiler_mark("icons_resolved", 0);
     }
-
-    return GLYPH_UNKNOWN;   /* Not found. */
 }
 
 /**
- * _ca_circular_applications_menu_get_segment_angles:
+ * ca_circular_application_menu_close_fileleaf:
  * @circular_application_menu: A CaCircularApplicationMenu pointer to the circular-application-menu widget instance.
- * @cr: A cairo-context to render to.
+ * @fileleaf: The file-leaf to close.
  *
- * Retrieves a file-item segment's lowest and higest angle.
+ * Closes a file-leaf.
  */
+void
+ca_circular_application_menu_close_fileleaf(CaCircularApplicationMenu* circular_application_menu, CaFileLeaf* fileleaf)
+{
+    CaCircularApplicationMenuPrivate* private;
+
+    private = _ca_circular_application_menu_get_instance_private(circular_application_menu);
+
+    ca_core_close_fileleaf(&private->core, fileleaf);
+}
+
+/**
+ * _ca_circular_application_menu_on_fileleaf_closing:
+ * @data: The CaFileLeaf about to be freed.
+ * @user_data: The circular-application-menu widget instance.
+ *
+ * Generated by the core before a file-leaf is freed; its icons are no longer resolved.
+ **/
 static void
-_ca_circular_applications_menu_get_segment_angles(CaFileItem* fileitem, gint radius, gdouble* from_angle, gdouble* to_angle)
+_ca_circular_application_menu_on_fileleaf_closing(gpointer data, gpointer user_data)
 {
-    gdouble half_circular_angle_share;
-    gdouble circumference_percentage;
-    gdouble common_angle;
-
-    g_assert(NULL != fileitem);
-    g_assert(NULL != from_angle);
-    g_assert(NULL != to_angle);
-
-    half_circular_angle_share = fileitem->_circular_angle_share / 2;
-
-    /* Smaller the circumference then larger the angle. */
-    circumference_percentage =
-    	(RADIUS_SEPERATOR + (SEGMENT_CIRCLE_RADIUS * 2)) / _ca_circular_application_menu_circumference_from_radius(radius);
-    common_angle = (360.0 * circumference_percentage) / 2;
-
-	/* Offset an angle by the given amount. */
-    *from_angle = _ca_circular_application_menu_calculate_angle_offset(
-        fileitem->_parent_angle,
-        -(half_circular_angle_share - common_angle));
-    *to_angle = _ca_circular_application_menu_calculate_angle_offset(
-        fileitem->_parent_angle,
-        half_circular_angle_share - common_angle);
+    CaCircularApplicationMenuPrivate* private;
+
+    private = _ca_circular_application_menu_get_instance_private(CA_CIRCULAR_APPLICATION_MENU(user_data));
+
+    /* Stop resolving the file-leaf icons. */
+    private->unresolved_fileleaves = g_list_remove(private->unresolved_fileleaves, data);
 }
 
 /**
- * _ca_circular_application_menu_render:
+ * _ca_circular_application_menu_page_fileleaf:
  * @circular_application_menu: A CaCircularApplicationMenu pointer to the circular-application-menu widget instance.
- * @cr: A cairo-context to render to.
+ * @fileleaf: An overflowing file-leaf.
+ * @page: The page to show, which wraps around.
+ * @x: The X co-ordinate of the pointer.
+ * @y: The Y co-ordinate of the pointer.
  *
- * Renders the circular-application-menu to a cairo context.
- */
+ * Shows another page of a file-leaf.  Only the file-items of the shown page exist, so only their
+ * icons are resolved.
+ **/
 static void
-_ca_circular_application_menu_render(CaCircularApplicationMenu* circular_application_menu, cairo_t* cr)
+_ca_circular_application_menu_page_fileleaf(CaCircularApplicationMenu* circular_application_menu, CaFileLeaf* fileleaf, gint page, gint x, gint y)
 {
     CaCircularApplicationMenuPrivate* private;
-    CaFileLeaf* current_fileleaf;
-    gboolean render_fileleaf;
 
     private = _ca_circular_application_menu_get_instance_private(circular_application_menu);
 
-    if (g_root_fileleaf == NULL)
-        return;
+    /* The file-items being opened, previewed or resolved are about to be freed. */
+    _ca_circular_application_menu_cancel_open(circular_application_menu);
+    private->unresolved_fileleaves = g_list_remove(private->unresolved_fileleaves, fileleaf);
 
-    /* Render all fileleafs. */
+    ca_core_page_fileleaf(&private->core, fileleaf, page);
 
-    current_fileleaf = g_root_fileleaf;  /* There should always at least one fileleaf at this point. */
+    _ca_circular_application_menu_resolve_fileleaf(circular_application_menu, fileleaf);
 
-    /* Iterate the fileleafs. */
-    do
-    {
-        GList* sub_list;
+    /* Retrieve the glyph-type, file-leaf and file-item at the current mouse co-ordinate. */
+    ca_core_update_current(&private->core, x, y);
 
-        /* Check whether the fileleaf should be rendered. */
-        render_fileleaf = TRUE;
+    /* Invalidate the widget. */
+    _ca_circular_application_menu_invalidate(circular_application_menu);
+}
 
-        if (private->render_tabbed_only)
-        {
-            if (current_fileleaf != g_tabbed_fileleaf)
-            {
-                render_fileleaf = FALSE;
-            }
-        }
+/**
+ * _ca_circular_applications_menu_imagefinder_path:
+ * @path: The path to check for an image.
+ *
+ * Retrieves an images path if it exists at the given location.
+ *
+ * Returns: The path to the found image; otherwise NULL.
+ */
+static const gchar*
+_ca_circular_applications_menu_imagefinder_path(const gchar* path)
+{
+    gchar* temp;
+    FILE* fp;
 
-        if (render_fileleaf)
-        {
-		    /* Render the file-leaf to a cairo context. */
-            _ca_circular_application_menu_render_fileleaf(circular_application_menu, current_fileleaf, cr);
-        }
+    fp = fopen(path, "r");
+
+    if (fp)
+    {
+        fclose(fp);
 
-        /* Iterate the sub fileleafs. */
-        sub_list = g_list_first(current_fileleaf->_sub_fileleaves_list);
+        return path;
+    }
+    else
+    {
+        gint i = 0;
 
-        while (sub_list)
+        while (TRUE)
         {
-            CaFileLeaf* sub_fileleaf;
-
-            sub_fileleaf = (CaFileLeaf*)sub_list->data;
-            g_assert(sub_fileleaf != NULL);
+            if (image_paths[i] != NULL)
+            {
+                temp = g_strdup_printf("%s/%s", image_paths[i], path);
 
-            /* Check whether the fileleaf should be rendered. */
-            render_fileleaf = TRUE;
+                fp = fopen(temp, "r");
 
-            if (private->render_tabbed_only)
-            {
-                if (sub_fileleaf != g_tabbed_fileleaf)
+                if (fp)
                 {
-                    render_fileleaf = FALSE;
+                    fclose(fp);
+
+                    return temp;
                 }
             }
-
-            if (render_fileleaf)
+            else
             {
-			    /* Render the file-leaf to a cairo context. */
-                _ca_circular_application_menu_render_fileleaf(circular_application_menu, sub_fileleaf, cr);
+                return NULL;
             }
 
-            sub_list = g_list_next(sub_list);
+            i++;
         }
-
-        /* Get next child fileleaf. */
-        current_fileleaf = current_fileleaf->_child_fileleaf;
     }
-    while (current_fileleaf != NULL);
-
-	/* Render the disassociated fileleaf. */
-    if (g_disassociated_fileleaf != NULL)
-    {
-        /* Render the file-leaf to a cairo context. */
-        _ca_circular_application_menu_render_fileleaf(circular_application_menu, g_disassociated_fileleaf, cr);
-	}
 }
 
 /**
- * _ca_circular_application_menu_render_reflection:
- * @circular_application_menu: A CaCircularApplicationMenu pointer to the circular-application-menu widget instance.
- * @cr: A cairo-context to render to.
+ * _ca_circular_applications_menu_get_pixbuf_from_name:
+ * @icon_info: The GtkIconInfo to use when retrieving the pixbuf.
+ * @width: The desired width of the retrieved pixbuf.
+ * @height: The desired height of the retrieved pixbuf.
+ *
+ * Retrieves a pixbuf associated with the given icon filename.
  *
- * Renders the reflection alpha to the cairo context.
+ * Returns: The newly created pixbuf; otherwise NULL.
  */
-static void
-_ca_circular_application_menu_render_reflection(CaCircularApplicationMenu* circular_application_menu, cairo_t* cr)
+static GdkPixbuf*
+_ca_circular_applications_menu_get_pixbuf_from_name(GtkIconInfo* icon_info, gint width, gint height)
 {
-    // see GskBlurMode Gtk+4.0
-
-    CaCircularApplicationMenuPrivate* private;
-    double x1;
-    double y1;
-    double x2;
-    double y2;
-    gint offset_x_start;
-    gint offset_y_start;
-    gint x;
-    gint y;
-    gint width;
-    gint height;
+    GdkPixbuf* icon;
 
-    private = _ca_circular_application_menu_get_instance_private(circular_application_menu);
+    icon = NULL;
 
-    cairo_fill_extents(cr, &x1, &y1, &x2, &y2);
+    const gchar* icon_filename = gtk_icon_info_get_filename(icon_info);
 
-    // 1472x50 the reflection will be stretched.
-    width = gdk_pixbuf_get_width(private->light_pixbuf);
-    height = gdk_pixbuf_get_height(private->light_pixbuf);
+    //g_info("Processing %d %d %s\n", width, height, icon_filename);
+        
+    if (icon_filename != NULL)
+    {
+        GtkIconTheme* theme;
 
-    /* Offset the image. */
-    offset_x_start = ((gint)y1 / height) * 31;
-    offset_y_start = ((gint)y1 % height);
+        theme = gtk_icon_theme_get_default ();
 
-    cairo_save(cr);
-    cairo_clip_preserve(cr);
+        if (icon_info != NULL)
+        {
+            icon = gdk_pixbuf_new_from_file_at_size(
+			    gtk_icon_info_get_filename (icon_info),
+			    width,
+			    -1,
+			    NULL);
 
-    x = offset_x_start;
+            g_object_unref(icon_info);
+        }
 
-    //g_print("Render reflection: w:%d h:%d t:%d b:%d\n", width, height, (y1 - offset_y_start), y2);
+        /* first we try gtkicontheme */
+        if (icon == NULL)
+        {
+            icon = gtk_icon_theme_load_icon(
+			    theme,
+			    icon_filename,
+			    width,
+			    GTK_ICON_LOOKUP_FORCE_SVG,
+			    NULL);
+        }
 
-    for(y = (y1 - offset_y_start); y < y2; y += height)
-    {
-        gdk_cairo_set_source_pixbuf (cr, private->light_pixbuf, x, y);
-        cairo_paint_with_alpha(cr, 1.0);
+        if (icon == NULL)
+        {
+            /* Check all known paths. */
+            const gchar* found_path;
 
-        x += 31;
-    }
+		    /* Retrieve an images path if it exists at the given location. */
+            found_path = _ca_circular_applications_menu_imagefinder_path(icon_filename);
 
-    cairo_restore(cr);
+            if (NULL != found_path)
+            {
+                icon = gdk_pixbuf_new_from_file_at_scale(found_path, width, height, TRUE, NULL);
+
+                g_free((gpointer)found_path);
+            }
+        }
+    }
+
+    if (icon == NULL)
+    {
+        g_print("D\n");
+        /*
+        No icon was found so use a default.
+        GTK+3 has moved over to the freedesktop.org Icon Naming Specification and internationalised labels. 
+        https://specifications.freedesktop.org/icon-naming-spec/icon-naming-spec-latest.html
+        */
+        icon = gtk_icon_theme_load_icon (
+            gtk_icon_theme_get_default (),
+            "application-x-executable",
+            width,
+            GTK_ICON_LOOKUP_NO_SVG,
+            NULL);
+    }
+
+    return icon;
 }
 
 /**
- * _ca_circular_application_menu_render_fileleaf:
- * @circular_application_menu: A CaCircularApplicationMenu pointer to the circular-application-menu widget instance.
- * @fileleaf: A file-leaf to render.
- * @cr: A cairo-context to render to.
+ * _ca_circular_application_menu_on_fade_tick:
+ * @data: a GtkObject pointer to the current widget.
  *
- * Renders the file-leaf to a cairo context.
- */
-static void
-_ca_circular_application_menu_render_fileleaf(
-	CaCircularApplicationMenu* circular_application_menu,
-	CaFileLeaf* fileleaf,
-	cairo_t* cr)
+ * Generated 'timeout' caused by a periodic interval occurring.
+ *
+ * Returns: TRUE if the event is handled.
+ **/
+static gint
+_ca_circular_application_menu_on_fade_tick(gpointer data)
 {
+    CaCircularApplicationMenu* circular_application_menu;
     CaCircularApplicationMenuPrivate* private;
-    GList* file_list;
-    CaFileItem* associated_fileitem;
+    gboolean animating;
 
+    g_return_val_if_fail(GTK_WIDGET(data) != NULL, FALSE);
+    g_return_val_if_fail(CA_IS_CIRCULAR_APPLICATION_MENU(data), FALSE);
+
+    circular_application_menu = CA_CIRCULAR_APPLICATION_MENU(data);
     private = _ca_circular_application_menu_get_instance_private(circular_application_menu);
 
-    /* Render the fileleaf. */
-    if (fileleaf == g_disassociated_fileleaf)
+    animating = FALSE;
+
+    /* Advance any opening file-leafs. */
+    if (ca_core_advance_animation(&private->core, FADE_PERCENTAGE_INCREMENT))
     {
-        cairo_path_t* path;
+        animating = TRUE;
 
-        /* Render the disassociated menu outer. */
-        cairo_arc (
-            cr,
-            OFFSET_2_SCREEN(fileleaf->x, private->view_x_offset),
-            OFFSET_2_SCREEN(fileleaf->y, private->view_y_offset),
-            fileleaf->radius + RADIUS_SPACER,
-            0,
-            DEGREE_2_RADIAN(360));
-
-        path = cairo_copy_path(cr);
-
-        /* Make any overlapped portions of a parent menu appear more translucent. */
-        cairo_set_operator (cr, CAIRO_OPERATOR_CLEAR);
-        cairo_save(cr);
-        cairo_clip_preserve(cr);
-        cairo_paint_with_alpha (cr, OVERLAP_TRANSLUCENCY);
-        cairo_restore(cr);
-        cairo_set_operator (cr, CAIRO_OPERATOR_OVER);
-
-        cairo_arc (
-            cr,
-            OFFSET_2_SCREEN(fileleaf->x, private->view_x_offset),
-            OFFSET_2_SCREEN(fileleaf->y, private->view_y_offset),
-            fileleaf->radius,
-            0,
-            DEGREE_2_RADIAN(360));
+        /* Invalidate the widget. */
+        _ca_circular_application_menu_invalidate(circular_application_menu);
+    }
+
+    /* Move the shown view; the scene itself is unchanged so it is only redrawn. */
+    if (ca_core_advance_view(&private->core, VIEW_PERCENTAGE_INCREMENT))
+    {
+        animating = TRUE;
 
-        cairo_new_sub_path (cr);
+        gtk_widget_queue_draw(GTK_WIDGET(circular_application_menu));
+    }
 
-        /* Render to the cairo context. */
-        cairo_set_source_rgba (cr, g_outer_inner_rgba._r, g_outer_inner_rgba._g, g_outer_inner_rgba._b, g_outer_inner_rgba._a_fill);
-        cairo_fill_preserve (cr);
+    if (animating != private->animating)
+    {
+        private->animating = animating;
 
-        /* Render reflections. */
-        if (FALSE == private->render_reflection_off)
+        if ((FALSE == animating) &&
+            (FALSE == private->render_fast))
         {
-            _ca_circular_application_menu_render_reflection(circular_application_menu, cr);
+            /* The animation has finished; render it once at full quality. */
+            _ca_circular_application_menu_invalidate(circular_application_menu);
         }
+    }
 
-        cairo_new_path(cr);
-        cairo_append_path(cr, path);
-
-        /* Outline with a lighter colour. */
-        cairo_clip_preserve(cr);
-        cairo_set_line_width (cr, g_outer_inner_rgba._line_width * 3 /*Overlap from edge*/);
-        cairo_set_source_rgba (cr, g_outer2_rgba._r, g_outer2_rgba._g, g_outer2_rgba._b, g_outer2_rgba._a_pen);
-        cairo_stroke_preserve (cr);
-        cairo_reset_clip(cr);
+    return TRUE;
+}
 
-        /* Outline with a darker colour. */
-        cairo_set_line_width (cr, g_outer_inner_rgba._line_width);
-        cairo_set_source_rgba (cr, g_outer1_rgba._r, g_outer1_rgba._g, g_outer1_rgba._b, g_outer1_rgba._a_pen);
-        cairo_stroke (cr);
+/**
+ * _ca_circular_application_menu_invalidate:
+ * @circular_application_menu: A CaCircularApplicationMenu pointer to the circular-application-menu widget instance.
+ *
+ * Redraws the widget after the scene has changed, so any view cache is rendered again.
+ **/
+static void
+_ca_circular_application_menu_invalidate(CaCircularApplicationMenu* circular_application_menu)
+{
+    CaCircularApplicationMenuPrivate* private;
+    GdkRectangle canvas;
 
-        cairo_path_destroy(path);
-    }
-    else if (fileleaf == g_root_fileleaf)
-    {
-        cairo_path_t* path;
+    private = _ca_circular_application_menu_get_instance_private(circular_application_menu);
 
-        /* Render the root menu outer. */
-        cairo_arc (
-            cr,
-            OFFSET_2_SCREEN(fileleaf->x, private->view_x_offset),
-            OFFSET_2_SCREEN(fileleaf->y, private->view_y_offset),
-            fileleaf->radius + RADIUS_SPACER,
-            0,
-            DEGREE_2_RADIAN(360));
+    private->scene_serial++;
 
-        path = cairo_copy_path(cr);
+    /* Grow or shrink the window to the changed scene. */
+    canvas = private->canvas;
+    _ca_circular_application_menu_update_canvas(circular_application_menu);
+    _ca_circular_application_menu_update_shape(circular_application_menu);
 
-        cairo_new_sub_path (cr);
+    if (TRUE == private->remote)
+    {
+        CaRenderContext context;
+        cairo_region_t* damage;
 
-        cairo_arc (
-            cr,
-            OFFSET_2_SCREEN(fileleaf->x, private->view_x_offset),
-            OFFSET_2_SCREEN(fileleaf->y, private->view_y_offset),
-            fileleaf->radius,
-            0,
-            DEGREE_2_RADIAN(360));
+        /* Only draw where the scene was and now is. */
+        _ca_circular_application_menu_get_render_context(circular_application_menu, &context);
 
-        /* Render to the cairo context. */
-        cairo_set_source_rgba (cr, g_outer_inner_rgba._r, g_outer_inner_rgba._g, g_outer_inner_rgba._b, g_outer_inner_rgba._a_fill);
-        cairo_fill_preserve (cr);
+        damage = cairo_region_create_rectangle(&private->scene_extents);
+        ca_render_get_extents(&context, &private->scene_extents);
+        cairo_region_union_rectangle(damage, &private->scene_extents);
 
-        /* Render reflections. */
-        if (FALSE == private->render_reflection_off)
+        /* A window which has been moved over the view is drawn again in full. */
+        if (TRUE == gdk_rectangle_equal(&canvas, &private->canvas))
         {
-            _ca_circular_application_menu_render_reflection(circular_application_menu, cr);
+            _ca_circular_application_menu_queue_damage(circular_application_menu, damage);
+            cairo_region_destroy(damage);
+
+            return;
         }
 
-        cairo_new_path(cr);
-        cairo_append_path(cr, path);
+        cairo_region_destroy(damage);
+    }
 
-        /* Outline with a lighter colour. */
-        cairo_clip_preserve(cr);
-        cairo_set_line_width (cr, g_outer_inner_rgba._line_width * 3 /*Overlap from edge*/);
-        cairo_set_source_rgba (cr, g_outer2_rgba._r, g_outer2_rgba._g, g_outer2_rgba._b, g_outer2_rgba._a_pen);
-        cairo_stroke_preserve (cr);
-        cairo_reset_clip(cr);
+    gtk_widget_queue_draw(GTK_WIDGET(circular_application_menu));
+}
 
-        /* Outline with a darker colour. */
-        cairo_set_line_width (cr, g_outer_inner_rgba._line_width);
-        cairo_set_source_rgba (cr, g_outer1_rgba._r, g_outer1_rgba._g, g_outer1_rgba._b, g_outer1_rgba._a_pen);
-        cairo_stroke (cr);
+/**
+ * _ca_circular_application_menu_invalidate_current:
+ * @circular_application_menu: A CaCircularApplicationMenu pointer to the circular-application-menu widget instance.
+ * @previous: The damage of the previous current glyph, which is added to; otherwise NULL unless
+ * the display is remote.  See: ca_render_add_current_damage.
+ *
+ * Redraws the widget after only the current glyph has changed.  On a remote display only the
+ * previous and current glyph and text are drawn; otherwise the widget is invalidated.
+ **/
+static void
+_ca_circular_application_menu_invalidate_current(CaCircularApplicationMenu* circular_application_menu, cairo_region_t* previous)
+{
+    CaCircularApplicationMenuPrivate* private;
+    CaRenderContext context;
 
-        cairo_path_destroy(path);
+    private = _ca_circular_application_menu_get_instance_private(circular_application_menu);
 
-        /* The root menu won't have any overlapped parent menus. */
-    }
-    else
+    if (FALSE == private->remote)
     {
-        /* Render a child menu outer. */
-        /*
-         C   E
-         B   F
-        A     A
-        A     A
-        A     A
-         AAAAA
-        */
-
-        gdouble parent_angle;
-        cairo_path_t* path;
+        _ca_circular_application_menu_invalidate(circular_application_menu);
 
-        parent_angle = fileleaf->_central_glyph->_parent_angle;
-
-        if (fileleaf->_menu_render == NULL)
-        {
-            gdouble circumference_percentage;
-            gdouble common_angle;
-
-            fileleaf->_menu_render = g_new(CaMenuRender, 1);
-
-            /* Smaller the circumference then larger the angle. */
-            circumference_percentage =
-            	private->tab_width / _ca_circular_application_menu_circumference_from_radius(fileleaf->radius + RADIUS_SPACER);
-            common_angle = (360.0 * circumference_percentage);
-
-            /* Calculate the nearest lowest and highest angle. */
-            fileleaf->_menu_render->lowest_angle_nearest =
-            	_ca_circular_application_menu_calculate_angle_offset(parent_angle, -(common_angle / 2));
-            fileleaf->_menu_render->highest_angle_nearest =
-            	_ca_circular_application_menu_calculate_angle_offset(parent_angle, (common_angle / 2));
-
-            /* Get B F information */
-            fileleaf->_menu_render->Bcircle_lowest_angle =
-            	_ca_circular_application_menu_calculate_angle_offset(parent_angle, 90.0);
-            fileleaf->_menu_render->Bcircle_highest_angle =
-            	_ca_circular_application_menu_calculate_angle_offset(fileleaf->_menu_render->lowest_angle_nearest, 180.0);
-
-            fileleaf->_menu_render->Fcircle_lowest_angle =
-            	_ca_circular_application_menu_calculate_angle_offset(fileleaf->_menu_render->highest_angle_nearest, 180.0);
-            fileleaf->_menu_render->Fcircle_highest_angle =
-            	_ca_circular_application_menu_calculate_angle_offset(parent_angle, -90.0);
-
-            _ca_get_point_from_source_offset(
-                fileleaf->_central_glyph->x,
-                fileleaf->_central_glyph->y,
-                fileleaf->_menu_render->lowest_angle_nearest,
-                fileleaf->radius + RADIUS_SPACER + CLOSEST_TAB_CIRCLE_RADIUS,
-                &fileleaf->_menu_render->Bcircle_x,
-                &fileleaf->_menu_render->Bcircle_y);
-
-            _ca_get_point_from_source_offset(
-                fileleaf->_central_glyph->x,
-                fileleaf->_central_glyph->y,
-                fileleaf->_menu_render->highest_angle_nearest,
-                fileleaf->radius + RADIUS_SPACER + CLOSEST_TAB_CIRCLE_RADIUS,
-                &fileleaf->_menu_render->Fcircle_x,
-                &fileleaf->_menu_render->Fcircle_y);
-
-            _ca_get_point_from_source_offset(
-                fileleaf->_menu_render->Bcircle_x,
-                fileleaf->_menu_render->Bcircle_y,
-                fileleaf->_menu_render->Bcircle_lowest_angle,
-                CLOSEST_TAB_CIRCLE_RADIUS,
-                &fileleaf->_menu_render->Bcircle_arc_x,
-                &fileleaf->_menu_render->Bcircle_arc_y);
-
-            /* Get gap information. */
-
-            /* Smaller the circumference then larger the angle. */
-            circumference_percentage =
-                private->tab_width /
-            	_ca_circular_application_menu_circumference_from_radius(
-					fileleaf->radius + RADIUS_SPACER + CLOSEST_TAB_CIRCLE_RADIUS + private->tab_height + FARTHEST_TAB_CIRCLE_RADIUS);
-
-            common_angle = (360.0 * circumference_percentage) / 2;
-
-            fileleaf->_menu_render->lowest_angle_farthest =
-            	_ca_circular_application_menu_calculate_angle_offset(parent_angle, -(common_angle / 2));
-            fileleaf->_menu_render->highest_angle_farthest =
-            	_ca_circular_application_menu_calculate_angle_offset(parent_angle, common_angle / 2);
-
-            /* Get C E information */
-            fileleaf->_menu_render->Ccircle_lowest_angle =
-            	_ca_circular_application_menu_calculate_angle_offset(parent_angle, -90.0);
-            fileleaf->_menu_render->Ccircle_highest_angle = parent_angle;
-
-            fileleaf->_menu_render->Ecircle_lowest_angle = parent_angle;
-            fileleaf->_menu_render->Ecircle_highest_angle =
-            	_ca_circular_application_menu_calculate_angle_offset(parent_angle, 90.0);
-
-            _ca_get_point_from_source_offset(
-                fileleaf->_central_glyph->x,
-                fileleaf->_central_glyph->y,
-                fileleaf->_menu_render->lowest_angle_farthest,
-                fileleaf->radius + RADIUS_SPACER + FARTHEST_TAB_CIRCLE_RADIUS + private->tab_height,
-                &fileleaf->_menu_render->Ccircle_x,
-                &fileleaf->_menu_render->Ccircle_y);
-
-            _ca_get_point_from_source_offset(
-                fileleaf->_central_glyph->x,
-                fileleaf->_central_glyph->y,
-                fileleaf->_menu_render->highest_angle_farthest,
-                fileleaf->radius + RADIUS_SPACER + FARTHEST_TAB_CIRCLE_RADIUS + private->tab_height,
-                &fileleaf->_menu_render->Ecircle_x,
-                &fileleaf->_menu_render->Ecircle_y);
-
-            _ca_get_point_from_source_offset(
-                fileleaf->_menu_render->Ccircle_x,
-                fileleaf->_menu_render->Ccircle_y,
-                fileleaf->_menu_render->Ccircle_lowest_angle,
-                FARTHEST_TAB_CIRCLE_RADIUS,
-                &fileleaf->_menu_render->Ccircle_arc_x,
-                &fileleaf->_menu_render->Ccircle_arc_y);
-
-            /* Render the parent fileleaf association on the tab. */
-            fileleaf->_menu_render->tab_glyph_radius =
-            	fileleaf->radius +
-            	((RADIUS_SPACER + CLOSEST_TAB_CIRCLE_RADIUS +
-            	private->tab_height +
-            	FARTHEST_TAB_CIRCLE_RADIUS) / 2);
-
-            _ca_get_point_from_source_offset(
-                fileleaf->_central_glyph->x,
-                fileleaf->_central_glyph->y,
-                parent_angle,
-                fileleaf->_menu_render->tab_glyph_radius,
-                &fileleaf->_menu_render->tab_glyph_x,
-                &fileleaf->_menu_render->tab_glyph_y);
-        }
+        return;
+    }
 
-        /* Render A */
-        cairo_arc(
-            cr,
-            OFFSET_2_SCREEN(fileleaf->_central_glyph->x, private->view_x_offset),
-            OFFSET_2_SCREEN(fileleaf->_central_glyph->y, private->view_y_offset),
-            fileleaf->radius + RADIUS_SPACER,
-            DEGREE_2_RADIAN(fileleaf->_menu_render->highest_angle_nearest),
-            DEGREE_2_RADIAN(fileleaf->_menu_render->lowest_angle_nearest));
-
-        /* Render B */
-        cairo_arc_negative(
-            cr,
-            OFFSET_2_SCREEN(fileleaf->_menu_render->Bcircle_x, private->view_x_offset),
-            OFFSET_2_SCREEN(fileleaf->_menu_render->Bcircle_y, private->view_y_offset),
-            CLOSEST_TAB_CIRCLE_RADIUS,
-            DEGREE_2_RADIAN(fileleaf->_menu_render->Bcircle_highest_angle),
-            DEGREE_2_RADIAN(fileleaf->_menu_render->Bcircle_lowest_angle));
-
-        /* Render C */
-        cairo_arc(
-            cr,
-            OFFSET_2_SCREEN(fileleaf->_menu_render->Ccircle_x, private->view_x_offset),
-            OFFSET_2_SCREEN(fileleaf->_menu_render->Ccircle_y, private->view_y_offset),
-            FARTHEST_TAB_CIRCLE_RADIUS,
-            DEGREE_2_RADIAN(fileleaf->_menu_render->Ccircle_lowest_angle),
-            DEGREE_2_RADIAN(fileleaf->_menu_render->Ccircle_highest_angle));
-
-        /* Render E */
-        cairo_arc(
-            cr,
-            OFFSET_2_SCREEN(fileleaf->_menu_render->Ecircle_x, private->view_x_offset),
-            OFFSET_2_SCREEN(fileleaf->_menu_render->Ecircle_y, private->view_y_offset),
-            FARTHEST_TAB_CIRCLE_RADIUS,
-            DEGREE_2_RADIAN(fileleaf->_menu_render->Ecircle_lowest_angle),
-            DEGREE_2_RADIAN(fileleaf->_menu_render->Ecircle_highest_angle));
-
-        /* Render F */
-        cairo_arc_negative(
-            cr,
-            OFFSET_2_SCREEN(fileleaf->_menu_render->Fcircle_x, private->view_x_offset),
-            OFFSET_2_SCREEN(fileleaf->_menu_render->Fcircle_y, private->view_y_offset),
-            CLOSEST_TAB_CIRCLE_RADIUS,
-            DEGREE_2_RADIAN(fileleaf->_menu_render->Fcircle_highest_angle),
-            DEGREE_2_RADIAN(fileleaf->_menu_render->Fcircle_lowest_angle));
-
-        cairo_close_path(cr);
-
-        path = cairo_copy_path(cr);
-
-        /* Make any overlapped portions of a parent menu appear more translucent. */
-        cairo_set_operator (cr, CAIRO_OPERATOR_CLEAR);
-        cairo_save(cr);
-        cairo_clip_preserve(cr);
-        cairo_paint_with_alpha (cr, OVERLAP_TRANSLUCENCY);
-        cairo_restore(cr);
-        cairo_set_operator (cr, CAIRO_OPERATOR_OVER);
-
-        cairo_new_sub_path (cr);
-
-        cairo_arc (
-            cr,
-            OFFSET_2_SCREEN(fileleaf->x, private->view_x_offset),
-            OFFSET_2_SCREEN(fileleaf->y, private->view_y_offset),
-            fileleaf->radius,
-            DEGREE_2_RADIAN(0.0),
-            DEGREE_2_RADIAN(360.0));
-
-        /* Render to the cairo context. */
-        cairo_set_source_rgba (
-			cr,
-			g_outer_inner_rgba._r,
-			g_outer_inner_rgba._g,
-			g_outer_inner_rgba._b,
-			g_outer_inner_rgba._a_fill);
-        cairo_fill_preserve (cr);
-
-        /* Render reflections. */
-        if (FALSE == private->render_reflection_off)
-        {
-            _ca_circular_application_menu_render_reflection(circular_application_menu, cr);
-        }
+    private->scene_serial++;
 
-        cairo_new_path(cr);
-        cairo_append_path(cr, path);
+    _ca_circular_application_menu_get_render_context(circular_application_menu, &context);
+    ca_render_add_current_damage(&context, previous);
 
-        /* Outline with a lighter colour. */
-        cairo_clip_preserve(cr);
-        cairo_set_line_width (cr, g_outer_inner_rgba._line_width * 3 /*Overlap from edge*/);
-        cairo_set_source_rgba (cr, g_outer2_rgba._r, g_outer2_rgba._g, g_outer2_rgba._b, g_outer2_rgba._a_pen);
-        cairo_stroke_preserve (cr);
-        cairo_reset_clip(cr);
+    /* The text surround is part of the scene extents. */
+    ca_render_get_extents(&context, &private->scene_extents);
 
-        /* Outline with a darker colour. */
-        cairo_set_line_width (cr, g_outer_inner_rgba._line_width);
-        cairo_set_source_rgba (cr, g_outer1_rgba._r, g_outer1_rgba._g, g_outer1_rgba._b, g_outer1_rgba._a_pen);
-        cairo_stroke (cr);
+    _ca_circular_application_menu_queue_damage(circular_application_menu, previous);
+}
 
-        cairo_path_destroy(path);
+/**
+ * _ca_circular_application_menu_queue_damage:
+ * @circular_application_menu: A CaCircularApplicationMenu pointer to the circular-application-menu widget instance.
+ * @damage: The region to draw, in view co-ordinates; it is translated to window co-ordinates.
+ *
+ * Queues a draw of the part of the window covering a region of the view.
+ **/
+static void
+_ca_circular_application_menu_queue_damage(CaCircularApplicationMenu* circular_application_menu, cairo_region_t* damage)
+{
+    CaCircularApplicationMenuPrivate* private;
 
-        /* Render the parent fileleaf association on the tab. */
-        g_assert(fileleaf->_central_glyph->_associated_fileitem != NULL);
+    private = _ca_circular_application_menu_get_instance_private(circular_application_menu);
 
-        gdk_cairo_set_source_pixbuf (
-            cr,
-            fileleaf->_central_glyph->_associated_fileitem->_pixbuf,
-            OFFSET_2_SCREEN(fileleaf->_menu_render->tab_glyph_x - (private->icon_width / 2), private->view_x_offset),
-            OFFSET_2_SCREEN(fileleaf->_menu_render->tab_glyph_y - (private->icon_height / 2), private->view_y_offset));
-        cairo_paint_with_alpha(cr, 1.0);
-    }
+    if (TRUE == cairo_region_is_empty(damage))
+        return;
 
-    /* Render the surround of the fileleaf central glyph. */
-    cairo_arc (
-        cr,
-        OFFSET_2_SCREEN(fileleaf->_central_glyph->x, private->view_x_offset),
-        OFFSET_2_SCREEN(fileleaf->_central_glyph->y, private->view_y_offset),
-        fileleaf->_central_glyph->size + CIRCULAR_ICON_SPACER,
-        0,
-        DEGREE_2_RADIAN(360));
+    /* The window only covers the canvas of the view. */
+    cairo_region_translate(damage, -private->canvas.x, -private->canvas.y);
+    gtk_widget_queue_draw_region(GTK_WIDGET(circular_application_menu), damage);
+}
 
-    /* Render to the cairo context. */
-    cairo_set_line_width (cr, g_outer_inner_rgba._line_width);
-    cairo_set_source_rgba (
-		cr,
-		g_outer_inner_rgba._r,
-		g_outer_inner_rgba._g,
-		g_outer_inner_rgba._b,
-		g_outer_inner_rgba._a_fill);
-    cairo_fill_preserve (cr);
+/**
+ * _ca_circular_application_menu_count_damage:
+ * @circular_application_menu: A CaCircularApplicationMenu pointer to the circular-application-menu widget instance.
+ * @cr: The cairo context of a frame, clipped to the damage of the window.
+ *
+ * Counts the window pixels a frame draws, which are sent to the display and composited.  The
+ * pixels and bytes per second are reported every DAMAGE_REPORT_INTERVAL, and a trace replay
+ * reports them for the whole replay.
+ **/
+static void
+_ca_circular_application_menu_count_damage(CaCircularApplicationMenu* circular_application_menu, cairo_t* cr)
+{
+    CaCircularApplicationMenuPrivate* private;
+    cairo_rectangle_list_t* rectangles;
+    gint64 pixels;
+    gint64 now;
 
-    /* Render reflections. */
-    if (FALSE == private->render_reflection_off)
-    {
-        _ca_circular_application_menu_render_reflection(circular_application_menu, cr);
-    }
+    private = _ca_circular_application_menu_get_instance_private(circular_application_menu);
 
-    cairo_set_source_rgba (cr, g_outer_inner_rgba._r, g_outer_inner_rgba._g, g_outer_inner_rgba._b, g_outer_inner_rgba._a_pen);
-    cairo_stroke (cr);
+    pixels = 0;
+    rectangles = cairo_copy_clip_rectangle_list(cr);
 
-    /* Render the fileleaf central glyph. */
+    if (rectangles->status == CAIRO_STATUS_SUCCESS)
     {
-        GdkPixbuf* pixbuf;
-        gint centre_iconsize;
-        gboolean free_pixbuf;
-        GError* error = NULL;
+        gint i;
 
-        free_pixbuf = TRUE;
-
-        /* Check whether the item is selected. */
-        if (((GLYPH_ROOT_CENTRE == g_current_type) && (fileleaf == g_root_fileleaf)) ||
-            ((GLYPH_FILE_MENU_CENTRE == g_current_type) && (fileleaf == g_current_fileleaf)))
-        {
-            if ((fileleaf == g_root_fileleaf) &&
-                (private->emblem_normal != NULL) &&
-                (private->emblem_prelight != NULL))
-            {
-                /* Use the emblem pixbuf. */
-                pixbuf = private->emblem_prelight;
-                free_pixbuf = FALSE;
-            }
-            else
-            {
-                if ((pixbuf = gdk_pixbuf_new_from_resource(RESOURCE_PATH"close-menu-prelight.png", &error)) == NULL)
-                {
-                    g_warning ("Resource not found: %s\n", error->message);
-                    g_clear_error (&error); /* g_error_free */
-                }
-            }
-        }
-        else
+        for (i = 0; i < rectangles->num_rectangles; i++)
         {
-            if ((fileleaf == g_root_fileleaf) &&
-                (private->emblem_normal != NULL) &&
-                (private->emblem_prelight != NULL))
-            {
-                /* Use the emblem pixbuf. */
-                pixbuf = private->emblem_normal;
-                free_pixbuf = FALSE;
-            }
-            else
-            {
-                if ((pixbuf = gdk_pixbuf_new_from_resource(RESOURCE_PATH"close-menu-normal.png", &error)) == NULL)
-                {
-                    g_warning ("Resource not found: %s\n", error->message);
-                    g_clear_error (&error); /* g_error_free */
-                }
-            }
+            pixels += (gint64)ceil(rectangles->rectangles[i].width) * (gint64)ceil(rectangles->rectangles[i].height);
         }
+    }
+    else
+    {
+        gdouble x1;
+        gdouble y1;
+        gdouble x2;
+        gdouble y2;
 
-        /* Retrieve the centre iconsize. */
-        centre_iconsize = _ca_circular_applications_menu_get_centre_iconsize(circular_application_menu, fileleaf);
+        /* The clip is not a set of rectangles; count its extents. */
+        cairo_clip_extents(cr, &x1, &y1, &x2, &y2);
+        pixels = (gint64)ceil(x2 - x1) * (gint64)ceil(y2 - y1);
+    }
 
-        g_assert(pixbuf != NULL);
+    cairo_rectangle_list_destroy(rectangles);
 
-        gdk_cairo_set_source_pixbuf (
-            cr,
-            pixbuf,
-            OFFSET_2_SCREEN(fileleaf->_central_glyph->x- (centre_iconsize / 2), private->view_x_offset),
-            OFFSET_2_SCREEN(fileleaf->_central_glyph->y- (centre_iconsize / 2), private->view_y_offset));
-        cairo_paint_with_alpha(cr, 1.0);
+    ca_trace_damage(pixels);
 
-        if (free_pixbuf)
-        {
-            g_object_unref(pixbuf);
-        }
-    }
+    now = g_get_monotonic_time();
+
+    private->damage_pixels += pixels;
+    private->damage_frames++;
 
-    /* Retieve the fileleafs associated sub fileitem. */
-    if (fileleaf->_child_fileleaf != NULL)
+    if (private->damage_since == 0)
     {
-        associated_fileitem = fileleaf->_child_fileleaf->_central_glyph->_associated_fileitem;
+        private->damage_since = now;
     }
-    else
+    else if ((now - private->damage_since) >= (DAMAGE_REPORT_INTERVAL * 1000))
     {
-        associated_fileitem = NULL;
+        g_info(
+            "Pushed %" G_GINT64_FORMAT " pixels (%" G_GINT64_FORMAT " bytes) per second in %d frames.",
+            (private->damage_pixels * G_USEC_PER_SEC) / (now - private->damage_since),
+            (private->damage_pixels * DAMAGE_BYTES_PER_PIXEL * G_USEC_PER_SEC) / (now - private->damage_since),
+            private->damage_frames);
+
+        private->damage_pixels = 0;
+        private->damage_frames = 0;
+        private->damage_since = now;
     }
+}
 
-    if (fileleaf->_fileitem_list_count == 1)
-    {
-        /* Only a single fileitem. */
-        CaFileItem* fileitem;
-        gdouble inner_radius;
-        gdouble outer_radius;
+/**
+ * _ca_circular_application_menu_draw_view_cache:
+ * @circular_application_menu: A CaCircularApplicationMenu pointer to the circular-application-menu widget instance.
+ * @context: The state to render, at the shown view.
+ * @cr: A cairo context to draw to.
+ *
+ * Draws a frame by translating a scene rendered once for the whole of a view animation; only the
+ * text is rendered again.  A scene is only kept once it has been drawn unchanged, so a file-leaf
+ * which is opening while the view moves is rendered directly.
+ *
+ * Returns: TRUE if the frame was drawn from the view cache; otherwise FALSE.
+ **/
+static gboolean
+_ca_circular_application_menu_draw_view_cache(
+    CaCircularApplicationMenu* circular_application_menu,
+    const CaRenderContext* context,
+    cairo_t* cr)
+{
+    CaCircularApplicationMenuPrivate* private;
+    gboolean unchanged;
 
-        file_list = g_list_first(fileleaf->_fileitem_list);
+    private = _ca_circular_application_menu_get_instance_private(circular_application_menu);
 
-        fileitem = (CaFileItem*)file_list->data;
-        g_assert(fileitem != NULL);
+    unchanged = (private->drawn_serial == private->scene_serial);
+    private->drawn_serial = private->scene_serial;
 
-        inner_radius = fileitem->_parent_radius - SEGMENT_INNER_SPACER(private->normal_iconsize);
-        outer_radius = fileitem->_parent_radius + SEGMENT_OUTER_SPACER(private->normal_iconsize);
-
-        cairo_arc(cr,
-            OFFSET_2_SCREEN(fileleaf->_central_glyph->x, private->view_x_offset),
-            OFFSET_2_SCREEN(fileleaf->_central_glyph->y, private->view_y_offset),
-            outer_radius,
-            DEGREE_2_RADIAN(0.0),
-            DEGREE_2_RADIAN(360.0));
-
-        cairo_arc(cr,
-            OFFSET_2_SCREEN(fileleaf->_central_glyph->x, private->view_x_offset),
-            OFFSET_2_SCREEN(fileleaf->_central_glyph->y, private->view_y_offset),
-            inner_radius,
-            DEGREE_2_RADIAN(0.0),
-            DEGREE_2_RADIAN(360.0));
-
-        /* Check whether the item is selected. */
-        if (fileitem == g_current_fileitem)
-        {
-            /* Prelight. */
-
-            /* Render to the cairo context. */
-            cairo_set_line_width (cr, g_prelight_segment_rgba._line_width);
-            cairo_set_source_rgba (
-				cr,
-				g_prelight_segment_rgba._r,
-				g_prelight_segment_rgba._g,
-				g_prelight_segment_rgba._b,
-				g_prelight_segment_rgba._a_fill);
-            cairo_fill_preserve (cr);
-
-            /* Render reflections. */
-            if (FALSE == private->render_reflection_off)
-            {
-                _ca_circular_application_menu_render_reflection(circular_application_menu, cr);
-            }
+    /* Drop the cache of an earlier scene. */
+    if ((private->view_cache != NULL) &&
+        (private->view_cache_serial != private->scene_serial))
+    {
+        cairo_surface_destroy(private->view_cache);
+        private->view_cache = NULL;
+    }
 
-            cairo_set_source_rgba (
-				cr,
-				g_prelight_segment_rgba._r,
-				g_prelight_segment_rgba._g,
-				g_prelight_segment_rgba._b,
-				g_prelight_segment_rgba._a_pen);
-            cairo_stroke (cr);
-        }
-        else
-        {
-            /* Prelight. */
-
-            /* Render to the cairo context. */
-            cairo_set_line_width (cr, g_normal_segment_rgba._line_width);
-            cairo_set_source_rgba (
-				cr,
-				g_normal_segment_rgba._r,
-				g_normal_segment_rgba._g,
-				g_normal_segment_rgba._b,
-				g_normal_segment_rgba._a_fill);
-            cairo_fill_preserve (cr);
-
-            /* Render reflections. */
-            if (FALSE == private->render_reflection_off)
-            {
-                _ca_circular_application_menu_render_reflection(circular_application_menu, cr);
-            }
+    if (private->view_cache == NULL)
+    {
+        CaRenderContext cache_context;
+        cairo_t* cache_cr;
 
-            cairo_set_source_rgba (
-				cr,
-				g_normal_segment_rgba._r,
-				g_normal_segment_rgba._g,
-				g_normal_segment_rgba._b,
-				g_normal_segment_rgba._a_pen);
-            cairo_stroke (cr);
+        if ((FALSE == unchanged) ||
+            (FALSE == ca_core_is_view_animating(&private->core)))
+        {
+            return FALSE;
         }
-    }
-    else
-    {
-        /* Multiple file-items. */
 
-        /* Iterate the file-leaf file-item's. */
-        file_list = g_list_first(fileleaf->_fileitem_list);
+        /* Cover the shown view and its destination. */
+        cache_context = *context;
+        cache_context.render_fast = FALSE;  /* Rendered once for the whole animation. */
+        cache_context.view_x_offset = MIN(private->core.shown_x_offset, private->core.view_x_offset);
+        cache_context.view_y_offset = MIN(private->core.shown_y_offset, private->core.view_y_offset);
+        cache_context.view_width = ABS(private->core.view_x_offset - private->core.shown_x_offset) + context->view_width;
+        cache_context.view_height = ABS(private->core.view_y_offset - private->core.shown_y_offset) + context->view_height;
 
-        /* Render all the circular segments. */
-        while (file_list)
+        if (((gint64)cache_context.view_width * cache_context.view_height) >
+            ((gint64)context->view_width * context->view_height * VIEW_CACHE_MAX_VIEWS))
         {
-            CaFileItem* fileitem;
-
-            fileitem = (CaFileItem*)file_list->data;
-            g_assert(fileitem != NULL);
+            return FALSE;   /* A long way to move; render each frame instead. */
+        }
 
-            if (associated_fileitem != fileitem)    /* Do not render as it is a sub fileleaf. */
-            {
-                /*
-                CDC
-                BAB
-                */
-                if (fileitem->_circular_angle_share == 360.0)
-                {
-                    if (fileitem->_segment_render == NULL)
-                    {
-                        fileitem->_segment_render = g_new(CaSegmentRender, 1);
-
-                        if (GLYPH_FILE_MENU == fileitem->_type)
-                        {
-                            /* Add an arrow. */
-                            fileitem->_segment_render->arrow_radius =
-                            	(gint)((fileitem->_parent_radius + SEGMENT_OUTER_SPACER(private->normal_iconsize)) -
-                            	SEGMENT_ARROW_HEIGHT);
-
-                            _ca_get_point_from_source_offset(
-                                fileleaf->_central_glyph->x,
-                                fileleaf->_central_glyph->y,
-                                fileitem->_parent_angle,
-                                fileitem->_segment_render->arrow_radius,
-                                &fileitem->_segment_render->arrow_point_x,
-                                &fileitem->_segment_render->arrow_point_y);
-                        }
-                    }
-
-                    /* Render a single segment. */
-                    cairo_arc(cr,
-                        OFFSET_2_SCREEN(fileleaf->_central_glyph->x, private->view_x_offset),
-                        OFFSET_2_SCREEN(fileleaf->_central_glyph->y, private->view_y_offset),
-                        fileitem->_parent_radius + SEGMENT_OUTER_SPACER(private->normal_iconsize),
-                        DEGREE_2_RADIAN(0.0),
-                        DEGREE_2_RADIAN(360.0));
-
-                    cairo_arc(cr,
-                        OFFSET_2_SCREEN(fileleaf->_central_glyph->x, private->view_x_offset),
-                        OFFSET_2_SCREEN(fileleaf->_central_glyph->y, private->view_y_offset),
-                        fileitem->_parent_radius - SEGMENT_INNER_SPACER(private->normal_iconsize),
-                        DEGREE_2_RADIAN(0.0),
-                        DEGREE_2_RADIAN(360.0));
-
-                    /* Check whether the item is selected. */
-                    if (fileitem == g_current_fileitem)
-                    {
-                        /* Prelight. */
-
-                        /* Render to the cairo context. */
-                        cairo_set_line_width (cr, g_prelight_segment_rgba._line_width);
-                        cairo_set_source_rgba (
-							cr,
-							g_prelight_segment_rgba._r,
-							g_prelight_segment_rgba._g,
-							g_prelight_segment_rgba._b,
-							g_prelight_segment_rgba._a_fill);
-                        cairo_fill_preserve (cr);
-
-                        /* Render reflections. */
-                        if (FALSE == private->render_reflection_off)
-                        {
-                            _ca_circular_application_menu_render_reflection(circular_application_menu, cr);
-                        }
-
-                        cairo_set_source_rgba (
-							cr,
-							g_prelight_segment_rgba._r,
-							g_prelight_segment_rgba._g,
-							g_prelight_segment_rgba._b,
-							g_prelight_segment_rgba._a_pen);
-                        cairo_stroke (cr);
-                    }
-                    else
-                    {
-                        /* Prelight. */
-
-                        /* Render to the cairo context. */
-                        cairo_set_line_width (cr, g_normal_segment_rgba._line_width);
-                        cairo_set_source_rgba (
-							cr,
-							g_normal_segment_rgba._r,
-							g_normal_segment_rgba._g,
-							g_normal_segment_rgba._b,
-							g_normal_segment_rgba._a_fill);
-                        cairo_fill_preserve (cr);
-
-                        /* Render reflections. */
-                        if (FALSE == private->render_reflection_off)
-                        {
-                            _ca_circular_application_menu_render_reflection(circular_application_menu, cr);
-                        }
-
-                        cairo_set_source_rgba (
-							cr,
-							g_normal_segment_rgba._r,
-							g_normal_segment_rgba._g,
-							g_normal_segment_rgba._b,
-							g_normal_segment_rgba._a_pen);
-                        cairo_stroke (cr);
-                    }
-
-                    if (GLYPH_FILE_MENU == fileitem->_type)
-                    {
-                        /* Add an arrow. */
-
-                        GdkPixbuf* pixbuf;
-                        GError* error = NULL;
-
-                        /* Check whether the item is selected. */
-                        if (fileitem == g_current_fileitem)
-                        {
-                            if ((pixbuf = gdk_pixbuf_new_from_resource(RESOURCE_PATH"open-sub-menu-prelight.png", &error)) == NULL)
-                            {
-                                g_warning ("Resource not found: %s\n", error->message);
-                                g_clear_error (&error); /* g_error_free */
-                            }                            
-                        }
-                        else
-                        {
-                            if ((pixbuf = gdk_pixbuf_new_from_resource(RESOURCE_PATH"open-sub-menu-normal.png", &error)) == NULL)
-                            {
-                                g_warning ("Resource not found: %s\n", error->message);
-                                g_clear_error (&error); /* g_error_free */
-                            }                            
-                        }
-
-                        gdk_cairo_set_source_pixbuf (
-                            cr,
-                            pixbuf,
-                            OFFSET_2_SCREEN(fileitem->_segment_render->arrow_point_x, private->view_x_offset) - (SEGMENT_ARROW_HEIGHT / 2),
-                            OFFSET_2_SCREEN(fileitem->_segment_render->arrow_point_y, private->view_y_offset) - (SEGMENT_ARROW_HEIGHT / 2));
-                        cairo_paint_with_alpha(cr, 1.0);
-
-                        g_assert(pixbuf != NULL);
-
-                        g_object_unref(pixbuf);
-                    }
-                }
-                else
-                {
-                    /* Render multiple segments. */
-
-                    if (fileitem->_segment_render == NULL)
-                    {
-                        fileitem->_segment_render = g_new(CaSegmentRender, 1);
-
-                        /* Smaller the circumference then larger the angle. */
-                        fileitem->_segment_render->Aradius =
-                        	(gint)(fileitem->_parent_radius - SEGMENT_INNER_SPACER(private->normal_iconsize));
-                        fileitem->_segment_render->Bradius =
-                        	(gint)(fileitem->_segment_render->Aradius + SEGMENT_CIRCLE_RADIUS);
-                        fileitem->_segment_render->Dradius =
-                        	(gint)(fileitem->_parent_radius + SEGMENT_OUTER_SPACER(private->normal_iconsize));
-                        fileitem->_segment_render->Cradius =
-                        	(gint)(fileitem->_segment_render->Dradius - SEGMENT_CIRCLE_RADIUS);
-
-                        _ca_circular_applications_menu_get_segment_angles(
-							fileitem,
-							fileitem->_segment_render->Aradius,
-							&fileitem->_segment_render->Afrom_angle,
-							&fileitem->_segment_render->Ato_angle);
-                        _ca_circular_applications_menu_get_segment_angles(
-							fileitem,
-							fileitem->_segment_render->Bradius,
-							&fileitem->_segment_render->Bfrom_angle,
-							&fileitem->_segment_render->Bto_angle);
-                        _ca_circular_applications_menu_get_segment_angles(
-							fileitem,
-							fileitem->_segment_render->Cradius,
-							&fileitem->_segment_render->Cfrom_angle,
-							&fileitem->_segment_render->Cto_angle);
-                        _ca_circular_applications_menu_get_segment_angles(
-							fileitem,
-							fileitem->_segment_render->Dradius,
-							&fileitem->_segment_render->Dfrom_angle,
-							&fileitem->_segment_render->Dto_angle);
-
-                        /* Calculate B lowest */
-                        _ca_get_point_from_source_offset(
-                            fileleaf->_central_glyph->x,
-                            fileleaf->_central_glyph->y,
-                            fileitem->_segment_render->Bfrom_angle,
-                            fileitem->_segment_render->Bradius,
-                            &fileitem->_segment_render->B_lowest_circle_x,
-                            &fileitem->_segment_render->B_lowest_circle_y);
-
-                        /* Calculate C lowest */
-                        _ca_get_point_from_source_offset(
-                            fileleaf->_central_glyph->x,
-                            fileleaf->_central_glyph->y,
-                            fileitem->_segment_render->Cfrom_angle,
-                            fileitem->_segment_render->Cradius,
-                            &fileitem->_segment_render->C_lowest_circle_x,
-                            &fileitem->_segment_render->C_lowest_circle_y);
-
-                        /* Calculate C highest */
-                        _ca_get_point_from_source_offset(
-                            fileleaf->_central_glyph->x,
-                            fileleaf->_central_glyph->y,
-                            fileitem->_segment_render->Cto_angle,
-                            fileitem->_segment_render->Cradius,
-                            &fileitem->_segment_render->C_highest_circle_x,
-                            &fileitem->_segment_render->C_highest_circle_y);
-
-                        /* Calculate B highest */
-                        _ca_get_point_from_source_offset(
-                            fileleaf->_central_glyph->x,
-                            fileleaf->_central_glyph->y,
-                            fileitem->_segment_render->Bto_angle,
-                            fileitem->_segment_render->Bradius,
-                            &fileitem->_segment_render->B_highest_circle_x,
-                            &fileitem->_segment_render->B_highest_circle_y);
-
-                        if (GLYPH_FILE_MENU == fileitem->_type)
-                        {
-                            /* Add an arrow. */
-                            fileitem->_segment_render->arrow_radius =
-                            	(gint)((fileitem->_parent_radius + SEGMENT_OUTER_SPACER(private->normal_iconsize)) - 
-                                SEGMENT_ARROW_HEIGHT);
-
-                            _ca_get_point_from_source_offset(
-                                fileleaf->_central_glyph->x,
-                                fileleaf->_central_glyph->y,
-                                fileitem->_parent_angle,
-                                fileitem->_segment_render->arrow_radius,
-                                &fileitem->_segment_render->arrow_point_x,
-                                &fileitem->_segment_render->arrow_point_y);
-                        }
-                    }
-
-                    /* Render B lowest */
-                    cairo_arc(cr,
-                        OFFSET_2_SCREEN(fileitem->_segment_render->B_lowest_circle_x, private->view_x_offset),
-                        OFFSET_2_SCREEN(fileitem->_segment_render->B_lowest_circle_y, private->view_y_offset),
-                        SEGMENT_CIRCLE_RADIUS,
-                        DEGREE_2_RADIAN(_ca_circular_application_menu_calculate_angle_offset(fileitem->_segment_render->Bfrom_angle, -180.0)),
-                        DEGREE_2_RADIAN(_ca_circular_application_menu_calculate_angle_offset(fileitem->_segment_render->Bfrom_angle, -90.0)));
-
-                    /* Render C lowest */
-                    cairo_arc(cr,
-                        OFFSET_2_SCREEN(fileitem->_segment_render->C_lowest_circle_x, private->view_x_offset),
-                        OFFSET_2_SCREEN(fileitem->_segment_render->C_lowest_circle_y, private->view_y_offset),
-                        SEGMENT_CIRCLE_RADIUS,
-                        DEGREE_2_RADIAN(_ca_circular_application_menu_calculate_angle_offset(fileitem->_segment_render->Cfrom_angle, -90.0)),
-                        DEGREE_2_RADIAN(fileitem->_segment_render->Cfrom_angle));
-
-                    /* Render D */
-                    cairo_arc(cr,
-                        OFFSET_2_SCREEN(fileleaf->_central_glyph->x, private->view_x_offset),
-                        OFFSET_2_SCREEN(fileleaf->_central_glyph->y, private->view_y_offset),
-                        fileitem->_segment_render->Dradius,
-                        DEGREE_2_RADIAN(fileitem->_segment_render->Dfrom_angle),
-                        DEGREE_2_RADIAN(fileitem->_segment_render->Dto_angle));
-
-                    /* Render C highest */
-                    cairo_arc(cr,
-                        OFFSET_2_SCREEN(fileitem->_segment_render->C_highest_circle_x, private->view_x_offset),
-                        OFFSET_2_SCREEN(fileitem->_segment_render->C_highest_circle_y, private->view_y_offset),
-                        SEGMENT_CIRCLE_RADIUS,
-                        DEGREE_2_RADIAN(fileitem->_segment_render->Cto_angle),
-                        DEGREE_2_RADIAN(_ca_circular_application_menu_calculate_angle_offset(fileitem->_segment_render->Cto_angle, 90.0)));
-
-                    /* Render B highest */
-                    cairo_arc(cr,
-                        OFFSET_2_SCREEN(fileitem->_segment_render->B_highest_circle_x, private->view_x_offset),
-                        OFFSET_2_SCREEN(fileitem->_segment_render->B_highest_circle_y, private->view_y_offset),
-                        SEGMENT_CIRCLE_RADIUS,
-                        DEGREE_2_RADIAN(_ca_circular_application_menu_calculate_angle_offset(fileitem->_segment_render->Bto_angle, 90.0)),
-                        DEGREE_2_RADIAN(_ca_circular_application_menu_calculate_angle_offset(fileitem->_segment_render->Bto_angle, 180.0)));
-
-                    /* Render A */
-                    cairo_arc_negative(cr,
-                        OFFSET_2_SCREEN(fileleaf->_central_glyph->x, private->view_x_offset),
-                        OFFSET_2_SCREEN(fileleaf->_central_glyph->y, private->view_y_offset),
-                        fileitem->_segment_render->Aradius,
-                        DEGREE_2_RADIAN(fileitem->_segment_render->Ato_angle),
-                        DEGREE_2_RADIAN(fileitem->_segment_render->Afrom_angle));
-
-                    /* Check whether the item is selected. */
-                    if (fileitem == g_current_fileitem)
-                    {
-                        /* Prelight. */
-
-                        /* Render to the cairo context. */
-                        cairo_set_line_width (cr, g_prelight_segment_rgba._line_width);
-                        cairo_set_source_rgba (cr, g_prelight_segment_rgba._r, g_prelight_segment_rgba._g, g_prelight_segment_rgba._b, g_prelight_segment_rgba._a_fill);
-                        cairo_fill_preserve (cr);
-
-                        /* Render reflections. */
-                        if (FALSE == private->render_reflection_off)
-                        {
-                            _ca_circular_application_menu_render_reflection(circular_application_menu, cr);
-                        }
-
-                        cairo_set_source_rgba (cr, g_prelight_segment_rgba._r, g_prelight_segment_rgba._g, g_prelight_segment_rgba._b, g_prelight_segment_rgba._a_pen);
-                        cairo_stroke (cr);
-                    }
-                    else
-                    {
-                        /* Prelight. */
-
-                        /* Render to the cairo context. */
-                        cairo_set_line_width (cr, g_normal_segment_rgba._line_width);
-                        cairo_set_source_rgba (cr, g_normal_segment_rgba._r, g_normal_segment_rgba._g, g_normal_segment_rgba._b, g_normal_segment_rgba._a_fill);
-                        cairo_fill_preserve (cr);
-
-                        /* Render reflections. */
-                        if (FALSE == private->render_reflection_off)
-                        {
-                            _ca_circular_application_menu_render_reflection(circular_application_menu, cr);
-                        }
-
-                        cairo_set_source_rgba (cr, g_normal_segment_rgba._r, g_normal_segment_rgba._g, g_normal_segment_rgba._b, g_normal_segment_rgba._a_pen);
-                        cairo_stroke (cr);
-                    }
-
-                    if (GLYPH_FILE_MENU == fileitem->_type)
-                    {
-                        /* Add an arrow. */
-
-                        GdkPixbuf* pixbuf;
-                        GError* error = NULL;
-
-                        /* Check whether the item is selected. */
-                        if (fileitem == g_current_fileitem)
-                        {
-                            if ((pixbuf = gdk_pixbuf_new_from_resource(RESOURCE_PATH"open-sub-menu-prelight.png", &error)) == NULL)
-                            {
-                                g_warning ("Resource not found: %s\n", error->message);
-                                g_clear_error (&error); /* g_error_free */
-                            }                            
-                        }
-                        else
-                        {
-                            if ((pixbuf = gdk_pixbuf_new_from_resource(RESOURCE_PATH"open-sub-menu-normal.png", &error)) == NULL)
-                            {
-                                g_warning ("Resource not found: %s\n", error->message);
-                                g_clear_error (&error); /* g_error_free */
-                            }
-                        }
-
-                        gdk_cairo_set_source_pixbuf (
-                            cr,
-                            pixbuf,
-                            OFFSET_2_SCREEN(fileitem->_segment_render->arrow_point_x, private->view_x_offset) - (SEGMENT_ARROW_HEIGHT / 2),
-                            OFFSET_2_SCREEN(fileitem->_segment_render->arrow_point_y, private->view_y_offset) - (SEGMENT_ARROW_HEIGHT / 2));
-                        cairo_paint_with_alpha(cr, 1.0);
-
-                        g_assert(pixbuf != NULL);
-
-                        g_object_unref(pixbuf);
-                    }
-                }
-            }
+        private->view_cache = cairo_surface_create_similar(
+            cairo_get_target(cr),
+            CAIRO_CONTENT_COLOR_ALPHA,
+            cache_context.view_width,
+            cache_context.view_height);
+        private->view_cache_serial = private->scene_serial;
+        private->view_cache_x_offset = cache_context.view_x_offset;
+        private->view_cache_y_offset = cache_context.view_y_offset;
+        private->view_cache_width = cache_context.view_width;
+        private->view_cache_height = cache_context.view_height;
 
-            file_list = g_list_next(file_list);
-        }
+        cache_cr = cairo_create(private->view_cache);
+        ca_render_scene(&cache_context, cache_cr);
+        cairo_destroy(cache_cr);
     }
 
-    file_list = g_list_first(fileleaf->_fileitem_list);
-
-    /* Render all the fileitems. */
-    while (file_list)
+    /* The shown view must lie within the cache. */
+    if ((context->view_x_offset < private->view_cache_x_offset) ||
+        (context->view_y_offset < private->view_cache_y_offset) ||
+        (context->view_x_offset + context->view_width > private->view_cache_x_offset + private->view_cache_width) ||
+        (context->view_y_offset + context->view_height > private->view_cache_y_offset + private->view_cache_height))
     {
-        CaFileItem* fileitem;
+        return FALSE;
+    }
 
-        fileitem = (CaFileItem*)file_list->data;
-        g_assert(fileitem != NULL);
+    /* Translate the cached scene into the view. */
+    cairo_save(cr);
+    cairo_rectangle(cr, 0, 0, context->view_width, context->view_height);
+    cairo_clip(cr);
+    cairo_set_operator(cr, CAIRO_OPERATOR_SOURCE);
+    cairo_set_source_surface(
+        cr,
+        private->view_cache,
+        OFFSET_2_SCREEN(private->view_cache_x_offset, context->view_x_offset),
+        OFFSET_2_SCREEN(private->view_cache_y_offset, context->view_y_offset));
+    cairo_paint(cr);
+    cairo_restore(cr);
 
-        if (associated_fileitem != fileitem)    /* Do not render as it is a sub fileleaf. */
-        {
-            /* Render the fileleaf fileitems. */
-            g_assert(fileitem->_pixbuf != NULL);
-
-            gdk_cairo_set_source_pixbuf (
-                cr,
-                fileitem->_pixbuf,
-                OFFSET_2_SCREEN(fileitem->x - (private->icon_width / 2), private->view_x_offset),
-                OFFSET_2_SCREEN(fileitem->y - (private->icon_height / 2), private->view_y_offset));
-            cairo_paint_with_alpha(cr, 1.0);
-        }
+    /* Render text. */
+    ca_render_text(context, cr);
 
-        file_list = g_list_next(file_list);
-    }
+    return TRUE;
 }
 
 /**
- * _ca_circular_application_menu_render_fileleaf:
+ * _ca_circular_application_menu_get_render_context:
  * @circular_application_menu: A CaCircularApplicationMenu pointer to the circular-application-menu widget instance.
- * @y: A Y co-ordinate of the text to render.
- * @text: The text to render.
- * @cr: A cairo-context to render to.
+ * @context: A return location for the state to render, at the shown view.
  *
- * Renders the text to a cairo context.
- */
+ * Fills a render context from the core, the options and the features the budget has left.
+ **/
 static void
-_ca_circular_application_menu_render_centred_text(
-	CaCircularApplicationMenu* circular_application_menu,
-	gint y,
-	const gchar* text,
-	cairo_t* cr)
+_ca_circular_application_menu_get_render_context(CaCircularApplicationMenu* circular_application_menu, CaRenderContext* context)
 {
     CaCircularApplicationMenuPrivate* private;
-    gint x;
-    gint radius;
-    cairo_text_extents_t text_extents;
-    cairo_text_extents_t complete_text_extents;
-    cairo_font_extents_t font_extents;
 
     private = _ca_circular_application_menu_get_instance_private(circular_application_menu);
 
-    if ((text == NULL) ||
-        (strlen(text) == 0))
-        return;
-
-    cairo_select_font_face (cr, "Sans", CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_NORMAL);
-    cairo_set_font_size (cr, 15.0);
-    cairo_font_extents(cr, &font_extents);
-
-    cairo_text_extents (cr, text, &text_extents);
-    cairo_text_extents (cr, "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz", &complete_text_extents);
-
-    /* Calculate the text position. */
-    x = (private->view_width - (gint)text_extents.width) / 2;
-    radius = (gint)(TEXT_BOUNDARY + font_extents.height + TEXT_BOUNDARY) / 2;
-
-    /* Render the text surround. */
-    cairo_arc(
-        cr,
-        x - TEXT_BOUNDARY,
-        y - (complete_text_extents.height / 2),
-        radius,
-        DEGREE_2_RADIAN(90.0),
-        DEGREE_2_RADIAN(270.0));
-
-    cairo_arc(
-        cr,
-        x + text_extents.width + TEXT_BOUNDARY,
-        y - (complete_text_extents.height / 2),
-        radius,
-        DEGREE_2_RADIAN(270.0),
-        DEGREE_2_RADIAN(90.0));
-
-    cairo_set_source_rgba (cr, g_text_box_rgba._r, g_text_box_rgba._g, g_text_box_rgba._b, g_text_box_rgba._a_fill);
-    cairo_fill_preserve (cr);
-    cairo_set_source_rgba (cr, g_text_box_rgba._r, g_text_box_rgba._g, g_text_box_rgba._b, g_text_box_rgba._a_pen);
-    cairo_set_line_width (cr, g_text_box_rgba._line_width);
-    cairo_stroke (cr);
-
-    /* Render the text. */
-    cairo_move_to (cr, x, y - (font_extents.descent / 2));
-    cairo_text_path (cr, text);
-    cairo_set_source_rgba (cr, g_text_rgba._r, g_text_rgba._g, g_text_rgba._b, g_text_rgba._a_fill);
-    cairo_fill_preserve (cr);
-    cairo_set_source_rgba (cr, g_text_rgba._r, g_text_rgba._g, g_text_rgba._b, g_text_rgba._a_pen);
-    cairo_set_line_width (cr, g_text_rgba._line_width);
-    cairo_stroke (cr);
+    context->geometry = &private->core.geometry;
+    context->view_x_offset = private->core.shown_x_offset;
+    context->view_y_offset = private->core.shown_y_offset;
+    context->view_width = private->core.view_width;
+    context->view_height = private->core.view_height;
+    context->light_pixbuf = private->light_pixbuf;
+    context->close_normal_pixbuf = private->close_normal_pixbuf;
+    context->close_prelight_pixbuf = private->close_prelight_pixbuf;
+    context->open_normal_pixbuf = private->open_normal_pixbuf;
+    context->open_prelight_pixbuf = private->open_prelight_pixbuf;
+    context->emblem_normal = private->emblem_normal;
+    context->emblem_prelight = private->emblem_prelight;
+    context->render_reflection_off =
+        private->render_reflection_off ||
+        (private->budget.level >= QUALITY_NO_REFLECTION);
+    context->render_overlap_off =
+        private->opaque ||
+        private->remote ||
+        (private->budget.level >= QUALITY_NO_OVERLAP);
+    context->render_opaque = private->opaque;
+    context->render_leaf_surfaces = private->remote;
+    context->render_tabbed_only = private->core.tabbed_only;
+    context->raster = private->raster;
+    context->render_fast =
+        private->render_fast ||
+        private->animating ||
+        ca_core_is_view_animating(&private->core);
+    context->root_fileleaf = private->core.root_fileleaf;
+    context->tabbed_fileleaf = private->core.tabbed_fileleaf;
+    context->current_fileleaf = private->core.current_fileleaf;
+    context->current_fileitem = private->core.current_fileitem;
+    context->current_type = private->core.current_type;
+    context->disassociated_fileleaf = private->core.disassociated_fileleaf;
 }
 
 /**
- * _ca_circular_application_menu_render_fileleaf:
+ * _ca_circular_application_menu_update_canvas:
  * @circular_application_menu: A CaCircularApplicationMenu pointer to the circular-application-menu widget instance.
- * @source_x: The circle X origin.
- * @source_y: The circle Y origin.
- * @angle: The angle of the destination co-ordinates.
- * @radius: The radius from the source origin of the destination co-ordinates.
- * @destination_x: The X destination co-ordinate.
- * @destination_y: The Y destination co-ordinate.
- *
- * Retrieves the xy co-ordinate from the given circle information.
- */
+ *
+ * Bounds the window to the canvas of the scene at both the shown view and its destination, so a
+ * view animation is not resized on every tick.  The canvas grows as soon as the scene needs more;
+ * it only shrinks once it is CANVAS_SHRINK_FACTOR times the area needed.
+ **/
 static void
-_ca_get_point_from_source_offset(
-	gint source_x,
-	gint source_y,
-	gdouble angle,
-	gdouble radius,
-	gint* destination_x,
-	gint* destination_y)
+_ca_circular_application_menu_update_canvas(CaCircularApplicationMenu* circular_application_menu)
 {
-    gdouble degree_in_radius;
+    CaCircularApplicationMenuPrivate* private;
+    CaRenderContext context;
+    GdkRectangle canvas;
+    GdkRectangle destination;
 
-    *destination_x = source_x;
-    *destination_y = source_y;
+    private = _ca_circular_application_menu_get_instance_private(circular_application_menu);
 
-    if (radius == 0.0)
-        return; /* No distance away from source. */
+    if (FALSE == private->bounded_canvas)
+        return;
 
-    g_assert(angle >= 0.0);
-    g_assert(angle <= 359.9);
+    _ca_circular_application_menu_get_render_context(circular_application_menu, &context);
+    ca_render_get_canvas(&context, &canvas);
 
-    degree_in_radius = angle * (M_PI / 180);
+    context.view_x_offset = private->core.view_x_offset;
+    context.view_y_offset = private->core.view_y_offset;
+    ca_render_get_canvas(&context, &destination);
 
-    *destination_x = (gint)(source_x + (radius * cos(degree_in_radius)));
-    *destination_y = (gint)(source_y + (radius * sin(degree_in_radius)));
-}
+    gdk_rectangle_union(&canvas, &destination, &canvas);
 
-/**
- * _ca_circular_application_menu_point_distance:
- * @x1: The first X co-ordinate.
- * @y1: The first Y co-ordinate.
- * @x2: The second X co-ordinate.
- * @y2: The second Y  co-ordinate.
- *
- * Retrieves the distance between two xy positions.
- *
- * Returns: The calculated distance between the two positions.
- */
-static gdouble
-_ca_circular_application_menu_point_distance(gint x1, gint y1, gint x2, gint y2)
-{
-    gdouble distance;   /* Distance in radians. */
-    gint xd;
-    gint yd;
+    /* Keep the current canvas whilst it covers the scene without being much too large. */
+    if ((canvas.x >= private->canvas.x) &&
+        (canvas.y >= private->canvas.y) &&
+        (canvas.x + canvas.width <= private->canvas.x + private->canvas.width) &&
+        (canvas.y + canvas.height <= private->canvas.y + private->canvas.height) &&
+        ((gint64)private->canvas.width * private->canvas.height <= (gint64)canvas.width * canvas.height * CANVAS_SHRINK_FACTOR))
+        return;
 
-    xd = x2 - x1;
-    yd = y2 - y1;
-    distance = sqrt(xd*xd + yd*yd);
+    private->canvas = canvas;
 
-    return distance;
+    _ca_circular_application_menu_apply_canvas(circular_application_menu);
 }
 
 /**
- * _ca_circular_application_menu_circle_contains_point:
- * @point_x: The first X co-ordinate.
- * @point_y: The first Y co-ordinate.
- * @circle_x: The circle X origin.
- * @circle_y: The circle Y origin.
- * @radius: The radius of the circle.
- *
- * Retrieves whether a circle contains a given xy position.
+ * _ca_circular_application_menu_apply_canvas:
+ * @circular_application_menu: A CaCircularApplicationMenu pointer to the circular-application-menu widget instance.
  *
- * Returns: TRUE if the circle contains the xy position; otherwise FALSE.
- */
-static gboolean
-_ca_circular_application_menu_circle_contains_point(gint point_x, gint point_y, gint circle_x, gint circle_y, gint radius)
+ * Moves and resizes the window to the canvas.
+ **/
+static void
+_ca_circular_application_menu_apply_canvas(CaCircularApplicationMenu* circular_application_menu)
 {
-    gdouble distance;
+    CaCircularApplicationMenuPrivate* private;
+    GtkWidget* toplevel;
 
-    distance = _ca_circular_application_menu_point_distance(point_x, point_y, circle_x, circle_y);
+    private = _ca_circular_application_menu_get_instance_private(circular_application_menu);
+
+    toplevel = gtk_widget_get_toplevel(GTK_WIDGET(circular_application_menu));
+
+    if ((gtk_widget_is_toplevel(toplevel)) &&
+        (GTK_IS_WINDOW(toplevel)))
+    {
+        gtk_window_move(GTK_WINDOW(toplevel), private->view_origin_x + private->canvas.x, private->view_origin_y + private->canvas.y);
+        gtk_window_resize(GTK_WINDOW(toplevel), private->canvas.width, private->canvas.height);
+    }
 
-    return (distance <= radius);
+    gtk_widget_queue_resize(GTK_WIDGET(circular_application_menu));
 }
 
 /**
- * _ca_circular_application_menu_circle_contains_point:
+ * _ca_circular_application_menu_update_shape:
  * @circular_application_menu: A CaCircularApplicationMenu pointer to the circular-application-menu widget instance.
- * @point_x: The X co-ordinate.
- * @point_y: The Y co-ordinate.
- * @fileitem: The file-item to check for a hittest.
- *
- * Retrieves whether a segment contains a given xy position.
  *
- * Returns: TRUE if the segment contains the xy position; otherwise FALSE.
- */
-static gboolean
-_ca_circular_application_menu_segment_contains_point(CaCircularApplicationMenu* circular_application_menu, gint point_x, gint point_y, CaFileItem* fileitem)
+ * Shapes the window to the file-leaves and text at both the shown view and its destination, so a
+ * view animation is not shaped on every tick.  The shape of each file-leaf is kept from one update
+ * to the next and the window is only shaped again when the shape has changed, i.e. once a file-leaf
+ * is opened or closed, the view is centred elsewhere or the text changes.
+ **/
+static void
+_ca_circular_application_menu_update_shape(CaCircularApplicationMenu* circular_application_menu)
 {
     CaCircularApplicationMenuPrivate* private;
-    CaFileLeaf* fileleaf;
-    gdouble current_distance;
-    gboolean between_angle;
+    CaRenderContext context;
+    cairo_region_t* shape;
+
     private = _ca_circular_application_menu_get_instance_private(circular_application_menu);
 
-    between_angle = FALSE;
+    if (FALSE == private->shape_window)
+        return;
+
+    shape = cairo_region_create();
 
-    fileleaf = fileitem->_assigned_fileleaf;
+    _ca_circular_application_menu_get_render_context(circular_application_menu, &context);
+    ca_render_get_shape(&context, shape);
 
-    current_distance = _ca_circular_application_menu_point_distance(
-        fileleaf->_central_glyph->x,
-        fileleaf->_central_glyph->y,
-        point_x,
-        point_y);
+    context.view_x_offset = private->core.view_x_offset;
+    context.view_y_offset = private->core.view_y_offset;
+    ca_render_get_shape(&context, shape);
 
-    /* Check for the correct ring. */
-    if ((current_distance > (fileitem->_parent_radius - SEGMENT_INNER_SPACER(private->normal_iconsize))) &&
-        (current_distance < (fileitem->_parent_radius + SEGMENT_OUTER_SPACER(private->normal_iconsize))))
+    /* The window only covers the canvas of the view. */
+    cairo_region_translate(shape, -private->canvas.x, -private->canvas.y);
+
+    if ((private->shape != NULL) &&
+        (cairo_region_equal(private->shape, shape)))
     {
-        if (fileitem->_circular_angle_share == 360.0)
-        {
-            /* Only one fileitem. */
-            between_angle = TRUE;
-        }
-        else
-        {
-            /* Check for the correct segment. */
-            gdouble half_circular_angle_share;
-            gdouble from_angle;
-            gdouble to_angle;
-            gdouble current_angle;
-
-            half_circular_angle_share = fileitem->_circular_angle_share / 2;
-            from_angle = _ca_circular_application_menu_calculate_angle_offset(fileitem->_parent_angle, -half_circular_angle_share);
-            to_angle = _ca_circular_application_menu_calculate_angle_offset(fileitem->_parent_angle, half_circular_angle_share);
-
-            current_angle = _ca_circular_application_menu_angle_between_points(fileitem->_assigned_fileleaf->x, fileitem->_assigned_fileleaf->y, point_x, point_y);
-            between_angle = _ca_circular_application_menu_is_angle_between_angles(current_angle, from_angle, to_angle);
-        }
+        cairo_region_destroy(shape);
+
+        return;
+    }
+
+    if (private->shape != NULL)
+    {
+        cairo_region_destroy(private->shape);
     }
 
-    return between_angle;
+    private->shape = shape;
+
+    _ca_circular_application_menu_apply_shape(circular_application_menu);
 }
 
 /**
- * _ca_circular_application_menu_circumference_from_radius:
- * @radius: The radius of the circle.
- *
- * Retrieves a circumference from a given radius.
+ * _ca_circular_application_menu_apply_shape:
+ * @circular_application_menu: A CaCircularApplicationMenu pointer to the circular-application-menu widget instance.
  *
- * Returns: The calculated circumference.
- */
-static gdouble
-_ca_circular_application_menu_circumference_from_radius(gdouble radius)
+ * Gives the shape to the window; the pointer then reaches the windows beneath everywhere else.
+ * Where the display supports shaped windows the compositor also only blends the shape.
+ **/
+static void
+_ca_circular_application_menu_apply_shape(CaCircularApplicationMenu* circular_application_menu)
 {
-    gdouble circumference;
+    CaCircularApplicationMenuPrivate* private;
+    GtkWidget* toplevel;
 
-    circumference = (radius + radius) * M_PI;
+    private = _ca_circular_application_menu_get_instance_private(circular_application_menu);
+
+    toplevel = gtk_widget_get_toplevel(GTK_WIDGET(circular_application_menu));
+
+    if (!gtk_widget_is_toplevel(toplevel))
+        return;
 
-    return circumference;
+    gtk_widget_input_shape_combine_region(toplevel, private->shape);
+
+    if (gdk_display_supports_shapes(gtk_widget_get_display(toplevel)))
+    {
+        gtk_widget_shape_combine_region(toplevel, private->shape);
+    }
+
+    /* The whole of the shape of an opaque window is painted. */
+    if ((TRUE == private->opaque) &&
+        (gtk_widget_get_realized(toplevel)))
+    {
+        gdk_window_set_opaque_region(gtk_widget_get_window(toplevel), private->shape);
+    }
 }
 
 /**
- * _ca_circular_application_menu_calculate_radius:
- * @circular_application_menu: A CaCircularApplicationMenu pointer to the circular-application-menu widget instance.
- * @fileleaf: The file-leaf to calculate the radius against.
- *
- * Calculates a radius of a given file-leaf taking into account the amount of segments.
+ * _ca_circular_application_menu_hierarchy_changed:
+ * @widget: a GtkWidget pointer to the current widget.
+ * @previous_toplevel: The previous toplevel; otherwise NULL.
  *
- * Returns: The calculated radius.
- */
-static gdouble
-_ca_circular_application_menu_calculate_radius(CaCircularApplicationMenu* circular_application_menu, CaFileLeaf* fileleaf)
+ * Generated 'hierarchy_changed' caused when the widget is added to a window, which is then placed
+ * over a bounded canvas and shaped.
+ **/
+static void
+_ca_circular_application_menu_hierarchy_changed(GtkWidget* widget, GtkWidget* previous_toplevel)
 {
     CaCircularApplicationMenuPrivate* private;
-    gint fileitems_total;
-    gdouble current_radius;
-    gint centre_iconsize;    
-    private = _ca_circular_application_menu_get_instance_private(circular_application_menu);
-    
-    /* Retrieve the centre iconsize. */
-    centre_iconsize = _ca_circular_applications_menu_get_centre_iconsize(circular_application_menu, fileleaf);
 
-    fileitems_total = fileleaf->_fileitem_list_count;
-    current_radius = (centre_iconsize / 2) + INITIAL_RADIUS(private->normal_iconsize);
+    private = _ca_circular_application_menu_get_instance_private(CA_CIRCULAR_APPLICATION_MENU(widget));
 
-    while (fileitems_total > 0)
+    if (TRUE == private->bounded_canvas)
     {
-        gint current_circumference;
-        gint fileitems_ring_count;
-
-        /* Start a new ring. */
-        current_circumference = (gint)_ca_circular_application_menu_circumference_from_radius(current_radius);
-        fileitems_ring_count = current_circumference / (gint)MIN_RADIUS_ICONAREA(private->normal_iconsize);
-        fileitems_ring_count = MIN(fileitems_total, fileitems_ring_count);
-
-        fileitems_total -= fileitems_ring_count;
-
-        if (fileitems_total > 0)
-        {
-            /* Increment to the next circular ring. */
-            /* (do not (private->normal_iconsize / 2) as two halves are incremented. */
-            current_radius +=
-            	(SEGMENT_OUTER_SPACER(private->normal_iconsize) +
-            	CIRCULAR_SEPERATOR +
-            	SEGMENT_INNER_SPACER(private->normal_iconsize));
-        }
-        else
-        {
-            /* No more circular rings to process. */
-            current_radius +=
-            	(SEGMENT_OUTER_SPACER(private->normal_iconsize) + CIRCULAR_SEPERATOR);
-        }
+        _ca_circular_application_menu_apply_canvas(CA_CIRCULAR_APPLICATION_MENU(widget));
     }
 
-    return current_radius;
+    if (private->shape != NULL)
+    {
+        _ca_circular_application_menu_apply_shape(CA_CIRCULAR_APPLICATION_MENU(widget));
+    }
 }
 
 /**
- * _ca_circular_applications_menu_get_centre_iconsize:
+ * ca_circular_application_menu_get_canvas:
  * @circular_application_menu: A CaCircularApplicationMenu pointer to the circular-application-menu widget instance.
- * @fileleaf: The file-leaf to reposition.
- *
- * Retrieves the centre iconsize..
+ * @view_width: A return location for the width of the view.
+ * @view_height: A return location for the height of the view.
+ * @canvas: A return location for the part of the view the window covers.
  *
- * Returns: The centre iconsize.
- */
-static gint 
-_ca_circular_applications_menu_get_centre_iconsize(CaCircularApplicationMenu* circular_application_menu, CaFileLeaf* fileleaf)
+ * Retrieves the canvas; the window co-ordinates of an event plus the canvas position are the view
+ * co-ordinates the menu is laid out in.
+ **/
+void
+ca_circular_application_menu_get_canvas(CaCircularApplicationMenu* circular_application_menu, gint* view_width, gint* view_height, GdkRectangle* canvas)
 {
     CaCircularApplicationMenuPrivate* private;
-    gint iconsize;
-    
-    private = _ca_circular_application_menu_get_instance_private(circular_application_menu);
 
-    if ((fileleaf == g_root_fileleaf) &&
-        (private->emblem_normal != NULL) &&
-        (private->emblem_prelight != NULL))
-    {
-        iconsize = MAX(gdk_pixbuf_get_width(private->emblem_normal), gdk_pixbuf_get_width(private->emblem_prelight));
-    }
-    else
-    {
-        iconsize = CENTRE_ICONSIZE;
-    }
+    private = _ca_circular_application_menu_get_instance_private(circular_application_menu);
 
-    return iconsize;
+    *view_width = private->core.view_width;
+    *view_height = private->core.view_height;
+    *canvas = private->canvas;
 }
 
 /**
- * _ca_circular_application_menu_position_fileleaf_files:
- * @circular_application_menu: A CaCircularApplicationMenu pointer to the circular-application-menu widget instance. 
- * @fileleaf: The file-leaf to reposition.
- * @radius: The file-leaf radius.
- * @angle: The parent angle of the file-leaf
+ * _ca_circular_application_menu_track_motion:
+ * @circular_application_menu: A CaCircularApplicationMenu pointer to the circular-application-menu widget instance.
+ * @x: The x co-ordinate of the pointer.
+ * @y: The y co-ordinate of the pointer.
  *
- * Positions a file-leaf and all child segments.
- */
+ * Measures the speed of the pointer; whilst it is faster than the motion threshold the frames are
+ * rendered fast, and a full quality frame is rendered once it has been slower for the settle
+ * interval.
+ **/
 static void
-_ca_circular_application_menu_position_fileleaf_files(CaCircularApplicationMenu* circular_application_menu, CaFileLeaf* fileleaf, gdouble radius, gdouble angle)
+_ca_circular_application_menu_track_motion(CaCircularApplicationMenu* circular_application_menu, gint x, gint y)
 {
-    /* TODO: Order the fileitems so the folders appear on the outside? */
-    CaCircularApplicationMenuPrivate* private;        
-    GList* list;
-    gint fileitems_total;
-    gint current_radius;
-    gint centre_iconsize;
-    
+    CaCircularApplicationMenuPrivate* private;
+    gint64 now;
+
     private = _ca_circular_application_menu_get_instance_private(circular_application_menu);
 
-    /* Assign the fileleaf size. */
-    if (fileleaf->_type == ROOT_LEAF)
-    {
-        /* Assign the fileleaf size. */
-        fileleaf->x = CA_VIEW_X_OFFSET_START;
-        fileleaf->y = CA_VIEW_Y_OFFSET_START;
-    }
-    else
+    now = g_get_monotonic_time();
+
+    if ((private->motion_threshold > 0) &&
+        (private->motion_time != 0) &&
+        (now > private->motion_time))
     {
-        /* Assign the sub fileleaf. */
-        gint parent_distance;
+        gdouble distance;
+        gdouble speed;
 
-        g_assert(fileleaf->_parent_fileleaf != NULL);
+        distance = sqrt(
+            (gdouble)(x - private->motion_x) * (x - private->motion_x) +
+            (gdouble)(y - private->motion_y) * (y - private->motion_y));
+        speed = (distance * G_USEC_PER_SEC) / (now - private->motion_time);
 
-        parent_distance =
-        	(gint)(fileleaf->_parent_fileleaf->radius +
-        	RADIUS_SPACER +
-        	SPOKE_LENGTH(private->tab_height) +
-        	radius);
+        if (speed > private->motion_threshold)
+        {
+            private->render_fast = TRUE;
 
-        _ca_get_point_from_source_offset(
-            fileleaf->_parent_fileleaf->x,
-            fileleaf->_parent_fileleaf->y,
-            angle,
-            parent_distance,
-            &fileleaf->x,
-            &fileleaf->y);
+            /* Restart the settle interval. */
+            if (private->settle_timeout_id != 0)
+            {
+                g_source_remove(private->settle_timeout_id);
+            }
+
+            private->settle_timeout_id = g_timeout_add(
+                private->settle_interval,
+                _ca_circular_application_menu_on_motion_settled,
+                (gpointer)circular_application_menu);
+        }
     }
 
-    fileitems_total = fileleaf->_fileitem_list_count;
+    private->motion_time = now;
+    private->motion_x = x;
+    private->motion_y = y;
+}
 
-    /* Assign the fileitems size. */
-    list = g_list_first(fileleaf->_fileitem_list);
+/**
+ * _ca_circular_application_menu_on_motion_settled:
+ * @data: a GtkObject pointer to the current widget.
+ *
+ * Generated 'timeout' caused when the pointer has been slower than the motion threshold for the
+ * settle interval; the frame is rendered again at full quality.
+ *
+ * Returns: FALSE so the timeout is removed.
+ **/
+static gboolean
+_ca_circular_application_menu_on_motion_settled(gpointer data)
+{
+    CaCircularApplicationMenu* circular_application_menu;
+    CaCircularApplicationMenuPrivate* private;
 
-    /* Retrieve the centre iconsize. */
-    centre_iconsize = _ca_circular_applications_menu_get_centre_iconsize(circular_application_menu, fileleaf);
+    circular_application_menu = CA_CIRCULAR_APPLICATION_MENU(data);
+    private = _ca_circular_application_menu_get_instance_private(circular_application_menu);
 
-    current_radius = (gint)((centre_iconsize / 2) + INITIAL_RADIUS(private->normal_iconsize));
+    private->settle_timeout_id = 0;
+    private->render_fast = FALSE;
 
-    while (fileitems_total > 0)
+    /* An animation renders its own full quality frame when it finishes. */
+    if (FALSE == private->animating)
     {
-        gint current_circumference;
-        gint fileitems_ring_count;
-        gdouble fileitem_angle;
-        gdouble current_fileitem_angle;
-
-        /* Start a new ring. */
-        current_circumference = (gint)((current_radius * 2) * M_PI);
-        fileitems_ring_count = current_circumference / (gint)MIN_RADIUS_ICONAREA(private->normal_iconsize);
-        fileitems_ring_count = MIN(fileitems_total, fileitems_ring_count);
+        _ca_circular_application_menu_invalidate(circular_application_menu);
+    }
 
-        fileitem_angle = 360.0 / fileitems_ring_count;
-        current_fileitem_angle = 0.0;
+    return FALSE;
+}
 
-        fileitems_total -= fileitems_ring_count;
+/**
+ * _ca_circular_application_menu_on_rasterized:
+ * @data: a GtkObject pointer to the current widget.
+ *
+ * Generated 'idle' caused when worker threads have rasterized file-leaf segments; the scene is
+ * rendered again to composite them.
+ *
+ * Returns: FALSE.
+ **/
+static gboolean
+_ca_circular_application_menu_on_rasterized(gpointer data)
+{
+    CaCircularApplicationMenu* circular_application_menu;
 
-        /* Process all fileitems within the ring. */
-        while (fileitems_ring_count > 0)
-        {
-            CaFileItem* fileitem;
+    circular_application_menu = CA_CIRCULAR_APPLICATION_MENU(data);
 
-            fileitem = (CaFileItem*)list->data;
-            g_assert(fileitem != NULL);
+    /* Invalidate the widget. */
+    _ca_circular_application_menu_invalidate(circular_application_menu);
 
-            _ca_get_point_from_source_offset(
-				fileleaf->x,
-				fileleaf->y,
-				current_fileitem_angle,
-				current_radius,
-				&fileitem->x,
-				&fileitem->y);
+    return FALSE;
+}
 
-            fileitem->size = (gint)private->normal_iconsize;
-            fileitem->_parent_angle = (gint)current_fileitem_angle;
-            fileitem->_parent_radius = (gint)current_radius;
-            fileitem->_circular_angle_share = fileitem_angle;
+/**
+ * _ca_circular_application_menu_on_quality_changed:
+ * @data: a GtkObject pointer to the current widget.
+ *
+ * Generated 'idle' caused when a frame has changed the quality level of the paint budget.  The
+ * reflection and the overlap translucency are read as each frame is rendered; the tabbed only
+ * view and the preview are changed here, outside of the paint.
+ *
+ * Returns: FALSE so the idle is removed.
+ **/
+static gboolean
+_ca_circular_application_menu_on_quality_changed(gpointer data)
+{
+    CaCircularApplicationMenu* circular_application_menu;
+    CaCircularApplicationMenuPrivate* private;
+    QualityLevel level;
 
-            current_fileitem_angle += fileitem_angle;
+    circular_application_menu = CA_CIRCULAR_APPLICATION_MENU(data);
+    private = _ca_circular_application_menu_get_instance_private(circular_application_menu);
 
-            fileitems_ring_count--;
+    private->quality_idle_id = 0;
+    level = private->budget.level;
 
-            /* Move onto the next fileitem. */
-            list = g_list_next(list);
-        }
+    private->core.tabbed_only =
+        private->render_tabbed_only ||
+        (level >= QUALITY_TABBED_ONLY);
 
-        if (fileitems_total > 0)
-        {
-            /* Increment to the next circular ring. */
-            /* (do not (private->normal_iconsize / 2) as two halves are incremented. */
-            current_radius += (gint)(SEGMENT_OUTER_SPACER(private->normal_iconsize) + CIRCULAR_SEPERATOR + SEGMENT_INNER_SPACER(private->normal_iconsize));
-        }
-        else
-        {
-            /* No more circular rings to process. */
-            current_radius += (gint)(SEGMENT_OUTER_SPACER(private->normal_iconsize) + CIRCULAR_SEPERATOR);
-        }
+    if (level >= QUALITY_NO_PREVIEW)
+    {
+        /* Abandon and close any preview. */
+        _ca_circular_application_menu_cancel_preview(circular_application_menu);
+        ca_core_close_preview(&private->core);
     }
 
-    /* Assign the fileleafs central glyph size. */
-    fileleaf->_central_glyph->x = fileleaf->x;
-    fileleaf->_central_glyph->y = fileleaf->y;
-    fileleaf->_central_glyph->size = (gint)centre_iconsize / 2;
-    fileleaf->radius = current_radius; /* outer */
+    g_info("The paint budget changed the quality to '%s'.", ca_budget_get_level_name(level));
+    ca_trace_quality(level, ca_budget_get_level_name(level));
+
+    /* Invalidate the widget. */
+    _ca_circular_application_menu_invalidate(circular_application_menu);
+
+    return FALSE;
 }
 
 /**
- * _ca_circular_application_menu_show_fileitem:
- * @circular_application_menu: A CaCircularApplicationMenu pointer to the circular-application-menu widget instance. 
- * @menutreedirectory: A GMenuTreeDirectory pointer to display as a menu.
- * @leaftype: The leaf-type of the menu being shown.
- * @fileitem: The file-item to show.
- * @disassociated: Specifies whether the file-item will be shown as a preview.
- *
- * Shows a given file-item as a given leaf type.
+ * _ca_circular_application_menu_on_fade_tick:
+ * @circular_application_menu: A CaCircularApplicationMenu pointer to the circular-application-menu widget instance.
  *
- * Returns: The newly created shown file-leaf.
- */
-static CaFileLeaf*
-_ca_circular_application_menu_show_fileitem(
-    CaCircularApplicationMenu* circular_application_menu, 
-	GMenuTreeDirectory* menutreedirectory,
-	LeafType leaftype,
-	CaFileItem* fileitem,
-	gboolean disassociated)
+ * Move the pointer to the centre of the screen.
+ **/
+static void 
+_ca_circular_application_menu_device_warp(CaCircularApplicationMenu* circular_application_menu)
 {
-    CaFileLeaf* fileleaf;
+    CaCircularApplicationMenuPrivate* private;
+    GdkDisplay* display;
+    GdkDevice* device;
 
-    fileleaf = ca_circular_application_menu_show_leaf(
-        circular_application_menu,
-        menutreedirectory,
-        leaftype,
-        fileitem,
-        disassociated);
+    private = _ca_circular_application_menu_get_instance_private(circular_application_menu);    
 
-    g_assert(fileleaf != NULL);
-    g_assert(fileleaf->_central_glyph != NULL);
+    //display = gdk_display_get_default();
+    display = gtk_widget_get_display (GTK_WIDGET (circular_application_menu));
+    device = gdk_seat_get_pointer(gdk_display_get_default_seat(display));
 
-    return fileleaf;
+    gdk_device_warp (
+        device,
+        gtk_widget_get_screen (GTK_WIDGET (circular_application_menu)),
+        private->view_origin_x + (private->core.view_width / 2),
+        private->view_origin_y + (private->core.view_height / 2));
 }
 
 /**
- * ca_circular_application_menu_show_leaf:
- * @circular_application_menu: A CaCircularApplicationMenu pointer to the circular-application-menu widget instance. 
- * @menutreedirectory: A GMenuTreeDirectory pointer to display as a menu.
- * @leaftype: The leaf-type of the menu being shown.
- * @fileitem: The file-item to show.
- * @disassociated: Specifies whether the file-item will be shown as a preview.
- *
- * Shows a given file-item as a given leaf type.
+ * _ca_circular_application_menu_resolve_fileitem:
+ * @circular_application_menu: A CaCircularApplicationMenu pointer to the circular-application-menu widget instance.
+ * @fileitem: The file-item whose icon is to be resolved.
  *
- * Returns: The newly created shown file-leaf.
- */
-CaFileLeaf*
-ca_circular_application_menu_show_leaf(
-    CaCircularApplicationMenu* circular_application_menu,
-	GMenuTreeDirectory* menutreedirectory,
-	LeafType leaftype,
-	CaFileItem* fileitem,
-	gboolean disassociated)
+ * Looks up and decodes the pixbuf of a file-item, unless any menu has already decoded it.  As the
+ * file-item has already been positioned an icon which cannot be found is replaced by a default
+ * rather than the file-item being removed.
+ **/
+static void
+_ca_circular_application_menu_resolve_fileitem(CaCircularApplicationMenu* circular_application_menu, CaFileItem* fileitem)
 {
-    /* TODO: make this private. */
-    CaCircularApplicationMenuPrivate* private;        
-    GMenuTreeDirectory* items;
-    GMenuTreeIter* tmp;
-    CaFileLeaf* fileleaf;
-    GList* current_list;
-    CaFileLeaf* parent_fileleaf;
-    gdouble angle;
+    CaCircularApplicationMenuPrivate* private;
+    CaMenuFileItem* menufileitem;
+    GtkIconInfo* icon_info;
+    gint64 timestamp;
 
     private = _ca_circular_application_menu_get_instance_private(circular_application_menu);
+    menufileitem = CA_MENU_FILEITEM(fileitem);
 
-    if (menutreedirectory == NULL)
-    {
-        return NULL;
-    }
-
-    if (fileitem != NULL)
-    {
-        parent_fileleaf = fileitem->_assigned_fileleaf;
-        angle = fileitem->_parent_angle;
-    }
-    else
-    {
-        /* Default values for the root fileleaf. */
+    g_assert(menufileitem->pixbuf == NULL);
 
-        g_assert(leaftype == ROOT_LEAF);
-        parent_fileleaf = NULL,
-        angle = 0.0;
-    }
+    /* The icon is shared with any other menu showing the same application. */
+    if ((menufileitem->pixbuf = ca_cache_lookup_icon(private->cache, menufileitem->icon, private->core.geometry.icon_width)) != NULL)
+        return;
 
-    /* Create a new fileleaf. */
-    fileleaf = g_new(CaFileLeaf, 1);
-    fileleaf->_type = leaftype;
-    fileleaf->_parent_fileleaf = parent_fileleaf;
-    fileleaf->_child_fileleaf = NULL;
-    fileleaf->_current_animation_state = INITIAL_OPEN;
-    fileleaf->_current_animation_tick = 0;
-    fileleaf->_fileitem_list = NULL;
-    fileleaf->_fileitem_list_count = 0;
-    fileleaf->_sub_fileleaves_list = NULL;
-    fileleaf->_menu_render = NULL;
+    timestamp = ca_profiler_timestamp();
+    icon_info = gtk_icon_theme_lookup_by_gicon(
+        gtk_icon_theme_get_default (),
+        menufileitem->icon,
+        private->core.geometry.normal_iconsize,
+        GTK_ICON_LOOKUP_USE_BUILTIN);
+    ca_profiler_accumulate("icon_lookup", timestamp);
 
-    /* Create the fileleafs central glyph. */
-    fileleaf->_central_glyph = g_new(CaFileItem, 1);
-    fileleaf->_central_glyph->_pixbuf = NULL;
-    fileleaf->_central_glyph->_associated_fileitem = disassociated ? NULL : fileitem;   /* Keep a reference to the associated fileitems. */
-    fileleaf->_central_glyph->_assigned_fileleaf = fileleaf;
-    fileleaf->_central_glyph->_parent_angle = 0;
-    fileleaf->_central_glyph->_circular_angle_share = 0.0;
-    fileleaf->_central_glyph->_parent_radius = 0;
-    fileleaf->_central_glyph->_segment_render = NULL;
+    timestamp = ca_profiler_timestamp();
 
-    if (disassociated)
+    if (NULL != icon_info)
     {
-        /* Disassociated fileleaf. */
-
-        fileleaf->_central_glyph->_type = GLYPH_FILE_MENU_CENTRE;
+        /* Retrieve a pixbuf associated with the given name. */
+        menufileitem->pixbuf = _ca_circular_applications_menu_get_pixbuf_from_name(
+            icon_info,
+            private->core.geometry.icon_width,
+            private->core.geometry.icon_height);
     }
-    else if (parent_fileleaf != NULL)
-    {
-        /* Sub fileleaf. */
 
-        parent_fileleaf->_child_fileleaf = fileleaf;
-
-        fileleaf->_central_glyph->_type = GLYPH_FILE_MENU_CENTRE;
-        fileleaf->_central_glyph->_parent_angle = _ca_circular_application_menu_calculate_angle_offset(angle, 180.0);
-    }
-    else
+    if (NULL == menufileitem->pixbuf)
     {
-        /* Root fileleaf. */
-
-        fileleaf->_central_glyph->_type = GLYPH_ROOT_CENTRE;
+        menufileitem->pixbuf = gtk_icon_theme_load_icon (
+            gtk_icon_theme_get_default (),
+            "application-x-executable",
+            private->core.geometry.icon_width,
+            GTK_ICON_LOOKUP_NO_SVG,
+            NULL);
     }
 
-    current_list = NULL;
+    ca_cache_insert_icon(private->cache, menufileitem->icon, private->core.geometry.icon_width, menufileitem->pixbuf);
 
-    /* Iterate all files. */
-    
-    //items = gmenu_tree_directory_get_parent(menutreedirectory);
+    ca_profiler_accumulate("icon_decode", timestamp);
+}
 
-    tmp = gmenu_tree_directory_iter (menutreedirectory);
-    GMenuTreeItemType itemtype;
+/**
+ * _ca_circular_application_menu_on_resolve_tick:
+ * @widget: a GtkWidget pointer to the current widget.
+ * @frame_clock: The frame clock of the widget.
+ * @data: Unused.
+ *
+ * Generated 'tick' caused once per frame whilst there are file-items with unresolved icons.  The
+ * icons are resolved within a per frame budget and the widget is invalidated once per frame.
+ *
+ * Returns: G_SOURCE_CONTINUE whilst there are unresolved icons; otherwise G_SOURCE_REMOVE.
+ **/
+static gboolean
+_ca_circular_application_menu_on_resolve_tick(GtkWidget* widget, GdkFrameClock* frame_clock, gpointer data)
+{
+    CaCircularApplicationMenu* circular_application_menu;
+    CaCircularApplicationMenuPrivate* private;
+    gint64 deadline;
 
-    /* Iterate all files in the source directory. */
-    while ((itemtype = gmenu_tree_iter_next(tmp)) != GMENU_TREE_ITEM_INVALID)
-    {
-        gpointer resolved_item;
+    circular_application_menu = CA_CIRCULAR_APPLICATION_MENU(widget);
+    private = _ca_circular_application_menu_get_instance_private(circular_application_menu);
 
-        /* Ignore unsupported types. */
-        if ((itemtype == GMENU_TREE_ITEM_INVALID) ||
-            (itemtype == GMENU_TREE_ITEM_SEPARATOR) ||
-            (itemtype == GMENU_TREE_ITEM_HEADER))
-        {
-            continue;
-        }
+    deadline = g_get_monotonic_time() + ICON_RESOLVE_BUDGET;
 
-        resolved_item = NULL;
+    while ((private->unresolved_fileleaves != NULL) &&
+           (g_get_monotonic_time() < deadline))
+    {
+        CaFileLeaf* fileleaf;
+        CaFileItem* fileitem;
 
-        // if (itemtype == GMENU_TREE_ITEM_ALIAS)
-        // {
-        //     resolved_item = gmenu_tree_iter_get_alias (tmp);
-        //     itemtype = gmenu_tree_alias_get_aliased_item_type (resolved_item);
-        // }
+        fileleaf = (CaFileLeaf*)private->unresolved_fileleaves->data;
+        g_assert(fileleaf->_unresolved_fileitem_list != NULL);
 
-        if (itemtype == GMENU_TREE_ITEM_ALIAS)
-        {
-            resolved_item = gmenu_tree_iter_get_alias (tmp);
-            //itemtype = gmenu_tree_alias_get_aliased_item_type (resolved_item);            
-        }
-        else if (itemtype == GMENU_TREE_ITEM_ENTRY)
-        {
-            resolved_item = gmenu_tree_iter_get_entry (tmp);
-            //itemtype = gmenu_tree_alias_get_aliased_entry (resolved_item);            
-        }
-        else if (itemtype == GMENU_TREE_ITEM_DIRECTORY)
-        {
-            resolved_item = gmenu_tree_iter_get_directory (tmp);
-            //itemtype = gmenu_tree_alias_get_aliased_directory (resolved_item);            
-        }
+        fileitem = (CaFileItem*)fileleaf->_unresolved_fileitem_list->data;
+        g_assert(fileitem != NULL);
 
-        if (NULL != resolved_item)
-        {
-            CaFileItem* current_fileitem;
-            GIcon* icon;
-
-            /* Create a new fileitem. */
-            current_fileitem = g_new(CaFileItem, 1);
-            current_fileitem->_type = (itemtype == GMENU_TREE_ITEM_DIRECTORY) ? GLYPH_FILE_MENU : GLYPH_FILE;
-            current_fileitem->_menutreeitem = resolved_item;
-			icon = (current_fileitem->_menutreeitem != NULL) ?
-				gmenu_tree_directory_get_icon(current_fileitem->_menutreeitem) :
-				NULL;
-
-            if (NULL != icon)
-            {
-                GtkIconInfo* icon_info;
-                
-                icon_info = gtk_icon_theme_lookup_by_gicon(
-                    gtk_icon_theme_get_default (),
-                    icon,
-                    private->normal_iconsize,
-                    GTK_ICON_LOOKUP_USE_BUILTIN);
+        _ca_circular_application_menu_resolve_fileitem(circular_application_menu, fileitem);
 
-                if (NULL == icon_info)
-                {
-                    /* Ignore the item if their is no available icon_info.*/
-                    continue;
-                }                
-
-                /* Retrieve a pixbuf associated with the given name. */
-                current_fileitem->_pixbuf = _ca_circular_applications_menu_get_pixbuf_from_name(
-                    icon_info,
-                    private->icon_width,
-                    private->icon_height);
-                g_assert(current_fileitem->_pixbuf != NULL);
-
-                current_fileitem->_assigned_fileleaf = fileleaf;
-                current_fileitem->_parent_angle = 0;
-                current_fileitem->_circular_angle_share = 0.0;
-                current_fileitem->_parent_radius = 0;
-                current_fileitem->_associated_fileitem = NULL;
-                current_fileitem->_segment_render = NULL;
-
-                current_list = g_list_prepend(current_list, (gpointer)current_fileitem);
-                fileleaf->_fileitem_list_count++;
-
-                if (fileleaf->_fileitem_list == NULL)
-                {
-                    fileleaf->_fileitem_list = current_list;
-                }
+        fileleaf->_unresolved_fileitem_list = g_list_next(fileleaf->_unresolved_fileitem_list);
 
-                //g_object_unref(icon_info);
-            }
-            
-            //gmenu_tree_item_unref (resolved_item);
+        if (fileleaf->_unresolved_fileitem_list == NULL)
+        {
+            /* All the file-leaf icons have been resolved. */
+            private->unresolved_fileleaves = g_list_delete_link(private->unresolved_fileleaves, private->unresolved_fileleaves);
         }
     }
 
-    gmenu_tree_iter_unref (tmp);
+    /* Invalidate the widget. */
+    _ca_circular_application_menu_invalidate(circular_application_menu);
 
-    /* Keep the refefence to the root fileleaf. */
-    if (g_root_fileleaf == NULL)
+    if (private->unresolved_fileleaves == NULL)
     {
-        g_root_fileleaf = fileleaf;
-        g_last_opened_fileleaf = fileleaf;
-        g_tabbed_fileleaf = fileleaf;
-    }
-
-    {
-        gdouble radius;
+        ca_profiler_mark("icons_resolved", 0);
 
-        radius = _ca_circular_application_menu_calculate_radius(circular_application_menu, fileleaf);
+        private->resolve_tick_id = 0;
 
-		/* Position a file-leaf and all child segments. */
-        _ca_circular_application_menu_position_fileleaf_files(circular_application_menu, fileleaf, radius, angle);
+        return G_SOURCE_REMOVE;
     }
 
-    return fileleaf;
+    return G_SOURCE_CONTINUE;
 }
 
 /**
- * ca_circular_application_menu_close_fileleaf:
- * @fileleaf: The file-leaf to close.
+ * _ca_circular_application_menu_open_fileitem:
+ * @circular_application_menu: A CaCircularApplicationMenu pointer to the circular-application-menu widget instance.
+ * @fileitem: The GLYPH_FILE_MENU file-item to open.
  *
- * Closes a file-leaf.
- */
-void
-ca_circular_application_menu_close_fileleaf(CaFileLeaf* fileleaf)
+ * Starts building the file-leaf of a file-item on a worker thread; it is shown once it is ready.
+ * Any file-leaf already being built is abandoned.
+ **/
+static void
+_ca_circular_application_menu_open_fileitem(CaCircularApplicationMenu* circular_application_menu, CaFileItem* fileitem)
 {
-    /* Clear the refefence to the root fileleaf. */
-    if (g_root_fileleaf == fileleaf)
-    {
-        g_root_fileleaf = NULL;
-        g_last_opened_fileleaf = NULL;
-        g_tabbed_fileleaf = NULL;
-    }
+    CaCircularApplicationMenuPrivate* private;
 
-    /* Check whether their are child fileleafs open. */
-    if (fileleaf->_child_fileleaf != NULL)
-    {
-        ca_circular_application_menu_close_fileleaf(fileleaf->_child_fileleaf);
-    }
+    private = _ca_circular_application_menu_get_instance_private(circular_application_menu);
 
-    g_free((gpointer)fileleaf->_central_glyph);
+    g_assert(fileitem->_type == GLYPH_FILE_MENU);
 
-    if (fileleaf->_fileitem_list != NULL)
-    {
-        GList* list;
+    _ca_circular_application_menu_cancel_open(circular_application_menu);
 
-        /* Iterate the fileitems. */
-        list = g_list_last(fileleaf->_fileitem_list);
+    private->open_cancellable = g_cancellable_new();
+    private->opening_fileitem = fileitem;
 
-        while (list)
-        {
-            CaFileItem* fileitem;
+    _ca_circular_application_menu_build_fileleaf(
+        circular_application_menu,
+        fileitem,
+        JOB_VISIBLE,
+        private->open_cancellable,
+        _ca_circular_application_menu_on_fileleaf_built);
+}
 
-            fileitem = (CaFileItem*)list->data;
-            g_assert(fileitem != NULL);
-            gmenu_tree_item_unref (fileitem->_menutreeitem);
-            fileitem->_menutreeitem = NULL;
-            g_free((gpointer)fileitem->_segment_render);
-            g_object_unref(fileitem->_pixbuf);
-            g_free((gpointer)fileitem);
+/**
+ * _ca_circular_application_menu_cancel_open:
+ * @circular_application_menu: A CaCircularApplicationMenu pointer to the circular-application-menu widget instance.
+ *
+ * Abandons the file-leaf being built, if any, along with any pending preview.
+ **/
+static void
+_ca_circular_application_menu_cancel_open(CaCircularApplicationMenu* circular_application_menu)
+{
+    CaCircularApplicationMenuPrivate* private;
 
-            list = g_list_previous(list);
-        }
+    private = _ca_circular_application_menu_get_instance_private(circular_application_menu);
 
-        g_list_free(fileleaf->_fileitem_list);
-        fileleaf->_fileitem_list = NULL;
-    }
+    _ca_circular_application_menu_cancel_preview(circular_application_menu);
 
-    /* Check whether this is a disassociated fileleaf. */
-    if (fileleaf != g_disassociated_fileleaf)
+    if (private->open_cancellable != NULL)
     {
-        if (fileleaf->_parent_fileleaf != NULL)
-        {
-            g_assert(fileleaf->_parent_fileleaf->_child_fileleaf == fileleaf);
-            fileleaf->_parent_fileleaf->_child_fileleaf = NULL;
-            fileleaf->_parent_fileleaf = NULL;
-        }
+        g_cancellable_cancel(private->open_cancellable);
+        g_object_unref(private->open_cancellable);
+        private->open_cancellable = NULL;
     }
 
-    g_free((gpointer)fileleaf->_menu_render);
-    g_free((gpointer)fileleaf);
+    private->opening_fileitem = NULL;
 }
 
 /**
- * _ca_circular_application_menu_view_centre_fileleaf:
+ * _ca_circular_application_menu_build_fileleaf:
  * @circular_application_menu: A CaCircularApplicationMenu pointer to the circular-application-menu widget instance.
- * @fileleaf: A file-leaf to centre.
- * @x: The X co-ordinate around which to centre the file-leaf.
- * @y: The Y co-ordinate around which to centre the file-leaf.
+ * @fileitem: The GLYPH_FILE_MENU file-item to build the file-leaf of.
+ * @job_class: The priority class of the build.
+ * @cancellable: The GCancellable which abandons the build.
+ * @done_func: Called on the main thread with the file-leaf.
  *
- * Centres the view around the given file-leaf.
- */
+ * Submits a file-leaf to be built by a worker of the scheduler.
+ **/
 static void
-_ca_circular_application_menu_view_centre_fileleaf(
+_ca_circular_application_menu_build_fileleaf(
 	CaCircularApplicationMenu* circular_application_menu,
-	CaFileLeaf* fileleaf,
-	gint x,
-	gint y)
+	CaFileItem* fileitem,
+	JobClass job_class,
+	GCancellable* cancellable,
+	CaJobDoneFunc done_func)
 {
     CaCircularApplicationMenuPrivate* private;
+    BuildFileLeaf* build;
 
     private = _ca_circular_application_menu_get_instance_private(circular_application_menu);
 
-    /* Update the view offset. */
-    private->view_x_offset = ((x == -1) ? fileleaf->x : x) - (private->view_width / 2);
-    private->view_y_offset = ((y == -1) ? fileleaf->y : y) - (private->view_height / 2);
+    build = g_new(BuildFileLeaf, 1);
+    build->circular_application_menu = g_object_ref(circular_application_menu);
+    build->menutreedirectory = (GMenuTreeDirectory*)gmenu_tree_item_ref(CA_MENU_FILEITEM(fileitem)->menutreeitem);
+    build->page_size = private->page_size;
+
+    ca_scheduler_submit(
+        private->scheduler,
+        job_class,
+        cancellable,
+        _ca_circular_application_menu_build_fileleaf_job,
+        done_func,
+        (gpointer)build,
+        _ca_circular_application_menu_build_fileleaf_free);
 }
 
 /**
- * _ca_circular_application_menu_angle_between_points:
- * @x1: The first X co-ordinate.
- * @y1: The first Y co-ordinate.
- * @x2: The second X co-ordinate.
- * @y2: The second Y  co-ordinate.
+ * _ca_circular_application_menu_build_fileleaf_job:
+ * @data: The BuildFileLeaf to build.
+ * @cancellable: The GCancellable of the build.
  *
- * Retrieves the calculated angle between two xy positions.
+ * Creates the file-leaf of a menu tree directory on a worker thread.
  *
- * Returns: The angle between the two positions.
- */
-static gdouble
-_ca_circular_application_menu_angle_between_points(gdouble x1, gdouble y1, gdouble x2, gdouble y2)
+ * Returns: The newly created file-leaf, which is incomplete if @cancellable was cancelled.
+ **/
+static gpointer
+_ca_circular_application_menu_build_fileleaf_job(gpointer data, GCancellable* cancellable)
 {
-    gdouble radians;
-    gdouble degrees;
+    BuildFileLeaf* build;
 
-    radians = atan2((y2 - y1), (x2 - x1));
+    build = (BuildFileLeaf*)data;
 
-    degrees = RADIAN_2_DEGREE(radians);
+    return (gpointer)ca_menu_fileleaf_new(build->menutreedirectory, FILE_LEAF, build->page_size, cancellable);
+}
 
-    /* For an angle of 270 atan2 give -90. */
-    if (degrees < 0.0)
-    {
-        degrees = _ca_circular_application_menu_calculate_angle_offset(0.0, degrees);
-    }
+/**
+ * _ca_circular_application_menu_build_fileleaf_free:
+ * @data: The BuildFileLeaf to free.
+ *
+ * Frees a build once it has been delivered.
+ **/
+static void
+_ca_circular_application_menu_build_fileleaf_free(gpointer data)
+{
+    BuildFileLeaf* build;
+
+    build = (BuildFileLeaf*)data;
 
-    return degrees;
+    gmenu_tree_item_unref(build->menutreedirectory);
+    g_object_unref(build->circular_application_menu);
+    g_free((gpointer)build);
 }
 
 /**
- * _ca_circular_application_menu_is_angle_between_angles:
- * @angle: The angle to check.
- * @angle_lower: The lowest angle.
- * @angle_higher: The highest angle.
+ * _ca_circular_application_menu_on_fileleaf_built:
+ * @result: The file-leaf which has been built; otherwise NULL.
+ * @cancelled: Whether the build was abandoned.
+ * @data: The BuildFileLeaf.
  *
- * Retrieves whether an angle is between two other angles.
- *
- * Returns: TRUE if the angle is between the two angles; otherwise FALSE.
- */
-static gboolean
-_ca_circular_application_menu_is_angle_between_angles(gdouble angle, gdouble angle_lower, gdouble angle_higher)
+ * Generated 'done' caused when a file-leaf has been built; the file-leaf is attached to the
+ * file-item it was opened from, the view is centred around it and it is animated open.
+ **/
+static void
+_ca_circular_application_menu_on_fileleaf_built(gpointer result, gboolean cancelled, gpointer data)
 {
-    gboolean between_angles = FALSE;
+    CaCircularApplicationMenu* circular_application_menu;
+    CaCircularApplicationMenuPrivate* private;
+    CaFileLeaf* sub_fileleaf;
+    GdkDevice* device;
+    gint x;
+    gint y;
+
+    sub_fileleaf = (CaFileLeaf*)result;
 
-    if (angle_higher < angle_lower)
+    if (cancelled)
     {
-        /* Spans 360 boundary. */
-        if ((angle >= angle_lower) || (angle <= angle_higher))
+        if (sub_fileleaf != NULL)
         {
-            between_angles = TRUE;
+            ca_fileleaf_free(sub_fileleaf);
         }
+
+        return;
     }
-    else
+
+    circular_application_menu = ((BuildFileLeaf*)data)->circular_application_menu;
+    private = _ca_circular_application_menu_get_instance_private(circular_application_menu);
+
+    g_assert(private->opening_fileitem != NULL);
+
+    _ca_circular_application_menu_attach_fileleaf(circular_application_menu, sub_fileleaf, private->opening_fileitem, FALSE);
+
+    g_object_unref(private->open_cancellable);
+    private->open_cancellable = NULL;
+    private->opening_fileitem = NULL;
+
+    /* Grow the file-leaf out of its parent segment; on a remote display it is shown at once. */
+    if (FALSE == private->remote)
     {
-        if ((angle >= angle_lower) && (angle <= angle_higher))
-        {
-            between_angles = TRUE;
-        }
+        sub_fileleaf->_current_animation_state = INITIAL_OPEN;
+        sub_fileleaf->_current_animation_tick = 0;
     }
 
-    return between_angles;
+    /* Centre the view around the file-leaf, which becomes the last opened and tabbed file-leaf. */
+    ca_core_open_fileleaf(&private->core, sub_fileleaf);
+
+    /* Update to reflect the new view position. */
+    device = gdk_seat_get_pointer(gdk_display_get_default_seat(gtk_widget_get_display(GTK_WIDGET(circular_application_menu))));
+
+    gdk_window_get_device_position(
+        gtk_widget_get_window(GTK_WIDGET(circular_application_menu)),
+        device,
+        &x,
+        &y,
+        NULL);
+
+    /* Retrieve the glyph-type, file-leaf and file-item at the current mouse co-ordinate. */
+    ca_core_update_current(&private->core, x + private->canvas.x, y + private->canvas.y);
+
+    /* Invalidate the widget. */
+    _ca_circular_application_menu_invalidate(circular_application_menu);
+
+    /* Move the mouse pointer to the centre of the screen. */
+    if (FALSE == private->xwarp_mouse_pointer)
+    {
+        /* Move the pointer to the centre of the screen. */
+        _ca_circular_application_menu_device_warp(circular_application_menu);
+    }
 }
 
 /**
- * _ca_circular_application_menu_calculate_angle_offset:
- * @angle: The current angle.
- * @offset: The amount to offset the angle by.
+ * _ca_circular_application_menu_schedule_preview:
+ * @circular_application_menu: A CaCircularApplicationMenu pointer to the circular-application-menu widget instance.
+ * @fileitem: The hovered GLYPH_FILE_MENU file-item.
  *
- * Offsets an angle by the given amount.
+ * Schedules the preview of a hovered file-item; nothing is built unless the pointer dwells on it.
+ **/
+static void
+_ca_circular_application_menu_schedule_preview(CaCircularApplicationMenu* circular_application_menu, CaFileItem* fileitem)
+{
+    CaCircularApplicationMenuPrivate* private;
+
+    private = _ca_circular_application_menu_get_instance_private(circular_application_menu);
+
+    g_assert(fileitem->_type == GLYPH_FILE_MENU);
+
+    _ca_circular_application_menu_cancel_preview(circular_application_menu);
+
+    private->preview_fileitem = fileitem;
+    private->preview_timeout_id = g_timeout_add(
+        PREVIEW_DWELL_INTERVAL,
+        _ca_circular_application_menu_on_preview_dwell,
+        (gpointer)circular_application_menu);
+}
+
+/**
+ * _ca_circular_application_menu_cancel_preview:
+ * @circular_application_menu: A CaCircularApplicationMenu pointer to the circular-application-menu widget instance.
  *
- * Returns: The offsetted angle.
- */
-static gdouble
-_ca_circular_application_menu_calculate_angle_offset(gdouble angle, gdouble offset)
+ * Abandons a scheduled, building or unconfirmed preview.  A preview which has already been shown
+ * is left for the caller to close.
+ **/
+static void
+_ca_circular_application_menu_cancel_preview(CaCircularApplicationMenu* circular_application_menu)
 {
-    angle += offset;
+    CaCircularApplicationMenuPrivate* private;
+
+    private = _ca_circular_application_menu_get_instance_private(circular_application_menu);
 
-    if (angle > 259)
+    if (private->preview_timeout_id != 0)
     {
-        angle -= 360;
+        g_source_remove(private->preview_timeout_id);
+        private->preview_timeout_id = 0;
     }
 
-    if (angle < 0)
+    if (private->preview_cancellable != NULL)
     {
-        angle = 360 + angle;
+        g_cancellable_cancel(private->preview_cancellable);
+        g_object_unref(private->preview_cancellable);
+        private->preview_cancellable = NULL;
     }
 
-    return angle;
+    private->preview_fileitem = NULL;
 }
 
 /**
- * _ca_circular_applications_menu_imagefinder_path:
- * @path: The path to check for an image.
+ * _ca_circular_application_menu_on_preview_dwell:
+ * @data: a GtkObject pointer to the current widget.
  *
- * Retrieves an images path if it exists at the given location.
+ * Generated 'timeout' caused when the pointer has dwelled on a GLYPH_FILE_MENU file-item; the
+ * preview file-leaf is built on a worker thread.
  *
- * Returns: The path to the found image; otherwise NULL.
- */
-static const gchar*
-_ca_circular_applications_menu_imagefinder_path(const gchar* path)
+ * Returns: FALSE so the timeout is removed.
+ **/
+static gboolean
+_ca_circular_application_menu_on_preview_dwell(gpointer data)
 {
-    gchar* temp;
-    FILE* fp;
-
-    fp = fopen(path, "r");
-
-    if (fp)
-    {
-        fclose(fp);
-
-        return path;
-    }
-    else
-    {
-        gint i = 0;
+    CaCircularApplicationMenu* circular_application_menu;
+    CaCircularApplicationMenuPrivate* private;
 
-        while (TRUE)
-        {
-            if (image_paths[i] != NULL)
-            {
-                temp = g_strdup_printf("%s/%s", image_paths[i], path);
+    circular_application_menu = CA_CIRCULAR_APPLICATION_MENU(data);
+    private = _ca_circular_application_menu_get_instance_private(circular_application_menu);
 
-                fp = fopen(temp, "r");
+    g_assert(private->preview_fileitem != NULL);
 
-                if (fp)
-                {
-                    fclose(fp);
+    private->preview_timeout_id = 0;
+    private->preview_cancellable = g_cancellable_new();
 
-                    return temp;
-                }
-            }
-            else
-            {
-                return NULL;
-            }
+    _ca_circular_application_menu_build_fileleaf(
+        circular_application_menu,
+        private->preview_fileitem,
+        JOB_PREVIEW,
+        private->preview_cancellable,
+        _ca_circular_application_menu_on_preview_built);
 
-            i++;
-        }
-    }
+    return FALSE;
 }
 
 /**
- * _ca_circular_applications_menu_get_pixbuf_from_name:
- * @icon_info: The GtkIconInfo to use when retrieving the pixbuf.
- * @width: The desired width of the retrieved pixbuf.
- * @height: The desired height of the retrieved pixbuf.
- *
- * Retrieves a pixbuf associated with the given icon filename.
+ * _ca_circular_application_menu_on_preview_built:
+ * @result: The file-leaf which has been built; otherwise NULL.
+ * @cancelled: Whether the build was abandoned.
+ * @data: The BuildFileLeaf.
  *
- * Returns: The newly created pixbuf; otherwise NULL.
- */
-static GdkPixbuf*
-_ca_circular_applications_menu_get_pixbuf_from_name(GtkIconInfo* icon_info, gint width, gint height)
+ * Generated 'done' caused when a preview file-leaf has been built; it is shown as a silhouette
+ * of its rings and segments until the hover has been confirmed.
+ **/
+static void
+_ca_circular_application_menu_on_preview_built(gpointer result, gboolean cancelled, gpointer data)
 {
-    GdkPixbuf* icon;
-
-    icon = NULL;
+    CaCircularApplicationMenu* circular_application_menu;
+    CaCircularApplicationMenuPrivate* private;
+    CaFileLeaf* fileleaf;
 
-    const gchar* icon_filename = gtk_icon_info_get_filename(icon_info);
+    fileleaf = (CaFileLeaf*)result;
 
-    //g_info("Processing %d %d %s\n", width, height, icon_filename);
-        
-    if (icon_filename != NULL)
+    if (cancelled)
     {
-        GtkIconTheme* theme;
-
-        theme = gtk_icon_theme_get_default ();
-
-        if (icon_info != NULL)
+        if (fileleaf != NULL)
         {
-            icon = gdk_pixbuf_new_from_file_at_size(
-			    gtk_icon_info_get_filename (icon_info),
-			    width,
-			    -1,
-			    NULL);
-
-            g_object_unref(icon_info);
+            ca_fileleaf_free(fileleaf);
         }
 
-        /* first we try gtkicontheme */
-        if (icon == NULL)
-        {
-            icon = gtk_icon_theme_load_icon(
-			    theme,
-			    icon_filename,
-			    width,
-			    GTK_ICON_LOOKUP_FORCE_SVG,
-			    NULL);
-        }
+        return;
+    }
 
-        if (icon == NULL)
-        {
-            /* Check all known paths. */
-            const gchar* found_path;
+    circular_application_menu = ((BuildFileLeaf*)data)->circular_application_menu;
+    private = _ca_circular_application_menu_get_instance_private(circular_application_menu);
 
-		    /* Retrieve an images path if it exists at the given location. */
-            found_path = _ca_circular_applications_menu_imagefinder_path(icon_filename);
+    g_assert(private->preview_fileitem != NULL);
+    g_assert(private->core.disassociated_fileleaf == NULL);
 
-            if (NULL != found_path)
-            {
-                icon = gdk_pixbuf_new_from_file_at_scale(found_path, width, height, TRUE, NULL);
+    g_object_unref(private->preview_cancellable);
+    private->preview_cancellable = NULL;
 
-                g_free((gpointer)found_path);
-            }
-        }
-    }
+    /* Show the disassociated fileleaf. */
+    _ca_circular_application_menu_attach_fileleaf(circular_application_menu, fileleaf, private->preview_fileitem, TRUE);
 
-    if (icon == NULL)
-    {
-        g_print("D\n");
-        /*
-        No icon was found so use a default.
-        GTK+3 has moved over to the freedesktop.org Icon Naming Specification and internationalised labels. 
-        https://specifications.freedesktop.org/icon-naming-spec/icon-naming-spec-latest.html
-        */
-        icon = gtk_icon_theme_load_icon (
-            gtk_icon_theme_get_default (),
-            "application-x-executable",
-            width,
-            GTK_ICON_LOOKUP_NO_SVG,
-            NULL);
-    }
+    /* Resolve the icons if the pointer stays. */
+    private->preview_timeout_id = g_timeout_add(
+        PREVIEW_CONFIRM_INTERVAL,
+        _ca_circular_application_menu_on_preview_confirmed,
+        (gpointer)circular_application_menu);
 
-    return icon;
+    /* Invalidate the widget. */
+    _ca_circular_application_menu_invalidate(circular_application_menu);
 }
 
 /**
- * _ca_circular_application_menu_on_fade_tick:
+ * _ca_circular_application_menu_on_preview_confirmed:
  * @data: a GtkObject pointer to the current widget.
  *
- * Generated 'timeout' caused by a periodic interval occurring.
+ * Generated 'timeout' caused when the pointer has remained on a previewed file-item; the icons of
+ * the preview are resolved.
  *
- * Returns: TRUE if the event is handled.
+ * Returns: FALSE so the timeout is removed.
  **/
-static gint
-_ca_circular_application_menu_on_fade_tick(gpointer data)
+static gboolean
+_ca_circular_application_menu_on_preview_confirmed(gpointer data)
 {
     CaCircularApplicationMenu* circular_application_menu;
-
-    g_return_val_if_fail(GTK_WIDGET(data) != NULL, FALSE);
-    g_return_val_if_fail(CA_IS_CIRCULAR_APPLICATION_MENU(data), FALSE);
+    CaCircularApplicationMenuPrivate* private;
 
     circular_application_menu = CA_CIRCULAR_APPLICATION_MENU(data);
+    private = _ca_circular_application_menu_get_instance_private(circular_application_menu);
 
-    return TRUE;
-}
+    g_assert(private->core.disassociated_fileleaf != NULL);
 
-/**
- * _ca_circular_application_menu_on_fade_tick:
- * @circular_application_menu: A CaCircularApplicationMenu pointer to the circular-application-menu widget instance.
- *
- * Move the pointer to the centre of the screen.
- **/
-static void 
-_ca_circular_application_menu_device_warp(CaCircularApplicationMenu* circular_application_menu)
-{
-    CaCircularApplicationMenuPrivate* private;
-    GdkDisplay* display;
-    GdkDevice* device;
-
-    private = _ca_circular_application_menu_get_instance_private(circular_application_menu);    
+    private->preview_timeout_id = 0;
+    private->preview_fileitem = NULL;
 
-    //display = gdk_display_get_default();
-    display = gtk_widget_get_display (GTK_WIDGET (circular_application_menu));
-    device = gdk_seat_get_pointer(gdk_display_get_default_seat(display));
+    _ca_circular_application_menu_resolve_fileleaf(circular_application_menu, private->core.disassociated_fileleaf);
 
-    gdk_device_warp (
-        device,
-        gtk_widget_get_screen (GTK_WIDGET (circular_application_menu)),
-        private->view_width / 2,
-        private->view_height / 2);
+    return FALSE;
 }
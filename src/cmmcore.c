@@ -0,0 +1,718 @@
+/* circular-main-menu
+ * Copyright (C) 2008 - Cole Anstey
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ * See http://code.google.com/p/circular-application-menu/
+ *
+ * The hit testing and navigation of the open file-leaves.  The widget feeds the pointer and keys
+ * in and paints what is left here; none of these functions allocate, other than paging, which
+ * creates the file-items of another page, and the file-leaves which are closed are freed.  The
+ * menus shown are only held as the opaque handles of their source; see: CaFileLeafSource.
+ */
+#include <string.h>
+
+#include "cmmcore.h"
+
+static GlyphType _ca_core_hittest_fileleaf(const CaCore* core, CaFileLeaf* fileleaf, gint x, gint y, CaFileLeaf** found_fileleaf, CaFileItem** found_fileitem);
+
+/**
+ * ca_core_init:
+ * @core: The core to initialise.
+ *
+ * Initialises a core without any file-leaves.  The geometry and the view size are assigned by
+ * the caller.
+ **/
+void
+ca_core_init(CaCore* core)
+{
+    memset(core, 0, sizeof(CaCore));
+
+    core->current_type = GLYPH_UNKNOWN;
+    core->view_animation_tick = 100;
+}
+
+/**
+ * ca_core_hittest:
+ * @core: The core to test.
+ * @x: An Integer X co-ordinate to test; see: SCREEN_2_OFFSET.
+ * @y: An Integer Y co-ordinate to test; see: SCREEN_2_OFFSET.
+ * @found_fileleaf: A found file-leaf; otherwise NULL.
+ * @found_fileitem: A found file-item; otherwise NULL.
+ *
+ * Retrieves the glyph-type, file-leaf and file-item at the specified co-ordinate.
+ *
+ * Returns: The found GlyphType.
+ */
+GlyphType
+ca_core_hittest(
+	const CaCore* core,
+	gint x,
+	gint y,
+	CaFileLeaf** found_fileleaf,
+	CaFileItem** found_fileitem)
+{
+    *found_fileleaf = NULL;
+    *found_fileitem = NULL;
+
+    if (NULL != core->root_fileleaf)
+    {
+        /* Render all fileleafs. */
+        CaFileLeaf* current_fileleaf;
+        GlyphType hit_type;
+
+        /* There should always at least one fileleaf. */
+        g_assert(NULL != core->last_opened_fileleaf);
+
+        /* Walk from the last opened fileleaf to the root fileleaf so overlapped */
+        /* fileitems take precedence. */
+        current_fileleaf = core->last_opened_fileleaf;
+        /* Iterate the fileleafs. */
+        do
+        {
+            gboolean allow_hitest;
+            GList* sub_list;
+
+            allow_hitest = TRUE;
+
+            if (core->tabbed_only)
+            {
+                if (current_fileleaf != core->tabbed_fileleaf)
+                {
+                    allow_hitest = FALSE;
+                }
+            }
+
+            /* Check whether the fileleaf allows a hittest. */
+            if (allow_hitest)
+            {
+                /* Retrieve the glyph-type, file-leaf and file-item at the specified mouse co-ordinate; for a given parent file-leaf. */
+                hit_type = _ca_core_hittest_fileleaf(
+				    core,
+				    current_fileleaf,
+				    x,
+				    y,
+				    found_fileleaf,
+				    found_fileitem);
+
+                if (GLYPH_UNKNOWN != hit_type)
+                    return hit_type;    /* Found. */
+            }
+
+            /* Iterate the sub fileleafs. */
+            sub_list = g_list_first(current_fileleaf->_sub_fileleaves_list);
+
+            while (sub_list)
+            {
+                CaFileLeaf* sub_fileleaf;
+
+                sub_fileleaf = (CaFileLeaf*)sub_list->data;
+                g_assert(sub_fileleaf != NULL);
+
+                allow_hitest = TRUE;
+
+                if (core->tabbed_only)
+                {
+                    if (sub_fileleaf != core->tabbed_fileleaf)
+                    {
+                        allow_hitest = FALSE;
+                    }
+                }
+
+                /* Check whether the fileleaf allows a hittest. */
+                if (allow_hitest)
+                {
+                    /* Retrieve the glyph-type, file-leaf and file-item at the specified mouse co-ordinate; for a given parent file-leaf. */
+                    hit_type = _ca_core_hittest_fileleaf(
+					    core,
+					    sub_fileleaf,
+					    x,
+					    y,
+					    found_fileleaf,
+					    found_fileitem);
+
+                    if (GLYPH_UNKNOWN != hit_type)
+                        return hit_type;    /* Found. */
+                }
+
+                sub_list = g_list_next(sub_list);
+            }
+
+            /* Get next child fileleaf. */
+            current_fileleaf = current_fileleaf->_parent_fileleaf;
+        }
+        while (current_fileleaf != NULL);
+    }
+
+    return GLYPH_UNKNOWN;   /* Not found. */
+}
+
+/**
+ * _ca_core_hittest_fileleaf:
+ * @core: The core to test.
+ * @fileleaf: The file-leaf to test.
+ * @x: An Integer X co-ordinate to test.
+ * @y: An Integer Y co-ordinate to test.
+ * @found_fileleaf: A found file-leaf; otherwise NULL.
+ * @found_fileitem: A found file-item; otherwise NULL.
+ *
+ * Retrieves the glyph-type, file-leaf and file-item at the specified co-ordinate; for a given parent file-leaf.
+ * Only the file-items on the rings whose annulus contains the co-ordinate are tested.
+ *
+ * Returns: The found GlyphType.
+ */
+static GlyphType
+_ca_core_hittest_fileleaf(const CaCore* core, CaFileLeaf* fileleaf, gint x, gint y, CaFileLeaf** found_fileleaf, CaFileItem** found_fileitem)
+{
+    CaFileItem* associated_fileitem;
+    gint tab_x;
+    gint tab_y;
+
+    /* Nothing of the file-leaf or its tab lies beyond the bounding circle. */
+    if (!ca_geometry_circle_contains_point(x, y, fileleaf->x, fileleaf->y, fileleaf->bound_radius))
+        return GLYPH_UNKNOWN;
+
+    if (NULL != fileleaf->_central_glyph->_associated_fileitem)
+    {
+        /* Check the fileleaf. */
+        if (ca_geometry_circle_contains_point(
+            x,
+            y,
+            fileleaf->_central_glyph->x,
+            fileleaf->_central_glyph->y,
+            fileleaf->radius + (gint)(RADIUS_SPACER + CLOSEST_TAB_CIRCLE_RADIUS + core->geometry.tab_height + FARTHEST_TAB_CIRCLE_RADIUS)))
+        {
+            /* Check the fileleaf tab. */
+            ca_geometry_point_from_source_offset(
+                fileleaf->_central_glyph->x,
+                fileleaf->_central_glyph->y,
+                fileleaf->_central_glyph->_parent_angle,
+                fileleaf->radius + ((RADIUS_SPACER + CLOSEST_TAB_CIRCLE_RADIUS + core->geometry.tab_height + FARTHEST_TAB_CIRCLE_RADIUS) / 2),
+                &tab_x,
+                &tab_y);
+
+            if (ca_geometry_circle_contains_point(
+				x,
+				y,
+				tab_x,
+				tab_y,
+				fileleaf->_central_glyph->_associated_fileitem->size))
+            {
+                *found_fileitem = fileleaf->_central_glyph->_associated_fileitem;
+
+                return GLYPH_TAB;   /* Found. */
+            }
+        }
+    }
+
+    /* Check the fileleaf. */
+    if (ca_geometry_circle_contains_point(x, y, fileleaf->x, fileleaf->y, fileleaf->radius))
+    {
+        gdouble distance;
+        gint ring;
+
+        *found_fileleaf = fileleaf;
+
+        /* Check the fileleaf central glyph. */
+        if (ca_geometry_circle_contains_point(
+			x,
+			y,
+			fileleaf->_central_glyph->x,
+			fileleaf->_central_glyph->y,
+			fileleaf->_central_glyph->size))
+        {
+            *found_fileitem = fileleaf->_central_glyph;
+
+            return (*found_fileitem)->_type;    /* Found. */
+        }
+
+        /* Retieve the fileleafs associated sub fileitem. */
+        if (fileleaf->_child_fileleaf != NULL)
+        {
+            associated_fileitem = fileleaf->_child_fileleaf->_central_glyph->_associated_fileitem;
+        }
+        else
+        {
+            associated_fileitem = NULL;
+        }
+
+        distance = ca_geometry_point_distance(fileleaf->x, fileleaf->y, x, y);
+
+        /* Iterate the rings which could contain the co-ordinate. */
+        for (ring = 0; ring < fileleaf->_ring_count; ring++)
+        {
+            const CaRingBounds* ring_bounds;
+            GList* file_list;
+            gint fileitem_count;
+
+            ring_bounds = &fileleaf->_ring_bounds[ring];
+
+            if ((distance < ring_bounds->inner_radius) || (distance > ring_bounds->outer_radius))
+                continue;
+
+            /* Iterate the ring fileitems. */
+            file_list = ring_bounds->fileitem_list;
+
+            for (fileitem_count = ring_bounds->fileitem_count; fileitem_count > 0; fileitem_count--)
+            {
+                CaFileItem* fileitem;
+
+                fileitem = (CaFileItem*)file_list->data;
+                g_assert(fileitem != NULL);
+
+                if (associated_fileitem != fileitem)	/* Do not render as it is a sub fileleaf. */
+                {
+                    /* Check the fileleaf fileitems. */
+                    if (ca_geometry_segment_contains_point(&core->geometry, x, y, fileitem))
+                    {
+                        *found_fileitem = fileitem;
+
+                        return (*found_fileitem)->_type;    /* Found. */
+                    }
+                }
+
+                file_list = g_list_next(file_list);
+            }
+        }
+    }
+
+    return GLYPH_UNKNOWN;   /* Not found. */
+}
+
+/**
+ * ca_core_update_current:
+ * @core: The core to update.
+ * @screen_x: The X co-ordinate of the pointer within the view.
+ * @screen_y: The Y co-ordinate of the pointer within the view.
+ *
+ * Updates the glyph-type, file-leaf and file-item under the pointer.
+ *
+ * Returns: TRUE if any of them have changed; otherwise FALSE.
+ **/
+gboolean
+ca_core_update_current(CaCore* core, gint screen_x, gint screen_y)
+{
+    CaFileLeaf* previous_fileleaf;
+    CaFileItem* previous_fileitem;
+    GlyphType previous_type;
+
+    previous_fileleaf = core->current_fileleaf;
+    previous_fileitem = core->current_fileitem;
+    previous_type = core->current_type;
+
+    /* Retrieve the glyph-type, file-leaf and file-item at the specified mouse co-ordinate. */
+    core->current_type = ca_core_hittest(
+        core,
+        SCREEN_2_OFFSET(screen_x, core->view_x_offset),
+        SCREEN_2_OFFSET(screen_y, core->view_y_offset),
+        &core->current_fileleaf,
+        &core->current_fileitem);
+
+    return ((core->current_fileleaf != previous_fileleaf) ||
+            (core->current_fileitem != previous_fileitem) ||
+            (core->current_type != previous_type));
+}
+
+/**
+ * ca_core_attach_fileleaf:
+ * @core: The core to attach to.
+ * @fileleaf: A file-leaf created by ca_fileleaf_new().
+ * @fileitem: The file-item to show; otherwise NULL for the root file-leaf.
+ * @disassociated: Specifies whether the file-item will be shown as a preview.
+ *
+ * Attaches a newly created file-leaf to the file-item it is shown from and positions it.  The first
+ * file-leaf attached becomes the root file-leaf and a disassociated file-leaf becomes the preview.
+ **/
+void
+ca_core_attach_fileleaf(CaCore* core, CaFileLeaf* fileleaf, CaFileItem* fileitem, gboolean disassociated)
+{
+    /* Keep the refefence to the root fileleaf. */
+    if (core->root_fileleaf == NULL)
+    {
+        core->root_fileleaf = fileleaf;
+        core->last_opened_fileleaf = fileleaf;
+        core->tabbed_fileleaf = fileleaf;
+    }
+
+    /* Position a file-leaf and all child segments. */
+    ca_fileleaf_attach(&core->geometry, fileleaf, fileitem, disassociated);
+
+    if (disassociated)
+    {
+        g_assert(core->disassociated_fileleaf == NULL);
+
+        core->disassociated_fileleaf = fileleaf;
+    }
+}
+
+/**
+ * ca_core_open_fileleaf:
+ * @core: The core to update.
+ * @fileleaf: An attached sub file-leaf.
+ *
+ * Makes an attached sub file-leaf the last opened and tabbed file-leaf and centres the view
+ * around it.
+ **/
+void
+ca_core_open_fileleaf(CaCore* core, CaFileLeaf* fileleaf)
+{
+    core->current_fileitem = fileleaf->_central_glyph;    /* Disassociated current fileitem so the text changes. */
+
+    /* Centre the view around the given file-leaf. */
+    ca_core_centre_view(core, fileleaf, -1, -1);
+
+    /* Update the current navigational fileleafs. */
+    core->last_opened_fileleaf = fileleaf;
+    core->tabbed_fileleaf = fileleaf;
+}
+
+/**
+ * ca_core_close_fileleaf:
+ * @core: The core to update.
+ * @fileleaf: The file-leaf to close.
+ *
+ * Closes and frees a file-leaf and any child file-leaves opened from it.
+ */
+void
+ca_core_close_fileleaf(CaCore* core, CaFileLeaf* fileleaf)
+{
+    /* Clear the refefence to the root fileleaf. */
+    if (core->root_fileleaf == fileleaf)
+    {
+        core->root_fileleaf = NULL;
+        core->last_opened_fileleaf = NULL;
+        core->tabbed_fileleaf = NULL;
+    }
+
+    /* Check whether their are child fileleafs open. */
+    if (fileleaf->_child_fileleaf != NULL)
+    {
+        ca_core_close_fileleaf(core, fileleaf->_child_fileleaf);
+    }
+
+    /* Check whether this is a disassociated fileleaf. */
+    if (fileleaf != core->disassociated_fileleaf)
+    {
+        if (fileleaf->_parent_fileleaf != NULL)
+        {
+            g_assert(fileleaf->_parent_fileleaf->_child_fileleaf == fileleaf);
+            fileleaf->_parent_fileleaf->_child_fileleaf = NULL;
+            fileleaf->_parent_fileleaf = NULL;
+        }
+    }
+
+    if (core->closing_func != NULL)
+    {
+        core->closing_func(fileleaf, core->closing_data);
+    }
+
+    ca_fileleaf_free(fileleaf);
+}
+
+/**
+ * ca_core_close_menu:
+ * @core: The core to update.
+ * @fileleaf: A CaFileLeaf pointer to close.
+ *
+ * Closes a sub file-leaf; its parent becomes the tabbed file-leaf and, unless the file-leaf is
+ * the preview, the last opened file-leaf.
+ */
+void
+ca_core_close_menu(CaCore* core, CaFileLeaf* fileleaf)
+{
+    CaFileLeaf* parent_fileleaf;
+    gboolean disassociated;
+
+    parent_fileleaf = fileleaf->_parent_fileleaf;
+    g_assert(parent_fileleaf != NULL);
+
+    disassociated = (fileleaf == core->disassociated_fileleaf);
+
+    ca_core_close_fileleaf(core, fileleaf);
+
+    core->current_fileitem = parent_fileleaf->_central_glyph;    /* Disassociated current fileitem so the text changes. */
+    core->current_fileleaf = parent_fileleaf->_central_glyph->_assigned_fileleaf;
+    core->current_type = GLYPH_UNKNOWN;
+
+    if (FALSE == disassociated)
+    {
+        ca_core_centre_view(core, parent_fileleaf, -1, -1);
+
+        /* Update the current navigational fileleafs. */
+        core->last_opened_fileleaf = parent_fileleaf;
+    }
+
+    core->tabbed_fileleaf = parent_fileleaf;
+}
+
+/**
+ * ca_core_close_preview:
+ * @core: The core to update.
+ *
+ * Closes the preview, if any.
+ **/
+void
+ca_core_close_preview(CaCore* core)
+{
+    if (core->disassociated_fileleaf != NULL)
+    {
+        /* Close the disassociated fileleaf. */
+        ca_core_close_menu(core, core->disassociated_fileleaf);
+        core->disassociated_fileleaf = NULL;
+    }
+}
+
+/**
+ * ca_core_clear:
+ * @core: The core to update.
+ *
+ * Closes the preview and every open file-leaf.
+ **/
+void
+ca_core_clear(CaCore* core)
+{
+    ca_core_close_preview(core);
+
+    if (core->root_fileleaf != NULL)
+    {
+        ca_core_close_fileleaf(core, core->root_fileleaf);
+    }
+
+    core->current_fileleaf = NULL;
+    core->current_fileitem = NULL;
+    core->current_type = GLYPH_UNKNOWN;
+}
+
+/**
+ * ca_core_centre_view:
+ * @core: The core to update.
+ * @fileleaf: A file-leaf to centre; otherwise NULL when both co-ordinates are given.
+ * @x: The X co-ordinate around which to centre the file-leaf; otherwise -1 for the file-leaf centre.
+ * @y: The Y co-ordinate around which to centre the file-leaf; otherwise -1 for the file-leaf centre.
+ *
+ * Centres the view around the given file-leaf.  When the view is animated the shown view starts
+ * moving from wherever it is now; hit testing always uses the destination.
+ */
+void
+ca_core_centre_view(CaCore* core, CaFileLeaf* fileleaf, gint x, gint y)
+{
+    /* Update the view offset. */
+    core->view_x_offset = ((x == -1) ? fileleaf->x : x) - (core->view_width / 2);
+    core->view_y_offset = ((y == -1) ? fileleaf->y : y) - (core->view_height / 2);
+
+    if (core->animate_view)
+    {
+        core->view_from_x_offset = core->shown_x_offset;
+        core->view_from_y_offset = core->shown_y_offset;
+        core->view_animation_tick = 0;
+    }
+    else
+    {
+        core->shown_x_offset = core->view_x_offset;
+        core->shown_y_offset = core->view_y_offset;
+        core->view_animation_tick = 100;
+    }
+}
+
+/**
+ * ca_core_move_tabbed_fileleaf:
+ * @core: The core to update.
+ * @screen_x: The X co-ordinate within the view to move the tabbed file-leaf to.
+ * @screen_y: The Y co-ordinate within the view to move the tabbed file-leaf to.
+ *
+ * Moves the view so the tabbed file-leaf is centred at the given co-ordinate.
+ **/
+void
+ca_core_move_tabbed_fileleaf(CaCore* core, gint screen_x, gint screen_y)
+{
+    g_assert(core->tabbed_fileleaf != NULL);
+
+    ca_core_centre_view(
+        core,
+        core->tabbed_fileleaf,
+        core->tabbed_fileleaf->x + ((core->view_width / 2) - screen_x),
+        core->tabbed_fileleaf->y + ((core->view_height / 2) - screen_y));
+}
+
+/**
+ * ca_core_get_navigation_fileleaf:
+ * @core: The core to navigate.
+ * @navigation: The direction to navigate in.
+ *
+ * Retrieves the file-leaf which a navigation from the tabbed file-leaf moves to.  The next and
+ * previous file-leaves wrap around between the root and the last opened file-leaf.
+ *
+ * Returns: The file-leaf to tab to; otherwise NULL.
+ **/
+CaFileLeaf*
+ca_core_get_navigation_fileleaf(const CaCore* core, Navigation navigation)
+{
+    if (core->tabbed_fileleaf == NULL)
+        return NULL;
+
+    switch (navigation)
+    {
+        case NAVIGATE_LAST_OPENED:
+            /* Move to the last opened fileleaf. */
+            return core->last_opened_fileleaf;
+        case NAVIGATE_ROOT:
+            /* Move to the root fileleaf. */
+            return core->root_fileleaf;
+        case NAVIGATE_NEXT:
+            /* Move to the next fileleaf. */
+            if (core->tabbed_fileleaf == core->last_opened_fileleaf)
+                return core->root_fileleaf;
+
+            return core->tabbed_fileleaf->_child_fileleaf;
+        case NAVIGATE_PREVIOUS:
+            /* Move to the previous fileleaf. */
+            if (core->tabbed_fileleaf == core->root_fileleaf)
+                return core->last_opened_fileleaf;
+
+            return core->tabbed_fileleaf->_parent_fileleaf;
+    }
+
+    return NULL;
+}
+
+/**
+ * ca_core_tab_fileleaf:
+ * @core: The core to update.
+ * @fileleaf: An open file-leaf.
+ *
+ * Makes a file-leaf the tabbed file-leaf and centres the view around it.
+ **/
+void
+ca_core_tab_fileleaf(CaCore* core, CaFileLeaf* fileleaf)
+{
+    /* Position view at the tabbed file-leaf. */
+    core->tabbed_fileleaf = fileleaf;
+
+    /* Centre the view around the given file-leaf. */
+    ca_core_centre_view(core, fileleaf, -1, -1);
+}
+
+/**
+ * ca_core_page_fileleaf:
+ * @core: The core to update.
+ * @fileleaf: An open file-leaf other than the preview.
+ * @page: The page to show, which wraps around the page count.
+ *
+ * Shows another page of an overflowing file-leaf.  The preview and any file-leaf opened from the
+ * current page are closed first, as their file-items are freed.
+ **/
+void
+ca_core_page_fileleaf(CaCore* core, CaFileLeaf* fileleaf, gint page)
+{
+    g_return_if_fail(fileleaf != core->disassociated_fileleaf);
+
+    ca_core_close_preview(core);
+
+    if (fileleaf->_child_fileleaf != NULL)
+    {
+        ca_core_close_menu(core, fileleaf->_child_fileleaf);
+    }
+
+    ca_fileleaf_set_page(&core->geometry, fileleaf, ((page % fileleaf->_page_count) + fileleaf->_page_count) % fileleaf->_page_count);
+
+    core->current_fileleaf = fileleaf;
+    core->current_fileitem = NULL;
+    core->current_type = GLYPH_UNKNOWN;
+
+    /* A sub file-leaf moves along its spoke as its radius changes. */
+    if (fileleaf == core->tabbed_fileleaf)
+    {
+        ca_core_centre_view(core, fileleaf, -1, -1);
+    }
+}
+
+/**
+ * ca_core_advance_animation:
+ * @core: The core to update.
+ * @increment: The percentage to advance the opening file-leaves by.
+ *
+ * Advances any opening file-leaves.
+ *
+ * Returns: TRUE if a file-leaf was opening; otherwise FALSE.
+ **/
+gboolean
+ca_core_advance_animation(CaCore* core, gint increment)
+{
+    CaFileLeaf* current_fileleaf;
+    gboolean animating;
+
+    animating = FALSE;
+
+    for (current_fileleaf = core->root_fileleaf; current_fileleaf != NULL; current_fileleaf = current_fileleaf->_child_fileleaf)
+    {
+        if (current_fileleaf->_current_animation_state != INITIAL_OPEN)
+            continue;
+
+        current_fileleaf->_current_animation_tick += increment;
+
+        if (current_fileleaf->_current_animation_tick >= 100)
+        {
+            current_fileleaf->_current_animation_state = NO_STATE;
+            current_fileleaf->_current_animation_tick = 0;
+        }
+
+        animating = TRUE;
+    }
+
+    return animating;
+}
+
+/**
+ * ca_core_advance_view:
+ * @core: The core to update.
+ * @increment: The percentage to move the shown view by.
+ *
+ * Moves the shown view towards the view offset, easing out so it settles into place.
+ *
+ * Returns: TRUE if the shown view moved; otherwise FALSE.
+ **/
+gboolean
+ca_core_advance_view(CaCore* core, gint increment)
+{
+    gdouble percentage;
+
+    if (!ca_core_is_view_animating(core))
+        return FALSE;
+
+    core->view_animation_tick = MIN(core->view_animation_tick + increment, 100);
+
+    percentage = core->view_animation_tick / 100.0;
+    percentage = 1.0 - ((1.0 - percentage) * (1.0 - percentage));
+
+    core->shown_x_offset = core->view_from_x_offset + (gint)((core->view_x_offset - core->view_from_x_offset) * percentage);
+    core->shown_y_offset = core->view_from_y_offset + (gint)((core->view_y_offset - core->view_from_y_offset) * percentage);
+
+    return TRUE;
+}
+
+/**
+ * ca_core_is_view_animating:
+ * @core: The core to test.
+ *
+ * Retrieves whether the shown view is still moving towards the view offset.
+ *
+ * Returns: TRUE if the view is animating; otherwise FALSE.
+ **/
+gboolean
+ca_core_is_view_animating(const CaCore* core)
+{
+    return (core->view_animation_tick < 100);
+}
@@ -0,0 +1,96 @@
+/* circular-main-menu
+ * Copyright (C) 2008 - Cole Anstey
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ * See http://code.google.com/p/circular-application-menu/
+ */
+#ifndef __CA_CORE_H__
+#define __CA_CORE_H__
+
+#include <glib.h>
+
+#include "cmmfileleaf.h"
+#include "cmmgeometry.h"
+
+G_BEGIN_DECLS
+
+/* Constants. */
+#define VIEW_PERCENTAGE_INCREMENT       12      /* The percentage a view moves towards its destination per tick. */
+
+/* The keyboard navigation between the open file-leaves. */
+typedef enum
+{
+    NAVIGATE_LAST_OPENED,
+    NAVIGATE_ROOT,
+    NAVIGATE_NEXT,
+    NAVIGATE_PREVIOUS
+} Navigation;
+
+typedef struct _CaCore CaCore;
+
+/* The layout, view and navigation state of a menu; nothing here depends on a display. */
+struct _CaCore
+{
+    CaGeometry geometry;
+    gint view_x_offset;                 /* See: OFFSET_2_SCREEN; the destination when the view is animated. */
+    gint view_y_offset;                 /* See: OFFSET_2_SCREEN; the destination when the view is animated. */
+    gint view_width;
+    gint view_height;
+    gboolean animate_view;              /* Move the shown view towards each change of view offset. */
+    gint shown_x_offset;                /* The view offset being shown. */
+    gint shown_y_offset;
+    gint view_from_x_offset;            /* The shown view offset when the view last changed. */
+    gint view_from_y_offset;
+    gint view_animation_tick;           /* The percentage moved towards the view offset. */
+    gboolean tabbed_only;               /* Only the tabbed file-leaf is shown and hit. */
+    GFunc closing_func;                 /* Called with each file-leaf before it is freed; otherwise NULL. */
+    gpointer closing_data;
+
+    /*< Navigation >*/
+    CaFileLeaf* root_fileleaf;
+    CaFileLeaf* last_opened_fileleaf;
+    CaFileLeaf* tabbed_fileleaf;
+    CaFileLeaf* current_fileleaf;       /* The file-leaf under the pointer. */
+    CaFileItem* current_fileitem;       /* The file-item under the pointer. */
+    GlyphType current_type;
+    CaFileLeaf* disassociated_fileleaf; /* The preview; otherwise NULL. */
+};
+
+/* Construction */
+void ca_core_init(CaCore* core);
+
+/* Implementation */
+GlyphType ca_core_hittest(const CaCore* core, gint x, gint y, CaFileLeaf** found_fileleaf, CaFileItem** found_fileitem);
+gboolean ca_core_update_current(CaCore* core, gint screen_x, gint screen_y);
+void ca_core_attach_fileleaf(CaCore* core, CaFileLeaf* fileleaf, CaFileItem* fileitem, gboolean disassociated);
+void ca_core_open_fileleaf(CaCore* core, CaFileLeaf* fileleaf);
+void ca_core_close_fileleaf(CaCore* core, CaFileLeaf* fileleaf);
+void ca_core_close_menu(CaCore* core, CaFileLeaf* fileleaf);
+void ca_core_close_preview(CaCore* core);
+void ca_core_clear(CaCore* core);
+void ca_core_centre_view(CaCore* core, CaFileLeaf* fileleaf, gint x, gint y);
+void ca_core_move_tabbed_fileleaf(CaCore* core, gint screen_x, gint screen_y);
+CaFileLeaf* ca_core_get_navigation_fileleaf(const CaCore* core, Navigation navigation);
+void ca_core_tab_fileleaf(CaCore* core, CaFileLeaf* fileleaf);
+void ca_core_page_fileleaf(CaCore* core, CaFileLeaf* fileleaf, gint page);
+gboolean ca_core_advance_animation(CaCore* core, gint increment);
+gboolean ca_core_advance_view(CaCore* core, gint increment);
+gboolean ca_core_is_view_animating(const CaCore* core);
+
+G_END_DECLS
+
+#endif
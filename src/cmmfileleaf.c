@@ -0,0 +1,365 @@
+/* circular-main-menu
+ * Copyright (C) 2008 - Cole Anstey
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ * See http://code.google.com/p/circular-application-menu/
+ */
+#include "cmmfileleaf.h"
+#include "cmmgeometry.h"
+
+/**
+ * ca_fileleaf_add_fileitem:
+ * @fileleaf: The file-leaf the file-item resides on.
+ * @type: The glyph-type of the file-item.
+ * @data: The menu item the file-item shows, which is adopted and freed by the source.
+ *
+ * Creates a file-item at the start of the file-leaf's file-items; only the source adds these,
+ * whilst a page is being created.
+ */
+void
+ca_fileleaf_add_fileitem(CaFileLeaf* fileleaf, GlyphType type, gpointer data)
+{
+    CaFileItem* current_fileitem;
+
+    current_fileitem = g_new(CaFileItem, 1);
+    current_fileitem->_type = type;
+    current_fileitem->_data = data;
+    current_fileitem->_assigned_fileleaf = fileleaf;
+    current_fileitem->_parent_angle = 0;
+    current_fileitem->_circular_angle_share = 0.0;
+    current_fileitem->_parent_radius = 0;
+    current_fileitem->_associated_fileitem = NULL;
+    current_fileitem->_segment_render = NULL;
+
+    fileleaf->_fileitem_list = g_list_prepend(fileleaf->_fileitem_list, (gpointer)current_fileitem);
+    fileleaf->_fileitem_list_count++;
+}
+
+/**
+ * _ca_fileleaf_fileitem_free:
+ * @fileleaf: The file-leaf the file-item resides on.
+ * @fileitem: The file-item to free.
+ *
+ * Frees a file-item.
+ */
+static void
+_ca_fileleaf_fileitem_free(CaFileLeaf* fileleaf, CaFileItem* fileitem)
+{
+    fileleaf->_source->free_fileitem(fileitem->_data);
+    fileitem->_data = NULL;
+
+    g_free((gpointer)fileitem->_segment_render);
+    g_free((gpointer)fileitem);
+}
+
+/**
+ * _ca_fileleaf_free_fileitems:
+ * @fileleaf: The file-leaf whose file-items are freed.
+ *
+ * Frees the file-items of the current page.
+ */
+static void
+_ca_fileleaf_free_fileitems(CaFileLeaf* fileleaf)
+{
+    if (fileleaf->_fileitem_list != NULL)
+    {
+        GList* list;
+
+        /* Iterate the fileitems. */
+        list = g_list_last(fileleaf->_fileitem_list);
+
+        while (list)
+        {
+            CaFileItem* fileitem;
+
+            fileitem = (CaFileItem*)list->data;
+            g_assert(fileitem != NULL);
+            _ca_fileleaf_fileitem_free(fileleaf, fileitem);
+
+            list = g_list_previous(list);
+        }
+
+        g_list_free(fileleaf->_fileitem_list);
+        fileleaf->_fileitem_list = NULL;
+    }
+
+    fileleaf->_fileitem_list_count = 0;
+    fileleaf->_unresolved_fileitem_list = NULL;
+    fileleaf->_ring_count = 0;      /* The rings refer to the freed file-items until repositioned. */
+}
+
+/**
+ * _ca_fileleaf_free_render:
+ * @fileleaf: The file-leaf whose render values are freed.
+ *
+ * Frees the values kept to render the file-leaf outline, which are calculated again once the
+ * file-leaf has been laid out.
+ */
+static void
+_ca_fileleaf_free_render(CaFileLeaf* fileleaf)
+{
+    g_free((gpointer)fileleaf->_menu_render);
+    fileleaf->_menu_render = NULL;
+
+    fileleaf->_source->discard_layout(fileleaf);
+}
+
+/**
+ * _ca_fileleaf_materialize_page:
+ * @fileleaf: The file-leaf whose current page is created.
+ *
+ * Creates the file-items of the current page.  The source counts every item of the menu so the
+ * pages can be counted, but only adds those on the current page.
+ */
+static void
+_ca_fileleaf_materialize_page(CaFileLeaf* fileleaf)
+{
+    gint fileitems_total;
+    gint page_fileitems;
+    gint first_fileitem;
+
+    /* The last file-item of a full page is replaced by the page glyph once the directory overflows. */
+    if (fileleaf->_page_size > 0)
+    {
+        page_fileitems = fileleaf->_page_size;
+        first_fileitem = fileleaf->_page * (fileleaf->_page_size - 1);
+    }
+    else
+    {
+        page_fileitems = G_MAXINT;
+        first_fileitem = 0;
+    }
+
+    fileitems_total = fileleaf->_source->add_page(fileleaf, first_fileitem, page_fileitems);
+
+    if ((fileleaf->_page_size > 0) &&
+        (fileitems_total > fileleaf->_page_size))
+    {
+        if (fileleaf->_fileitem_list_count == fileleaf->_page_size)
+        {
+            /* Make room for the page glyph; the most recent file-item is first. */
+            _ca_fileleaf_fileitem_free(fileleaf, (CaFileItem*)fileleaf->_fileitem_list->data);
+            fileleaf->_fileitem_list = g_list_delete_link(fileleaf->_fileitem_list, fileleaf->_fileitem_list);
+            fileleaf->_fileitem_list_count--;
+        }
+
+        fileleaf->_page_count = ((fileitems_total - 1) / (fileleaf->_page_size - 1)) + 1;
+
+        ca_fileleaf_add_fileitem(fileleaf, GLYPH_PAGE, fileleaf->_source->new_page_glyph(fileleaf));
+    }
+    else
+    {
+        fileleaf->_page_count = 1;
+    }
+}
+
+/**
+ * ca_fileleaf_new:
+ * @leaftype: The leaf-type of the menu being shown.
+ * @page_size: The most file-items shown at once, including the page glyph; otherwise 0 if unpaged.
+ * @source: The source of the menu shown.
+ * @data: The menu shown, which is adopted and freed by @source.
+ *
+ * Creates an unpositioned file-leaf containing the file-items of the first page of a menu.  No
+ * global state is touched so this may be called on a worker thread.
+ *
+ * Returns: The newly created file-leaf.
+ */
+CaFileLeaf*
+ca_fileleaf_new(
+	LeafType leaftype,
+	gint page_size,
+	const CaFileLeafSource* source,
+	gpointer data)
+{
+    CaFileLeaf* fileleaf;
+
+    g_return_val_if_fail((page_size == 0) || (page_size >= 2), NULL);
+
+    /* Create a new fileleaf. */
+    fileleaf = g_new(CaFileLeaf, 1);
+    fileleaf->_type = leaftype;
+    fileleaf->_source = source;
+    fileleaf->_data = data;
+    fileleaf->_parent_fileleaf = NULL;
+    fileleaf->_child_fileleaf = NULL;
+    fileleaf->_current_animation_state = NO_STATE;
+    fileleaf->_current_animation_tick = 0;
+    fileleaf->_fileitem_list = NULL;
+    fileleaf->_fileitem_list_count = 0;
+    fileleaf->_page_size = page_size;
+    fileleaf->_page = 0;
+    fileleaf->_page_count = 1;
+    fileleaf->_sub_fileleaves_list = NULL;
+    fileleaf->_unresolved_fileitem_list = NULL;
+    fileleaf->_menu_render = NULL;
+    fileleaf->_ring_bounds = NULL;
+    fileleaf->_ring_capacity = 0;
+    fileleaf->_ring_count = 0;
+    fileleaf->bound_radius = 0;
+
+    /* Create the fileleafs central glyph. */
+    fileleaf->_central_glyph = g_new(CaFileItem, 1);
+    fileleaf->_central_glyph->_type = GLYPH_ROOT_CENTRE;
+    fileleaf->_central_glyph->_data = NULL;
+    fileleaf->_central_glyph->_associated_fileitem = NULL;
+    fileleaf->_central_glyph->_assigned_fileleaf = fileleaf;
+    fileleaf->_central_glyph->_parent_angle = 0;
+    fileleaf->_central_glyph->_circular_angle_share = 0.0;
+    fileleaf->_central_glyph->_parent_radius = 0;
+    fileleaf->_central_glyph->_segment_render = NULL;
+
+    /* Create the file-items of the first page. */
+    _ca_fileleaf_materialize_page(fileleaf);
+
+    return fileleaf;
+}
+
+/**
+ * ca_fileleaf_attach:
+ * @geometry: The glyph sizes to lay out with.
+ * @fileleaf: A file-leaf created by ca_fileleaf_new().
+ * @fileitem: The file-item to show.
+ * @disassociated: Specifies whether the file-item will be shown as a preview.
+ *
+ * Attaches a newly created file-leaf to the file-item it is shown from and positions it.  The
+ * ring bounds are sized here for the largest page, so laying out again does not allocate.  The
+ * icons are left for the caller to resolve.
+ */
+void
+ca_fileleaf_attach(
+    const CaGeometry* geometry,
+	CaFileLeaf* fileleaf,
+	CaFileItem* fileitem,
+	gboolean disassociated)
+{
+    CaFileLeaf* parent_fileleaf;
+    gdouble angle;
+
+    if (fileitem != NULL)
+    {
+        parent_fileleaf = fileitem->_assigned_fileleaf;
+        angle = fileitem->_parent_angle;
+    }
+    else
+    {
+        /* Default values for the root fileleaf. */
+
+        g_assert(fileleaf->_type == ROOT_LEAF);
+        parent_fileleaf = NULL,
+        angle = 0.0;
+    }
+
+    fileleaf->_parent_fileleaf = parent_fileleaf;
+    fileleaf->_central_glyph->_associated_fileitem = disassociated ? NULL : fileitem;   /* Keep a reference to the associated fileitems. */
+
+    if (disassociated)
+    {
+        /* Disassociated fileleaf. */
+
+        fileleaf->_central_glyph->_type = GLYPH_FILE_MENU_CENTRE;
+    }
+    else if (parent_fileleaf != NULL)
+    {
+        /* Sub fileleaf. */
+
+        parent_fileleaf->_child_fileleaf = fileleaf;
+
+        fileleaf->_central_glyph->_type = GLYPH_FILE_MENU_CENTRE;
+        fileleaf->_central_glyph->_parent_angle = ca_geometry_calculate_angle_offset(angle, 180.0);
+    }
+    else
+    {
+        /* Root fileleaf. */
+
+        fileleaf->_central_glyph->_type = GLYPH_ROOT_CENTRE;
+    }
+
+    g_assert(fileleaf->_ring_bounds == NULL);
+
+    fileleaf->_ring_capacity = ca_geometry_count_rings(
+        geometry,
+        fileleaf,
+        (fileleaf->_page_size > 0) ? fileleaf->_page_size : fileleaf->_fileitem_list_count);
+    fileleaf->_ring_bounds = g_new(CaRingBounds, MAX(fileleaf->_ring_capacity, 1));
+
+    {
+        gdouble radius;
+
+        radius = ca_geometry_calculate_radius(geometry, fileleaf);
+
+		/* Position a file-leaf and all child segments. */
+        ca_geometry_position_fileleaf_files(geometry, fileleaf, radius, angle);
+    }
+}
+
+/**
+ * ca_fileleaf_set_page:
+ * @geometry: The glyph sizes to lay out with.
+ * @fileleaf: An attached file-leaf which is neither the preview nor has a child file-leaf.
+ * @page: The page to show.
+ *
+ * Replaces the file-items with those of another page and positions them again.  The icons are
+ * left for the caller to resolve.
+ */
+void
+ca_fileleaf_set_page(const CaGeometry* geometry, CaFileLeaf* fileleaf, gint page)
+{
+    gdouble radius;
+    gdouble angle;
+
+    g_return_if_fail((page >= 0) && (page < fileleaf->_page_count));
+    g_return_if_fail(fileleaf->_child_fileleaf == NULL);
+
+    _ca_fileleaf_free_fileitems(fileleaf);
+
+    fileleaf->_page = page;
+    _ca_fileleaf_materialize_page(fileleaf);
+
+    /* The tab to the parent file-leaf depends upon the radius. */
+    _ca_fileleaf_free_render(fileleaf);
+
+    /* The file-leaf faces its parent file-item. */
+    angle = (fileleaf->_parent_fileleaf != NULL) ? ca_geometry_calculate_angle_offset(fileleaf->_central_glyph->_parent_angle, 180.0) : 0.0;
+    radius = ca_geometry_calculate_radius(geometry, fileleaf);
+
+    /* Position a file-leaf and all child segments. */
+    ca_geometry_position_fileleaf_files(geometry, fileleaf, radius, angle);
+}
+
+/**
+ * ca_fileleaf_free:
+ * @fileleaf: The file-leaf to free.
+ *
+ * Frees a file-leaf and its file-items.  No global state is touched so this may be used for a
+ * file-leaf which was never attached.
+ */
+void
+ca_fileleaf_free(CaFileLeaf* fileleaf)
+{
+    g_free((gpointer)fileleaf->_central_glyph);
+
+    _ca_fileleaf_free_fileitems(fileleaf);
+
+    /* The source abandons any job still serving the file-leaf and frees what it kept with it. */
+    fileleaf->_source->free_fileleaf(fileleaf->_data);
+    fileleaf->_data = NULL;
+
+    g_free((gpointer)fileleaf->_menu_render);
+    g_free((gpointer)fileleaf->_ring_bounds);
+    g_free((gpointer)fileleaf);
+}
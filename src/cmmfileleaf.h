@@ -0,0 +1,226 @@
+/* circular-main-menu
+ * Copyright (C) 2008 - Cole Anstey
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ * See http://code.google.com/p/circular-application-menu/
+ */
+#ifndef __CA_FILELEAF_H__
+#define __CA_FILELEAF_H__
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/* Leaf types. */
+typedef enum
+{
+    ROOT_LEAF,
+    FILE_LEAF,
+    SUB_FILE_LEAF
+} LeafType;
+
+/* Gylph types. */
+typedef enum
+{
+    GLYPH_UNKNOWN,
+    GLYPH_ROOT_CENTRE,
+    GLYPH_FILE_MENU_CENTRE,
+    GLYPH_FILE,
+    GLYPH_FILE_MENU,
+    GLYPH_TAB,
+    GLYPH_PAGE              /* Shows the next page of an overflowing file-leaf. */
+} GlyphType;
+
+/* The current animation state of a leaf. */
+typedef enum
+{
+    NO_STATE,
+    INITIAL_OPEN
+} AnimationState;
+
+typedef struct _CaMenuRender CaMenuRender;
+typedef struct _CaSegmentRender CaSegmentRender;
+typedef struct _CaRingBounds CaRingBounds;
+typedef struct _CaFileItem CaFileItem;
+typedef struct _CaFileLeaf CaFileLeaf;
+typedef struct _CaFileLeafSource CaFileLeafSource;
+typedef struct _CaGeometry CaGeometry;
+
+/* Structure to hold calculated menu values for rendering. */
+/* Held here to stop them being calculated more than once. */
+struct _CaMenuRender
+{
+    // Render a child menu.
+    /*
+     C   E
+     B   F
+    A     A
+    A     A
+    A     A
+     AAAAA
+    */
+    gint Bcircle_x;
+    gint Bcircle_y;
+    gint Ccircle_x;
+    gint Ccircle_y;
+    gint Ecircle_x;
+    gint Ecircle_y;
+    gint Fcircle_x;
+    gint Fcircle_y;
+    gint Bcircle_arc_x;
+    gint Bcircle_arc_y;
+    gint Ccircle_arc_x;
+    gint Ccircle_arc_y;
+    gdouble lowest_angle_nearest;
+    gdouble highest_angle_nearest;
+    gdouble Bcircle_lowest_angle;
+    gdouble Bcircle_highest_angle;
+    gdouble Fcircle_lowest_angle;
+    gdouble Fcircle_highest_angle;
+    gdouble lowest_angle_farthest;
+    gdouble highest_angle_farthest;
+    gdouble Ccircle_lowest_angle;
+    gdouble Ccircle_highest_angle;
+    gdouble Ecircle_lowest_angle;
+    gdouble Ecircle_highest_angle;
+
+    gdouble tab_glyph_radius;
+    gint tab_glyph_x;
+    gint tab_glyph_y;
+};
+
+/* Structure to hold calculated segment values for rendering. */
+/* Held here to stop them being calculated more than once.    */
+struct _CaSegmentRender
+{
+    /*
+    Segment
+
+    CDC
+    BAB
+    */
+    gint Aradius;
+    gint Bradius;
+    gint Cradius;
+    gint Dradius;
+    gdouble Afrom_angle;
+    gdouble Bfrom_angle;
+    gdouble Cfrom_angle;
+    gdouble Dfrom_angle;
+    gdouble Ato_angle;
+    gdouble Bto_angle;
+    gdouble Cto_angle;
+    gdouble Dto_angle;
+    gint B_lowest_circle_x;
+    gint B_lowest_circle_y;
+    gint C_lowest_circle_x;
+    gint C_lowest_circle_y;
+    gint B_highest_circle_x;
+    gint B_highest_circle_y;
+    gint C_highest_circle_x;
+    gint C_highest_circle_y;
+
+    // Arrow.
+    gdouble arrow_percentage;
+    gdouble common_angle;
+    gint arrow_point_x;
+    gint arrow_point_y;
+    gint arrow_side_x;
+    gint arrow_side_y;
+    gint arrow_radius;
+    gdouble arrow_angle;
+};
+
+/* The annulus covered by the segments of one ring of a file-leaf. */
+struct _CaRingBounds
+{
+    gint inner_radius;
+    gint outer_radius;
+    GList* fileitem_list;       /* The first file-item of the ring within _fileitem_list. */
+    gint fileitem_count;
+};
+
+/* The file-item which resides on a file-leaf. */
+struct _CaFileItem
+{
+    GlyphType _type;
+    gpointer _data;         /* The menu item shown, held for the source; otherwise NULL for a central glyph. */
+    CaFileLeaf* _assigned_fileleaf;
+    CaFileItem* _associated_fileitem;
+    gdouble _parent_angle;
+    gdouble _circular_angle_share;
+    gdouble _parent_radius;
+    CaSegmentRender* _segment_render;
+
+    /*< Drawing >*/
+    gint x;
+    gint y;
+    gint size;
+};
+
+/* The file-leaf containing 0-* file-items. */
+struct _CaFileLeaf
+{
+    LeafType _type;
+    const CaFileLeafSource* _source;
+    gpointer _data;                     /* The menu shown, held for the source. */
+    GList* _fileitem_list;              /* The file-items of the current page only. */
+    gint _fileitem_list_count;
+    gint _page_size;                    /* The most file-items shown at once; otherwise 0 if unpaged. */
+    gint _page;
+    gint _page_count;
+    AnimationState _current_animation_state;
+    gint _current_animation_tick;
+    CaFileLeaf* _parent_fileleaf;
+    CaFileLeaf* _child_fileleaf;
+    GList* _sub_fileleaves_list;
+    GList* _unresolved_fileitem_list;   /* The next file-item whose icon is to be resolved. */
+    CaFileItem* _central_glyph;
+    CaMenuRender* _menu_render;
+    CaRingBounds* _ring_bounds;         /* The rings from the innermost outwards; sized for the largest page once attached. */
+    gint _ring_capacity;
+    gint _ring_count;
+
+    /*< Drawing >*/
+    gint x;
+    gint y;
+    gint radius;
+    gint bound_radius;                  /* Covers the file-leaf, its outline and its tab. */
+};
+
+/* The menu shown by a file-leaf; the core only holds the items and the menu as opaque handles. */
+struct _CaFileLeafSource
+{
+    gint (*add_page)(CaFileLeaf* fileleaf, gint first_fileitem, gint page_fileitems);     /* Adds the items of a page by ca_fileleaf_add_fileitem(); returns the items of the whole menu. */
+    gpointer (*new_page_glyph)(CaFileLeaf* fileleaf);                                   /* The item shown by the page glyph. */
+    void (*discard_layout)(CaFileLeaf* fileleaf);                                       /* Called once the file-leaf is laid out again. */
+    GDestroyNotify free_fileitem;
+    GDestroyNotify free_fileleaf;
+};
+
+/* Construction */
+CaFileLeaf* ca_fileleaf_new(LeafType leaftype, gint page_size, const CaFileLeafSource* source, gpointer data);
+void ca_fileleaf_free(CaFileLeaf* fileleaf);
+
+/* Implementation */
+void ca_fileleaf_add_fileitem(CaFileLeaf* fileleaf, GlyphType type, gpointer data);
+void ca_fileleaf_attach(const CaGeometry* geometry, CaFileLeaf* fileleaf, CaFileItem* fileitem, gboolean disassociated);
+void ca_fileleaf_set_page(const CaGeometry* geometry, CaFileLeaf* fileleaf, gint page);
+
+G_END_DECLS
+
+#endif
@@ -0,0 +1,759 @@
+/* circular-main-menu
+ * Copyright (C) 2008 - Cole Anstey
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ * See http://code.google.com/p/circular-application-menu/
+ */
+#include "cmmgeometry.h"
+
+#include <math.h>
+
+/**
+ * _ca_geometry_ring_capacity:
+ * @geometry: The glyph sizes to lay out with.
+ * @radius: The radius of a ring.
+ *
+ * Retrieves how many file-items fit on a ring.
+ *
+ * Returns: The file-item count, which is at least one.
+ */
+static gint
+_ca_geometry_ring_capacity(const CaGeometry* geometry, gint radius)
+{
+    gint circumference;
+
+    circumference = (gint)ca_geometry_circumference_from_radius(radius);
+
+    return MAX(1, circumference / (gint)MIN_RADIUS_ICONAREA(geometry->normal_iconsize));
+}
+
+/**
+ * _ca_geometry_ring_plan_init:
+ * @geometry: The glyph sizes to lay out with.
+ * @ring_plan: The ring plan to fill.
+ * @centre_iconsize: The size of the central glyph the rings surround.
+ *
+ * Lays out the rings once, so the radius and the positions of a file-leaf are looked up rather
+ * than derived again for every file-leaf.
+ */
+static void
+_ca_geometry_ring_plan_init(const CaGeometry* geometry, CaRingPlan* ring_plan, gint centre_iconsize)
+{
+    gint ring;
+
+    for (ring = 0; ring < MAX_RING_PLAN_RINGS; ring++)
+    {
+        if (ring == 0)
+        {
+            ring_plan->radius[ring] = (gint)((centre_iconsize / 2) + INITIAL_RADIUS(geometry->normal_iconsize));
+            ring_plan->fileitems[ring] = 0;
+        }
+        else
+        {
+            /* (do not (geometry->normal_iconsize / 2) as two halves are incremented. */
+            ring_plan->radius[ring] = ring_plan->radius[ring - 1] + geometry->ring_spacing;
+            ring_plan->fileitems[ring] = ring_plan->fileitems[ring - 1];
+        }
+
+        ring_plan->capacity[ring] = _ca_geometry_ring_capacity(geometry, ring_plan->radius[ring]);
+        ring_plan->fileitems[ring] += ring_plan->capacity[ring];
+        ring_plan->angle[ring] = 360.0 / ring_plan->capacity[ring];
+        ring_plan->outer_radius[ring] = ring_plan->radius[ring] + (gint)(SEGMENT_OUTER_SPACER(geometry->normal_iconsize) + CIRCULAR_SEPERATOR);
+    }
+}
+
+/**
+ * _ca_geometry_get_ring:
+ * @geometry: The glyph sizes to lay out with.
+ * @ring_plan: The ring plan of the file-leaf.
+ * @ring: The ring index, from the innermost outwards.
+ * @radius: A return location for the ring radius.
+ * @capacity: A return location for how many file-items fit on the ring.
+ *
+ * Retrieves a ring; the rings beyond the plan continue at the same spacing.
+ */
+static void
+_ca_geometry_get_ring(const CaGeometry* geometry, const CaRingPlan* ring_plan, gint ring, gint* radius, gint* capacity)
+{
+    if (ring < MAX_RING_PLAN_RINGS)
+    {
+        *radius = ring_plan->radius[ring];
+        *capacity = ring_plan->capacity[ring];
+
+        return;
+    }
+
+    *radius = ring_plan->radius[MAX_RING_PLAN_RINGS - 1] + ((ring - (MAX_RING_PLAN_RINGS - 1)) * geometry->ring_spacing);
+    *capacity = _ca_geometry_ring_capacity(geometry, *radius);
+}
+
+/**
+ * ca_geometry_init:
+ * @geometry: The glyph sizes to initialise.
+ * @icon_width: The width of a file-item icon.
+ * @icon_height: The height of a file-item icon.
+ * @root_centre_iconsize: The size of the root file-leaf central glyph.
+ *
+ * Initialises the glyph sizes from which the file-leaves are laid out.
+ */
+void
+ca_geometry_init(CaGeometry* geometry, gint icon_width, gint icon_height, gint root_centre_iconsize)
+{
+    gint hypotenuse;
+
+    geometry->icon_width = icon_width;
+    geometry->icon_height = icon_height;
+    geometry->root_centre_iconsize = root_centre_iconsize;
+
+    /* Work out the hypotenuse so a square image fits onto a tab. */
+    hypotenuse = MAX(icon_width * icon_width, icon_height * icon_height);
+
+    /* Use the smaller side as not worried about any overlap. */
+    geometry->normal_iconsize = MAX(icon_width, icon_height);
+
+    geometry->tab_width =
+        RADIUS_ICON_SPACER +
+        RADIUS_ICON_SPACER +
+        sqrt(hypotenuse * 2);   /* Use the larger hypotenuse so there is no overlap. */
+
+    geometry->tab_height =
+        ((RADIUS_ICON_SPACER + geometry->normal_iconsize + RADIUS_ICON_SPACER) -
+        (RADIUS_SPACER + CLOSEST_TAB_CIRCLE_RADIUS + FARTHEST_TAB_CIRCLE_RADIUS));
+
+    geometry->ring_spacing =
+        (gint)(SEGMENT_OUTER_SPACER(geometry->normal_iconsize) +
+        CIRCULAR_SEPERATOR +
+        SEGMENT_INNER_SPACER(geometry->normal_iconsize));
+
+    /* The root file-leaf surrounds the emblem; every other file-leaf surrounds a CENTRE_ICONSIZE glyph. */
+    _ca_geometry_ring_plan_init(geometry, &geometry->root_ring_plan, root_centre_iconsize);
+    _ca_geometry_ring_plan_init(geometry, &geometry->ring_plan, (gint)CENTRE_ICONSIZE);
+}
+
+/**
+ * ca_geometry_point_from_source_offset:
+ * @source_x: The circle X origin.
+ * @source_y: The circle Y origin.
+ * @angle: The angle of the destination co-ordinates.
+ * @radius: The radius from the source origin of the destination co-ordinates.
+ * @destination_x: The X destination co-ordinate.
+ * @destination_y: The Y destination co-ordinate.
+ *
+ * Retrieves the xy co-ordinate from the given circle information.
+ */
+void
+ca_geometry_point_from_source_offset(
+	gint source_x,
+	gint source_y,
+	gdouble angle,
+	gdouble radius,
+	gint* destination_x,
+	gint* destination_y)
+{
+    gdouble degree_in_radius;
+
+    *destination_x = source_x;
+    *destination_y = source_y;
+
+    if (radius == 0.0)
+        return; /* No distance away from source. */
+
+    g_assert(angle >= 0.0);
+    g_assert(angle <= 359.9);
+
+    degree_in_radius = angle * (M_PI / 180);
+
+    *destination_x = (gint)(source_x + (radius * cos(degree_in_radius)));
+    *destination_y = (gint)(source_y + (radius * sin(degree_in_radius)));
+}
+
+/**
+ * ca_geometry_point_distance:
+ * @x1: The first X co-ordinate.
+ * @y1: The first Y co-ordinate.
+ * @x2: The second X co-ordinate.
+ * @y2: The second Y  co-ordinate.
+ *
+ * Retrieves the distance between two xy positions.
+ *
+ * Returns: The calculated distance between the two positions.
+ */
+gdouble
+ca_geometry_point_distance(gint x1, gint y1, gint x2, gint y2)
+{
+    gdouble distance;   /* Distance in radians. */
+    gint xd;
+    gint yd;
+
+    xd = x2 - x1;
+    yd = y2 - y1;
+    distance = sqrt(xd*xd + yd*yd);
+
+    return distance;
+}
+
+/**
+ * ca_geometry_circle_contains_point:
+ * @point_x: The first X co-ordinate.
+ * @point_y: The first Y co-ordinate.
+ * @circle_x: The circle X origin.
+ * @circle_y: The circle Y origin.
+ * @radius: The radius of the circle.
+ *
+ * Retrieves whether a circle contains a given xy position.
+ *
+ * Returns: TRUE if the circle contains the xy position; otherwise FALSE.
+ */
+gboolean
+ca_geometry_circle_contains_point(gint point_x, gint point_y, gint circle_x, gint circle_y, gint radius)
+{
+    gdouble distance;
+
+    distance = ca_geometry_point_distance(point_x, point_y, circle_x, circle_y);
+
+    return (distance <= radius);
+}
+
+/**
+ * ca_geometry_segment_contains_point:
+ * @geometry: The glyph sizes to lay out with.
+ * @point_x: The X co-ordinate.
+ * @point_y: The Y co-ordinate.
+ * @fileitem: The file-item to check for a hittest.
+ *
+ * Retrieves whether a segment contains a given xy position.
+ *
+ * Returns: TRUE if the segment contains the xy position; otherwise FALSE.
+ */
+gboolean
+ca_geometry_segment_contains_point(const CaGeometry* geometry, gint point_x, gint point_y, CaFileItem* fileitem)
+{
+    CaFileLeaf* fileleaf;
+    gdouble current_distance;
+    gboolean between_angle;
+
+    between_angle = FALSE;
+
+    fileleaf = fileitem->_assigned_fileleaf;
+
+    current_distance = ca_geometry_point_distance(
+        fileleaf->_central_glyph->x,
+        fileleaf->_central_glyph->y,
+        point_x,
+        point_y);
+
+    /* Check for the correct ring. */
+    if ((current_distance > (fileitem->_parent_radius - SEGMENT_INNER_SPACER(geometry->normal_iconsize))) &&
+        (current_distance < (fileitem->_parent_radius + SEGMENT_OUTER_SPACER(geometry->normal_iconsize))))
+    {
+        if (fileitem->_circular_angle_share == 360.0)
+        {
+            /* Only one fileitem. */
+            between_angle = TRUE;
+        }
+        else
+        {
+            /* Check for the correct segment. */
+            gdouble half_circular_angle_share;
+            gdouble from_angle;
+            gdouble to_angle;
+            gdouble current_angle;
+
+            half_circular_angle_share = fileitem->_circular_angle_share / 2;
+            from_angle = ca_geometry_calculate_angle_offset(fileitem->_parent_angle, -half_circular_angle_share);
+            to_angle = ca_geometry_calculate_angle_offset(fileitem->_parent_angle, half_circular_angle_share);
+
+            current_angle = ca_geometry_angle_between_points(fileitem->_assigned_fileleaf->x, fileitem->_assigned_fileleaf->y, point_x, point_y);
+            between_angle = ca_geometry_is_angle_between_angles(current_angle, from_angle, to_angle);
+        }
+    }
+
+    return between_angle;
+}
+
+/**
+ * ca_geometry_annulus_intersects_rectangle:
+ * @circle_x: The annulus X origin.
+ * @circle_y: The annulus Y origin.
+ * @inner_radius: The radius of the hole; 0 for a circle.
+ * @outer_radius: The outer radius.
+ * @x1: The left of the rectangle.
+ * @y1: The top of the rectangle.
+ * @x2: The right of the rectangle.
+ * @y2: The bottom of the rectangle.
+ *
+ * Retrieves whether an annulus overlaps a rectangle; a rectangle within the hole does not.
+ *
+ * Returns: TRUE if the annulus overlaps the rectangle; otherwise FALSE.
+ */
+gboolean
+ca_geometry_annulus_intersects_rectangle(
+    gint circle_x,
+    gint circle_y,
+    gint inner_radius,
+    gint outer_radius,
+    gdouble x1,
+    gdouble y1,
+    gdouble x2,
+    gdouble y2)
+{
+    gdouble nearest_x;
+    gdouble nearest_y;
+    gdouble farthest_x;
+    gdouble farthest_y;
+
+    /* The nearest point of the rectangle must be within the outer radius. */
+    nearest_x = CLAMP(circle_x, x1, x2) - circle_x;
+    nearest_y = CLAMP(circle_y, y1, y2) - circle_y;
+
+    if (((nearest_x * nearest_x) + (nearest_y * nearest_y)) > ((gdouble)outer_radius * outer_radius))
+        return FALSE;
+
+    /* The farthest corner of the rectangle must be beyond the inner radius. */
+    farthest_x = MAX(fabs(x1 - circle_x), fabs(x2 - circle_x));
+    farthest_y = MAX(fabs(y1 - circle_y), fabs(y2 - circle_y));
+
+    return (((farthest_x * farthest_x) + (farthest_y * farthest_y)) >= ((gdouble)inner_radius * inner_radius));
+}
+
+/**
+ * ca_geometry_circumference_from_radius:
+ * @radius: The radius of the circle.
+ *
+ * Retrieves a circumference from a given radius.
+ *
+ * Returns: The calculated circumference.
+ */
+gdouble
+ca_geometry_circumference_from_radius(gdouble radius)
+{
+    gdouble circumference;
+
+    circumference = (radius + radius) * M_PI;
+
+    return circumference;
+}
+
+/**
+ * ca_geometry_calculate_radius:
+ * @geometry: The glyph sizes to lay out with.
+ * @fileleaf: The file-leaf to calculate the radius against.
+ *
+ * Calculates a radius of a given file-leaf taking into account the amount of segments.  This is
+ * looked up from the same ring plan the file-items are positioned on.
+ *
+ * Returns: The calculated radius.
+ */
+gdouble
+ca_geometry_calculate_radius(const CaGeometry* geometry, CaFileLeaf* fileleaf)
+{
+    const CaRingPlan* ring_plan;
+    gint fileitems_total;
+    gint ring;
+    gint radius;
+    gint capacity;
+
+    ring_plan = ca_geometry_get_ring_plan(geometry, fileleaf);
+    fileitems_total = fileleaf->_fileitem_list_count;
+
+    if (fileitems_total <= 0)
+        return ring_plan->radius[0];
+
+    /* Find the outermost ring. */
+    for (ring = 0; ring < MAX_RING_PLAN_RINGS; ring++)
+    {
+        if (fileitems_total <= ring_plan->fileitems[ring])
+            return ring_plan->outer_radius[ring];
+    }
+
+    fileitems_total -= ring_plan->fileitems[MAX_RING_PLAN_RINGS - 1];
+
+    while (TRUE)
+    {
+        _ca_geometry_get_ring(geometry, ring_plan, ring, &radius, &capacity);
+
+        if (fileitems_total <= capacity)
+            return radius + (ring_plan->outer_radius[0] - ring_plan->radius[0]);
+
+        fileitems_total -= capacity;
+        ring++;
+    }
+}
+
+/**
+ * ca_geometry_count_rings:
+ * @geometry: The glyph sizes to lay out with.
+ * @fileleaf: The file-leaf to lay out.
+ * @fileitems: The number of file-items to lay out.
+ *
+ * Counts the rings a number of file-items are positioned on, from the same ring plan.
+ *
+ * Returns: The number of rings.
+ */
+gint
+ca_geometry_count_rings(const CaGeometry* geometry, CaFileLeaf* fileleaf, gint fileitems)
+{
+    const CaRingPlan* ring_plan;
+    gint ring;
+    gint radius;
+    gint capacity;
+
+    ring_plan = ca_geometry_get_ring_plan(geometry, fileleaf);
+
+    if (fileitems <= 0)
+        return 0;
+
+    for (ring = 0; ring < MAX_RING_PLAN_RINGS; ring++)
+    {
+        if (fileitems <= ring_plan->fileitems[ring])
+            return ring + 1;
+    }
+
+    fileitems -= ring_plan->fileitems[MAX_RING_PLAN_RINGS - 1];
+
+    while (TRUE)
+    {
+        _ca_geometry_get_ring(geometry, ring_plan, ring, &radius, &capacity);
+
+        if (fileitems <= capacity)
+            return ring + 1;
+
+        fileitems -= capacity;
+        ring++;
+    }
+}
+
+/**
+ * ca_geometry_get_centre_iconsize:
+ * @geometry: The glyph sizes to lay out with.
+ * @fileleaf: The file-leaf to reposition.
+ *
+ * Retrieves the centre iconsize..
+ *
+ * Returns: The centre iconsize.
+ */
+gint 
+ca_geometry_get_centre_iconsize(const CaGeometry* geometry, CaFileLeaf* fileleaf)
+{
+    gint iconsize;
+
+    if (fileleaf->_type == ROOT_LEAF)
+    {
+        iconsize = geometry->root_centre_iconsize;
+    }
+    else
+    {
+        iconsize = CENTRE_ICONSIZE;
+    }
+
+    return iconsize;
+}
+
+/**
+ * ca_geometry_get_ring_plan:
+ * @geometry: The glyph sizes to lay out with.
+ * @fileleaf: The file-leaf to lay out.
+ *
+ * Retrieves the rings a file-leaf is laid out on, which depend upon its central glyph size.
+ *
+ * Returns: The ring plan, owned by the geometry.
+ */
+const CaRingPlan*
+ca_geometry_get_ring_plan(const CaGeometry* geometry, CaFileLeaf* fileleaf)
+{
+    return (fileleaf->_type == ROOT_LEAF) ? &geometry->root_ring_plan : &geometry->ring_plan;
+}
+
+/**
+ * ca_geometry_position_fileleaf_files:
+ * @geometry: The glyph sizes to lay out with.
+ * @fileleaf: The file-leaf to reposition.
+ * @radius: The file-leaf radius.
+ * @angle: The parent angle of the file-leaf
+ *
+ * Positions a file-leaf and all child segments, and records the bounding circle of the file-leaf
+ * and the annulus of each ring so those outside a view or away from a point can be skipped.
+ */
+void
+ca_geometry_position_fileleaf_files(const CaGeometry* geometry, CaFileLeaf* fileleaf, gdouble radius, gdouble angle)
+{
+    /* TODO: Order the fileitems so the folders appear on the outside? */
+    const CaRingPlan* ring_plan;
+    GList* list;
+    gint fileitems_total;
+    gint ring;
+    gint current_radius;
+    gint outer_radius;
+    gint centre_iconsize;
+    
+    /* Assign the fileleaf size. */
+    if (fileleaf->_type == ROOT_LEAF)
+    {
+        /* Assign the fileleaf size. */
+        fileleaf->x = CA_VIEW_X_OFFSET_START;
+        fileleaf->y = CA_VIEW_Y_OFFSET_START;
+    }
+    else
+    {
+        /* Assign the sub fileleaf. */
+        gint parent_distance;
+
+        g_assert(fileleaf->_parent_fileleaf != NULL);
+
+        parent_distance =
+        	(gint)(fileleaf->_parent_fileleaf->radius +
+        	RADIUS_SPACER +
+        	SPOKE_LENGTH(geometry->tab_height) +
+        	radius);
+
+        ca_geometry_point_from_source_offset(
+            fileleaf->_parent_fileleaf->x,
+            fileleaf->_parent_fileleaf->y,
+            angle,
+            parent_distance,
+            &fileleaf->x,
+            &fileleaf->y);
+    }
+
+    fileitems_total = fileleaf->_fileitem_list_count;
+
+    /* Assign the fileitems size. */
+    list = g_list_first(fileleaf->_fileitem_list);
+
+    /* Retrieve the centre iconsize. */
+    centre_iconsize = ca_geometry_get_centre_iconsize(geometry, fileleaf);
+
+    /* The rings are the same as those the radius was calculated from. */
+    ring_plan = ca_geometry_get_ring_plan(geometry, fileleaf);
+    ring = 0;
+
+    fileleaf->_ring_count = 0;
+
+    current_radius = ring_plan->radius[0];
+    outer_radius = current_radius;
+
+    while (fileitems_total > 0)
+    {
+        gint fileitems_ring_count;
+        gdouble fileitem_angle;
+        gdouble current_fileitem_angle;
+
+        /* Start a new ring. */
+        _ca_geometry_get_ring(geometry, ring_plan, ring, &current_radius, &fileitems_ring_count);
+
+        if (fileitems_total < fileitems_ring_count)
+        {
+            /* The outermost ring is only partially filled. */
+            fileitems_ring_count = fileitems_total;
+            fileitem_angle = 360.0 / fileitems_ring_count;
+        }
+        else
+        {
+            fileitem_angle = (ring < MAX_RING_PLAN_RINGS) ? ring_plan->angle[ring] : 360.0 / fileitems_ring_count;
+        }
+
+        current_fileitem_angle = 0.0;
+
+        fileitems_total -= fileitems_ring_count;
+
+        /* Bound the segments of the ring. */
+        g_assert(ring < fileleaf->_ring_capacity);
+        fileleaf->_ring_bounds[ring].inner_radius = (gint)(current_radius - SEGMENT_INNER_SPACER(geometry->normal_iconsize) - BOUND_SPACER);
+        fileleaf->_ring_bounds[ring].outer_radius = (gint)(current_radius + SEGMENT_OUTER_SPACER(geometry->normal_iconsize) + BOUND_SPACER) + 1;
+        fileleaf->_ring_bounds[ring].fileitem_list = list;
+        fileleaf->_ring_bounds[ring].fileitem_count = fileitems_ring_count;
+        fileleaf->_ring_count = ring + 1;
+
+        /* Process all fileitems within the ring. */
+        while (fileitems_ring_count > 0)
+        {
+            CaFileItem* fileitem;
+
+            fileitem = (CaFileItem*)list->data;
+            g_assert(fileitem != NULL);
+
+            ca_geometry_point_from_source_offset(
+				fileleaf->x,
+				fileleaf->y,
+				current_fileitem_angle,
+				current_radius,
+				&fileitem->x,
+				&fileitem->y);
+
+            fileitem->size = (gint)geometry->normal_iconsize;
+            fileitem->_parent_angle = (gint)current_fileitem_angle;
+            fileitem->_parent_radius = (gint)current_radius;
+            fileitem->_circular_angle_share = fileitem_angle;
+
+            current_fileitem_angle += fileitem_angle;
+
+            fileitems_ring_count--;
+
+            /* Move onto the next fileitem. */
+            list = g_list_next(list);
+        }
+
+        /* No more circular rings to process once this is the outermost. */
+        outer_radius = current_radius + (ring_plan->outer_radius[0] - ring_plan->radius[0]);
+
+        ring++;
+    }
+
+    /* Assign the fileleafs central glyph size. */
+    fileleaf->_central_glyph->x = fileleaf->x;
+    fileleaf->_central_glyph->y = fileleaf->y;
+    fileleaf->_central_glyph->size = (gint)centre_iconsize / 2;
+    fileleaf->radius = outer_radius;
+
+    /* Bound the file-leaf outline and, when shown from a file-item, the tab reaching back to it. */
+    if (fileleaf->_central_glyph->_associated_fileitem != NULL)
+    {
+        fileleaf->bound_radius =
+            (gint)(outer_radius + RADIUS_SPACER + CLOSEST_TAB_CIRCLE_RADIUS + geometry->tab_height + FARTHEST_TAB_CIRCLE_RADIUS + BOUND_SPACER) + 1;
+    }
+    else
+    {
+        fileleaf->bound_radius = (gint)(outer_radius + RADIUS_SPACER + BOUND_SPACER) + 1;
+    }
+}
+
+/**
+ * ca_geometry_calculate_angle_offset:
+ * @angle: The current angle.
+ * @offset: The amount to offset the angle by.
+ *
+ * Offsets an angle by the given amount.
+ *
+ * Returns: The offsetted angle.
+ */
+gdouble
+ca_geometry_calculate_angle_offset(gdouble angle, gdouble offset)
+{
+    angle += offset;
+
+    if (angle > 259)
+    {
+        angle -= 360;
+    }
+
+    if (angle < 0)
+    {
+        angle = 360 + angle;
+    }
+
+    return angle;
+}
+
+/**
+ * ca_geometry_angle_between_points:
+ * @x1: The first X co-ordinate.
+ * @y1: The first Y co-ordinate.
+ * @x2: The second X co-ordinate.
+ * @y2: The second Y  co-ordinate.
+ *
+ * Retrieves the calculated angle between two xy positions.
+ *
+ * Returns: The angle between the two positions.
+ */
+gdouble
+ca_geometry_angle_between_points(gdouble x1, gdouble y1, gdouble x2, gdouble y2)
+{
+    gdouble radians;
+    gdouble degrees;
+
+    radians = atan2((y2 - y1), (x2 - x1));
+
+    degrees = RADIAN_2_DEGREE(radians);
+
+    /* For an angle of 270 atan2 give -90. */
+    if (degrees < 0.0)
+    {
+        degrees = ca_geometry_calculate_angle_offset(0.0, degrees);
+    }
+
+    return degrees;
+}
+
+/**
+ * ca_geometry_is_angle_between_angles:
+ * @angle: The angle to check.
+ * @angle_lower: The lowest angle.
+ * @angle_higher: The highest angle.
+ *
+ * Retrieves whether an angle is between two other angles.
+ *
+ * Returns: TRUE if the angle is between the two angles; otherwise FALSE.
+ */
+gboolean
+ca_geometry_is_angle_between_angles(gdouble angle, gdouble angle_lower, gdouble angle_higher)
+{
+    gboolean between_angles = FALSE;
+
+    if (angle_higher < angle_lower)
+    {
+        /* Spans 360 boundary. */
+        if ((angle >= angle_lower) || (angle <= angle_higher))
+        {
+            between_angles = TRUE;
+        }
+    }
+    else
+    {
+        if ((angle >= angle_lower) && (angle <= angle_higher))
+        {
+            between_angles = TRUE;
+        }
+    }
+
+    return between_angles;
+}
+
+/**
+ * ca_geometry_get_segment_angles:
+ * @fileitem: The file-item of the segment.
+ * @radius: The radius the segment is rendered at.
+ * @from_angle: A return location for the lowest angle.
+ * @to_angle: A return location for the highest angle.
+ *
+ * Retrieves a file-item segment's lowest and higest angle.
+ */
+void
+ca_geometry_get_segment_angles(CaFileItem* fileitem, gint radius, gdouble* from_angle, gdouble* to_angle)
+{
+    gdouble half_circular_angle_share;
+    gdouble circumference_percentage;
+    gdouble common_angle;
+
+    g_assert(NULL != fileitem);
+    g_assert(NULL != from_angle);
+    g_assert(NULL != to_angle);
+
+    half_circular_angle_share = fileitem->_circular_angle_share / 2;
+
+    /* Smaller the circumference then larger the angle. */
+    circumference_percentage =
+    	(RADIUS_SEPERATOR + (SEGMENT_CIRCLE_RADIUS * 2)) / ca_geometry_circumference_from_radius(radius);
+    common_angle = (360.0 * circumference_percentage) / 2;
+
+	/* Offset an angle by the given amount. */
+    *from_angle = ca_geometry_calculate_angle_offset(
+        fileitem->_parent_angle,
+        -(half_circular_angle_share - common_angle));
+    *to_angle = ca_geometry_calculate_angle_offset(
+        fileitem->_parent_angle,
+        half_circular_angle_share - common_angle);
+}
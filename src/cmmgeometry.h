@@ -0,0 +1,108 @@
+/* circular-main-menu
+ * Copyright (C) 2008 - Cole Anstey
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ * See http://code.google.com/p/circular-application-menu/
+ */
+#ifndef __CA_GEOMETRY_H__
+#define __CA_GEOMETRY_H__
+
+#include <glib.h>
+
+#include "cmmfileleaf.h"
+
+G_BEGIN_DECLS
+
+/* Constants. */
+#define RADIUS_SPACER                   4.0
+#define CENTRE_ICONSIZE                 24.0
+#define SEGMENT_ARROW_WIDTH             6.0     /* The width of an arrow. */
+#define SEGMENT_ARROW_HEIGHT            16.0    /* The height of an arrow. */
+#define SEGMENT_CIRCLE_RADIUS           3.0     /* The bevel of a fileitem segment. */
+#define CIRCULAR_SEPERATOR              4.0
+#define SPOKE_SEPERATOR                 RADIUS_SPACER
+#define SPOKE_LENGTH(x)                 SPOKE_SEPERATOR + CLOSEST_TAB_CIRCLE_RADIUS + x + CLOSEST_TAB_CIRCLE_RADIUS + RADIUS_SPACER
+#define RADIUS_SEPERATOR                CIRCULAR_SEPERATOR
+#define RADIUS_ICON_SPACER              10.0
+#define CIRCULAR_ICON_SPACER            10.0
+#define SEGMENT_INNER_SPACER(x)         ((x / 2) + CIRCULAR_ICON_SPACER)
+#define SEGMENT_OUTER_SPACER(x)         ((x / 2) + CIRCULAR_ICON_SPACER + SEGMENT_ARROW_HEIGHT)
+#define MIN_RADIUS_ICONAREA(x)          (RADIUS_ICON_SPACER + x + RADIUS_ICON_SPACER)
+#define INITIAL_RADIUS(x)               CIRCULAR_ICON_SPACER + CIRCULAR_SEPERATOR + SEGMENT_INNER_SPACER(x)
+
+#define CLOSEST_TAB_CIRCLE_RADIUS       10.0    /* The innermost tab bevel. */
+#define FARTHEST_TAB_CIRCLE_RADIUS      10.0    /* The outermost tab bevel. */
+#define BOUND_SPACER                    2.0     /* Covers the outline strokes beyond a file-leaf or segment. */
+
+#define MAX_FILEITEMS_PER_FILELEAF      15
+#define MAX_RING_PLAN_RINGS             16      /* The rings held in a ring plan; any further rings are extrapolated. */
+#define CA_VIEW_X_OFFSET_START          16384
+#define CA_VIEW_Y_OFFSET_START          16384
+#define OFFSET_2_SCREEN(xy, offset_xy)  (xy - offset_xy)
+#define SCREEN_2_OFFSET(xy, offset_xy)  (xy + offset_xy)
+#define RADIAN_2_DEGREE(radian)         (radian * (180.0 / M_PI))
+#define DEGREE_2_RADIAN(degree)         (degree * (M_PI / 180.0))
+
+typedef struct _CaRingPlan CaRingPlan;
+
+/* The concentric rings of a file-leaf from the innermost outwards, for one centre glyph size. */
+struct _CaRingPlan
+{
+    gint radius[MAX_RING_PLAN_RINGS];
+    gint capacity[MAX_RING_PLAN_RINGS];         /* The file-items which fit on the ring. */
+    gint fileitems[MAX_RING_PLAN_RINGS];        /* The file-items which fit on the ring and every inner ring. */
+    gdouble angle[MAX_RING_PLAN_RINGS];         /* The angle share of a file-item on a full ring. */
+    gint outer_radius[MAX_RING_PLAN_RINGS];     /* The file-leaf radius when the ring is the outermost. */
+};
+
+/* The glyph sizes from which the file-leaves are laid out. */
+struct _CaGeometry
+{
+    gint icon_width;
+    gint icon_height;
+    gint normal_iconsize;
+    gint tab_width;
+    gint tab_height;
+    gint root_centre_iconsize;     /* The emblem size when one is used; otherwise CENTRE_ICONSIZE. */
+    gint ring_spacing;              /* The radius between two rings. */
+    CaRingPlan root_ring_plan;
+    CaRingPlan ring_plan;
+};
+
+/* Construction */
+void ca_geometry_init(CaGeometry* geometry, gint icon_width, gint icon_height, gint root_centre_iconsize);
+
+/* Implementation */
+void ca_geometry_point_from_source_offset(gint source_x, gint source_y, gdouble angle, gdouble radius, gint* destination_x, gint* destination_y);
+gdouble ca_geometry_point_distance(gint x1, gint y1, gint x2, gint y2);
+gboolean ca_geometry_circle_contains_point(gint point_x, gint point_y, gint circle_x, gint circle_y, gint radius);
+gboolean ca_geometry_segment_contains_point(const CaGeometry* geometry, gint point_x, gint point_y, CaFileItem* fileitem);
+gboolean ca_geometry_annulus_intersects_rectangle(gint circle_x, gint circle_y, gint inner_radius, gint outer_radius, gdouble x1, gdouble y1, gdouble x2, gdouble y2);
+gdouble ca_geometry_circumference_from_radius(gdouble radius);
+gdouble ca_geometry_calculate_radius(const CaGeometry* geometry, CaFileLeaf* fileleaf);
+gint ca_geometry_count_rings(const CaGeometry* geometry, CaFileLeaf* fileleaf, gint fileitems);
+gint ca_geometry_get_centre_iconsize(const CaGeometry* geometry, CaFileLeaf* fileleaf);
+const CaRingPlan* ca_geometry_get_ring_plan(const CaGeometry* geometry, CaFileLeaf* fileleaf);
+void ca_geometry_position_fileleaf_files(const CaGeometry* geometry, CaFileLeaf* fileleaf, gdouble radius, gdouble angle);
+gdouble ca_geometry_calculate_angle_offset(gdouble angle, gdouble offset);
+gdouble ca_geometry_angle_between_points(gdouble x1, gdouble y1, gdouble x2, gdouble y2);
+gboolean ca_geometry_is_angle_between_angles(gdouble angle, gdouble angle_lower, gdouble angle_higher);
+void ca_geometry_get_segment_angles(CaFileItem* fileitem, gint radius, gdouble* from_angle, gdouble* to_angle);
+
+G_END_DECLS
+
+#endif
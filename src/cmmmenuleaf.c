@@ -0,0 +1,283 @@
+/* circular-main-menu
+ * Copyright (C) 2008 - Cole Anstey
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ * See http://code.google.com/p/circular-application-menu/
+ *
+ * The menu tree side of the file-leaves.  The core only holds the menu tree directory of a
+ * file-leaf and the menu tree item and icon of each file-item as opaque handles, which are
+ * created and freed here.
+ */
+#include "cmmmenuleaf.h"
+
+/* Constants. */
+#define PAGE_ICON_NAME                  "go-next"
+
+static gint _ca_menu_fileleaf_add_page(CaFileLeaf* fileleaf, gint first_fileitem, gint page_fileitems);
+static gpointer _ca_menu_fileleaf_new_page_glyph(CaFileLeaf* fileleaf);
+static void _ca_menu_fileleaf_discard_layout(CaFileLeaf* fileleaf);
+static void _ca_menu_fileitem_free(gpointer data);
+static void _ca_menu_fileleaf_free(gpointer data);
+
+static const CaFileLeafSource g_menu_source =
+{
+    _ca_menu_fileleaf_add_page,
+    _ca_menu_fileleaf_new_page_glyph,
+    _ca_menu_fileleaf_discard_layout,
+    _ca_menu_fileitem_free,
+    _ca_menu_fileleaf_free
+};
+
+/**
+ * _ca_menu_fileitem_new:
+ * @menutreeitem: The menu tree item shown, which is adopted; otherwise NULL.
+ * @icon: The icon of the menu tree item.
+ *
+ * Creates the menu item of a file-item; the icon is resolved once the file-leaf has been shown.
+ *
+ * Returns: The newly created menu item.
+ */
+static CaMenuFileItem*
+_ca_menu_fileitem_new(gpointer menutreeitem, GIcon* icon)
+{
+    CaMenuFileItem* menufileitem;
+
+    menufileitem = g_new(CaMenuFileItem, 1);
+    menufileitem->menutreeitem = menutreeitem;
+    menufileitem->icon = g_object_ref(icon);
+    menufileitem->pixbuf = NULL;
+
+    return menufileitem;
+}
+
+/**
+ * _ca_menu_fileitem_free:
+ * @data: The menu item to free.
+ *
+ * Frees the menu item of a file-item.
+ */
+static void
+_ca_menu_fileitem_free(gpointer data)
+{
+    CaMenuFileItem* menufileitem;
+
+    menufileitem = (CaMenuFileItem*)data;
+
+    if (menufileitem->menutreeitem != NULL)
+    {
+        gmenu_tree_item_unref (menufileitem->menutreeitem);
+        menufileitem->menutreeitem = NULL;
+    }
+
+    g_object_unref(menufileitem->icon);
+
+    if (menufileitem->pixbuf != NULL)
+    {
+        g_object_unref(menufileitem->pixbuf);
+    }
+
+    g_free((gpointer)menufileitem);
+}
+
+/**
+ * _ca_menu_fileleaf_add_page:
+ * @fileleaf: The file-leaf whose current page is created.
+ * @first_fileitem: The index of the first item on the page.
+ * @page_fileitems: The most items on the page.
+ *
+ * Adds the file-items of a page.  Every item of the menu tree directory is visited so the pages
+ * can be counted, but only those on the page are kept; nothing is decoded here so a page of a
+ * large directory costs the same as a small directory.
+ *
+ * Returns: The number of items of the menu tree directory which can be shown.
+ */
+static gint
+_ca_menu_fileleaf_add_page(CaFileLeaf* fileleaf, gint first_fileitem, gint page_fileitems)
+{
+    CaMenuFileLeaf* menufileleaf;
+    GMenuTreeIter* tmp;
+    GMenuTreeItemType itemtype;
+    gint fileitems_total;
+
+    menufileleaf = CA_MENU_FILELEAF(fileleaf);
+    fileitems_total = 0;
+
+    tmp = gmenu_tree_directory_iter (menufileleaf->menutreedirectory);
+
+    /* Iterate all files in the source directory. */
+    while ((itemtype = gmenu_tree_iter_next(tmp)) != GMENU_TREE_ITEM_INVALID)
+    {
+        gpointer resolved_item;
+        GIcon* icon;
+
+        /* Stop if the file-leaf has been abandoned. */
+        if (g_cancellable_is_cancelled(menufileleaf->build_cancellable))
+        {
+            break;
+        }
+
+        resolved_item = NULL;
+
+        if (itemtype == GMENU_TREE_ITEM_ALIAS)
+        {
+            resolved_item = gmenu_tree_iter_get_alias (tmp);
+        }
+        else if (itemtype == GMENU_TREE_ITEM_ENTRY)
+        {
+            resolved_item = gmenu_tree_iter_get_entry (tmp);
+        }
+        else if (itemtype == GMENU_TREE_ITEM_DIRECTORY)
+        {
+            resolved_item = gmenu_tree_iter_get_directory (tmp);
+        }
+
+        /* Ignore unsupported types. */
+        if (NULL == resolved_item)
+        {
+            continue;
+        }
+
+        icon = gmenu_tree_directory_get_icon(resolved_item);
+
+        /* Ignore the item if their is no available icon; those off the page are only counted. */
+        if ((NULL == icon) ||
+            (fileitems_total++ < first_fileitem) ||
+            (fileleaf->_fileitem_list_count >= page_fileitems))
+        {
+            gmenu_tree_item_unref (resolved_item);
+
+            continue;
+        }
+
+        ca_fileleaf_add_fileitem(
+            fileleaf,
+            (itemtype == GMENU_TREE_ITEM_DIRECTORY) ? GLYPH_FILE_MENU : GLYPH_FILE,
+            (gpointer)_ca_menu_fileitem_new(resolved_item, icon));
+    }
+
+    gmenu_tree_iter_unref (tmp);
+
+    return fileitems_total;
+}
+
+/**
+ * _ca_menu_fileleaf_new_page_glyph:
+ * @fileleaf: The file-leaf which overflows.
+ *
+ * Creates the menu item of the page glyph, which only has an icon.
+ *
+ * Returns: The newly created menu item.
+ */
+static gpointer
+_ca_menu_fileleaf_new_page_glyph(CaFileLeaf* fileleaf)
+{
+    CaMenuFileItem* menufileitem;
+    GIcon* page_icon;
+
+    page_icon = g_themed_icon_new(PAGE_ICON_NAME);
+    menufileitem = _ca_menu_fileitem_new(NULL, page_icon);
+    g_object_unref(page_icon);
+
+    return (gpointer)menufileitem;
+}
+
+/**
+ * _ca_menu_fileleaf_discard_layout:
+ * @fileleaf: The file-leaf which has been laid out again.
+ *
+ * Frees the values the renderer kept with the file-leaf.
+ */
+static void
+_ca_menu_fileleaf_discard_layout(CaFileLeaf* fileleaf)
+{
+    CaMenuFileLeaf* menufileleaf;
+
+    menufileleaf = CA_MENU_FILELEAF(fileleaf);
+
+    if (menufileleaf->render_data != NULL)
+    {
+        menufileleaf->render_data_free(menufileleaf->render_data);
+        menufileleaf->render_data = NULL;
+    }
+}
+
+/**
+ * _ca_menu_fileleaf_free:
+ * @data: The menu of the file-leaf to free.
+ *
+ * Frees the menu of a file-leaf.
+ */
+static void
+_ca_menu_fileleaf_free(gpointer data)
+{
+    CaMenuFileLeaf* menufileleaf;
+
+    menufileleaf = (CaMenuFileLeaf*)data;
+
+    /* Abandon any job still serving the file-leaf. */
+    g_cancellable_cancel(menufileleaf->cancellable);
+
+    if (menufileleaf->render_data != NULL)
+    {
+        menufileleaf->render_data_free(menufileleaf->render_data);
+        menufileleaf->render_data = NULL;
+    }
+
+    g_object_unref(menufileleaf->cancellable);
+    gmenu_tree_item_unref (menufileleaf->menutreedirectory);
+
+    g_free((gpointer)menufileleaf);
+}
+
+/**
+ * ca_menu_fileleaf_new:
+ * @menutreedirectory: A GMenuTreeDirectory pointer to display as a menu.
+ * @leaftype: The leaf-type of the menu being shown.
+ * @page_size: The most file-items shown at once, including the page glyph; otherwise 0 if unpaged.
+ * @cancellable: A GCancellable to abandon the file-leaf; otherwise NULL.
+ *
+ * Creates an unpositioned file-leaf containing the file-items of the first page of a menu tree
+ * directory.  No global state is touched so this may be called on a worker thread.
+ *
+ * Returns: The newly created file-leaf, which is incomplete if @cancellable was cancelled.
+ */
+CaFileLeaf*
+ca_menu_fileleaf_new(
+	GMenuTreeDirectory* menutreedirectory,
+	LeafType leaftype,
+	gint page_size,
+	GCancellable* cancellable)
+{
+    CaMenuFileLeaf* menufileleaf;
+    CaFileLeaf* fileleaf;
+
+    g_return_val_if_fail((page_size == 0) || (page_size >= 2), NULL);
+
+    menufileleaf = g_new(CaMenuFileLeaf, 1);
+    menufileleaf->menutreedirectory = gmenu_tree_item_ref(menutreedirectory);
+    menufileleaf->cancellable = g_cancellable_new();
+    menufileleaf->build_cancellable = cancellable;
+    menufileleaf->render_data = NULL;
+    menufileleaf->render_data_free = NULL;
+
+    fileleaf = ca_fileleaf_new(leaftype, page_size, &g_menu_source, (gpointer)menufileleaf);
+
+    /* Only the first page may be abandoned. */
+    menufileleaf->build_cancellable = NULL;
+
+    return fileleaf;
+}
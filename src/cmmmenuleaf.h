@@ -0,0 +1,64 @@
+/* circular-main-menu
+ * Copyright (C) 2008 - Cole Anstey
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ * See http://code.google.com/p/circular-application-menu/
+ */
+#ifndef __CA_MENU_LEAF_H__
+#define __CA_MENU_LEAF_H__
+
+#include <gio/gio.h>
+#include <gdk-pixbuf/gdk-pixbuf.h>
+
+#define GMENU_I_KNOW_THIS_IS_UNSTABLE
+#include <gnome-menus-3.0/gmenu-tree.h>
+
+#include "cmmfileleaf.h"
+
+G_BEGIN_DECLS
+
+/* Retrieves the menu item of a file-item or the menu of a file-leaf; NULL for a central glyph. */
+#define CA_MENU_FILEITEM(fileitem)      ((CaMenuFileItem*)(fileitem)->_data)
+#define CA_MENU_FILELEAF(fileleaf)      ((CaMenuFileLeaf*)(fileleaf)->_data)
+
+typedef struct _CaMenuFileItem CaMenuFileItem;
+typedef struct _CaMenuFileLeaf CaMenuFileLeaf;
+
+/* The menu tree item and icon shown by a file-item. */
+struct _CaMenuFileItem
+{
+    gpointer menutreeitem;              /* NULL for the page glyph. */
+    GIcon* icon;
+    GdkPixbuf* pixbuf;                  /* NULL until the icon has been resolved. */
+};
+
+/* The menu tree directory shown by a file-leaf and the values the widget keeps with it. */
+struct _CaMenuFileLeaf
+{
+    GMenuTreeDirectory* menutreedirectory;
+    GCancellable* cancellable;          /* Cancelled once the file-leaf is freed, abandoning the jobs which serve it. */
+    GCancellable* build_cancellable;    /* Abandons the first page whilst it is created; otherwise NULL. */
+    gpointer render_data;               /* Kept by the renderer until the file-leaf is laid out again; otherwise NULL. */
+    GDestroyNotify render_data_free;
+};
+
+/* Construction */
+CaFileLeaf* ca_menu_fileleaf_new(GMenuTreeDirectory* menutreedirectory, LeafType leaftype, gint page_size, GCancellable* cancellable);
+
+G_END_DECLS
+
+#endif
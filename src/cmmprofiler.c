@@ -0,0 +1,402 @@
+/* circular-main-menu
+ * Copyright (C) 2008 - Cole Anstey
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ * See http://code.google.com/p/circular-application-menu/
+ */
+#include "cmmprofiler.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/* Constants. */
+#define MAX_PROFILER_PHASES             32
+#define MAX_PROFILER_COUNTERS           16
+#define MAX_PROFILER_MARKS              16
+
+typedef struct _CaProfilerPhase CaProfilerPhase;
+typedef struct _CaProfilerCounter CaProfilerCounter;
+typedef struct _CaProfilerMark CaProfilerMark;
+
+/* A named interval of the startup sequence. */
+struct _CaProfilerPhase
+{
+    const gchar* _name;
+    gint64 _start;
+    gint64 _end;
+};
+
+/* A named running total, i.e. the time spent on every icon lookup. */
+struct _CaProfilerCounter
+{
+    const gchar* _name;
+    gint64 _total;
+    gint _count;
+};
+
+/* A single named point in time, i.e. the first completed frame. */
+struct _CaProfilerMark
+{
+    const gchar* _name;
+    gint64 _timestamp;
+};
+
+/* Local data; the menu tree and icon theme are loaded on worker threads so recording is locked. */
+G_LOCK_DEFINE_STATIC (profiler);
+static gboolean g_recording = FALSE;
+static gboolean g_enabled = FALSE;
+static gchar* g_filename = NULL;
+static gint64 g_origin = 0;
+static CaProfilerPhase g_phases[MAX_PROFILER_PHASES];
+static gint g_phases_count = 0;
+static CaProfilerCounter g_counters[MAX_PROFILER_COUNTERS];
+static gint g_counters_count = 0;
+static CaProfilerMark g_marks[MAX_PROFILER_MARKS];
+static gint g_marks_count = 0;
+
+/**
+ * ca_profiler_init:
+ *
+ * Starts recording the startup timestamps.  This is called before anything else in main()
+ * so the timestamps are relative to the process start; whether the report is written is
+ * only known once the options have been parsed.
+ **/
+void
+ca_profiler_init(void)
+{
+    g_origin = g_get_monotonic_time();
+    g_recording = TRUE;
+}
+
+/**
+ * ca_profiler_enable:
+ * @filename: The JSON file to write the report to; otherwise NULL for the standard output.
+ *
+ * Enables the writing of the startup report.
+ **/
+void
+ca_profiler_enable(const gchar* filename)
+{
+    g_enabled = TRUE;
+
+    g_free((gpointer)g_filename);
+    g_filename = g_strdup(filename);
+}
+
+/**
+ * ca_profiler_is_enabled:
+ *
+ * Retrieves whether the startup report will be written.
+ *
+ * Returns: TRUE if the profiler is enabled; otherwise FALSE.
+ **/
+gboolean
+ca_profiler_is_enabled(void)
+{
+    return g_enabled;
+}
+
+/**
+ * ca_profiler_stop:
+ *
+ * Stops recording without writing the report, so the rest of the session is not timed.
+ **/
+void
+ca_profiler_stop(void)
+{
+    G_LOCK (profiler);
+
+    g_recording = FALSE;
+
+    G_UNLOCK (profiler);
+}
+
+/**
+ * ca_profiler_timestamp:
+ *
+ * Retrieves the current monotonic time while the startup is being recorded.
+ *
+ * Returns: The monotonic time in microseconds; otherwise 0 once recording has finished.
+ **/
+gint64
+ca_profiler_timestamp(void)
+{
+    if (FALSE == g_recording)
+        return 0;
+
+    return g_get_monotonic_time();
+}
+
+/**
+ * ca_profiler_phase_begin:
+ * @phase: The static name of the phase.
+ *
+ * Records the start of a startup phase.
+ **/
+void
+ca_profiler_phase_begin(const gchar* phase)
+{
+    if (FALSE == g_recording)
+        return;
+
+    G_LOCK (profiler);
+
+    if ((TRUE == g_recording) &&
+        (g_phases_count < MAX_PROFILER_PHASES))
+    {
+        g_phases[g_phases_count]._name = phase;
+        g_phases[g_phases_count]._start = g_get_monotonic_time();
+        g_phases[g_phases_count]._end = 0;
+        g_phases_count++;
+    }
+
+    G_UNLOCK (profiler);
+}
+
+/**
+ * ca_profiler_phase_end:
+ * @phase: The static name of the phase.
+ *
+ * Records the end of the most recently started phase with the given name.
+ **/
+void
+ca_profiler_phase_end(const gchar* phase)
+{
+    gint i;
+
+    if (FALSE == g_recording)
+        return;
+
+    G_LOCK (profiler);
+
+    for (i = g_phases_count - 1; (TRUE == g_recording) && (i >= 0); i--)
+    {
+        if ((g_phases[i]._end == 0) &&
+            (strcmp(g_phases[i]._name, phase) == 0))
+        {
+            g_phases[i]._end = g_get_monotonic_time();
+
+            break;
+        }
+    }
+
+    G_UNLOCK (profiler);
+}
+
+/**
+ * ca_profiler_accumulate:
+ * @counter: The static name of the counter.
+ * @start: The timestamp returned by ca_profiler_timestamp() when the work started.
+ *
+ * Adds the time elapsed since @start to the given counter.
+ **/
+void
+ca_profiler_accumulate(const gchar* counter, gint64 start)
+{
+    gint64 elapsed;
+    gint i;
+
+    if ((FALSE == g_recording) ||
+        (start == 0))
+        return;
+
+    elapsed = g_get_monotonic_time() - start;
+
+    G_LOCK (profiler);
+
+    for (i = 0; i < g_counters_count; i++)
+    {
+        if (strcmp(g_counters[i]._name, counter) == 0)
+            break;
+    }
+
+    if ((i == g_counters_count) &&
+        (g_counters_count < MAX_PROFILER_COUNTERS))
+    {
+        g_counters[i]._name = counter;
+        g_counters[i]._total = 0;
+        g_counters[i]._count = 0;
+        g_counters_count++;
+    }
+
+    if (i < g_counters_count)
+    {
+        g_counters[i]._total += elapsed;
+        g_counters[i]._count++;
+    }
+
+    G_UNLOCK (profiler);
+}
+
+/**
+ * ca_profiler_mark:
+ * @event: The static name of the event.
+ * @timestamp: The monotonic time of the event; otherwise 0 for the current time.
+ *
+ * Records a single point in time.
+ **/
+void
+ca_profiler_mark(const gchar* event, gint64 timestamp)
+{
+    if (FALSE == g_recording)
+        return;
+
+    G_LOCK (profiler);
+
+    if ((TRUE == g_recording) &&
+        (g_marks_count < MAX_PROFILER_MARKS))
+    {
+        g_marks[g_marks_count]._name = event;
+        g_marks[g_marks_count]._timestamp = (timestamp != 0) ? timestamp : g_get_monotonic_time();
+        g_marks_count++;
+    }
+
+    G_UNLOCK (profiler);
+}
+
+/**
+ * ca_profiler_has_mark:
+ * @event: The name of the event.
+ *
+ * Retrieves whether the given event has been recorded.
+ *
+ * Returns: TRUE if the event has been recorded; otherwise FALSE.
+ **/
+gboolean
+ca_profiler_has_mark(const gchar* event)
+{
+    gboolean found;
+    gint i;
+
+    found = FALSE;
+
+    G_LOCK (profiler);
+
+    for (i = 0; (i < g_marks_count) && (FALSE == found); i++)
+    {
+        found = (strcmp(g_marks[i]._name, event) == 0);
+    }
+
+    G_UNLOCK (profiler);
+
+    return found;
+}
+
+/**
+ * ca_profiler_write:
+ *
+ * Stops recording and, if enabled, writes the report as JSON.  All times are in
+ * microseconds relative to ca_profiler_init().
+ **/
+void
+ca_profiler_write(void)
+{
+    GString* json;
+    gint i;
+
+    G_LOCK (profiler);
+
+    if (FALSE == g_recording)
+    {
+        G_UNLOCK (profiler);
+
+        return;
+    }
+
+    g_recording = FALSE;
+
+    G_UNLOCK (profiler);
+
+    if (FALSE == g_enabled)
+        return;
+
+    json = g_string_new("{\n");
+    g_string_append(json, "  \"version\": 1,\n");
+    g_string_append(json, "  \"clock\": \"monotonic\",\n");
+    g_string_append(json, "  \"units\": \"us\",\n");
+    g_string_append_printf(json, "  \"origin\": %" G_GINT64_FORMAT ",\n", g_origin);
+
+    /* Phases. */
+    g_string_append(json, "  \"phases\": [");
+
+    for (i = 0; i < g_phases_count; i++)
+    {
+        gint64 end;
+
+        end = (g_phases[i]._end != 0) ? g_phases[i]._end : g_phases[i]._start;
+
+        g_string_append_printf(
+            json,
+            "%s\n    { \"name\": \"%s\", \"start\": %" G_GINT64_FORMAT ", \"end\": %" G_GINT64_FORMAT ", \"duration\": %" G_GINT64_FORMAT " }",
+            (i == 0) ? "" : ",",
+            g_phases[i]._name,
+            g_phases[i]._start - g_origin,
+            end - g_origin,
+            end - g_phases[i]._start);
+    }
+
+    g_string_append(json, "\n  ],\n");
+
+    /* Counters. */
+    g_string_append(json, "  \"counters\": [");
+
+    for (i = 0; i < g_counters_count; i++)
+    {
+        g_string_append_printf(
+            json,
+            "%s\n    { \"name\": \"%s\", \"count\": %d, \"total\": %" G_GINT64_FORMAT " }",
+            (i == 0) ? "" : ",",
+            g_counters[i]._name,
+            g_counters[i]._count,
+            g_counters[i]._total);
+    }
+
+    g_string_append(json, "\n  ],\n");
+
+    /* Marks. */
+    g_string_append(json, "  \"marks\": [");
+
+    for (i = 0; i < g_marks_count; i++)
+    {
+        g_string_append_printf(
+            json,
+            "%s\n    { \"name\": \"%s\", \"time\": %" G_GINT64_FORMAT " }",
+            (i == 0) ? "" : ",",
+            g_marks[i]._name,
+            g_marks[i]._timestamp - g_origin);
+    }
+
+    g_string_append(json, "\n  ]\n}\n");
+
+    if (g_filename != NULL)
+    {
+        GError* error = NULL;
+
+        if (!g_file_set_contents(g_filename, json->str, json->len, &error))
+        {
+            g_warning ("Writing the startup profile failed: %s\n", error->message);
+            g_clear_error (&error); /* g_error_free */
+        }
+    }
+    else
+    {
+        fputs(json->str, stdout);
+        fflush(stdout);
+    }
+
+    g_string_free(json, TRUE);
+}
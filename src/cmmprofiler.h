@@ -0,0 +1,45 @@
+/* circular-main-menu
+ * Copyright (C) 2008 - Cole Anstey
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ * See http://code.google.com/p/circular-application-menu/
+ */
+#ifndef __CA_PROFILER_H__
+#define __CA_PROFILER_H__
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/* Construction */
+void ca_profiler_init(void);
+void ca_profiler_enable(const gchar* filename);
+gboolean ca_profiler_is_enabled(void);
+void ca_profiler_stop(void);
+
+/* Implementation */
+gint64 ca_profiler_timestamp(void);
+void ca_profiler_phase_begin(const gchar* phase);
+void ca_profiler_phase_end(const gchar* phase);
+void ca_profiler_accumulate(const gchar* counter, gint64 start);
+void ca_profiler_mark(const gchar* event, gint64 timestamp);
+gboolean ca_profiler_has_mark(const gchar* event);
+void ca_profiler_write(void);
+
+G_END_DECLS
+
+#endif
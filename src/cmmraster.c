@@ -0,0 +1,260 @@
+/* circular-main-menu
+ * Copyright (C) 2008 - Cole Anstey
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ * See http://code.google.com/p/circular-application-menu/
+ */
+#include "cmmraster.h"
+
+/* Rasterizes surfaces with the jobs of a scheduler. */
+struct _CaRaster
+{
+    CaScheduler* scheduler;
+    gint ref_count;                     /* Held by the owner and by every job not yet delivered. */
+    gint pending;                       /* The jobs submitted but not yet delivered. */
+    GSourceFunc completed_func;         /* Called on the main thread once a job has completed; otherwise NULL. */
+    gpointer completed_data;
+};
+
+static gpointer _ca_raster_run(gpointer data, GCancellable* cancellable);
+static void _ca_raster_on_done(gpointer result, gboolean cancelled, gpointer data);
+static void _ca_raster_unref(CaRaster* raster);
+static void _ca_raster_job_unref(CaRasterJob* job);
+
+/**
+ * ca_raster_new:
+ * @scheduler: The scheduler whose workers rasterize the surfaces.
+ * @completed_func: Called on the main thread once a submitted job has completed; otherwise NULL.
+ * @completed_data: The data passed to @completed_func.
+ *
+ * Creates a raster which rasterizes surfaces away from the main thread.
+ *
+ * Returns: The newly created raster.
+ **/
+CaRaster*
+ca_raster_new(CaScheduler* scheduler, GSourceFunc completed_func, gpointer completed_data)
+{
+    CaRaster* raster;
+
+    raster = g_new0(CaRaster, 1);
+    raster->scheduler = ca_scheduler_ref(scheduler);
+    raster->ref_count = 1;
+    raster->pending = 0;
+    raster->completed_func = completed_func;
+    raster->completed_data = completed_data;
+
+    return raster;
+}
+
+/**
+ * ca_raster_free:
+ * @raster: The raster to free.
+ *
+ * Releases the raster; the jobs already submitted are still delivered, but @completed_func is no
+ * longer called.  Any job still held by its submitter keeps its surface until it is cancelled.
+ **/
+void
+ca_raster_free(CaRaster* raster)
+{
+    raster->completed_func = NULL;
+
+    _ca_raster_unref(raster);
+}
+
+/**
+ * ca_raster_submit:
+ * @raster: The raster to rasterize with.
+ * @job_class: The priority class of the job.
+ * @cancellable: A GCancellable to abandon the job, e.g. the one of the file-leaf it serves;
+ * otherwise NULL.
+ * @func: Rasterizes the surface on a worker thread.
+ * @data: The data passed to @func; nothing else may change it until the job has completed.
+ * @data_free: Frees @data on the main thread; otherwise NULL.
+ *
+ * Queues a surface to be rasterized by a worker thread.  The job is marked completed on the main
+ * thread once the scheduler delivers it.
+ *
+ * Returns: The job; owned by the caller until ca_raster_job_cancel() is called.
+ **/
+CaRasterJob*
+ca_raster_submit(
+	CaRaster* raster,
+	JobClass job_class,
+	GCancellable* cancellable,
+	CaRasterFunc func,
+	gpointer data,
+	GDestroyNotify data_free)
+{
+    CaRasterJob* job;
+
+    job = g_new0(CaRasterJob, 1);
+    job->_func = func;
+    job->_data = data;
+    job->_data_free = data_free;
+    job->_raster = raster;
+    job->_ref_count = 2;    /* The caller and the scheduler. */
+    job->_cancelled = FALSE;
+    job->completed = FALSE;
+    job->surface = NULL;
+
+    g_atomic_int_inc(&raster->ref_count);
+    raster->pending++;
+
+    ca_scheduler_submit(raster->scheduler, job_class, cancellable, _ca_raster_run, _ca_raster_on_done, (gpointer)job, NULL);
+
+    return job;
+}
+
+/**
+ * ca_raster_job_cancel:
+ * @job: A job returned by ca_raster_submit().
+ *
+ * Releases the caller's job; a job which has not started is not rasterized.
+ **/
+void
+ca_raster_job_cancel(CaRasterJob* job)
+{
+    g_atomic_int_set(&job->_cancelled, TRUE);
+
+    _ca_raster_job_unref(job);
+}
+
+/**
+ * ca_raster_collect:
+ * @raster: The raster of the jobs.
+ *
+ * Delivers the completed jobs of the raster's scheduler on the main thread, marking each job of
+ * the raster completed; only required when the scheduler has no main context.
+ *
+ * Returns: The number of jobs delivered.
+ **/
+gint
+ca_raster_collect(CaRaster* raster)
+{
+    return ca_scheduler_dispatch(raster->scheduler);
+}
+
+/**
+ * ca_raster_get_pending:
+ * @raster: The raster of the jobs.
+ *
+ * Retrieves the number of jobs which have been submitted but not yet delivered.
+ *
+ * Returns: The number of pending jobs.
+ **/
+gint
+ca_raster_get_pending(CaRaster* raster)
+{
+    return raster->pending;
+}
+
+/**
+ * _ca_raster_run:
+ * @data: The job to rasterize.
+ * @cancellable: The GCancellable of the job.
+ *
+ * Rasterizes a job on a worker thread unless its submitter has cancelled it.
+ *
+ * Returns: The rasterized surface; otherwise NULL.
+ **/
+static gpointer
+_ca_raster_run(gpointer data, GCancellable* cancellable)
+{
+    CaRasterJob* job;
+
+    job = (CaRasterJob*)data;
+
+    if (g_atomic_int_get(&job->_cancelled))
+        return NULL;
+
+    return (gpointer)job->_func(job->_data);
+}
+
+/**
+ * _ca_raster_on_done:
+ * @result: The rasterized surface; otherwise NULL.
+ * @cancelled: Whether the job was cancelled.
+ * @data: The job.
+ *
+ * Marks a job completed on the main thread and releases the scheduler's reference to it.
+ **/
+static void
+_ca_raster_on_done(gpointer result, gboolean cancelled, gpointer data)
+{
+    CaRasterJob* job;
+    CaRaster* raster;
+
+    job = (CaRasterJob*)data;
+    raster = job->_raster;
+
+    /* The surface of a cancelled job is freed with the job. */
+    job->surface = (cairo_surface_t*)result;
+    job->completed = TRUE;
+
+    raster->pending--;
+
+    if ((FALSE == cancelled) &&
+        (raster->completed_func != NULL))
+    {
+        raster->completed_func(raster->completed_data);
+    }
+
+    _ca_raster_job_unref(job);
+    _ca_raster_unref(raster);
+}
+
+/**
+ * _ca_raster_unref:
+ * @raster: The raster to release.
+ *
+ * Frees the raster once its owner and every job not yet delivered have released it.
+ **/
+static void
+_ca_raster_unref(CaRaster* raster)
+{
+    if (g_atomic_int_dec_and_test(&raster->ref_count))
+    {
+        ca_scheduler_unref(raster->scheduler);
+        g_free((gpointer)raster);
+    }
+}
+
+/**
+ * _ca_raster_job_unref:
+ * @job: The job to release.
+ *
+ * Frees the job, its surface and its data once both the caller and the scheduler have released
+ * it; this is always on the main thread.
+ **/
+static void
+_ca_raster_job_unref(CaRasterJob* job)
+{
+    if (g_atomic_int_dec_and_test(&job->_ref_count))
+    {
+        if (job->surface != NULL)
+        {
+            cairo_surface_destroy(job->surface);
+        }
+
+        if (job->_data_free != NULL)
+        {
+            job->_data_free(job->_data);
+        }
+
+        g_free((gpointer)job);
+    }
+}
@@ -0,0 +1,61 @@
+/* circular-main-menu
+ * Copyright (C) 2008 - Cole Anstey
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ * See http://code.google.com/p/circular-application-menu/
+ */
+#ifndef __CA_RASTER_H__
+#define __CA_RASTER_H__
+
+#include <cairo.h>
+#include <glib.h>
+
+#include "cmmscheduler.h"
+
+G_BEGIN_DECLS
+
+typedef struct _CaRaster CaRaster;
+typedef struct _CaRasterJob CaRasterJob;
+
+typedef cairo_surface_t* (*CaRasterFunc)(gpointer data);
+
+/* A surface rasterized on a worker thread; see: ca_raster_submit. */
+struct _CaRasterJob
+{
+    CaRasterFunc _func;                 /* Called on a worker thread. */
+    gpointer _data;                     /* Only read by the worker thread until the job has completed. */
+    GDestroyNotify _data_free;
+    CaRaster* _raster;                  /* A reference held until the job has been delivered. */
+    gint _ref_count;                    /* Held by the submitter and by the scheduler until it has delivered the job. */
+    gint _cancelled;                    /* Set by ca_raster_job_cancel; read by the worker thread. */
+    gboolean completed;                 /* The surface may be used; only read and written on the main thread. */
+    cairo_surface_t* surface;           /* Owned by the job; otherwise NULL if cancelled or failed. */
+};
+
+/* Construction */
+CaRaster* ca_raster_new(CaScheduler* scheduler, GSourceFunc completed_func, gpointer completed_data);
+void ca_raster_free(CaRaster* raster);
+
+/* Implementation */
+CaRasterJob* ca_raster_submit(CaRaster* raster, JobClass job_class, GCancellable* cancellable, CaRasterFunc func, gpointer data, GDestroyNotify data_free);
+void ca_raster_job_cancel(CaRasterJob* job);
+gint ca_raster_collect(CaRaster* raster);
+gint ca_raster_get_pending(CaRaster* raster);
+
+G_END_DECLS
+
+#endif
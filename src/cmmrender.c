@@ -0,0 +1,2661 @@
+/* circular-main-menu
+ * Copyright (C) 2008 - Cole Anstey
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ * See http://code.google.com/p/circular-application-menu/
+ */
+#include "cmmrender.h"
+#include "cmmmenuleaf.h"
+
+#include <gdk/gdk.h>
+#include <gio/gdesktopappinfo.h>
+
+#include <math.h>
+#include <string.h>
+
+typedef struct _RGBA RGBA;
+typedef struct _ClipExtents ClipExtents;
+typedef struct _FileLeafRender FileLeafRender;
+typedef struct _RasterSegments RasterSegments;
+typedef void (*FileLeafFunc)(const CaRenderContext* context, CaFileLeaf* fileleaf, gpointer data);
+
+struct _RGBA
+{
+    gdouble _r;
+    gdouble _g;
+    gdouble _b;
+    gdouble _a_pen;
+    gdouble _a_fill;
+    gdouble _line_width;
+};
+
+/* The extents of the clip in user space; nothing outside them is rendered. */
+struct _ClipExtents
+{
+    gdouble x1;
+    gdouble y1;
+    gdouble x2;
+    gdouble y2;
+};
+
+/* The render values kept with a file-leaf until it is laid out again. */
+struct _FileLeafRender
+{
+    cairo_surface_t* overlap_mask;      /* See: _ca_render_overlap; otherwise NULL. */
+    cairo_path_t** ring_paths;          /* The normal segments of each ring; NULL until a ring is visible. */
+    gint ring_count;
+    CaFileItem* associated_fileitem;    /* The file-item left out of the ring paths. */
+    CaRasterJob* segments_job;          /* The normal segments rasterized by a worker; otherwise NULL. */
+    CaFileItem* segments_associated_fileitem;
+    gboolean segments_reflection_off;
+    gint segments_x;                    /* The surface origin; see: OFFSET_2_SCREEN. */
+    gint segments_y;
+    cairo_region_t* shape;              /* The bounding circle in the offset co-ordinates; otherwise NULL. */
+    gint shape_x;                       /* The file-leaf position and bound radius the shape was built for. */
+    gint shape_y;
+    gint shape_radius;
+    cairo_surface_t* surface;           /* The file-leaf rendered without prelight; see: _ca_render_cached_fileleaf. */
+    gint surface_x;                     /* The surface origin in the offset co-ordinates. */
+    gint surface_y;
+    gint surface_radius;
+    CaFileItem* surface_associated_fileitem;
+    GList* surface_unresolved;          /* The file-leaf icons still unresolved when the surface was rendered. */
+    GdkPixbuf* surface_tab_pixbuf;
+    gboolean surface_disassociated;
+    gboolean surface_reflection_off;
+};
+
+/* The normal segments of a file-leaf to rasterize; only read by the worker thread. */
+struct _RasterSegments
+{
+    cairo_path_t* path;                 /* In the offset co-ordinates. */
+    gint x;                             /* The surface origin in the offset co-ordinates. */
+    gint y;
+    gint width;
+    gint height;
+    gdouble x_scale;                    /* The device scale of the target. */
+    gdouble y_scale;
+    GdkPixbuf* light_pixbuf;
+    gboolean render_reflection_off;
+};
+
+#define CRGB(x)                 (x / 255.0)
+
+/* Defines the colours etc.         Red        Green      Blue       Apen   Afill   lwidth   */
+//RGBA g_normal_segment_rgba      = { CRGB(205), CRGB(233), CRGB(241), 0.8,   0.8,    0.0 };
+//RGBA g_prelight_segment_rgba    = { CRGB(205), CRGB(233), CRGB(241), 1.0,   0.9,    0.0 };
+//RGBA g_outer_inner_rgba         = { CRGB(205), CRGB(233), CRGB(241), 1.0,   0.8,    1.0 };
+
+RGBA g_normal_segment_rgba      = { CRGB(0), CRGB(0), CRGB(0), 0.8,   0.8,    1.0 };
+RGBA g_prelight_segment_rgba    = { CRGB(0), CRGB(0), CRGB(0), 1.0,   0.9,    1.0 };
+RGBA g_outer_inner_rgba         = { CRGB(0), CRGB(0), CRGB(0), 1.0,   0.8,    1.0 };
+
+RGBA g_outer1_rgba              = { CRGB(0),   CRGB(0),   CRGB(0),   1.0,   0.0,    0.0 };  /* Aline + lwidth unused. */
+RGBA g_outer2_rgba              = { CRGB(255), CRGB(255), CRGB(255), 0.5,   0.0,    0.0 };  /* Aline + lwidth unused. */
+
+RGBA g_text_box_rgba            = { CRGB(0),   CRGB(0),   CRGB(0),   0.0,   0.8,    0.0 };
+RGBA g_text_rgba                = { CRGB(255), CRGB(255), CRGB(255), 0.0,   1.0,    0.0 };
+RGBA g_background_rgba          = { CRGB(96),  CRGB(96),  CRGB(96),  0.0,   1.0,    0.0 };  /* Aline + lwidth unused. */
+
+/* Constants. */
+#define OVERLAP_TRANSLUCENCY            0.75    /* The translucency for overlapped parent menus. */
+#define TEXT_BOUNDARY                   1.0     /* The boundary surrounding the text. */
+#define SHAPE_STRIP_HEIGHT              4       /* The rows of a bounding circle covered by each rectangle of a shape. */
+#define LEAF_SURFACE_MARGIN             2       /* The pixels a file-leaf surface extends beyond the bound radius. */
+#define CLOSE_MENU_TEXT                 "close the menu"
+#define CLOSE_SUB_MENU_TEXT             "close the sub menu"
+#define NEXT_PAGE_TEXT                  "next page (%d of %d)"
+
+static void _ca_render_fileleaves(const CaRenderContext* context, cairo_t* cr);
+static void _ca_render_reflection(const CaRenderContext* context, cairo_t* cr);
+static void _ca_render_fileleaf(const CaRenderContext* context, CaFileLeaf* fileleaf, cairo_t* cr);
+static void _ca_render_cached_fileleaf(const CaRenderContext* context, CaFileLeaf* fileleaf, cairo_t* cr);
+static gboolean _ca_render_is_fileleaf_prelit(const CaRenderContext* context, CaFileLeaf* fileleaf);
+static void _ca_render_opening_fileleaf(const CaRenderContext* context, CaFileLeaf* fileleaf, cairo_t* cr);
+static void _ca_render_overlap(const CaRenderContext* context, CaFileLeaf* fileleaf, cairo_path_t* path, cairo_t* cr);
+static void _ca_render_text(const CaRenderContext* context, cairo_rectangle_int_t* extents, cairo_t* cr);
+static void _ca_render_centred_text(const CaRenderContext* context, gint y, const gchar* text, cairo_rectangle_int_t* extents, cairo_t* cr);
+static void _ca_render_add_extents(cairo_rectangle_int_t* extents, gdouble x1, gdouble y1, gdouble x2, gdouble y2);
+static void _ca_render_add_text_extents(const CaRenderContext* context, cairo_rectangle_int_t* extents);
+static void _ca_render_add_glyph_extents(const CaRenderContext* context, CaFileLeaf* fileleaf, cairo_rectangle_int_t* extents);
+static void _ca_render_add_fileleaf_extents(const CaRenderContext* context, CaFileLeaf* fileleaf, gpointer data);
+static void _ca_render_add_fileleaf_shape(const CaRenderContext* context, CaFileLeaf* fileleaf, gpointer data);
+static cairo_region_t* _ca_render_circle_region(gint x, gint y, gint radius);
+static void _ca_render_foreach_fileleaf(const CaRenderContext* context, FileLeafFunc func, gpointer data);
+static FileLeafRender* _ca_render_get_fileleaf_render(CaFileLeaf* fileleaf);
+static void _ca_render_free_ring_paths(FileLeafRender* render);
+static void _ca_render_fileleaf_render_free(gpointer data);
+static void _ca_render_segment_path(const CaRenderContext* context, CaFileLeaf* fileleaf, CaFileItem* fileitem, cairo_t* cr);
+static void _ca_render_segments(const CaRenderContext* context, const RGBA* rgba, cairo_t* cr);
+static cairo_path_t* _ca_render_ring_path(const CaRenderContext* context, CaFileLeaf* fileleaf, gint ring, CaFileItem* associated_fileitem, cairo_t* cr);
+static gboolean _ca_render_rasterized_segments(const CaRenderContext* context, CaFileLeaf* fileleaf, FileLeafRender* render, CaFileItem* associated_fileitem, CaFileItem* current_fileitem, const ClipExtents* clip, cairo_t* cr);
+static cairo_surface_t* _ca_render_raster_segments(gpointer data);
+static void _ca_render_raster_segments_free(gpointer data);
+static gboolean _ca_render_is_ring_visible(const CaRenderContext* context, CaFileLeaf* fileleaf, const ClipExtents* clip, gint ring);
+static GList* _ca_render_next_visible_fileitem(const CaRenderContext* context, CaFileLeaf* fileleaf, const ClipExtents* clip, GList* file_list, gint* ring, gint* fileitem_count);
+
+/**
+ * ca_render_frame:
+ * @context: The state to render.
+ * @cr: A cairo-context to render to.
+ *
+ * Renders a complete frame of the circular-application-menu; the file-leaves followed by the
+ * name and comment of the current file-item.
+ */
+void
+ca_render_frame(const CaRenderContext* context, cairo_t* cr)
+{
+    /* Render the file-leaves. */
+    ca_render_scene(context, cr);
+
+    /* Render text. */
+    ca_render_text(context, cr);
+}
+
+/**
+ * ca_render_scene:
+ * @context: The state to render.
+ * @cr: A cairo-context to render to.
+ *
+ * Renders the file-leaves over a cleared view; the text is left to ca_render_text() so a scene
+ * may be kept and composited again while the view is moved.
+ */
+void
+ca_render_scene(const CaRenderContext* context, cairo_t* cr)
+{
+    cairo_set_fill_rule (cr, CAIRO_FILL_RULE_EVEN_ODD);
+
+    /* Trade the quality of the arcs and edges for speed whilst the menu is moving. */
+    if (TRUE == context->render_fast)
+    {
+        cairo_set_tolerance (cr, FAST_RENDER_TOLERANCE);
+        cairo_set_antialias (cr, CAIRO_ANTIALIAS_FAST);
+    }
+
+    /* draw the background */
+    ca_render_background(context, cr);
+
+    /* VM - Non transparent debug. */
+    /*
+    cairo_rectangle (cr, 0, 0, widget->allocation.width, widget->allocation.height);
+    cairo_set_source_rgba (cr, 0.8, 0.8, 0.8, 1.0);
+    cairo_fill (cr);
+    */
+
+    /* Draw a gradient circle. */
+    /* FIXME: Bit slow this and not working quite right.  Turn off for now.
+    {
+        cairo_set_source_rgba(cr, 1, 1, 1, 0.9);
+        cairo_rectangle(cr, 0, 0, 500, 500);
+        cairo_fill(cr);
+        cairo_stroke(cr);
+
+        cairo_pattern_t* pattern;
+
+        pattern = cairo_pattern_create_radial(
+            widget->allocation.width / 2,
+            widget->allocation.height / 2,
+            widget->allocation.height / 8,
+            widget->allocation.width / 2,
+            widget->allocation.height / 2,
+            widget->allocation.height);
+
+        cairo_pattern_add_color_stop_rgba (pattern, 0.0, 0.0, 0.0, 0.0, 1.0);
+        cairo_pattern_add_color_stop_rgba (pattern, 1.0, 0.0, 0.0, 0.1, 0.0);
+
+        cairo_set_source (cr, pattern);
+        cairo_mask (cr, pattern);
+
+        cairo_pattern_destroy (pattern);
+    }
+    */
+
+    cairo_rectangle (
+        cr,
+        0,
+        0,
+        context->view_width,
+        context->view_height);
+
+    cairo_clip (cr);
+    
+	/* Render the circular-application-menu to a cairo context. */
+    _ca_render_fileleaves(context, cr);
+}
+
+/**
+ * ca_render_background:
+ * @context: The state to render.
+ * @cr: A cairo-context to render to.
+ *
+ * Clears the view, or paints it with an opaque background for a window without an alpha channel;
+ * the operator is left as CAIRO_OPERATOR_OVER.
+ */
+void
+ca_render_background(const CaRenderContext* context, cairo_t* cr)
+{
+    if (TRUE == context->render_opaque)
+    {
+        cairo_set_operator (cr, CAIRO_OPERATOR_SOURCE);
+        cairo_set_source_rgba (cr, g_background_rgba._r, g_background_rgba._g, g_background_rgba._b, g_background_rgba._a_fill);
+    }
+    else
+    {
+        cairo_set_operator (cr, CAIRO_OPERATOR_CLEAR);
+    }
+
+    cairo_paint (cr);
+    cairo_set_operator (cr, CAIRO_OPERATOR_OVER);
+}
+
+/**
+ * ca_render_text:
+ * @context: The state to render.
+ * @cr: A cairo-context to render to.
+ *
+ * Renders the name and comment of the current file-item, or what the current glyph does, at the
+ * foot of the view.
+ */
+void
+ca_render_text(const CaRenderContext* context, cairo_t* cr)
+{
+    _ca_render_text(context, NULL, cr);
+}
+
+/**
+ * ca_render_get_extents:
+ * @context: The state to render.
+ * @extents: A return location for the extents, in view co-ordinates; the width and height are 0
+ * when nothing would be rendered.
+ *
+ * Calculates the rectangle a frame renders into; the bounding circles of the shown file-leaves and
+ * the text surround.  The extents are not clipped to the view.
+ */
+void
+ca_render_get_extents(const CaRenderContext* context, cairo_rectangle_int_t* extents)
+{
+    extents->x = 0;
+    extents->y = 0;
+    extents->width = 0;
+    extents->height = 0;
+
+    _ca_render_foreach_fileleaf(context, _ca_render_add_fileleaf_extents, (gpointer)extents);
+    _ca_render_add_text_extents(context, extents);
+}
+
+/**
+ * ca_render_get_shape:
+ * @context: The state to render.
+ * @shape: The region to add the shape to, in view co-ordinates.
+ *
+ * Adds the pixels a frame may render to a region; the bounding circles of the shown file-leaves,
+ * each of which covers its tab, and the text surround.  The circles are covered by rectangles
+ * SHAPE_STRIP_HEIGHT high, which are kept with each file-leaf so only the file-leaves laid out
+ * since the last shape are calculated; a file-leaf which is opening is covered by a rectangle.
+ */
+void
+ca_render_get_shape(const CaRenderContext* context, cairo_region_t* shape)
+{
+    cairo_region_t* offset_shape;
+    cairo_rectangle_int_t text;
+
+    offset_shape = cairo_region_create();
+
+    _ca_render_foreach_fileleaf(context, _ca_render_add_fileleaf_shape, (gpointer)offset_shape);
+
+    cairo_region_translate(offset_shape, -context->view_x_offset, -context->view_y_offset);
+    cairo_region_union(shape, offset_shape);
+    cairo_region_destroy(offset_shape);
+
+    text.x = 0;
+    text.y = 0;
+    text.width = 0;
+    text.height = 0;
+
+    _ca_render_add_text_extents(context, &text);
+
+    if ((text.width > 0) &&
+        (text.height > 0))
+    {
+        cairo_region_union_rectangle(shape, &text);
+    }
+}
+
+/**
+ * ca_render_add_current_damage:
+ * @context: The state to render.
+ * @damage: The region to add the damage to, in view co-ordinates.
+ *
+ * Adds the rectangles the prelight of the current glyph renders into to a region; the segment of
+ * the current file-item or the surround of the current central glyph, and the text surround.  When
+ * only the current glyph changes, a frame only differs within the damage before and after.
+ */
+void
+ca_render_add_current_damage(const CaRenderContext* context, cairo_region_t* damage)
+{
+    CaFileItem* fileitem;
+    cairo_rectangle_int_t extents;
+
+    extents.x = 0;
+    extents.y = 0;
+    extents.width = 0;
+    extents.height = 0;
+
+    if ((GLYPH_ROOT_CENTRE == context->current_type) &&
+        (context->root_fileleaf != NULL))
+    {
+        _ca_render_add_glyph_extents(context, context->root_fileleaf, &extents);
+    }
+    else if ((GLYPH_FILE_MENU_CENTRE == context->current_type) &&
+             (context->current_fileleaf != NULL))
+    {
+        _ca_render_add_glyph_extents(context, context->current_fileleaf, &extents);
+    }
+
+    fileitem = context->current_fileitem;
+
+    if ((fileitem != NULL) &&
+        (fileitem->_assigned_fileleaf != NULL) &&
+        (fileitem != fileitem->_assigned_fileleaf->_central_glyph))
+    {
+        cairo_surface_t* surface;
+        cairo_t* cr;
+        gdouble x1;
+        gdouble y1;
+        gdouble x2;
+        gdouble y2;
+
+        /* The segment holds the icon and any arrow; half of its outline lies outside it. */
+        surface = cairo_image_surface_create(CAIRO_FORMAT_A8, 1, 1);
+        cr = cairo_create(surface);
+
+        _ca_render_segment_path(context, fileitem->_assigned_fileleaf, fileitem, cr);
+        cairo_set_line_width(cr, g_prelight_segment_rgba._line_width);
+        cairo_stroke_extents(cr, &x1, &y1, &x2, &y2);
+
+        cairo_destroy(cr);
+        cairo_surface_destroy(surface);
+
+        _ca_render_add_extents(&extents, x1, y1, x2, y2);
+    }
+
+    if ((extents.width > 0) &&
+        (extents.height > 0))
+    {
+        cairo_region_union_rectangle(damage, &extents);
+    }
+
+    /* The text lies apart from the glyph, at the foot of the view. */
+    extents.x = 0;
+    extents.y = 0;
+    extents.width = 0;
+    extents.height = 0;
+
+    _ca_render_add_text_extents(context, &extents);
+
+    if ((extents.width > 0) &&
+        (extents.height > 0))
+    {
+        cairo_region_union_rectangle(damage, &extents);
+    }
+}
+
+/**
+ * ca_render_get_canvas:
+ * @context: The state to render.
+ * @canvas: A return location for the canvas, in view co-ordinates.
+ *
+ * Calculates the smallest canvas a frame may be rendered to instead of the whole view; the
+ * extents of the frame grown by CANVAS_MARGIN and rounded out to CANVAS_GRANULARITY, within the
+ * view.  A frame which renders nothing has a canvas of CANVAS_GRANULARITY at the view centre.
+ */
+void
+ca_render_get_canvas(const CaRenderContext* context, cairo_rectangle_int_t* canvas)
+{
+    cairo_rectangle_int_t extents;
+    gint left;
+    gint top;
+    gint right;
+    gint bottom;
+
+    ca_render_get_extents(context, &extents);
+
+    if ((extents.width > 0) &&
+        (extents.height > 0))
+    {
+        left = (gint)floor((gdouble)(extents.x - CANVAS_MARGIN) / CANVAS_GRANULARITY) * CANVAS_GRANULARITY;
+        top = (gint)floor((gdouble)(extents.y - CANVAS_MARGIN) / CANVAS_GRANULARITY) * CANVAS_GRANULARITY;
+        right = (gint)ceil((gdouble)(extents.x + extents.width + CANVAS_MARGIN) / CANVAS_GRANULARITY) * CANVAS_GRANULARITY;
+        bottom = (gint)ceil((gdouble)(extents.y + extents.height + CANVAS_MARGIN) / CANVAS_GRANULARITY) * CANVAS_GRANULARITY;
+
+        left = MAX(left, 0);
+        top = MAX(top, 0);
+        right = MIN(right, context->view_width);
+        bottom = MIN(bottom, context->view_height);
+    }
+    else
+    {
+        left = right = top = bottom = 0;
+    }
+
+    if ((right <= left) ||
+        (bottom <= top))
+    {
+        left = MAX((context->view_width - CANVAS_GRANULARITY) / 2, 0);
+        top = MAX((context->view_height - CANVAS_GRANULARITY) / 2, 0);
+        right = MIN(left + CANVAS_GRANULARITY, context->view_width);
+        bottom = MIN(top + CANVAS_GRANULARITY, context->view_height);
+    }
+
+    canvas->x = left;
+    canvas->y = top;
+    canvas->width = right - left;
+    canvas->height = bottom - top;
+}
+
+/**
+ * _ca_render_text:
+ * @context: The state to render.
+ * @extents: The extents to add the text surround to rather than rendering it; otherwise NULL.
+ * @cr: A cairo-context to render to.
+ *
+ * Renders the name and comment of the current file-item, or what the current glyph does.
+ */
+static void
+_ca_render_text(const CaRenderContext* context, cairo_rectangle_int_t* extents, cairo_t* cr)
+{
+    gint y;
+
+    /* Calculate the text position. */
+    y = context->view_height - (context->view_height / 7);
+
+    if (context->current_type == GLYPH_ROOT_CENTRE)
+    {
+		/* Render the text to a cairo context. */
+        _ca_render_centred_text(
+            context,
+            y,
+            CLOSE_MENU_TEXT,
+            extents,
+            cr);
+    }
+    else if (context->current_type == GLYPH_FILE_MENU_CENTRE)
+    {
+		/* Render the text to a cairo context. */
+        _ca_render_centred_text(
+            context,
+            y,
+            CLOSE_SUB_MENU_TEXT,
+            extents,
+            cr);
+    }
+    else if ((context->current_type == GLYPH_PAGE) &&
+        (context->current_fileleaf != NULL))
+    {
+        gchar* text;
+
+        text = g_strdup_printf(NEXT_PAGE_TEXT, context->current_fileleaf->_page + 1, context->current_fileleaf->_page_count);
+
+		/* Render the text to a cairo context. */
+        _ca_render_centred_text(
+            context,
+            y,
+            text,
+            extents,
+            cr);
+
+        g_free((gpointer)text);
+    }
+    else if ((context->current_type != GLYPH_UNKNOWN) &&
+        (context->current_fileitem != NULL) &&
+        (CA_MENU_FILEITEM(context->current_fileitem) != NULL) &&
+        (CA_MENU_FILEITEM(context->current_fileitem)->menutreeitem != NULL) &&
+        (context->current_fileleaf != context->disassociated_fileleaf))
+    {
+        const gchar* name;
+        const gchar* comment;
+
+        name = NULL;
+        comment = NULL;
+
+        if (context->current_type == GLYPH_FILE_MENU)
+        {
+            name = gmenu_tree_directory_get_name(CA_MENU_FILEITEM(context->current_fileitem)->menutreeitem);
+            comment = gmenu_tree_directory_get_comment(CA_MENU_FILEITEM(context->current_fileitem)->menutreeitem);
+        }
+        else
+        {
+            /* https://github.com/frida/glib/blob/master/gio/gdesktopappinfo.c */
+            GDesktopAppInfo* desktop_app_info;
+
+            desktop_app_info = gmenu_tree_entry_get_app_info(CA_MENU_FILEITEM(context->current_fileitem)->menutreeitem);
+
+            name = g_desktop_app_info_get_string(desktop_app_info, "Name");
+            comment = g_desktop_app_info_get_string(desktop_app_info, "Comment");
+        }
+
+        /* Name. */
+
+        /* Render the text to a cairo context. */
+        _ca_render_centred_text(
+            context,
+            y,
+            (name != NULL) ? name : "",
+            extents,
+            cr);
+
+        y += 25;
+
+        /* Comment. */
+
+        /* Render the text to a cairo context. */
+        _ca_render_centred_text(
+            context,
+            y,
+            (comment != NULL) ? comment : "",
+            extents,
+            cr);
+    }
+
+}
+
+/**
+ * ca_render_discard:
+ * @fileleaf: A file-leaf.
+ *
+ * Frees the render values kept with a file-leaf, so it is rendered as if it had just been laid
+ * out; any rasterization in progress is cancelled.
+ */
+void
+ca_render_discard(CaFileLeaf* fileleaf)
+{
+    CaMenuFileLeaf* menufileleaf;
+
+    menufileleaf = CA_MENU_FILELEAF(fileleaf);
+
+    if (menufileleaf->render_data != NULL)
+    {
+        menufileleaf->render_data_free(menufileleaf->render_data);
+        menufileleaf->render_data = NULL;
+    }
+}
+
+/**
+ * _ca_render_fileleaves:
+ * @context: The state to render.
+ * @cr: A cairo-context to render to.
+ *
+ * Renders the circular-application-menu to a cairo context.
+ */
+static void
+_ca_render_fileleaves(const CaRenderContext* context, cairo_t* cr)
+{
+    CaFileLeaf* current_fileleaf;
+    gboolean render_fileleaf;
+
+    if (context->root_fileleaf == NULL)
+        return;
+
+    /* Render all fileleafs. */
+
+    current_fileleaf = context->root_fileleaf;  /* There should always at least one fileleaf at this point. */
+
+    /* Iterate the fileleafs. */
+    do
+    {
+        GList* sub_list;
+
+        /* Check whether the fileleaf should be rendered. */
+        render_fileleaf = TRUE;
+
+        if (context->render_tabbed_only)
+        {
+            if (current_fileleaf != context->tabbed_fileleaf)
+            {
+                render_fileleaf = FALSE;
+            }
+        }
+
+        if (render_fileleaf)
+        {
+            if (current_fileleaf->_current_animation_state == INITIAL_OPEN)
+            {
+                /* Render the file-leaf growing out of its parent segment. */
+                _ca_render_opening_fileleaf(context, current_fileleaf, cr);
+            }
+            else
+            {
+                /* Render the file-leaf to a cairo context. */
+                _ca_render_cached_fileleaf(context, current_fileleaf, cr);
+            }
+        }
+
+        /* Iterate the sub fileleafs. */
+        sub_list = g_list_first(current_fileleaf->_sub_fileleaves_list);
+
+        while (sub_list)
+        {
+            CaFileLeaf* sub_fileleaf;
+
+            sub_fileleaf = (CaFileLeaf*)sub_list->data;
+            g_assert(sub_fileleaf != NULL);
+
+            /* Check whether the fileleaf should be rendered. */
+            render_fileleaf = TRUE;
+
+            if (context->render_tabbed_only)
+            {
+                if (sub_fileleaf != context->tabbed_fileleaf)
+                {
+                    render_fileleaf = FALSE;
+                }
+            }
+
+            if (render_fileleaf)
+            {
+			    /* Render the file-leaf to a cairo context. */
+                _ca_render_cached_fileleaf(context, sub_fileleaf, cr);
+            }
+
+            sub_list = g_list_next(sub_list);
+        }
+
+        /* Get next child fileleaf. */
+        current_fileleaf = current_fileleaf->_child_fileleaf;
+    }
+    while (current_fileleaf != NULL);
+
+	/* Render the disassociated fileleaf. */
+    if (context->disassociated_fileleaf != NULL)
+    {
+        /* Render the file-leaf to a cairo context. */
+        _ca_render_cached_fileleaf(context, context->disassociated_fileleaf, cr);
+	}
+}
+
+/**
+ * _ca_render_reflection:
+ * @context: The state to render.
+ * @cr: A cairo-context to render to.
+ *
+ * Renders the reflection alpha to the cairo context.
+ */
+static void
+_ca_render_reflection(const CaRenderContext* context, cairo_t* cr)
+{
+    // see GskBlurMode Gtk+4.0
+
+    double x1;
+    double y1;
+    double x2;
+    double y2;
+    gint offset_x_start;
+    gint offset_y_start;
+    gint x;
+    gint y;
+    gint width;
+    gint height;
+
+    /* The reflection is the most expensive part of a frame; leave it out whilst moving. */
+    if (TRUE == context->render_fast)
+        return;
+
+    cairo_fill_extents(cr, &x1, &y1, &x2, &y2);
+
+    // 1472x50 the reflection will be stretched.
+    width = gdk_pixbuf_get_width(context->light_pixbuf);
+    height = gdk_pixbuf_get_height(context->light_pixbuf);
+
+    /* Offset the image. */
+    offset_x_start = ((gint)y1 / height) * 31;
+    offset_y_start = ((gint)y1 % height);
+
+    cairo_save(cr);
+    cairo_clip_preserve(cr);
+
+    x = offset_x_start;
+
+    //g_print("Render reflection: w:%d h:%d t:%d b:%d\n", width, height, (y1 - offset_y_start), y2);
+
+    for(y = (y1 - offset_y_start); y < y2; y += height)
+    {
+        gdk_cairo_set_source_pixbuf (cr, context->light_pixbuf, x, y);
+        cairo_paint_with_alpha(cr, 1.0);
+
+        x += 31;
+    }
+
+    cairo_restore(cr);
+}
+
+/**
+ * _ca_render_fileleaf:
+ * @context: The state to render.
+ * @fileleaf: A file-leaf to render.
+ * @cr: A cairo-context to render to.
+ *
+ * Renders the file-leaf to a cairo context.  A file-leaf outside the clip is skipped, as are the
+ * rings outside it of a file-leaf which is partly visible.
+ */
+static void
+_ca_render_fileleaf(
+	const CaRenderContext* context,
+	CaFileLeaf* fileleaf,
+	cairo_t* cr)
+{
+    GList* file_list;
+    CaFileItem* associated_fileitem;
+    ClipExtents clip;
+    gint ring;
+    gint fileitem_count;
+
+    /* The clip is in user space so this also holds while the file-leaf is being scaled open. */
+    cairo_clip_extents(cr, &clip.x1, &clip.y1, &clip.x2, &clip.y2);
+
+    if (!ca_geometry_annulus_intersects_rectangle(
+        OFFSET_2_SCREEN(fileleaf->x, context->view_x_offset),
+        OFFSET_2_SCREEN(fileleaf->y, context->view_y_offset),
+        0,
+        fileleaf->bound_radius,
+        clip.x1,
+        clip.y1,
+        clip.x2,
+        clip.y2))
+    {
+        return;
+    }
+
+    /* Render the fileleaf. */
+    if (fileleaf == context->disassociated_fileleaf)
+    {
+        cairo_path_t* path;
+
+        /* Render the disassociated menu outer. */
+        cairo_arc (
+            cr,
+            OFFSET_2_SCREEN(fileleaf->x, context->view_x_offset),
+            OFFSET_2_SCREEN(fileleaf->y, context->view_y_offset),
+            fileleaf->radius + RADIUS_SPACER,
+            0,
+            DEGREE_2_RADIAN(360));
+
+        path = cairo_copy_path(cr);
+
+        /* Make any overlapped portions of a parent menu appear more translucent. */
+        _ca_render_overlap(context, fileleaf, path, cr);
+
+        cairo_arc (
+            cr,
+            OFFSET_2_SCREEN(fileleaf->x, context->view_x_offset),
+            OFFSET_2_SCREEN(fileleaf->y, context->view_y_offset),
+            fileleaf->radius,
+            0,
+            DEGREE_2_RADIAN(360));
+
+        cairo_new_sub_path (cr);
+
+        /* Render to the cairo context. */
+        cairo_set_source_rgba (cr, g_outer_inner_rgba._r, g_outer_inner_rgba._g, g_outer_inner_rgba._b, g_outer_inner_rgba._a_fill);
+        cairo_fill_preserve (cr);
+
+        /* Render reflections. */
+        if (FALSE == context->render_reflection_off)
+        {
+            _ca_render_reflection(context, cr);
+        }
+
+        cairo_new_path(cr);
+        cairo_append_path(cr, path);
+
+        /* Outline with a lighter colour. */
+        cairo_clip_preserve(cr);
+        cairo_set_line_width (cr, g_outer_inner_rgba._line_width * 3 /*Overlap from edge*/);
+        cairo_set_source_rgba (cr, g_outer2_rgba._r, g_outer2_rgba._g, g_outer2_rgba._b, g_outer2_rgba._a_pen);
+        cairo_stroke_preserve (cr);
+        cairo_reset_clip(cr);
+
+        /* Outline with a darker colour. */
+        cairo_set_line_width (cr, g_outer_inner_rgba._line_width);
+        cairo_set_source_rgba (cr, g_outer1_rgba._r, g_outer1_rgba._g, g_outer1_rgba._b, g_outer1_rgba._a_pen);
+        cairo_stroke (cr);
+
+        cairo_path_destroy(path);
+    }
+    else if (fileleaf == context->root_fileleaf)
+    {
+        cairo_path_t* path;
+
+        /* Render the root menu outer. */
+        cairo_arc (
+            cr,
+            OFFSET_2_SCREEN(fileleaf->x, context->view_x_offset),
+            OFFSET_2_SCREEN(fileleaf->y, context->view_y_offset),
+            fileleaf->radius + RADIUS_SPACER,
+            0,
+            DEGREE_2_RADIAN(360));
+
+        path = cairo_copy_path(cr);
+
+        cairo_new_sub_path (cr);
+
+        cairo_arc (
+            cr,
+            OFFSET_2_SCREEN(fileleaf->x, context->view_x_offset),
+            OFFSET_2_SCREEN(fileleaf->y, context->view_y_offset),
+            fileleaf->radius,
+            0,
+            DEGREE_2_RADIAN(360));
+
+        /* Render to the cairo context. */
+        cairo_set_source_rgba (cr, g_outer_inner_rgba._r, g_outer_inner_rgba._g, g_outer_inner_rgba._b, g_outer_inner_rgba._a_fill);
+        cairo_fill_preserve (cr);
+
+        /* Render reflections. */
+        if (FALSE == context->render_reflection_off)
+        {
+            _ca_render_reflection(context, cr);
+        }
+
+        cairo_new_path(cr);
+        cairo_append_path(cr, path);
+
+        /* Outline with a lighter colour. */
+        cairo_clip_preserve(cr);
+        cairo_set_line_width (cr, g_outer_inner_rgba._line_width * 3 /*Overlap from edge*/);
+        cairo_set_source_rgba (cr, g_outer2_rgba._r, g_outer2_rgba._g, g_outer2_rgba._b, g_outer2_rgba._a_pen);
+        cairo_stroke_preserve (cr);
+        cairo_reset_clip(cr);
+
+        /* Outline with a darker colour. */
+        cairo_set_line_width (cr, g_outer_inner_rgba._line_width);
+        cairo_set_source_rgba (cr, g_outer1_rgba._r, g_outer1_rgba._g, g_outer1_rgba._b, g_outer1_rgba._a_pen);
+        cairo_stroke (cr);
+
+        cairo_path_destroy(path);
+
+        /* The root menu won't have any overlapped parent menus. */
+    }
+    else
+    {
+        /* Render a child menu outer. */
+        /*
+         C   E
+         B   F
+        A     A
+        A     A
+        A     A
+         AAAAA
+        */
+
+        gdouble parent_angle;
+        cairo_path_t* path;
+
+        parent_angle = fileleaf->_central_glyph->_parent_angle;
+
+        if (fileleaf->_menu_render == NULL)
+        {
+            gdouble circumference_percentage;
+            gdouble common_angle;
+
+            fileleaf->_menu_render = g_new(CaMenuRender, 1);
+
+            /* Smaller the circumference then larger the angle. */
+            circumference_percentage =
+            	context->geometry->tab_width / ca_geometry_circumference_from_radius(fileleaf->radius + RADIUS_SPACER);
+            common_angle = (360.0 * circumference_percentage);
+
+            /* Calculate the nearest lowest and highest angle. */
+            fileleaf->_menu_render->lowest_angle_nearest =
+            	ca_geometry_calculate_angle_offset(parent_angle, -(common_angle / 2));
+            fileleaf->_menu_render->highest_angle_nearest =
+            	ca_geometry_calculate_angle_offset(parent_angle, (common_angle / 2));
+
+            /* Get B F information */
+            fileleaf->_menu_render->Bcircle_lowest_angle =
+            	ca_geometry_calculate_angle_offset(parent_angle, 90.0);
+            fileleaf->_menu_render->Bcircle_highest_angle =
+            	ca_geometry_calculate_angle_offset(fileleaf->_menu_render->lowest_angle_nearest, 180.0);
+
+            fileleaf->_menu_render->Fcircle_lowest_angle =
+            	ca_geometry_calculate_angle_offset(fileleaf->_menu_render->highest_angle_nearest, 180.0);
+            fileleaf->_menu_render->Fcircle_highest_angle =
+            	ca_geometry_calculate_angle_offset(parent_angle, -90.0);
+
+            ca_geometry_point_from_source_offset(
+                fileleaf->_central_glyph->x,
+                fileleaf->_central_glyph->y,
+                fileleaf->_menu_render->lowest_angle_nearest,
+                fileleaf->radius + RADIUS_SPACER + CLOSEST_TAB_CIRCLE_RADIUS,
+                &fileleaf->_menu_render->Bcircle_x,
+                &fileleaf->_menu_render->Bcircle_y);
+
+            ca_geometry_point_from_source_offset(
+                fileleaf->_central_glyph->x,
+                fileleaf->_central_glyph->y,
+                fileleaf->_menu_render->highest_angle_nearest,
+                fileleaf->radius + RADIUS_SPACER + CLOSEST_TAB_CIRCLE_RADIUS,
+                &fileleaf->_menu_render->Fcircle_x,
+                &fileleaf->_menu_render->Fcircle_y);
+
+            ca_geometry_point_from_source_offset(
+                fileleaf->_menu_render->Bcircle_x,
+                fileleaf->_menu_render->Bcircle_y,
+                fileleaf->_menu_render->Bcircle_lowest_angle,
+                CLOSEST_TAB_CIRCLE_RADIUS,
+                &fileleaf->_menu_render->Bcircle_arc_x,
+                &fileleaf->_menu_render->Bcircle_arc_y);
+
+            /* Get gap information. */
+
+            /* Smaller the circumference then larger the angle. */
+            circumference_percentage =
+                context->geometry->tab_width /
+            	ca_geometry_circumference_from_radius(
+					fileleaf->radius + RADIUS_SPACER + CLOSEST_TAB_CIRCLE_RADIUS + context->geometry->tab_height + FARTHEST_TAB_CIRCLE_RADIUS);
+
+            common_angle = (360.0 * circumference_percentage) / 2;
+
+            fileleaf->_menu_render->lowest_angle_farthest =
+            	ca_geometry_calculate_angle_offset(parent_angle, -(common_angle / 2));
+            fileleaf->_menu_render->highest_angle_farthest =
+            	ca_geometry_calculate_angle_offset(parent_angle, common_angle / 2);
+
+            /* Get C E information */
+            fileleaf->_menu_render->Ccircle_lowest_angle =
+            	ca_geometry_calculate_angle_offset(parent_angle, -90.0);
+            fileleaf->_menu_render->Ccircle_highest_angle = parent_angle;
+
+            fileleaf->_menu_render->Ecircle_lowest_angle = parent_angle;
+            fileleaf->_menu_render->Ecircle_highest_angle =
+            	ca_geometry_calculate_angle_offset(parent_angle, 90.0);
+
+            ca_geometry_point_from_source_offset(
+                fileleaf->_central_glyph->x,
+                fileleaf->_central_glyph->y,
+                fileleaf->_menu_render->lowest_angle_farthest,
+                fileleaf->radius + RADIUS_SPACER + FARTHEST_TAB_CIRCLE_RADIUS + context->geometry->tab_height,
+                &fileleaf->_menu_render->Ccircle_x,
+                &fileleaf->_menu_render->Ccircle_y);
+
+            ca_geometry_point_from_source_offset(
+                fileleaf->_central_glyph->x,
+                fileleaf->_central_glyph->y,
+                fileleaf->_menu_render->highest_angle_farthest,
+                fileleaf->radius + RADIUS_SPACER + FARTHEST_TAB_CIRCLE_RADIUS + context->geometry->tab_height,
+                &fileleaf->_menu_render->Ecircle_x,
+                &fileleaf->_menu_render->Ecircle_y);
+
+            ca_geometry_point_from_source_offset(
+                fileleaf->_menu_render->Ccircle_x,
+                fileleaf->_menu_render->Ccircle_y,
+                fileleaf->_menu_render->Ccircle_lowest_angle,
+                FARTHEST_TAB_CIRCLE_RADIUS,
+                &fileleaf->_menu_render->Ccircle_arc_x,
+                &fileleaf->_menu_render->Ccircle_arc_y);
+
+            /* Render the parent fileleaf association on the tab. */
+            fileleaf->_menu_render->tab_glyph_radius =
+            	fileleaf->radius +
+            	((RADIUS_SPACER + CLOSEST_TAB_CIRCLE_RADIUS +
+            	context->geometry->tab_height +
+            	FARTHEST_TAB_CIRCLE_RADIUS) / 2);
+
+            ca_geometry_point_from_source_offset(
+                fileleaf->_central_glyph->x,
+                fileleaf->_central_glyph->y,
+                parent_angle,
+                fileleaf->_menu_render->tab_glyph_radius,
+                &fileleaf->_menu_render->tab_glyph_x,
+                &fileleaf->_menu_render->tab_glyph_y);
+        }
+
+        /* Render A */
+        cairo_arc(
+            cr,
+            OFFSET_2_SCREEN(fileleaf->_central_glyph->x, context->view_x_offset),
+            OFFSET_2_SCREEN(fileleaf->_central_glyph->y, context->view_y_offset),
+            fileleaf->radius + RADIUS_SPACER,
+            DEGREE_2_RADIAN(fileleaf->_menu_render->highest_angle_nearest),
+            DEGREE_2_RADIAN(fileleaf->_menu_render->lowest_angle_nearest));
+
+        /* Render B */
+        cairo_arc_negative(
+            cr,
+            OFFSET_2_SCREEN(fileleaf->_menu_render->Bcircle_x, context->view_x_offset),
+            OFFSET_2_SCREEN(fileleaf->_menu_render->Bcircle_y, context->view_y_offset),
+            CLOSEST_TAB_CIRCLE_RADIUS,
+            DEGREE_2_RADIAN(fileleaf->_menu_render->Bcircle_highest_angle),
+            DEGREE_2_RADIAN(fileleaf->_menu_render->Bcircle_lowest_angle));
+
+        /* Render C */
+        cairo_arc(
+            cr,
+            OFFSET_2_SCREEN(fileleaf->_menu_render->Ccircle_x, context->view_x_offset),
+            OFFSET_2_SCREEN(fileleaf->_menu_render->Ccircle_y, context->view_y_offset),
+            FARTHEST_TAB_CIRCLE_RADIUS,
+            DEGREE_2_RADIAN(fileleaf->_menu_render->Ccircle_lowest_angle),
+            DEGREE_2_RADIAN(fileleaf->_menu_render->Ccircle_highest_angle));
+
+        /* Render E */
+        cairo_arc(
+            cr,
+            OFFSET_2_SCREEN(fileleaf->_menu_render->Ecircle_x, context->view_x_offset),
+            OFFSET_2_SCREEN(fileleaf->_menu_render->Ecircle_y, context->view_y_offset),
+            FARTHEST_TAB_CIRCLE_RADIUS,
+            DEGREE_2_RADIAN(fileleaf->_menu_render->Ecircle_lowest_angle),
+            DEGREE_2_RADIAN(fileleaf->_menu_render->Ecircle_highest_angle));
+
+        /* Render F */
+        cairo_arc_negative(
+            cr,
+            OFFSET_2_SCREEN(fileleaf->_menu_render->Fcircle_x, context->view_x_offset),
+            OFFSET_2_SCREEN(fileleaf->_menu_render->Fcircle_y, context->view_y_offset),
+            CLOSEST_TAB_CIRCLE_RADIUS,
+            DEGREE_2_RADIAN(fileleaf->_menu_render->Fcircle_highest_angle),
+            DEGREE_2_RADIAN(fileleaf->_menu_render->Fcircle_lowest_angle));
+
+        cairo_close_path(cr);
+
+        path = cairo_copy_path(cr);
+
+        /* Make any overlapped portions of a parent menu appear more translucent. */
+        _ca_render_overlap(context, fileleaf, path, cr);
+
+        cairo_new_sub_path (cr);
+
+        cairo_arc (
+            cr,
+            OFFSET_2_SCREEN(fileleaf->x, context->view_x_offset),
+            OFFSET_2_SCREEN(fileleaf->y, context->view_y_offset),
+            fileleaf->radius,
+            DEGREE_2_RADIAN(0.0),
+            DEGREE_2_RADIAN(360.0));
+
+        /* Render to the cairo context. */
+        cairo_set_source_rgba (
+			cr,
+			g_outer_inner_rgba._r,
+			g_outer_inner_rgba._g,
+			g_outer_inner_rgba._b,
+			g_outer_inner_rgba._a_fill);
+        cairo_fill_preserve (cr);
+
+        /* Render reflections. */
+        if (FALSE == context->render_reflection_off)
+        {
+            _ca_render_reflection(context, cr);
+        }
+
+        cairo_new_path(cr);
+        cairo_append_path(cr, path);
+
+        /* Outline with a lighter colour. */
+        cairo_clip_preserve(cr);
+        cairo_set_line_width (cr, g_outer_inner_rgba._line_width * 3 /*Overlap from edge*/);
+        cairo_set_source_rgba (cr, g_outer2_rgba._r, g_outer2_rgba._g, g_outer2_rgba._b, g_outer2_rgba._a_pen);
+        cairo_stroke_preserve (cr);
+        cairo_reset_clip(cr);
+
+        /* Outline with a darker colour. */
+        cairo_set_line_width (cr, g_outer_inner_rgba._line_width);
+        cairo_set_source_rgba (cr, g_outer1_rgba._r, g_outer1_rgba._g, g_outer1_rgba._b, g_outer1_rgba._a_pen);
+        cairo_stroke (cr);
+
+        cairo_path_destroy(path);
+
+        /* Render the parent fileleaf association on the tab. */
+        g_assert(fileleaf->_central_glyph->_associated_fileitem != NULL);
+
+        if (CA_MENU_FILEITEM(fileleaf->_central_glyph->_associated_fileitem)->pixbuf != NULL)
+        {
+            gdk_cairo_set_source_pixbuf (
+                cr,
+                CA_MENU_FILEITEM(fileleaf->_central_glyph->_associated_fileitem)->pixbuf,
+                OFFSET_2_SCREEN(fileleaf->_menu_render->tab_glyph_x - (context->geometry->icon_width / 2), context->view_x_offset),
+                OFFSET_2_SCREEN(fileleaf->_menu_render->tab_glyph_y - (context->geometry->icon_height / 2), context->view_y_offset));
+            cairo_paint_with_alpha(cr, 1.0);
+        }
+    }
+
+    /* Render the surround of the fileleaf central glyph. */
+    cairo_arc (
+        cr,
+        OFFSET_2_SCREEN(fileleaf->_central_glyph->x, context->view_x_offset),
+        OFFSET_2_SCREEN(fileleaf->_central_glyph->y, context->view_y_offset),
+        fileleaf->_central_glyph->size + CIRCULAR_ICON_SPACER,
+        0,
+        DEGREE_2_RADIAN(360));
+
+    /* Render to the cairo context. */
+    cairo_set_line_width (cr, g_outer_inner_rgba._line_width);
+    cairo_set_source_rgba (
+		cr,
+		g_outer_inner_rgba._r,
+		g_outer_inner_rgba._g,
+		g_outer_inner_rgba._b,
+		g_outer_inner_rgba._a_fill);
+    cairo_fill_preserve (cr);
+
+    /* Render reflections. */
+    if (FALSE == context->render_reflection_off)
+    {
+        _ca_render_reflection(context, cr);
+    }
+
+    cairo_set_source_rgba (cr, g_outer_inner_rgba._r, g_outer_inner_rgba._g, g_outer_inner_rgba._b, g_outer_inner_rgba._a_pen);
+    cairo_stroke (cr);
+
+    /* Render the fileleaf central glyph. */
+    {
+        GdkPixbuf* pixbuf;
+        gint centre_iconsize;
+
+        /* Check whether the item is selected. */
+        if (((GLYPH_ROOT_CENTRE == context->current_type) && (fileleaf == context->root_fileleaf)) ||
+            ((GLYPH_FILE_MENU_CENTRE == context->current_type) && (fileleaf == context->current_fileleaf)))
+        {
+            if ((fileleaf == context->root_fileleaf) &&
+                (context->emblem_normal != NULL) &&
+                (context->emblem_prelight != NULL))
+            {
+                /* Use the emblem pixbuf. */
+                pixbuf = context->emblem_prelight;
+            }
+            else
+            {
+                pixbuf = context->close_prelight_pixbuf;
+            }
+        }
+        else
+        {
+            if ((fileleaf == context->root_fileleaf) &&
+                (context->emblem_normal != NULL) &&
+                (context->emblem_prelight != NULL))
+            {
+                /* Use the emblem pixbuf. */
+                pixbuf = context->emblem_normal;
+            }
+            else
+            {
+                pixbuf = context->close_normal_pixbuf;
+            }
+        }
+
+        /* Retrieve the centre iconsize. */
+        centre_iconsize = ca_geometry_get_centre_iconsize(context->geometry, fileleaf);
+
+        g_assert(pixbuf != NULL);
+
+        gdk_cairo_set_source_pixbuf (
+            cr,
+            pixbuf,
+            OFFSET_2_SCREEN(fileleaf->_central_glyph->x- (centre_iconsize / 2), context->view_x_offset),
+            OFFSET_2_SCREEN(fileleaf->_central_glyph->y- (centre_iconsize / 2), context->view_y_offset));
+        cairo_paint_with_alpha(cr, 1.0);
+    }
+
+    /* Retieve the fileleafs associated sub fileitem. */
+    if (fileleaf->_child_fileleaf != NULL)
+    {
+        associated_fileitem = fileleaf->_child_fileleaf->_central_glyph->_associated_fileitem;
+    }
+    else
+    {
+        associated_fileitem = NULL;
+    }
+
+    if (fileleaf->_fileitem_list_count == 1)
+    {
+        /* Only a single fileitem. */
+        CaFileItem* fileitem;
+        gdouble inner_radius;
+        gdouble outer_radius;
+
+        file_list = g_list_first(fileleaf->_fileitem_list);
+
+        fileitem = (CaFileItem*)file_list->data;
+        g_assert(fileitem != NULL);
+
+        inner_radius = fileitem->_parent_radius - SEGMENT_INNER_SPACER(context->geometry->normal_iconsize);
+        outer_radius = fileitem->_parent_radius + SEGMENT_OUTER_SPACER(context->geometry->normal_iconsize);
+
+        cairo_arc(cr,
+            OFFSET_2_SCREEN(fileleaf->_central_glyph->x, context->view_x_offset),
+            OFFSET_2_SCREEN(fileleaf->_central_glyph->y, context->view_y_offset),
+            outer_radius,
+            DEGREE_2_RADIAN(0.0),
+            DEGREE_2_RADIAN(360.0));
+
+        cairo_arc(cr,
+            OFFSET_2_SCREEN(fileleaf->_central_glyph->x, context->view_x_offset),
+            OFFSET_2_SCREEN(fileleaf->_central_glyph->y, context->view_y_offset),
+            inner_radius,
+            DEGREE_2_RADIAN(0.0),
+            DEGREE_2_RADIAN(360.0));
+
+        /* Check whether the item is selected. */
+        if (fileitem == context->current_fileitem)
+        {
+            /* Prelight. */
+
+            /* Render to the cairo context. */
+            cairo_set_line_width (cr, g_prelight_segment_rgba._line_width);
+            cairo_set_source_rgba (
+				cr,
+				g_prelight_segment_rgba._r,
+				g_prelight_segment_rgba._g,
+				g_prelight_segment_rgba._b,
+				g_prelight_segment_rgba._a_fill);
+            cairo_fill_preserve (cr);
+
+            /* Render reflections. */
+            if (FALSE == context->render_reflection_off)
+            {
+                _ca_render_reflection(context, cr);
+            }
+
+            cairo_set_source_rgba (
+				cr,
+				g_prelight_segment_rgba._r,
+				g_prelight_segment_rgba._g,
+				g_prelight_segment_rgba._b,
+				g_prelight_segment_rgba._a_pen);
+            cairo_stroke (cr);
+        }
+        else
+        {
+            /* Prelight. */
+
+            /* Render to the cairo context. */
+            cairo_set_line_width (cr, g_normal_segment_rgba._line_width);
+            cairo_set_source_rgba (
+				cr,
+				g_normal_segment_rgba._r,
+				g_normal_segment_rgba._g,
+				g_normal_segment_rgba._b,
+				g_normal_segment_rgba._a_fill);
+            cairo_fill_preserve (cr);
+
+            /* Render reflections. */
+            if (FALSE == context->render_reflection_off)
+            {
+                _ca_render_reflection(context, cr);
+            }
+
+            cairo_set_source_rgba (
+				cr,
+				g_normal_segment_rgba._r,
+				g_normal_segment_rgba._g,
+				g_normal_segment_rgba._b,
+				g_normal_segment_rgba._a_pen);
+            cairo_stroke (cr);
+        }
+    }
+    else
+    {
+        /* Multiple file-items. */
+        FileLeafRender* render;
+        CaFileItem* current_fileitem;
+
+        render = _ca_render_get_fileleaf_render(fileleaf);
+
+        /* Retrieve the prelit file-item of this file-leaf. */
+        current_fileitem = context->current_fileitem;
+
+        if ((current_fileitem != NULL) &&
+            ((current_fileitem->_assigned_fileleaf != fileleaf) ||
+             (current_fileitem == fileleaf->_central_glyph) ||
+             (current_fileitem == associated_fileitem)))
+        {
+            current_fileitem = NULL;
+        }
+
+        /* The ring paths leave out the associated file-item only, so are kept across prelight. */
+        if ((render->ring_count != fileleaf->_ring_count) ||
+            (render->associated_fileitem != associated_fileitem))
+        {
+            _ca_render_free_ring_paths(render);
+
+            render->ring_paths = g_new0(cairo_path_t*, fileleaf->_ring_count);
+            render->ring_count = fileleaf->_ring_count;
+            render->associated_fileitem = associated_fileitem;
+        }
+
+        if ((context->raster == NULL) ||
+            !_ca_render_rasterized_segments(context, fileleaf, render, associated_fileitem, current_fileitem, &clip, cr))
+        {
+            CaRenderContext segments_context;
+
+            cairo_save(cr);
+
+            if (current_fileitem != NULL)
+            {
+                /* Clip out the prelit segment; the fill rule is even-odd. */
+                cairo_new_path(cr);
+                cairo_rectangle(cr, clip.x1, clip.y1, clip.x2 - clip.x1, clip.y2 - clip.y1);
+                _ca_render_segment_path(context, fileleaf, current_fileitem, cr);
+                cairo_clip(cr);
+            }
+
+            /* Gather the normal segments of the visible rings into a single path. */
+            cairo_new_path(cr);
+
+            for (ring = 0; ring < fileleaf->_ring_count; ring++)
+            {
+                if (!_ca_render_is_ring_visible(context, fileleaf, &clip, ring))
+                    continue;
+
+                if (render->ring_paths[ring] == NULL)
+                {
+                    render->ring_paths[ring] = _ca_render_ring_path(
+                        context,
+                        fileleaf,
+                        ring,
+                        render->associated_fileitem,
+                        cr);
+                }
+
+                /* The ring paths are held in the offset co-ordinates. */
+                cairo_save(cr);
+                cairo_translate(cr, -context->view_x_offset, -context->view_y_offset);
+                cairo_append_path(cr, render->ring_paths[ring]);
+                cairo_restore(cr);
+            }
+
+            segments_context = *context;
+
+            if ((context->raster != NULL) &&
+                (render->segments_job != NULL) &&
+                (FALSE == render->segments_job->completed))
+            {
+                /* Leave the reflection to the worker whilst the segments are being rasterized; once
+                 * a job has completed without a surface, the segments are rendered here in full. */
+                segments_context.render_reflection_off = TRUE;
+            }
+
+            /* Render to the cairo context. */
+            _ca_render_segments(&segments_context, &g_normal_segment_rgba, cr);
+            cairo_restore(cr);
+        }
+
+        if (current_fileitem != NULL)
+        {
+            /* Prelight. */
+            cairo_new_path(cr);
+            _ca_render_segment_path(context, fileleaf, current_fileitem, cr);
+
+            /* Render to the cairo context. */
+            _ca_render_segments(context, &g_prelight_segment_rgba, cr);
+        }
+    }
+
+    ring = -1;
+    file_list = _ca_render_next_visible_fileitem(context, fileleaf, &clip, NULL, &ring, &fileitem_count);
+
+    /* Render all the arrows and fileitems. */
+    while (file_list)
+    {
+        CaFileItem* fileitem;
+
+        fileitem = (CaFileItem*)file_list->data;
+        g_assert(fileitem != NULL);
+
+        if ((associated_fileitem != fileitem) &&
+            (GLYPH_FILE_MENU == fileitem->_type) &&
+            (fileitem->_segment_render != NULL))
+        {
+            /* Add an arrow. */
+
+            GdkPixbuf* pixbuf;
+
+            /* Check whether the item is selected. */
+            pixbuf = (fileitem == context->current_fileitem) ? context->open_prelight_pixbuf : context->open_normal_pixbuf;
+
+            gdk_cairo_set_source_pixbuf (
+                cr,
+                pixbuf,
+                OFFSET_2_SCREEN(fileitem->_segment_render->arrow_point_x, context->view_x_offset) - (SEGMENT_ARROW_HEIGHT / 2),
+                OFFSET_2_SCREEN(fileitem->_segment_render->arrow_point_y, context->view_y_offset) - (SEGMENT_ARROW_HEIGHT / 2));
+            cairo_paint_with_alpha(cr, 1.0);
+        }
+
+        /* Do not render as it is a sub fileleaf; an unresolved icon leaves the segment empty. */
+        if ((associated_fileitem != fileitem) &&
+            (CA_MENU_FILEITEM(fileitem)->pixbuf != NULL))
+        {
+            /* Render the fileleaf fileitems. */
+            gdk_cairo_set_source_pixbuf (
+                cr,
+                CA_MENU_FILEITEM(fileitem)->pixbuf,
+                OFFSET_2_SCREEN(fileitem->x - (context->geometry->icon_width / 2), context->view_x_offset),
+                OFFSET_2_SCREEN(fileitem->y - (context->geometry->icon_height / 2), context->view_y_offset));
+            cairo_paint_with_alpha(cr, 1.0);
+        }
+
+        file_list = _ca_render_next_visible_fileitem(context, fileleaf, &clip, file_list, &ring, &fileitem_count);
+    }
+}
+
+/**
+ * _ca_render_cached_fileleaf:
+ * @context: The state to render.
+ * @fileleaf: A file-leaf to render.
+ * @cr: A cairo-context to render to.
+ *
+ * Renders a file-leaf from a surface similar to the target, so a target on a display server is
+ * only sent the file-leaf once.  The surface is rendered without prelight or overlap and kept
+ * until the file-leaf is laid out, moved, opens a different sub file-leaf or resolves an icon.  A
+ * file-leaf holding the current glyph is rendered directly, as is every file-leaf unless
+ * render_leaf_surfaces is set.
+ */
+static void
+_ca_render_cached_fileleaf(
+	const CaRenderContext* context,
+	CaFileLeaf* fileleaf,
+	cairo_t* cr)
+{
+    FileLeafRender* render;
+    CaFileItem* associated_fileitem;
+    GdkPixbuf* tab_pixbuf;
+    ClipExtents clip;
+    gboolean disassociated;
+
+    if ((FALSE == context->render_leaf_surfaces) ||
+        (TRUE == _ca_render_is_fileleaf_prelit(context, fileleaf)))
+    {
+        _ca_render_fileleaf(context, fileleaf, cr);
+
+        return;
+    }
+
+    cairo_clip_extents(cr, &clip.x1, &clip.y1, &clip.x2, &clip.y2);
+
+    if (!ca_geometry_annulus_intersects_rectangle(
+        OFFSET_2_SCREEN(fileleaf->x, context->view_x_offset),
+        OFFSET_2_SCREEN(fileleaf->y, context->view_y_offset),
+        0,
+        fileleaf->bound_radius,
+        clip.x1,
+        clip.y1,
+        clip.x2,
+        clip.y2))
+    {
+        return;
+    }
+
+    render = _ca_render_get_fileleaf_render(fileleaf);
+
+    associated_fileitem = (fileleaf->_child_fileleaf != NULL) ? fileleaf->_child_fileleaf->_central_glyph->_associated_fileitem : NULL;
+    tab_pixbuf = (fileleaf->_central_glyph->_associated_fileitem != NULL) ? CA_MENU_FILEITEM(fileleaf->_central_glyph->_associated_fileitem)->pixbuf : NULL;
+    disassociated = (fileleaf == context->disassociated_fileleaf);
+
+    if ((render->surface != NULL) &&
+        ((render->surface_x != fileleaf->x - fileleaf->bound_radius - LEAF_SURFACE_MARGIN) ||
+         (render->surface_y != fileleaf->y - fileleaf->bound_radius - LEAF_SURFACE_MARGIN) ||
+         (render->surface_radius != fileleaf->bound_radius) ||
+         (render->surface_associated_fileitem != associated_fileitem) ||
+         (render->surface_unresolved != fileleaf->_unresolved_fileitem_list) ||
+         (render->surface_tab_pixbuf != tab_pixbuf) ||
+         (render->surface_disassociated != disassociated) ||
+         (render->surface_reflection_off != context->render_reflection_off)))
+    {
+        cairo_surface_destroy(render->surface);
+        render->surface = NULL;
+    }
+
+    if (render->surface == NULL)
+    {
+        CaRenderContext surface_context;
+        cairo_t* surface_cr;
+        gint size;
+
+        render->surface_x = fileleaf->x - fileleaf->bound_radius - LEAF_SURFACE_MARGIN;
+        render->surface_y = fileleaf->y - fileleaf->bound_radius - LEAF_SURFACE_MARGIN;
+        render->surface_radius = fileleaf->bound_radius;
+        render->surface_associated_fileitem = associated_fileitem;
+        render->surface_unresolved = fileleaf->_unresolved_fileitem_list;
+        render->surface_tab_pixbuf = tab_pixbuf;
+        render->surface_disassociated = disassociated;
+        render->surface_reflection_off = context->render_reflection_off;
+
+        /* The surface is the view of the file-leaf; nothing is prelit or drawn onto its parent. */
+        size = (fileleaf->bound_radius + LEAF_SURFACE_MARGIN) * 2;
+
+        surface_context = *context;
+        surface_context.view_x_offset = render->surface_x;
+        surface_context.view_y_offset = render->surface_y;
+        surface_context.view_width = size;
+        surface_context.view_height = size;
+        surface_context.render_fast = FALSE;
+        surface_context.render_overlap_off = TRUE;
+        surface_context.raster = NULL;
+        surface_context.current_fileleaf = NULL;
+        surface_context.current_fileitem = NULL;
+        surface_context.current_type = GLYPH_UNKNOWN;
+
+        render->surface = cairo_surface_create_similar(cairo_get_target(cr), CAIRO_CONTENT_COLOR_ALPHA, size, size);
+
+        surface_cr = cairo_create(render->surface);
+        cairo_set_fill_rule(surface_cr, CAIRO_FILL_RULE_EVEN_ODD);
+        _ca_render_fileleaf(&surface_context, fileleaf, surface_cr);
+        cairo_destroy(surface_cr);
+    }
+
+    cairo_set_source_surface(
+        cr,
+        render->surface,
+        OFFSET_2_SCREEN(render->surface_x, context->view_x_offset),
+        OFFSET_2_SCREEN(render->surface_y, context->view_y_offset));
+    cairo_paint(cr);
+}
+
+/**
+ * _ca_render_is_fileleaf_prelit:
+ * @context: The state to render.
+ * @fileleaf: A shown file-leaf.
+ *
+ * Checks whether a file-leaf holds the current glyph; a file-item or a central glyph.
+ *
+ * Returns: TRUE if any of the file-leaf is prelit; otherwise FALSE.
+ */
+static gboolean
+_ca_render_is_fileleaf_prelit(const CaRenderContext* context, CaFileLeaf* fileleaf)
+{
+    if ((context->current_fileitem != NULL) &&
+        (context->current_fileitem->_assigned_fileleaf == fileleaf))
+        return TRUE;
+
+    return
+        ((GLYPH_ROOT_CENTRE == context->current_type) && (fileleaf == context->root_fileleaf)) ||
+        ((GLYPH_FILE_MENU_CENTRE == context->current_type) && (fileleaf == context->current_fileleaf));
+}
+
+/**
+ * _ca_render_segment_path:
+ * @context: The state to render.
+ * @fileleaf: The file-leaf of the file-item.
+ * @fileitem: A file-item of a file-leaf with multiple file-items.
+ * @cr: A cairo-context to add the segment to.
+ *
+ * Adds the outline of a file-item segment to the current path as a new sub-path.
+ */
+static void
+_ca_render_segment_path(
+	const CaRenderContext* context,
+	CaFileLeaf* fileleaf,
+	CaFileItem* fileitem,
+	cairo_t* cr)
+{
+    cairo_new_sub_path(cr);
+
+    /*
+    CDC
+    BAB
+    */
+    if (fileitem->_circular_angle_share == 360.0)
+    {
+        if (fileitem->_segment_render == NULL)
+        {
+            fileitem->_segment_render = g_new(CaSegmentRender, 1);
+
+            if (GLYPH_FILE_MENU == fileitem->_type)
+            {
+                /* Add an arrow. */
+                fileitem->_segment_render->arrow_radius =
+                	(gint)((fileitem->_parent_radius + SEGMENT_OUTER_SPACER(context->geometry->normal_iconsize)) -
+                	SEGMENT_ARROW_HEIGHT);
+
+                ca_geometry_point_from_source_offset(
+                    fileleaf->_central_glyph->x,
+                    fileleaf->_central_glyph->y,
+                    fileitem->_parent_angle,
+                    fileitem->_segment_render->arrow_radius,
+                    &fileitem->_segment_render->arrow_point_x,
+                    &fileitem->_segment_render->arrow_point_y);
+            }
+        }
+
+        /* Render a single segment. */
+        cairo_arc(cr,
+            OFFSET_2_SCREEN(fileleaf->_central_glyph->x, context->view_x_offset),
+            OFFSET_2_SCREEN(fileleaf->_central_glyph->y, context->view_y_offset),
+            fileitem->_parent_radius + SEGMENT_OUTER_SPACER(context->geometry->normal_iconsize),
+            DEGREE_2_RADIAN(0.0),
+            DEGREE_2_RADIAN(360.0));
+
+        cairo_arc(cr,
+            OFFSET_2_SCREEN(fileleaf->_central_glyph->x, context->view_x_offset),
+            OFFSET_2_SCREEN(fileleaf->_central_glyph->y, context->view_y_offset),
+            fileitem->_parent_radius - SEGMENT_INNER_SPACER(context->geometry->normal_iconsize),
+            DEGREE_2_RADIAN(0.0),
+            DEGREE_2_RADIAN(360.0));
+    }
+    else
+    {
+        /* Render multiple segments. */
+
+        if (fileitem->_segment_render == NULL)
+        {
+            fileitem->_segment_render = g_new(CaSegmentRender, 1);
+
+            /* Smaller the circumference then larger the angle. */
+            fileitem->_segment_render->Aradius =
+            	(gint)(fileitem->_parent_radius - SEGMENT_INNER_SPACER(context->geometry->normal_iconsize));
+            fileitem->_segment_render->Bradius =
+            	(gint)(fileitem->_segment_render->Aradius + SEGMENT_CIRCLE_RADIUS);
+            fileitem->_segment_render->Dradius =
+            	(gint)(fileitem->_parent_radius + SEGMENT_OUTER_SPACER(context->geometry->normal_iconsize));
+            fileitem->_segment_render->Cradius =
+            	(gint)(fileitem->_segment_render->Dradius - SEGMENT_CIRCLE_RADIUS);
+
+            ca_geometry_get_segment_angles(
+				fileitem,
+				fileitem->_segment_render->Aradius,
+				&fileitem->_segment_render->Afrom_angle,
+				&fileitem->_segment_render->Ato_angle);
+            ca_geometry_get_segment_angles(
+				fileitem,
+				fileitem->_segment_render->Bradius,
+				&fileitem->_segment_render->Bfrom_angle,
+				&fileitem->_segment_render->Bto_angle);
+            ca_geometry_get_segment_angles(
+				fileitem,
+				fileitem->_segment_render->Cradius,
+				&fileitem->_segment_render->Cfrom_angle,
+				&fileitem->_segment_render->Cto_angle);
+            ca_geometry_get_segment_angles(
+				fileitem,
+				fileitem->_segment_render->Dradius,
+				&fileitem->_segment_render->Dfrom_angle,
+				&fileitem->_segment_render->Dto_angle);
+
+            /* Calculate B lowest */
+            ca_geometry_point_from_source_offset(
+                fileleaf->_central_glyph->x,
+                fileleaf->_central_glyph->y,
+                fileitem->_segment_render->Bfrom_angle,
+                fileitem->_segment_render->Bradius,
+                &fileitem->_segment_render->B_lowest_circle_x,
+                &fileitem->_segment_render->B_lowest_circle_y);
+
+            /* Calculate C lowest */
+            ca_geometry_point_from_source_offset(
+                fileleaf->_central_glyph->x,
+                fileleaf->_central_glyph->y,
+                fileitem->_segment_render->Cfrom_angle,
+                fileitem->_segment_render->Cradius,
+                &fileitem->_segment_render->C_lowest_circle_x,
+                &fileitem->_segment_render->C_lowest_circle_y);
+
+            /* Calculate C highest */
+            ca_geometry_point_from_source_offset(
+                fileleaf->_central_glyph->x,
+                fileleaf->_central_glyph->y,
+                fileitem->_segment_render->Cto_angle,
+                fileitem->_segment_render->Cradius,
+                &fileitem->_segment_render->C_highest_circle_x,
+                &fileitem->_segment_render->C_highest_circle_y);
+
+            /* Calculate B highest */
+            ca_geometry_point_from_source_offset(
+                fileleaf->_central_glyph->x,
+                fileleaf->_central_glyph->y,
+                fileitem->_segment_render->Bto_angle,
+                fileitem->_segment_render->Bradius,
+                &fileitem->_segment_render->B_highest_circle_x,
+                &fileitem->_segment_render->B_highest_circle_y);
+
+            if (GLYPH_FILE_MENU == fileitem->_type)
+            {
+                /* Add an arrow. */
+                fileitem->_segment_render->arrow_radius =
+                	(gint)((fileitem->_parent_radius + SEGMENT_OUTER_SPACER(context->geometry->normal_iconsize)) - 
+                    SEGMENT_ARROW_HEIGHT);
+
+                ca_geometry_point_from_source_offset(
+                    fileleaf->_central_glyph->x,
+                    fileleaf->_central_glyph->y,
+                    fileitem->_parent_angle,
+                    fileitem->_segment_render->arrow_radius,
+                    &fileitem->_segment_render->arrow_point_x,
+                    &fileitem->_segment_render->arrow_point_y);
+            }
+        }
+
+        /* Render B lowest */
+        cairo_arc(cr,
+            OFFSET_2_SCREEN(fileitem->_segment_render->B_lowest_circle_x, context->view_x_offset),
+            OFFSET_2_SCREEN(fileitem->_segment_render->B_lowest_circle_y, context->view_y_offset),
+            SEGMENT_CIRCLE_RADIUS,
+            DEGREE_2_RADIAN(ca_geometry_calculate_angle_offset(fileitem->_segment_render->Bfrom_angle, -180.0)),
+            DEGREE_2_RADIAN(ca_geometry_calculate_angle_offset(fileitem->_segment_render->Bfrom_angle, -90.0)));
+
+        /* Render C lowest */
+        cairo_arc(cr,
+            OFFSET_2_SCREEN(fileitem->_segment_render->C_lowest_circle_x, context->view_x_offset),
+            OFFSET_2_SCREEN(fileitem->_segment_render->C_lowest_circle_y, context->view_y_offset),
+            SEGMENT_CIRCLE_RADIUS,
+            DEGREE_2_RADIAN(ca_geometry_calculate_angle_offset(fileitem->_segment_render->Cfrom_angle, -90.0)),
+            DEGREE_2_RADIAN(fileitem->_segment_render->Cfrom_angle));
+
+        /* Render D */
+        cairo_arc(cr,
+            OFFSET_2_SCREEN(fileleaf->_central_glyph->x, context->view_x_offset),
+            OFFSET_2_SCREEN(fileleaf->_central_glyph->y, context->view_y_offset),
+            fileitem->_segment_render->Dradius,
+            DEGREE_2_RADIAN(fileitem->_segment_render->Dfrom_angle),
+            DEGREE_2_RADIAN(fileitem->_segment_render->Dto_angle));
+
+        /* Render C highest */
+        cairo_arc(cr,
+            OFFSET_2_SCREEN(fileitem->_segment_render->C_highest_circle_x, context->view_x_offset),
+            OFFSET_2_SCREEN(fileitem->_segment_render->C_highest_circle_y, context->view_y_offset),
+            SEGMENT_CIRCLE_RADIUS,
+            DEGREE_2_RADIAN(fileitem->_segment_render->Cto_angle),
+            DEGREE_2_RADIAN(ca_geometry_calculate_angle_offset(fileitem->_segment_render->Cto_angle, 90.0)));
+
+        /* Render B highest */
+        cairo_arc(cr,
+            OFFSET_2_SCREEN(fileitem->_segment_render->B_highest_circle_x, context->view_x_offset),
+            OFFSET_2_SCREEN(fileitem->_segment_render->B_highest_circle_y, context->view_y_offset),
+            SEGMENT_CIRCLE_RADIUS,
+            DEGREE_2_RADIAN(ca_geometry_calculate_angle_offset(fileitem->_segment_render->Bto_angle, 90.0)),
+            DEGREE_2_RADIAN(ca_geometry_calculate_angle_offset(fileitem->_segment_render->Bto_angle, 180.0)));
+
+        /* Render A */
+        cairo_arc_negative(cr,
+            OFFSET_2_SCREEN(fileleaf->_central_glyph->x, context->view_x_offset),
+            OFFSET_2_SCREEN(fileleaf->_central_glyph->y, context->view_y_offset),
+            fileitem->_segment_render->Aradius,
+            DEGREE_2_RADIAN(fileitem->_segment_render->Ato_angle),
+            DEGREE_2_RADIAN(fileitem->_segment_render->Afrom_angle));
+    }
+}
+
+/**
+ * _ca_render_segments:
+ * @context: The state to render.
+ * @rgba: The colours of the segments.
+ * @cr: A cairo-context whose current path holds the segments.
+ *
+ * Fills, reflects and outlines every segment of the current path at once.
+ */
+static void
+_ca_render_segments(const CaRenderContext* context, const RGBA* rgba, cairo_t* cr)
+{
+    cairo_set_line_width (cr, rgba->_line_width);
+    cairo_set_source_rgba (cr, rgba->_r, rgba->_g, rgba->_b, rgba->_a_fill);
+    cairo_fill_preserve (cr);
+
+    /* Render reflections. */
+    if (FALSE == context->render_reflection_off)
+    {
+        _ca_render_reflection(context, cr);
+    }
+
+    cairo_set_source_rgba (cr, rgba->_r, rgba->_g, rgba->_b, rgba->_a_pen);
+    cairo_stroke (cr);
+}
+
+/**
+ * _ca_render_ring_path:
+ * @context: The state to render.
+ * @fileleaf: The file-leaf of the ring.
+ * @ring: The ring to build; otherwise -1 for every ring.
+ * @associated_fileitem: The file-item of an open sub file-leaf, which is left out; otherwise NULL.
+ * @cr: A cairo-context to build the path with; its current path is cleared.
+ *
+ * Builds the outlines of the normal segments of a ring into a single path, in the offset
+ * co-ordinates so the path is kept across changes of view.
+ *
+ * Returns: The newly created path.
+ */
+static cairo_path_t*
+_ca_render_ring_path(
+	const CaRenderContext* context,
+	CaFileLeaf* fileleaf,
+	gint ring,
+	CaFileItem* associated_fileitem,
+	cairo_t* cr)
+{
+    CaRenderContext path_context;
+    cairo_path_t* path;
+    gint last_ring;
+
+    path_context = *context;
+    path_context.view_x_offset = 0;
+    path_context.view_y_offset = 0;
+
+    cairo_save(cr);
+    cairo_identity_matrix(cr);
+    cairo_new_path(cr);
+
+    last_ring = (ring < 0) ? fileleaf->_ring_count - 1 : ring;
+
+    for (ring = MAX(ring, 0); ring <= last_ring; ring++)
+    {
+        GList* file_list;
+        gint fileitem_count;
+
+        file_list = fileleaf->_ring_bounds[ring].fileitem_list;
+
+        for (fileitem_count = fileleaf->_ring_bounds[ring].fileitem_count; fileitem_count > 0; fileitem_count--)
+        {
+            CaFileItem* fileitem;
+
+            fileitem = (CaFileItem*)file_list->data;
+            g_assert(fileitem != NULL);
+
+            if (associated_fileitem != fileitem)        /* Do not render as it is a sub fileleaf. */
+            {
+                _ca_render_segment_path(&path_context, fileleaf, fileitem, cr);
+            }
+
+            file_list = g_list_next(file_list);
+        }
+    }
+
+    path = cairo_copy_path(cr);
+
+    cairo_new_path(cr);
+    cairo_restore(cr);
+
+    return path;
+}
+
+/**
+ * _ca_render_rasterized_segments:
+ * @context: The state to render.
+ * @fileleaf: The file-leaf being rendered.
+ * @render: The render values of the file-leaf.
+ * @associated_fileitem: The file-item of an open sub file-leaf; otherwise NULL.
+ * @current_fileitem: The prelit file-item of the file-leaf; otherwise NULL.
+ * @clip: The clip extents of the cairo context.
+ * @cr: A cairo-context to render to.
+ *
+ * Composites the normal segments of a file-leaf once a worker has rasterized them, leaving out
+ * the prelit segment so it can be rendered over the top.  The segments are rasterized again when
+ * the associated file-item or the reflection changes.
+ *
+ * Returns: TRUE if the segments were composited; otherwise FALSE whilst they are rasterized or
+ * if the job completed without a surface.
+ */
+static gboolean
+_ca_render_rasterized_segments(
+	const CaRenderContext* context,
+	CaFileLeaf* fileleaf,
+	FileLeafRender* render,
+	CaFileItem* associated_fileitem,
+	CaFileItem* current_fileitem,
+	const ClipExtents* clip,
+	cairo_t* cr)
+{
+    if ((render->segments_job != NULL) &&
+        ((render->segments_associated_fileitem != associated_fileitem) ||
+         (render->segments_reflection_off != context->render_reflection_off)))
+    {
+        ca_raster_job_cancel(render->segments_job);
+        render->segments_job = NULL;
+    }
+
+    if (render->segments_job == NULL)
+    {
+        RasterSegments* segments;
+
+        /* The path is built here, as it reads the file-items; the worker only fills and strokes it. */
+        segments = g_new0(RasterSegments, 1);
+        segments->path = _ca_render_ring_path(context, fileleaf, -1, associated_fileitem, cr);
+        segments->x = fileleaf->x - fileleaf->bound_radius;
+        segments->y = fileleaf->y - fileleaf->bound_radius;
+        segments->width = fileleaf->bound_radius * 2;
+        segments->height = fileleaf->bound_radius * 2;
+        segments->light_pixbuf = g_object_ref(context->light_pixbuf);
+        segments->render_reflection_off = context->render_reflection_off;
+
+        cairo_surface_get_device_scale(cairo_get_target(cr), &segments->x_scale, &segments->y_scale);
+
+        render->segments_job = ca_raster_submit(
+            context->raster,
+            (fileleaf == context->disassociated_fileleaf) ? JOB_PREVIEW : JOB_VISIBLE,
+            CA_MENU_FILELEAF(fileleaf)->cancellable,
+            _ca_render_raster_segments,
+            (gpointer)segments,
+            _ca_render_raster_segments_free);
+        render->segments_associated_fileitem = associated_fileitem;
+        render->segments_reflection_off = context->render_reflection_off;
+        render->segments_x = segments->x;
+        render->segments_y = segments->y;
+
+        return FALSE;
+    }
+
+    if ((FALSE == render->segments_job->completed) ||
+        (render->segments_job->surface == NULL))
+    {
+        return FALSE;
+    }
+
+    cairo_save(cr);
+
+    if (current_fileitem != NULL)
+    {
+        /* Clip out the prelit segment; the fill rule is even-odd. */
+        cairo_new_path(cr);
+        cairo_rectangle(cr, clip->x1, clip->y1, clip->x2 - clip->x1, clip->y2 - clip->y1);
+        _ca_render_segment_path(context, fileleaf, current_fileitem, cr);
+        cairo_clip(cr);
+    }
+
+    cairo_set_source_surface(
+        cr,
+        render->segments_job->surface,
+        OFFSET_2_SCREEN(render->segments_x, context->view_x_offset),
+        OFFSET_2_SCREEN(render->segments_y, context->view_y_offset));
+    cairo_paint(cr);
+    cairo_restore(cr);
+
+    return TRUE;
+}
+
+/**
+ * _ca_render_raster_segments:
+ * @data: The RasterSegments to rasterize.
+ *
+ * Fills, reflects and strokes the normal segments of a file-leaf into an image surface; this is
+ * called on a worker thread so only @data is read.
+ *
+ * Returns: The newly created surface; otherwise NULL if it could not be created.
+ */
+static cairo_surface_t*
+_ca_render_raster_segments(gpointer data)
+{
+    RasterSegments* segments;
+    CaRenderContext context;
+    cairo_surface_t* surface;
+    cairo_t* cr;
+
+    segments = (RasterSegments*)data;
+
+    surface = cairo_image_surface_create(
+        CAIRO_FORMAT_ARGB32,
+        (gint)ceil(segments->width * segments->x_scale),
+        (gint)ceil(segments->height * segments->y_scale));
+
+    if (cairo_surface_status(surface) != CAIRO_STATUS_SUCCESS)
+    {
+        cairo_surface_destroy(surface);
+
+        return NULL;
+    }
+
+    cairo_surface_set_device_scale(surface, segments->x_scale, segments->y_scale);
+
+    /* Only the reflection reads the context. */
+    memset(&context, 0, sizeof(CaRenderContext));
+    context.light_pixbuf = segments->light_pixbuf;
+    context.render_reflection_off = segments->render_reflection_off;
+
+    cr = cairo_create(surface);
+    cairo_set_fill_rule(cr, CAIRO_FILL_RULE_EVEN_ODD);
+    cairo_translate(cr, -segments->x, -segments->y);
+    cairo_append_path(cr, segments->path);
+
+    _ca_render_segments(&context, &g_normal_segment_rgba, cr);
+
+    cairo_destroy(cr);
+    cairo_surface_flush(surface);
+
+    return surface;
+}
+
+/**
+ * _ca_render_raster_segments_free:
+ * @data: The RasterSegments to free.
+ *
+ * Frees the normal segments once they have been rasterized or cancelled.
+ */
+static void
+_ca_render_raster_segments_free(gpointer data)
+{
+    RasterSegments* segments;
+
+    segments = (RasterSegments*)data;
+
+    cairo_path_destroy(segments->path);
+    g_object_unref(segments->light_pixbuf);
+
+    g_free((gpointer)segments);
+}
+
+/**
+ * _ca_render_overlap:
+ * @context: The state to render.
+ * @fileleaf: A sub or disassociated file-leaf.
+ * @path: The outline of the file-leaf.
+ * @cr: A cairo-context to render to.
+ *
+ * Makes any overlapped portions of a parent menu appear more translucent.  The outline is
+ * rendered once into an alpha mask covering the bounding circle of the file-leaf, which is kept
+ * until the file-leaf is laid out again, so only that square is touched each frame.
+ */
+static void
+_ca_render_overlap(
+	const CaRenderContext* context,
+	CaFileLeaf* fileleaf,
+	cairo_path_t* path,
+	cairo_t* cr)
+{
+    FileLeafRender* render;
+    gint mask_x;
+    gint mask_y;
+
+    if (TRUE == context->render_overlap_off)
+        return;
+
+    render = _ca_render_get_fileleaf_render(fileleaf);
+
+    /* The mask is positioned in the offset co-ordinates so it survives any change of view. */
+    mask_x = fileleaf->x - fileleaf->bound_radius;
+    mask_y = fileleaf->y - fileleaf->bound_radius;
+
+    if (render->overlap_mask == NULL)
+    {
+        cairo_surface_t* mask;
+        cairo_t* mask_cr;
+
+        mask = cairo_surface_create_similar(
+            cairo_get_target(cr),
+            CAIRO_CONTENT_ALPHA,
+            fileleaf->bound_radius * 2,
+            fileleaf->bound_radius * 2);
+
+        mask_cr = cairo_create(mask);
+        cairo_translate(
+            mask_cr,
+            -OFFSET_2_SCREEN(mask_x, context->view_x_offset),
+            -OFFSET_2_SCREEN(mask_y, context->view_y_offset));
+        cairo_append_path(mask_cr, path);
+        cairo_set_source_rgba(mask_cr, 0.0, 0.0, 0.0, OVERLAP_TRANSLUCENCY);
+        cairo_fill(mask_cr);
+        cairo_destroy(mask_cr);
+
+        render->overlap_mask = mask;
+    }
+
+    cairo_save(cr);
+    cairo_set_operator(cr, CAIRO_OPERATOR_CLEAR);
+    cairo_mask_surface(
+        cr,
+        render->overlap_mask,
+        OFFSET_2_SCREEN(mask_x, context->view_x_offset),
+        OFFSET_2_SCREEN(mask_y, context->view_y_offset));
+    cairo_restore(cr);
+}
+
+/**
+ * _ca_render_next_visible_fileitem:
+ * @context: The state to render.
+ * @fileleaf: The file-leaf being rendered.
+ * @clip: The clip extents of the cairo context.
+ * @file_list: The current file-item; otherwise NULL to find the first.
+ * @ring: The ring of @file_list; -1 to find the first.
+ * @fileitem_count: The file-items remaining on @ring, including @file_list.
+ *
+ * Retrieves the file-item following @file_list, stepping over any ring whose annulus lies
+ * outside the clip.
+ *
+ * Returns: The next visible file-item; otherwise NULL.
+ */
+static GList*
+_ca_render_next_visible_fileitem(
+	const CaRenderContext* context,
+	CaFileLeaf* fileleaf,
+	const ClipExtents* clip,
+	GList* file_list,
+	gint* ring,
+	gint* fileitem_count)
+{
+    if ((file_list != NULL) && (--(*fileitem_count) > 0))
+        return g_list_next(file_list);
+
+    /* Move onto the next visible ring. */
+    for ((*ring)++; *ring < fileleaf->_ring_count; (*ring)++)
+    {
+        if ((fileleaf->_ring_bounds[*ring].fileitem_count > 0) &&
+            _ca_render_is_ring_visible(context, fileleaf, clip, *ring))
+        {
+            *fileitem_count = fileleaf->_ring_bounds[*ring].fileitem_count;
+
+            return fileleaf->_ring_bounds[*ring].fileitem_list;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * _ca_render_is_ring_visible:
+ * @context: The state to render.
+ * @fileleaf: The file-leaf being rendered.
+ * @clip: The clip extents of the cairo context.
+ * @ring: The ring to test.
+ *
+ * Retrieves whether the annulus of a ring lies within the clip.
+ *
+ * Returns: TRUE if the ring is visible; otherwise FALSE.
+ */
+static gboolean
+_ca_render_is_ring_visible(
+	const CaRenderContext* context,
+	CaFileLeaf* fileleaf,
+	const ClipExtents* clip,
+	gint ring)
+{
+    return ca_geometry_annulus_intersects_rectangle(
+        OFFSET_2_SCREEN(fileleaf->x, context->view_x_offset),
+        OFFSET_2_SCREEN(fileleaf->y, context->view_y_offset),
+        fileleaf->_ring_bounds[ring].inner_radius,
+        fileleaf->_ring_bounds[ring].outer_radius,
+        clip->x1,
+        clip->y1,
+        clip->x2,
+        clip->y2);
+}
+
+/**
+ * _ca_render_get_fileleaf_render:
+ * @fileleaf: The file-leaf being rendered.
+ *
+ * Retrieves the render values kept with a file-leaf, creating them when the file-leaf has been
+ * laid out since it was last rendered.
+ *
+ * Returns: The render values of the file-leaf.
+ */
+static FileLeafRender*
+_ca_render_get_fileleaf_render(CaFileLeaf* fileleaf)
+{
+    CaMenuFileLeaf* menufileleaf;
+
+    menufileleaf = CA_MENU_FILELEAF(fileleaf);
+
+    if (menufileleaf->render_data == NULL)
+    {
+        FileLeafRender* render;
+
+        render = g_new0(FileLeafRender, 1);
+
+        menufileleaf->render_data = render;
+        menufileleaf->render_data_free = _ca_render_fileleaf_render_free;
+    }
+
+    return (FileLeafRender*)menufileleaf->render_data;
+}
+
+/**
+ * _ca_render_free_ring_paths:
+ * @render: The render values of a file-leaf.
+ *
+ * Frees the ring paths so they are built again.
+ */
+static void
+_ca_render_free_ring_paths(FileLeafRender* render)
+{
+    gint ring;
+
+    for (ring = 0; ring < render->ring_count; ring++)
+    {
+        if (render->ring_paths[ring] != NULL)
+        {
+            cairo_path_destroy(render->ring_paths[ring]);
+        }
+    }
+
+    g_free((gpointer)render->ring_paths);
+    render->ring_paths = NULL;
+    render->ring_count = 0;
+}
+
+/**
+ * _ca_render_fileleaf_render_free:
+ * @data: The render values of a file-leaf.
+ *
+ * Frees the render values of a file-leaf; see: _ca_render_get_fileleaf_render.
+ */
+static void
+_ca_render_fileleaf_render_free(gpointer data)
+{
+    FileLeafRender* render;
+
+    render = (FileLeafRender*)data;
+
+    if (render->overlap_mask != NULL)
+    {
+        cairo_surface_destroy(render->overlap_mask);
+    }
+
+    if (render->segments_job != NULL)
+    {
+        ca_raster_job_cancel(render->segments_job);
+    }
+
+    _ca_render_free_ring_paths(render);
+
+    if (render->shape != NULL)
+    {
+        cairo_region_destroy(render->shape);
+    }
+
+    if (render->surface != NULL)
+    {
+        cairo_surface_destroy(render->surface);
+    }
+
+    g_free((gpointer)render);
+}
+
+/**
+ * _ca_render_opening_fileleaf:
+ * @context: The state to render.
+ * @fileleaf: An INITIAL_OPEN file-leaf to render.
+ * @cr: A cairo-context to render to.
+ *
+ * Renders a file-leaf scaled and faded in from the parent segment it was opened from.
+ */
+static void
+_ca_render_opening_fileleaf(
+	const CaRenderContext* context,
+	CaFileLeaf* fileleaf,
+	cairo_t* cr)
+{
+    CaFileItem* associated_fileitem;
+    gdouble percentage;
+    gdouble fileleaf_x;
+    gdouble fileleaf_y;
+    gdouble segment_x;
+    gdouble segment_y;
+
+    associated_fileitem = fileleaf->_central_glyph->_associated_fileitem;
+    g_assert(associated_fileitem != NULL);
+
+    /* Ease out so the file-leaf settles into place. */
+    percentage = MAX(fileleaf->_current_animation_tick, FADE_PERCENTAGE_INCREMENT) / 100.0;
+    percentage = 1.0 - ((1.0 - percentage) * (1.0 - percentage));
+
+    fileleaf_x = OFFSET_2_SCREEN(fileleaf->x, context->view_x_offset);
+    fileleaf_y = OFFSET_2_SCREEN(fileleaf->y, context->view_y_offset);
+    segment_x = OFFSET_2_SCREEN(associated_fileitem->x, context->view_x_offset);
+    segment_y = OFFSET_2_SCREEN(associated_fileitem->y, context->view_y_offset);
+
+    cairo_save(cr);
+    cairo_translate(
+        cr,
+        segment_x + ((fileleaf_x - segment_x) * percentage),
+        segment_y + ((fileleaf_y - segment_y) * percentage));
+    cairo_scale(cr, percentage, percentage);
+    cairo_translate(cr, -fileleaf_x, -fileleaf_y);
+
+    cairo_push_group(cr);
+    _ca_render_fileleaf(context, fileleaf, cr);
+    cairo_pop_group_to_source(cr);
+    cairo_paint_with_alpha(cr, percentage);
+
+    cairo_restore(cr);
+}
+
+/**
+ * _ca_render_centred_text:
+ * @context: The state to render.
+ * @y: A Y co-ordinate of the text to render.
+ * @text: The text to render.
+ * @extents: The extents to add the text surround to rather than rendering it; otherwise NULL.
+ * @cr: A cairo-context to render to.
+ *
+ * Renders the text to a cairo context.
+ */
+static void
+_ca_render_centred_text(
+	const CaRenderContext* context,
+	gint y,
+	const gchar* text,
+	cairo_rectangle_int_t* extents,
+	cairo_t* cr)
+{
+    gint x;
+    gint radius;
+    cairo_text_extents_t text_extents;
+    cairo_text_extents_t complete_text_extents;
+    cairo_font_extents_t font_extents;
+
+    if ((text == NULL) ||
+        (strlen(text) == 0))
+        return;
+
+    cairo_select_font_face (cr, "Sans", CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_NORMAL);
+    cairo_set_font_size (cr, 15.0);
+    cairo_font_extents(cr, &font_extents);
+
+    cairo_text_extents (cr, text, &text_extents);
+    cairo_text_extents (cr, "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz", &complete_text_extents);
+
+    /* Calculate the text position. */
+    x = (context->view_width - (gint)text_extents.width) / 2;
+    radius = (gint)(TEXT_BOUNDARY + font_extents.height + TEXT_BOUNDARY) / 2;
+
+    if (extents != NULL)
+    {
+        /* The surround, and the half of its outline outside it. */
+        _ca_render_add_extents(
+            extents,
+            x - TEXT_BOUNDARY - radius - g_text_box_rgba._line_width,
+            y - (complete_text_extents.height / 2) - radius - g_text_box_rgba._line_width,
+            x + text_extents.width + TEXT_BOUNDARY + radius + g_text_box_rgba._line_width,
+            y - (complete_text_extents.height / 2) + radius + g_text_box_rgba._line_width);
+
+        return;
+    }
+
+    /* Render the text surround. */
+    cairo_arc(
+        cr,
+        x - TEXT_BOUNDARY,
+        y - (complete_text_extents.height / 2),
+        radius,
+        DEGREE_2_RADIAN(90.0),
+        DEGREE_2_RADIAN(270.0));
+
+    cairo_arc(
+        cr,
+        x + text_extents.width + TEXT_BOUNDARY,
+        y - (complete_text_extents.height / 2),
+        radius,
+        DEGREE_2_RADIAN(270.0),
+        DEGREE_2_RADIAN(90.0));
+
+    cairo_set_source_rgba (cr, g_text_box_rgba._r, g_text_box_rgba._g, g_text_box_rgba._b, g_text_box_rgba._a_fill);
+    cairo_fill_preserve (cr);
+    cairo_set_source_rgba (cr, g_text_box_rgba._r, g_text_box_rgba._g, g_text_box_rgba._b, g_text_box_rgba._a_pen);
+    cairo_set_line_width (cr, g_text_box_rgba._line_width);
+    cairo_stroke (cr);
+
+    /* Render the text. */
+    cairo_move_to (cr, x, y - (font_extents.descent / 2));
+    cairo_text_path (cr, text);
+    cairo_set_source_rgba (cr, g_text_rgba._r, g_text_rgba._g, g_text_rgba._b, g_text_rgba._a_fill);
+    cairo_fill_preserve (cr);
+    cairo_set_source_rgba (cr, g_text_rgba._r, g_text_rgba._g, g_text_rgba._b, g_text_rgba._a_pen);
+    cairo_set_line_width (cr, g_text_rgba._line_width);
+    cairo_stroke (cr);
+}
+
+/**
+ * _ca_render_add_text_extents:
+ * @context: The state to render.
+ * @extents: The extents to grow.
+ *
+ * Grows the extents to the text surround, which is measured but not rendered.
+ */
+static void
+_ca_render_add_text_extents(const CaRenderContext* context, cairo_rectangle_int_t* extents)
+{
+    cairo_surface_t* surface;
+    cairo_t* cr;
+
+    surface = cairo_image_surface_create(CAIRO_FORMAT_A8, 1, 1);
+    cr = cairo_create(surface);
+    _ca_render_text(context, extents, cr);
+    cairo_destroy(cr);
+    cairo_surface_destroy(surface);
+}
+
+/**
+ * _ca_render_add_glyph_extents:
+ * @context: The state to render.
+ * @fileleaf: The file-leaf of the central glyph.
+ * @extents: The extents to grow.
+ *
+ * Grows the extents to the surround of the central glyph of a file-leaf and its outline.
+ */
+static void
+_ca_render_add_glyph_extents(const CaRenderContext* context, CaFileLeaf* fileleaf, cairo_rectangle_int_t* extents)
+{
+    gdouble x;
+    gdouble y;
+    gdouble radius;
+
+    x = OFFSET_2_SCREEN(fileleaf->_central_glyph->x, context->view_x_offset);
+    y = OFFSET_2_SCREEN(fileleaf->_central_glyph->y, context->view_y_offset);
+    radius = fileleaf->_central_glyph->size + CIRCULAR_ICON_SPACER + g_outer_inner_rgba._line_width;
+
+    _ca_render_add_extents(extents, x - radius, y - radius, x + radius, y + radius);
+}
+
+/**
+ * _ca_render_add_extents:
+ * @extents: The extents to grow.
+ * @x1: The left of the rectangle to add.
+ * @y1: The top of the rectangle to add.
+ * @x2: The right of the rectangle to add.
+ * @y2: The bottom of the rectangle to add.
+ *
+ * Grows the extents to the whole pixels covering a rectangle; empty extents become the rectangle.
+ */
+static void
+_ca_render_add_extents(cairo_rectangle_int_t* extents, gdouble x1, gdouble y1, gdouble x2, gdouble y2)
+{
+    gint left;
+    gint top;
+    gint right;
+    gint bottom;
+
+    left = (gint)floor(x1);
+    top = (gint)floor(y1);
+    right = (gint)ceil(x2);
+    bottom = (gint)ceil(y2);
+
+    if ((extents->width > 0) &&
+        (extents->height > 0))
+    {
+        left = MIN(left, extents->x);
+        top = MIN(top, extents->y);
+        right = MAX(right, extents->x + extents->width);
+        bottom = MAX(bottom, extents->y + extents->height);
+    }
+
+    extents->x = left;
+    extents->y = top;
+    extents->width = right - left;
+    extents->height = bottom - top;
+}
+
+/**
+ * _ca_render_add_fileleaf_extents:
+ * @context: The state to render.
+ * @fileleaf: A shown file-leaf.
+ * @data: The cairo_rectangle_int_t extents to grow.
+ *
+ * Grows the extents to the bounding circle of a file-leaf; a file-leaf which is opening also
+ * covers the parent segment it grows out of.
+ */
+static void
+_ca_render_add_fileleaf_extents(const CaRenderContext* context, CaFileLeaf* fileleaf, gpointer data)
+{
+    cairo_rectangle_int_t* extents;
+    gdouble x;
+    gdouble y;
+
+    extents = (cairo_rectangle_int_t*)data;
+
+    x = OFFSET_2_SCREEN(fileleaf->x, context->view_x_offset);
+    y = OFFSET_2_SCREEN(fileleaf->y, context->view_y_offset);
+
+    _ca_render_add_extents(
+        extents,
+        x - fileleaf->bound_radius,
+        y - fileleaf->bound_radius,
+        x + fileleaf->bound_radius,
+        y + fileleaf->bound_radius);
+
+    if ((fileleaf->_current_animation_state == INITIAL_OPEN) &&
+        (fileleaf->_central_glyph->_associated_fileitem != NULL))
+    {
+        x = OFFSET_2_SCREEN(fileleaf->_central_glyph->_associated_fileitem->x, context->view_x_offset);
+        y = OFFSET_2_SCREEN(fileleaf->_central_glyph->_associated_fileitem->y, context->view_y_offset);
+
+        _ca_render_add_extents(extents, x, y, x, y);
+    }
+}
+
+/**
+ * _ca_render_add_fileleaf_shape:
+ * @context: The state to render.
+ * @fileleaf: A shown file-leaf.
+ * @data: The cairo_region_t to add to, in the offset co-ordinates.
+ *
+ * Adds the bounding circle of a file-leaf to a shape, building it once for each layout; a
+ * file-leaf which is opening also covers the parent segment it grows out of.
+ */
+static void
+_ca_render_add_fileleaf_shape(const CaRenderContext* context, CaFileLeaf* fileleaf, gpointer data)
+{
+    cairo_region_t* shape;
+    FileLeafRender* render;
+
+    shape = (cairo_region_t*)data;
+    render = _ca_render_get_fileleaf_render(fileleaf);
+
+    if ((render->shape != NULL) &&
+        ((render->shape_x != fileleaf->x) ||
+         (render->shape_y != fileleaf->y) ||
+         (render->shape_radius != fileleaf->bound_radius)))
+    {
+        cairo_region_destroy(render->shape);
+        render->shape = NULL;
+    }
+
+    if (render->shape == NULL)
+    {
+        render->shape = _ca_render_circle_region(fileleaf->x, fileleaf->y, fileleaf->bound_radius);
+        render->shape_x = fileleaf->x;
+        render->shape_y = fileleaf->y;
+        render->shape_radius = fileleaf->bound_radius;
+    }
+
+    cairo_region_union(shape, render->shape);
+
+    if ((fileleaf->_current_animation_state == INITIAL_OPEN) &&
+        (fileleaf->_central_glyph->_associated_fileitem != NULL))
+    {
+        cairo_rectangle_int_t opening;
+        CaFileItem* associated_fileitem;
+
+        associated_fileitem = fileleaf->_central_glyph->_associated_fileitem;
+
+        opening.x = MIN(fileleaf->x - fileleaf->bound_radius, associated_fileitem->x);
+        opening.y = MIN(fileleaf->y - fileleaf->bound_radius, associated_fileitem->y);
+        opening.width = MAX(fileleaf->x + fileleaf->bound_radius, associated_fileitem->x + 1) - opening.x;
+        opening.height = MAX(fileleaf->y + fileleaf->bound_radius, associated_fileitem->y + 1) - opening.y;
+
+        cairo_region_union_rectangle(shape, &opening);
+    }
+}
+
+/**
+ * _ca_render_circle_region:
+ * @x: The x co-ordinate of the centre.
+ * @y: The y co-ordinate of the centre.
+ * @radius: The radius.
+ *
+ * Covers a circle with rectangles SHAPE_STRIP_HEIGHT high, each as wide as the circle is at the
+ * row of the strip nearest the centre.
+ *
+ * Returns: The newly created region.
+ */
+static cairo_region_t*
+_ca_render_circle_region(gint x, gint y, gint radius)
+{
+    cairo_region_t* region;
+    gint top;
+
+    region = cairo_region_create();
+
+    for (top = y - radius; top < y + radius; top += SHAPE_STRIP_HEIGHT)
+    {
+        cairo_rectangle_int_t strip;
+        gint distance;
+        gint half_width;
+
+        /* The row of the strip nearest the centre. */
+        if ((top <= y) && (top + SHAPE_STRIP_HEIGHT >= y))
+        {
+            distance = 0;
+        }
+        else
+        {
+            distance = MIN(ABS(top - y), ABS(top + SHAPE_STRIP_HEIGHT - y));
+        }
+
+        half_width = (gint)ceil(sqrt(MAX((gdouble)radius * radius - (gdouble)distance * distance, 0.0)));
+
+        strip.x = x - half_width;
+        strip.y = top;
+        strip.width = half_width * 2;
+        strip.height = MIN(SHAPE_STRIP_HEIGHT, y + radius - top);
+
+        cairo_region_union_rectangle(region, &strip);
+    }
+
+    return region;
+}
+
+/**
+ * _ca_render_foreach_fileleaf:
+ * @context: The state to render.
+ * @func: The function to call with each file-leaf.
+ * @data: User data passed to @func.
+ *
+ * Calls a function with each file-leaf which is rendered, in the order they are rendered.
+ */
+static void
+_ca_render_foreach_fileleaf(const CaRenderContext* context, FileLeafFunc func, gpointer data)
+{
+    CaFileLeaf* current_fileleaf;
+
+    for (current_fileleaf = context->root_fileleaf; current_fileleaf != NULL; current_fileleaf = current_fileleaf->_child_fileleaf)
+    {
+        GList* sub_list;
+
+        if ((FALSE == context->render_tabbed_only) ||
+            (current_fileleaf == context->tabbed_fileleaf))
+        {
+            func(context, current_fileleaf, data);
+        }
+
+        for (sub_list = g_list_first(current_fileleaf->_sub_fileleaves_list); sub_list != NULL; sub_list = g_list_next(sub_list))
+        {
+            if ((FALSE == context->render_tabbed_only) ||
+                ((CaFileLeaf*)sub_list->data == context->tabbed_fileleaf))
+            {
+                func(context, (CaFileLeaf*)sub_list->data, data);
+            }
+        }
+    }
+
+    if (context->disassociated_fileleaf != NULL)
+    {
+        func(context, context->disassociated_fileleaf, data);
+    }
+}
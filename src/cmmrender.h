@@ -0,0 +1,87 @@
+/* circular-main-menu
+ * Copyright (C) 2008 - Cole Anstey
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ * See http://code.google.com/p/circular-application-menu/
+ */
+#ifndef __CA_RENDER_H__
+#define __CA_RENDER_H__
+
+#include <cairo.h>
+#include <gdk-pixbuf/gdk-pixbuf.h>
+
+#include "cmmfileleaf.h"
+#include "cmmgeometry.h"
+#include "cmmraster.h"
+
+G_BEGIN_DECLS
+
+/* Constants. */
+#define FADE_PERCENTAGE_INCREMENT       5		/* The percentacge increment when fading. */
+#define FAST_RENDER_TOLERANCE           0.5     /* The arc tolerance in pixels of a fast frame; cairo defaults to 0.1. */
+#define CANVAS_MARGIN                   8       /* The pixels a canvas extends beyond what a frame renders. */
+#define CANVAS_GRANULARITY              64      /* A canvas is rounded out to these pixels so it is resized less often. */
+#define DAMAGE_BYTES_PER_PIXEL          4       /* The bytes of a drawn pixel sent uncompressed, as ARGB32. */
+
+typedef struct _CaRenderContext CaRenderContext;
+
+/* Everything a frame is rendered from; no widget or display is required. */
+struct _CaRenderContext
+{
+    const CaGeometry* geometry;
+    gint view_x_offset;            /* See: OFFSET_2_SCREEN. */
+    gint view_y_offset;            /* See: OFFSET_2_SCREEN. */
+    gint view_width;
+    gint view_height;
+    GdkPixbuf* light_pixbuf;
+    GdkPixbuf* close_normal_pixbuf;
+    GdkPixbuf* close_prelight_pixbuf;
+    GdkPixbuf* open_normal_pixbuf;
+    GdkPixbuf* open_prelight_pixbuf;
+    GdkPixbuf* emblem_normal;
+    GdkPixbuf* emblem_prelight;
+    gboolean render_reflection_off;
+    gboolean render_tabbed_only;
+    gboolean render_fast;           /* Coarser arcs and edges, and no reflection; see: FAST_RENDER_TOLERANCE. */
+    gboolean render_overlap_off;    /* Overlapped portions of a parent menu are not made translucent. */
+    gboolean render_opaque;         /* The background is painted opaque for a window without an alpha channel. */
+    gboolean render_leaf_surfaces;  /* Each file-leaf is composited from a surface similar to the target; see: ca_render_add_current_damage. */
+    CaRaster* raster;               /* Rasterizes the normal segments of each file-leaf; otherwise NULL to render them directly. */
+
+    /*< Navigation >*/
+    CaFileLeaf* root_fileleaf;
+    CaFileLeaf* tabbed_fileleaf;
+    CaFileLeaf* current_fileleaf;
+    CaFileItem* current_fileitem;
+    GlyphType current_type;
+    CaFileLeaf* disassociated_fileleaf;
+};
+
+/* Implementation */
+void ca_render_frame(const CaRenderContext* context, cairo_t* cr);
+void ca_render_scene(const CaRenderContext* context, cairo_t* cr);
+void ca_render_background(const CaRenderContext* context, cairo_t* cr);
+void ca_render_text(const CaRenderContext* context, cairo_t* cr);
+void ca_render_get_extents(const CaRenderContext* context, cairo_rectangle_int_t* extents);
+void ca_render_get_canvas(const CaRenderContext* context, cairo_rectangle_int_t* canvas);
+void ca_render_get_shape(const CaRenderContext* context, cairo_region_t* shape);
+void ca_render_add_current_damage(const CaRenderContext* context, cairo_region_t* damage);
+void ca_render_discard(CaFileLeaf* fileleaf);
+
+G_END_DECLS
+
+#endif
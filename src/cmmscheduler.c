@@ -0,0 +1,621 @@
+/* circular-main-menu
+ * Copyright (C) 2008 - Cole Anstey
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ * See http://code.google.com/p/circular-application-menu/
+ */
+#include "cmmscheduler.h"
+
+typedef struct _CaJob CaJob;
+typedef struct _CaWorker CaWorker;
+
+/* A job from being submitted until it is delivered to the main thread. */
+struct _CaJob
+{
+    JobClass job_class;
+    CaJobFunc func;
+    CaJobDoneFunc done_func;
+    gpointer data;
+    GDestroyNotify data_free;
+    GCancellable* cancellable;          /* A reference; otherwise NULL. */
+    gpointer result;
+    gboolean abandoned;                 /* Never run as the scheduler was freed. */
+    gint64 submit_time;
+    gint64 start_time;
+    GList link;                         /* Within the queue of a worker. */
+    CaJob* next;                        /* The next job on the completion stack. */
+};
+
+/* A worker thread and its queues, which other workers steal from when theirs are empty. */
+struct _CaWorker
+{
+    CaScheduler* scheduler;
+    GThread* thread;
+    GMutex mutex;                       /* Guards the queues. */
+    GQueue queues[JOB_CLASSES];
+};
+
+/* Workers which take jobs in priority order and return their results through a lock-free stack. */
+struct _CaScheduler
+{
+    gint ref_count;                     /* Held by the owners and by any pending wake-up. */
+    CaWorker* workers;
+    gint worker_count;
+    gint next_worker;                   /* The worker queued onto next from outside the workers. */
+    gint queued;                        /* The jobs queued but not yet taken; atomic. */
+    gint depth[JOB_CLASSES];            /* Atomic. */
+    GMutex mutex;                       /* Guards the sleeping workers and quit. */
+    GCond queued_cond;
+    gboolean quit;
+    CaJob* completed;                   /* The completion stack; pushed by the workers, emptied by the main thread. */
+    gint wakeup;                        /* A wake-up is pending on the main context; atomic. */
+    GMainContext* main_context;         /* Dispatches the completed jobs; otherwise NULL. */
+    CaJobStats stats[JOB_CLASSES];      /* Only the depth is read from here atomically. */
+};
+
+/* Local data. */
+static CaScheduler* g_default_scheduler = NULL;
+static GPrivate g_current_worker;       /* The worker of the calling thread; otherwise NULL. */
+static const gchar* g_class_names[JOB_CLASSES] = { "visible", "preview", "speculative", "maintenance" };
+
+static gpointer _ca_scheduler_worker(gpointer data);
+static CaJob* _ca_scheduler_take(CaScheduler* scheduler, CaWorker* worker);
+static void _ca_scheduler_complete(CaScheduler* scheduler, CaJob* job);
+static gboolean _ca_scheduler_on_wakeup(gpointer data);
+static gboolean _ca_scheduler_ref_if_alive(CaScheduler* scheduler);
+static void _ca_scheduler_deliver(CaScheduler* scheduler, CaJob* job, gint64 now);
+
+/**
+ * ca_scheduler_new:
+ * @threads: The number of worker threads.
+ * @main_context: The main context the completed jobs are delivered on; otherwise NULL if the
+ * owner delivers them with ca_scheduler_dispatch().
+ *
+ * Creates worker threads which run jobs away from the main thread.
+ *
+ * Returns: The newly created scheduler; release it with ca_scheduler_unref().
+ **/
+CaScheduler*
+ca_scheduler_new(gint threads, GMainContext* main_context)
+{
+    CaScheduler* scheduler;
+    gint worker;
+
+    scheduler = g_new0(CaScheduler, 1);
+    scheduler->ref_count = 1;
+    scheduler->worker_count = CLAMP(threads, 1, SCHEDULER_MAX_THREADS);
+    scheduler->workers = g_new0(CaWorker, scheduler->worker_count);
+    scheduler->quit = FALSE;
+    scheduler->completed = NULL;
+    scheduler->main_context = (main_context != NULL) ? g_main_context_ref(main_context) : NULL;
+
+    g_mutex_init(&scheduler->mutex);
+    g_cond_init(&scheduler->queued_cond);
+
+    /* Every queue exists before any worker can steal from it. */
+    for (worker = 0; worker < scheduler->worker_count; worker++)
+    {
+        gint job_class;
+
+        scheduler->workers[worker].scheduler = scheduler;
+        g_mutex_init(&scheduler->workers[worker].mutex);
+
+        for (job_class = 0; job_class < JOB_CLASSES; job_class++)
+        {
+            g_queue_init(&scheduler->workers[worker].queues[job_class]);
+        }
+    }
+
+    for (worker = 0; worker < scheduler->worker_count; worker++)
+    {
+        scheduler->workers[worker].thread = g_thread_new("cam-worker", _ca_scheduler_worker, (gpointer)&scheduler->workers[worker]);
+    }
+
+    return scheduler;
+}
+
+/**
+ * ca_scheduler_get_default:
+ *
+ * Retrieves the scheduler shared by every menu in the process, creating it if required.  It has
+ * a worker for each processor but one, which is left for the main thread, and delivers the
+ * completed jobs on the default main context.
+ *
+ * Returns: A new reference to the scheduler; release it with ca_scheduler_unref().
+ **/
+CaScheduler*
+ca_scheduler_get_default(void)
+{
+    if (g_default_scheduler != NULL)
+    {
+        return ca_scheduler_ref(g_default_scheduler);
+    }
+
+    g_default_scheduler = ca_scheduler_new((gint)g_get_num_processors() - 1, g_main_context_default());
+
+    return g_default_scheduler;
+}
+
+/**
+ * ca_scheduler_ref:
+ * @scheduler: The scheduler.
+ *
+ * Adds a reference to the scheduler.
+ *
+ * Returns: The scheduler.
+ **/
+CaScheduler*
+ca_scheduler_ref(CaScheduler* scheduler)
+{
+    g_atomic_int_inc(&scheduler->ref_count);
+
+    return scheduler;
+}
+
+/**
+ * ca_scheduler_unref:
+ * @scheduler: The scheduler.
+ *
+ * Releases a reference to the scheduler.  Once the last is released the workers finish the jobs
+ * they are running and are joined; every job not yet delivered is then delivered as cancelled.
+ **/
+void
+ca_scheduler_unref(CaScheduler* scheduler)
+{
+    gint worker;
+
+    if (!g_atomic_int_dec_and_test(&scheduler->ref_count))
+        return;
+
+    g_mutex_lock(&scheduler->mutex);
+    scheduler->quit = TRUE;
+    g_cond_broadcast(&scheduler->queued_cond);
+    g_mutex_unlock(&scheduler->mutex);
+
+    for (worker = 0; worker < scheduler->worker_count; worker++)
+    {
+        g_thread_join(scheduler->workers[worker].thread);
+    }
+
+    /* Nothing remains to wake; the jobs never started are completed without being run. */
+    if (scheduler->main_context != NULL)
+    {
+        g_main_context_unref(scheduler->main_context);
+        scheduler->main_context = NULL;
+    }
+
+    for (worker = 0; worker < scheduler->worker_count; worker++)
+    {
+        gint job_class;
+
+        for (job_class = 0; job_class < JOB_CLASSES; job_class++)
+        {
+            GList* link;
+
+            while ((link = g_queue_pop_head_link(&scheduler->workers[worker].queues[job_class])) != NULL)
+            {
+                CaJob* job;
+
+                job = (CaJob*)link->data;
+                job->abandoned = TRUE;
+
+                _ca_scheduler_complete(scheduler, job);
+            }
+        }
+
+        g_mutex_clear(&scheduler->workers[worker].mutex);
+    }
+
+    ca_scheduler_dispatch(scheduler);
+
+    if (scheduler == g_default_scheduler)
+    {
+        g_default_scheduler = NULL;
+    }
+
+    g_mutex_clear(&scheduler->mutex);
+    g_cond_clear(&scheduler->queued_cond);
+    g_free((gpointer)scheduler->workers);
+    g_free((gpointer)scheduler);
+}
+
+/**
+ * ca_scheduler_submit:
+ * @scheduler: The scheduler to run the job.
+ * @job_class: The priority class of the job.
+ * @cancellable: A GCancellable to abandon the job, e.g. the one of the file-leaf it serves;
+ * otherwise NULL.
+ * @func: Runs the job on a worker thread; it is not called once @cancellable is cancelled.
+ * @done_func: Called on the main thread with the result; otherwise NULL.
+ * @data: The data passed to @func and @done_func; nothing else may change it until the job has
+ * been delivered.
+ * @data_free: Frees @data on the main thread after @done_func; otherwise NULL.
+ *
+ * Queues a job.  A job submitted by a worker is queued onto that worker; otherwise the workers
+ * are queued onto in turn.  An idle worker steals from the others.
+ **/
+void
+ca_scheduler_submit(
+	CaScheduler* scheduler,
+	JobClass job_class,
+	GCancellable* cancellable,
+	CaJobFunc func,
+	CaJobDoneFunc done_func,
+	gpointer data,
+	GDestroyNotify data_free)
+{
+    CaWorker* worker;
+    CaJob* job;
+
+    g_return_if_fail(job_class < JOB_CLASSES);
+
+    job = g_new0(CaJob, 1);
+    job->job_class = job_class;
+    job->func = func;
+    job->done_func = done_func;
+    job->data = data;
+    job->data_free = data_free;
+    job->cancellable = (cancellable != NULL) ? g_object_ref(cancellable) : NULL;
+    job->result = NULL;
+    job->abandoned = FALSE;
+    job->submit_time = g_get_monotonic_time();
+    job->link.data = (gpointer)job;
+
+    worker = (CaWorker*)g_private_get(&g_current_worker);
+
+    if ((worker == NULL) ||
+        (worker->scheduler != scheduler))
+    {
+        gint next;
+
+        next = g_atomic_int_add(&scheduler->next_worker, 1);
+        worker = &scheduler->workers[(guint)next % scheduler->worker_count];
+    }
+
+    g_mutex_lock(&worker->mutex);
+    g_queue_push_tail_link(&worker->queues[job_class], &job->link);
+    g_mutex_unlock(&worker->mutex);
+
+    g_atomic_int_inc(&scheduler->depth[job_class]);
+    g_atomic_int_inc(&scheduler->queued);
+
+    /* Wake a sleeping worker; the count is read beneath the same lock, so no wake-up is lost. */
+    g_mutex_lock(&scheduler->mutex);
+    g_cond_signal(&scheduler->queued_cond);
+    g_mutex_unlock(&scheduler->mutex);
+}
+
+/**
+ * ca_scheduler_dispatch:
+ * @scheduler: The scheduler of the jobs.
+ *
+ * Empties the completion stack on the main thread, delivering the jobs of each priority class
+ * in turn and in the order they completed.
+ *
+ * Returns: The number of jobs delivered.
+ **/
+gint
+ca_scheduler_dispatch(CaScheduler* scheduler)
+{
+    GSList* delivery[JOB_CLASSES] = { NULL };
+    CaJob* job;
+    gint64 now;
+    gint job_class;
+    gint count;
+
+    /* Clear the wake-up first, so a job completed from here on wakes the main context again. */
+    g_atomic_int_set(&scheduler->wakeup, FALSE);
+
+    /* Take the whole stack at once, so a job cannot be reused beneath a concurrent pop. */
+    do
+    {
+        job = (CaJob*)g_atomic_pointer_get(&scheduler->completed);
+    }
+    while (!g_atomic_pointer_compare_and_exchange(&scheduler->completed, job, NULL));
+
+    /* The stack is newest first, so prepending restores the completion order. */
+    for (; job != NULL; job = job->next)
+    {
+        delivery[job->job_class] = g_slist_prepend(delivery[job->job_class], (gpointer)job);
+    }
+
+    now = g_get_monotonic_time();
+    count = 0;
+
+    for (job_class = 0; job_class < JOB_CLASSES; job_class++)
+    {
+        GSList* list;
+
+        for (list = delivery[job_class]; list != NULL; list = g_slist_next(list))
+        {
+            _ca_scheduler_deliver(scheduler, (CaJob*)list->data, now);
+            count++;
+        }
+
+        g_slist_free(delivery[job_class]);
+    }
+
+    return count;
+}
+
+/**
+ * ca_scheduler_get_stats:
+ * @scheduler: The scheduler.
+ * @job_class: The priority class.
+ * @stats: A return location for the counters of the class.
+ *
+ * Retrieves the queue depth and the delivered, cancelled, wait and latency counters of a priority
+ * class on the main thread.
+ **/
+void
+ca_scheduler_get_stats(CaScheduler* scheduler, JobClass job_class, CaJobStats* stats)
+{
+    g_return_if_fail(job_class < JOB_CLASSES);
+
+    *stats = scheduler->stats[job_class];
+    stats->depth = g_atomic_int_get(&scheduler->depth[job_class]);
+}
+
+/**
+ * ca_scheduler_get_class_name:
+ * @job_class: The priority class.
+ *
+ * Retrieves the name of a priority class, e.g. to print its counters.
+ *
+ * Returns: The name of the class.
+ **/
+const gchar*
+ca_scheduler_get_class_name(JobClass job_class)
+{
+    g_return_val_if_fail(job_class < JOB_CLASSES, NULL);
+
+    return g_class_names[job_class];
+}
+
+/**
+ * _ca_scheduler_worker:
+ * @data: The worker.
+ *
+ * Takes and runs jobs on a worker thread, sleeping whilst none are queued.
+ *
+ * Returns: NULL.
+ **/
+static gpointer
+_ca_scheduler_worker(gpointer data)
+{
+    CaScheduler* scheduler;
+    CaWorker* worker;
+
+    worker = (CaWorker*)data;
+    scheduler = worker->scheduler;
+
+    g_private_set(&g_current_worker, (gpointer)worker);
+
+    for (;;)
+    {
+        CaJob* job;
+
+        if ((job = _ca_scheduler_take(scheduler, worker)) == NULL)
+        {
+            gboolean quit;
+
+            g_mutex_lock(&scheduler->mutex);
+
+            while ((g_atomic_int_get(&scheduler->queued) == 0) &&
+                   (FALSE == scheduler->quit))
+            {
+                g_cond_wait(&scheduler->queued_cond, &scheduler->mutex);
+            }
+
+            quit = scheduler->quit;
+
+            g_mutex_unlock(&scheduler->mutex);
+
+            if (quit)
+                break;
+
+            continue;
+        }
+
+        job->start_time = g_get_monotonic_time();
+
+        if (!g_cancellable_is_cancelled(job->cancellable))
+        {
+            job->result = job->func(job->data, job->cancellable);
+        }
+
+        _ca_scheduler_complete(scheduler, job);
+    }
+
+    g_private_set(&g_current_worker, NULL);
+
+    return NULL;
+}
+
+/**
+ * _ca_scheduler_take:
+ * @scheduler: The scheduler.
+ * @worker: The worker taking a job.
+ *
+ * Takes the most urgent job queued; the oldest of the worker's own queue, or otherwise the newest
+ * of another worker's queue.
+ *
+ * Returns: The job; otherwise NULL if none are queued.
+ **/
+static CaJob*
+_ca_scheduler_take(CaScheduler* scheduler, CaWorker* worker)
+{
+    gint job_class;
+
+    for (job_class = 0; job_class < JOB_CLASSES; job_class++)
+    {
+        GList* link;
+        gint victim;
+
+        g_mutex_lock(&worker->mutex);
+        link = g_queue_pop_head_link(&worker->queues[job_class]);
+        g_mutex_unlock(&worker->mutex);
+
+        /* Steal, starting beyond this worker so the thieves spread out. */
+        for (victim = 1; (link == NULL) && (victim < scheduler->worker_count); victim++)
+        {
+            CaWorker* other;
+
+            other = &scheduler->workers[(worker - scheduler->workers + victim) % scheduler->worker_count];
+
+            g_mutex_lock(&other->mutex);
+            link = g_queue_pop_tail_link(&other->queues[job_class]);
+            g_mutex_unlock(&other->mutex);
+        }
+
+        if (link != NULL)
+        {
+            g_atomic_int_add(&scheduler->depth[job_class], -1);
+            g_atomic_int_add(&scheduler->queued, -1);
+
+            return (CaJob*)link->data;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * _ca_scheduler_complete:
+ * @scheduler: The scheduler.
+ * @job: The job which has been run or abandoned.
+ *
+ * Pushes a job onto the completion stack; the main context is woken once for each batch, i.e.
+ * until it next dispatches.
+ **/
+static void
+_ca_scheduler_complete(CaScheduler* scheduler, CaJob* job)
+{
+    CaJob* head;
+
+    do
+    {
+        head = (CaJob*)g_atomic_pointer_get(&scheduler->completed);
+        job->next = head;
+    }
+    while (!g_atomic_pointer_compare_and_exchange(&scheduler->completed, head, job));
+
+    /* A scheduler whose last reference has gone is delivering its jobs itself. */
+    if ((scheduler->main_context != NULL) &&
+        g_atomic_int_compare_and_exchange(&scheduler->wakeup, FALSE, TRUE) &&
+        _ca_scheduler_ref_if_alive(scheduler))
+    {
+        GSource* source;
+
+        source = g_idle_source_new();
+        g_source_set_callback(source, _ca_scheduler_on_wakeup, (gpointer)scheduler, (GDestroyNotify)ca_scheduler_unref);
+        g_source_attach(source, scheduler->main_context);
+        g_source_unref(source);
+    }
+}
+
+/**
+ * _ca_scheduler_on_wakeup:
+ * @data: The scheduler of the completed jobs.
+ *
+ * Generated 'idle' caused when a worker thread has completed a batch of jobs.
+ *
+ * Returns: FALSE so the idle is removed.
+ **/
+static gboolean
+_ca_scheduler_on_wakeup(gpointer data)
+{
+    ca_scheduler_dispatch((CaScheduler*)data);
+
+    return FALSE;
+}
+
+/**
+ * _ca_scheduler_ref_if_alive:
+ * @scheduler: The scheduler.
+ *
+ * Adds a reference to the scheduler from a worker thread unless its last reference has already
+ * been released.
+ *
+ * Returns: TRUE if a reference was added; otherwise FALSE.
+ **/
+static gboolean
+_ca_scheduler_ref_if_alive(CaScheduler* scheduler)
+{
+    gint ref_count;
+
+    do
+    {
+        if ((ref_count = g_atomic_int_get(&scheduler->ref_count)) == 0)
+            return FALSE;
+    }
+    while (!g_atomic_int_compare_and_exchange(&scheduler->ref_count, ref_count, ref_count + 1));
+
+    return TRUE;
+}
+
+/**
+ * _ca_scheduler_deliver:
+ * @scheduler: The scheduler.
+ * @job: The completed job.
+ * @now: The time of the delivery.
+ *
+ * Counts a completed job, passes its result to its done function and frees it.
+ **/
+static void
+_ca_scheduler_deliver(CaScheduler* scheduler, CaJob* job, gint64 now)
+{
+    CaJobStats* stats;
+    gboolean cancelled;
+    gint64 wait;
+    gint64 latency;
+
+    cancelled = job->abandoned || g_cancellable_is_cancelled(job->cancellable);
+
+    /* A job abandoned before it was started waited until it was delivered. */
+    wait = ((job->start_time != 0) ? job->start_time : now) - job->submit_time;
+    latency = now - job->submit_time;
+
+    stats = &scheduler->stats[job->job_class];
+    stats->completed++;
+    stats->wait_total += wait;
+    stats->wait_max = MAX(stats->wait_max, wait);
+    stats->latency_total += latency;
+    stats->latency_max = MAX(stats->latency_max, latency);
+
+    if (cancelled)
+    {
+        stats->cancelled++;
+    }
+
+    if (job->done_func != NULL)
+    {
+        job->done_func(job->result, cancelled, job->data);
+    }
+
+    if (job->data_free != NULL)
+    {
+        job->data_free(job->data);
+    }
+
+    if (job->cancellable != NULL)
+    {
+        g_object_unref(job->cancellable);
+    }
+
+    g_free((gpointer)job);
+}
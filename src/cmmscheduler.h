@@ -0,0 +1,83 @@
+/* circular-main-menu
+ * Copyright (C) 2008 - Cole Anstey
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ * See http://code.google.com/p/circular-application-menu/
+ */
+#ifndef __CA_SCHEDULER_H__
+#define __CA_SCHEDULER_H__
+
+#include <gio/gio.h>
+
+G_BEGIN_DECLS
+
+/* Constants. */
+#define SCHEDULER_MAX_THREADS           16      /* The most worker threads of a scheduler. */
+
+/* The priority classes of the jobs; a worker always takes the most urgent job queued. */
+typedef enum
+{
+    JOB_VISIBLE,                        /* Required by what is shown now. */
+    JOB_PREVIEW,                        /* Required by the preview. */
+    JOB_SPECULATIVE,                    /* May be required soon, e.g. prefetching. */
+    JOB_MAINTENANCE,                    /* Never waited for, e.g. writing caches. */
+    JOB_CLASSES
+} JobClass;
+
+typedef struct _CaScheduler CaScheduler;
+typedef struct _CaJobStats CaJobStats;
+
+/* Called on a worker thread; long jobs should return early once @cancellable is cancelled. */
+typedef gpointer (*CaJobFunc)(gpointer data, GCancellable* cancellable);
+
+/* Called on the main thread with the result of the job, which it owns, even once cancelled. */
+typedef void (*CaJobDoneFunc)(gpointer result, gboolean cancelled, gpointer data);
+
+/* The counters of a priority class; the times are in microseconds. */
+struct _CaJobStats
+{
+    gint depth;                         /* The jobs queued but not yet started. */
+    guint completed;                    /* The jobs delivered to the main thread. */
+    guint cancelled;                    /* The delivered jobs which had been cancelled. */
+    gint64 wait_total;                  /* From being submitted until a worker started them. */
+    gint64 wait_max;
+    gint64 latency_total;               /* From being submitted until they were delivered. */
+    gint64 latency_max;
+};
+
+/* Construction */
+CaScheduler* ca_scheduler_new(gint threads, GMainContext* main_context);
+CaScheduler* ca_scheduler_get_default(void);
+CaScheduler* ca_scheduler_ref(CaScheduler* scheduler);
+void ca_scheduler_unref(CaScheduler* scheduler);
+
+/* Implementation */
+void ca_scheduler_submit(
+	CaScheduler* scheduler,
+	JobClass job_class,
+	GCancellable* cancellable,
+	CaJobFunc func,
+	CaJobDoneFunc done_func,
+	gpointer data,
+	GDestroyNotify data_free);
+gint ca_scheduler_dispatch(CaScheduler* scheduler);
+void ca_scheduler_get_stats(CaScheduler* scheduler, JobClass job_class, CaJobStats* stats);
+const gchar* ca_scheduler_get_class_name(JobClass job_class);
+
+G_END_DECLS
+
+#endif
@@ -0,0 +1,424 @@
+/* circular-main-menu
+ * Copyright (C) 2008 - Cole Anstey
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ * See http://code.google.com/p/circular-application-menu/
+ */
+#include "cmmtiles.h"
+
+typedef struct _CaTile CaTile;
+typedef struct _CaTileFrame CaTileFrame;
+
+/* A tile of the view with its own image surface. */
+struct _CaTile
+{
+    gint x;
+    gint y;
+    gint width;
+    gint height;
+    gboolean empty;                     /* No file-leaf bounding circle intersects the tile. */
+    cairo_surface_t* surface;
+};
+
+/* Renders the scene into tiles on several threads; see: ca_tiles_render_scene. */
+struct _CaTiles
+{
+    GThreadPool* pool;                  /* The threads beside the main thread; otherwise NULL. */
+    gint threads;                       /* Including the main thread. */
+    gint tile_size;
+    CaTile* tiles;
+    gint tile_count;
+    gint view_width;                    /* The view the tiles cover. */
+    gint view_height;
+};
+
+/* A frame being rendered; the tiles are taken in turn by every thread. */
+struct _CaTileFrame
+{
+    CaTiles* tiles;
+    const CaRenderContext* context;
+    gint next_tile;                     /* The next tile to take; atomic. */
+    gint running;                       /* The pool threads still rendering. */
+    GMutex mutex;
+    GCond finished;
+};
+
+static void _ca_tiles_layout(CaTiles* tiles, gint view_width, gint view_height);
+static void _ca_tiles_prepare(CaTiles* tiles, const CaRenderContext* context);
+static gboolean _ca_tiles_is_empty(const CaRenderContext* context, const CaTile* tile);
+static gboolean _ca_tiles_fileleaf_intersects(const CaRenderContext* context, CaFileLeaf* fileleaf, const CaTile* tile);
+static void _ca_tiles_render(CaTileFrame* frame);
+static void _ca_tiles_worker(gpointer data, gpointer user_data);
+
+/**
+ * ca_tiles_new:
+ * @threads: The threads to render with, including the calling thread.
+ * @tile_size: The width and height of each tile in pixels.
+ *
+ * Creates a renderer which splits a frame into tiles and renders them on several threads.
+ *
+ * Returns: The newly created tile renderer.
+ **/
+CaTiles*
+ca_tiles_new(gint threads, gint tile_size)
+{
+    CaTiles* tiles;
+
+    g_return_val_if_fail(tile_size > 0, NULL);
+
+    tiles = g_new0(CaTiles, 1);
+    tiles->threads = CLAMP(threads, 1, TILE_MAX_THREADS);
+    tiles->tile_size = tile_size;
+    tiles->tiles = NULL;
+    tiles->tile_count = 0;
+
+    if (tiles->threads > 1)
+    {
+        tiles->pool = g_thread_pool_new(_ca_tiles_worker, (gpointer)tiles, tiles->threads - 1, TRUE, NULL);
+    }
+
+    return tiles;
+}
+
+/**
+ * ca_tiles_free:
+ * @tiles: The tile renderer to free.
+ *
+ * Frees the tile renderer, its threads and its tile surfaces.
+ **/
+void
+ca_tiles_free(CaTiles* tiles)
+{
+    gint tile;
+
+    if (tiles->pool != NULL)
+    {
+        g_thread_pool_free(tiles->pool, FALSE, TRUE);
+    }
+
+    for (tile = 0; tile < tiles->tile_count; tile++)
+    {
+        cairo_surface_destroy(tiles->tiles[tile].surface);
+    }
+
+    g_free((gpointer)tiles->tiles);
+    g_free((gpointer)tiles);
+}
+
+/**
+ * ca_tiles_render_scene:
+ * @tiles: The tile renderer.
+ * @context: The state to render.
+ * @cr: A cairo-context to assemble the tiles on.
+ *
+ * Renders the file-leaves as ca_render_scene() does, but into tiles on several threads which are
+ * then assembled on @cr.  The render values kept with the file-leaves are built first on the
+ * calling thread, so the tile threads only read the file-leaves.  Nothing may change the
+ * file-leaves until this returns.  Tiles outside the clip of @cr are not rendered.
+ **/
+void
+ca_tiles_render_scene(CaTiles* tiles, const CaRenderContext* context, cairo_t* cr)
+{
+    CaRenderContext tile_context;
+    CaTileFrame frame;
+    gdouble clip_x1, clip_y1, clip_x2, clip_y2;
+    gint tile;
+    gint thread;
+
+    _ca_tiles_layout(tiles, context->view_width, context->view_height);
+
+    /* Every tile renders its segments and file-leaves directly; nothing is handed to the raster or kept as a surface. */
+    tile_context = *context;
+    tile_context.raster = NULL;
+    tile_context.render_leaf_surfaces = FALSE;
+
+    _ca_tiles_prepare(tiles, &tile_context);
+
+    /* Only the damage may be drawn, e.g. a change of prelight. */
+    cairo_clip_extents(cr, &clip_x1, &clip_y1, &clip_x2, &clip_y2);
+
+    for (tile = 0; tile < tiles->tile_count; tile++)
+    {
+        CaTile* current;
+
+        current = &tiles->tiles[tile];
+        current->empty =
+            (current->x >= clip_x2) ||
+            (current->y >= clip_y2) ||
+            (current->x + current->width <= clip_x1) ||
+            (current->y + current->height <= clip_y1) ||
+            _ca_tiles_is_empty(&tile_context, current);
+    }
+
+    frame.tiles = tiles;
+    frame.context = &tile_context;
+    frame.next_tile = 0;
+    frame.running = tiles->threads - 1;
+    g_mutex_init(&frame.mutex);
+    g_cond_init(&frame.finished);
+
+    for (thread = 1; thread < tiles->threads; thread++)
+    {
+        g_thread_pool_push(tiles->pool, (gpointer)&frame, NULL);
+    }
+
+    /* The calling thread takes tiles too. */
+    _ca_tiles_render(&frame);
+
+    g_mutex_lock(&frame.mutex);
+
+    while (frame.running > 0)
+    {
+        g_cond_wait(&frame.finished, &frame.mutex);
+    }
+
+    g_mutex_unlock(&frame.mutex);
+    g_mutex_clear(&frame.mutex);
+    g_cond_clear(&frame.finished);
+
+    /* Assemble the tiles over a cleared view. */
+    cairo_save(cr);
+    ca_render_background(context, cr);
+    cairo_set_operator(cr, CAIRO_OPERATOR_SOURCE);
+
+    for (tile = 0; tile < tiles->tile_count; tile++)
+    {
+        if (tiles->tiles[tile].empty)
+            continue;
+
+        cairo_set_source_surface(cr, tiles->tiles[tile].surface, tiles->tiles[tile].x, tiles->tiles[tile].y);
+        cairo_rectangle(cr, tiles->tiles[tile].x, tiles->tiles[tile].y, tiles->tiles[tile].width, tiles->tiles[tile].height);
+        cairo_fill(cr);
+    }
+
+    cairo_restore(cr);
+}
+
+/**
+ * ca_tiles_render_frame:
+ * @tiles: The tile renderer.
+ * @context: The state to render.
+ * @cr: A cairo-context to render to.
+ *
+ * Renders a complete frame as ca_render_frame() does, with the file-leaves rendered in tiles.
+ **/
+void
+ca_tiles_render_frame(CaTiles* tiles, const CaRenderContext* context, cairo_t* cr)
+{
+    /* Render the file-leaves. */
+    ca_tiles_render_scene(tiles, context, cr);
+
+    /* Render text. */
+    ca_render_text(context, cr);
+}
+
+/**
+ * _ca_tiles_layout:
+ * @tiles: The tile renderer.
+ * @view_width: The width of the view.
+ * @view_height: The height of the view.
+ *
+ * Splits the view into tiles; the tiles and their surfaces are kept until the view changes size.
+ **/
+static void
+_ca_tiles_layout(CaTiles* tiles, gint view_width, gint view_height)
+{
+    gint columns;
+    gint rows;
+    gint tile;
+
+    if ((tiles->tiles != NULL) &&
+        (tiles->view_width == view_width) &&
+        (tiles->view_height == view_height))
+        return;
+
+    for (tile = 0; tile < tiles->tile_count; tile++)
+    {
+        cairo_surface_destroy(tiles->tiles[tile].surface);
+    }
+
+    g_free((gpointer)tiles->tiles);
+
+    columns = (view_width + tiles->tile_size - 1) / tiles->tile_size;
+    rows = (view_height + tiles->tile_size - 1) / tiles->tile_size;
+
+    tiles->tile_count = columns * rows;
+    tiles->tiles = g_new0(CaTile, tiles->tile_count);
+    tiles->view_width = view_width;
+    tiles->view_height = view_height;
+
+    for (tile = 0; tile < tiles->tile_count; tile++)
+    {
+        CaTile* current;
+
+        current = &tiles->tiles[tile];
+        current->x = (tile % columns) * tiles->tile_size;
+        current->y = (tile / columns) * tiles->tile_size;
+        current->width = MIN(tiles->tile_size, view_width - current->x);
+        current->height = MIN(tiles->tile_size, view_height - current->y);
+        current->surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, current->width, current->height);
+    }
+}
+
+/**
+ * _ca_tiles_prepare:
+ * @tiles: The tile renderer.
+ * @context: The state to render.
+ *
+ * Builds the render values of every visible file-leaf and ring, i.e. the ring paths and overlap
+ * masks, by rendering the whole view once into a single pixel.  This is the same code as the tiles
+ * run, so they find every value already built and leave the file-leaves unchanged.
+ **/
+static void
+_ca_tiles_prepare(CaTiles* tiles, const CaRenderContext* context)
+{
+    CaRenderContext prepare_context;
+    cairo_surface_t* surface;
+    cairo_t* cr;
+
+    /* The reflection is not kept, so it is left out. */
+    prepare_context = *context;
+    prepare_context.render_reflection_off = TRUE;
+
+    surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, 1, 1);
+    cr = cairo_create(surface);
+
+    /* The clip extents in user space then cover the whole view, so nothing is culled. */
+    cairo_scale(cr, 1.0 / MAX(context->view_width, 1), 1.0 / MAX(context->view_height, 1));
+    ca_render_scene(&prepare_context, cr);
+
+    cairo_destroy(cr);
+    cairo_surface_destroy(surface);
+}
+
+/**
+ * _ca_tiles_is_empty:
+ * @context: The state to render.
+ * @tile: The tile to test.
+ *
+ * Retrieves whether no file-leaf can be rendered within a tile, from the bounding circles of the
+ * file-leaves.  A file-leaf which is opening is scaled out of its parent, so every tile is
+ * rendered whilst one is.
+ *
+ * Returns: TRUE if the tile is empty; otherwise FALSE.
+ **/
+static gboolean
+_ca_tiles_is_empty(const CaRenderContext* context, const CaTile* tile)
+{
+    CaFileLeaf* fileleaf;
+
+    for (fileleaf = context->root_fileleaf; fileleaf != NULL; fileleaf = fileleaf->_child_fileleaf)
+    {
+        GList* sub_list;
+
+        if (fileleaf->_current_animation_state == INITIAL_OPEN)
+            return FALSE;
+
+        if (_ca_tiles_fileleaf_intersects(context, fileleaf, tile))
+            return FALSE;
+
+        for (sub_list = fileleaf->_sub_fileleaves_list; sub_list != NULL; sub_list = g_list_next(sub_list))
+        {
+            if (_ca_tiles_fileleaf_intersects(context, (CaFileLeaf*)sub_list->data, tile))
+                return FALSE;
+        }
+    }
+
+    if ((context->disassociated_fileleaf != NULL) &&
+        _ca_tiles_fileleaf_intersects(context, context->disassociated_fileleaf, tile))
+        return FALSE;
+
+    return TRUE;
+}
+
+/**
+ * _ca_tiles_fileleaf_intersects:
+ * @context: The state to render.
+ * @fileleaf: A file-leaf.
+ * @tile: The tile to test.
+ *
+ * Retrieves whether the bounding circle of a file-leaf intersects a tile.
+ *
+ * Returns: TRUE if the file-leaf may be rendered within the tile; otherwise FALSE.
+ **/
+static gboolean
+_ca_tiles_fileleaf_intersects(const CaRenderContext* context, CaFileLeaf* fileleaf, const CaTile* tile)
+{
+    return ca_geometry_annulus_intersects_rectangle(
+        OFFSET_2_SCREEN(fileleaf->x, context->view_x_offset),
+        OFFSET_2_SCREEN(fileleaf->y, context->view_y_offset),
+        0,
+        fileleaf->bound_radius,
+        tile->x,
+        tile->y,
+        tile->x + tile->width,
+        tile->y + tile->height);
+}
+
+/**
+ * _ca_tiles_render:
+ * @frame: The frame being rendered.
+ *
+ * Takes the tiles of a frame in turn and renders each one until none are left; called by the
+ * main thread and every pool thread.
+ **/
+static void
+_ca_tiles_render(CaTileFrame* frame)
+{
+    gint tile;
+
+    while ((tile = g_atomic_int_add(&frame->next_tile, 1)) < frame->tiles->tile_count)
+    {
+        CaTile* current;
+        cairo_t* cr;
+
+        current = &frame->tiles->tiles[tile];
+
+        if (current->empty)
+            continue;
+
+        /* The scene clears the tile and the surface bounds clip it. */
+        cr = cairo_create(current->surface);
+        cairo_translate(cr, -current->x, -current->y);
+        ca_render_scene(frame->context, cr);
+        cairo_destroy(cr);
+
+        cairo_surface_flush(current->surface);
+    }
+}
+
+/**
+ * _ca_tiles_worker:
+ * @data: The frame being rendered.
+ * @user_data: The tile renderer.
+ *
+ * Renders tiles on a pool thread, then signals the main thread once it has finished.
+ **/
+static void
+_ca_tiles_worker(gpointer data, gpointer user_data)
+{
+    CaTileFrame* frame;
+
+    frame = (CaTileFrame*)data;
+
+    _ca_tiles_render(frame);
+
+    g_mutex_lock(&frame->mutex);
+    frame->running--;
+    g_cond_signal(&frame->finished);
+    g_mutex_unlock(&frame->mutex);
+}
@@ -0,0 +1,47 @@
+/* circular-main-menu
+ * Copyright (C) 2008 - Cole Anstey
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ * See http://code.google.com/p/circular-application-menu/
+ */
+#ifndef __CA_TILES_H__
+#define __CA_TILES_H__
+
+#include <cairo.h>
+#include <glib.h>
+
+#include "cmmrender.h"
+
+G_BEGIN_DECLS
+
+/* Constants. */
+#define TILE_DEFAULT_SIZE               256     /* The width and height of a tile in pixels. */
+#define TILE_MAX_THREADS                64
+
+typedef struct _CaTiles CaTiles;
+
+/* Construction */
+CaTiles* ca_tiles_new(gint threads, gint tile_size);
+void ca_tiles_free(CaTiles* tiles);
+
+/* Implementation */
+void ca_tiles_render_scene(CaTiles* tiles, const CaRenderContext* context, cairo_t* cr);
+void ca_tiles_render_frame(CaTiles* tiles, const CaRenderContext* context, cairo_t* cr);
+
+G_END_DECLS
+
+#endif
@@ -0,0 +1,991 @@
+/* circular-main-menu
+ * Copyright (C) 2008 - Cole Anstey
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ * See http://code.google.com/p/circular-application-menu/
+ */
+#include <gtk/gtk.h>
+#include <gio/gio.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cmmtrace.h"
+#include "cmmcircularmainmenu.h"
+#include "cmmrender.h"
+
+#define TRACE_VERSION                   1
+#define FILELEAF_BARRIER_TIMEOUT        5000    /* The milliseconds a replay waits for a file-leaf to be built. */
+#define REPLAY_SETTLE_INTERVAL          500     /* The milliseconds of frames collected after the last event. */
+
+/* What is being traced. */
+typedef enum
+{
+    TRACE_OFF,
+    TRACE_RECORDING,
+    TRACE_REPLAYING
+} TraceMode;
+
+typedef struct _CaTraceEntry CaTraceEntry;
+typedef struct _CaTraceQuality CaTraceQuality;
+
+/* A single line of a trace; an event delivered to the widget or a file-leaf which was built. */
+struct _CaTraceEntry
+{
+    gint64 _time;                       /* The microseconds since the trace started. */
+    GdkEventType _type;                 /* GDK_NOTHING for a built file-leaf. */
+    gint _x;
+    gint _y;
+    guint _detail;                      /* The button, keyval or number of file-leaves built. */
+    guint _state;
+    gint64 _handler;                    /* The microseconds spent in the widget when replayed. */
+};
+
+/* A change of the render quality during a replay; see: CaBudget. */
+struct _CaTraceQuality
+{
+    gint64 _time;                       /* The microseconds since the trace started. */
+    gint _level;
+    const gchar* _name;
+};
+
+/* The names of the trace entries. */
+static const struct
+{
+    const gchar* _name;
+    GdkEventType _type;
+} g_entry_names[] =
+{
+    { "motion", GDK_MOTION_NOTIFY },
+    { "button-press", GDK_BUTTON_PRESS },
+    { "2button-press", GDK_2BUTTON_PRESS },
+    { "3button-press", GDK_3BUTTON_PRESS },
+    { "button-release", GDK_BUTTON_RELEASE },
+    { "key-press", GDK_KEY_PRESS },
+    { "key-release", GDK_KEY_RELEASE },
+    { "fileleaf", GDK_NOTHING }
+};
+
+/* Local data. */
+static TraceMode g_mode = TRACE_OFF;
+static GtkWidget* g_widget = NULL;
+static gint64 g_origin = 0;
+static gint g_fileleaves_built = 0;
+static gchar* g_filename = NULL;
+static GString* g_trace = NULL;
+static GArray* g_entries = NULL;
+static guint g_next_entry = 0;
+static guint g_replay_source_id = 0;
+static gboolean g_waiting = FALSE;
+static gint64 g_waiting_since = 0;
+static GArray* g_frames = NULL;
+static gdouble g_frame_budget = 0.0;
+static GArray* g_qualities = NULL;
+static gint g_quality_level = 0;
+static const gchar* g_quality_name = NULL;
+static gint64 g_damage_pixels = 0;
+static gint g_damage_frames = 0;
+
+static gboolean _ca_trace_on_replay_next(gpointer data);
+
+/**
+ * _ca_trace_entry_name:
+ * @type: The type of the trace entry.
+ *
+ * Retrieves the name written to the trace for an entry.
+ *
+ * Returns: The static name; otherwise NULL if the event is not traced.
+ **/
+static const gchar*
+_ca_trace_entry_name(GdkEventType type)
+{
+    guint i;
+
+    for (i = 0; i < G_N_ELEMENTS(g_entry_names); i++)
+    {
+        if (g_entry_names[i]._type == type)
+            return g_entry_names[i]._name;
+    }
+
+    return NULL;
+}
+
+/**
+ * _ca_trace_on_event:
+ * @widget: The traced widget.
+ * @event: The event about to be delivered.
+ * @data: Unused.
+ *
+ * Generated 'event' caused before any event is delivered to the traced widget.  A recording
+ * writes the pointer and key events to the trace; a replay stops the real pointer and keyboard
+ * from reaching the widget so only the trace drives it.
+ *
+ * Returns: TRUE to stop a real event during a replay; otherwise FALSE.
+ **/
+static gboolean
+_ca_trace_on_event(GtkWidget* widget, GdkEvent* event, gpointer data)
+{
+    const gchar* name;
+    GdkRectangle canvas;
+    gint width, height;
+    gint64 time;
+
+    if ((name = _ca_trace_entry_name(event->type)) == NULL)
+        return FALSE;
+
+    if (g_mode == TRACE_REPLAYING)
+    {
+        /* The replayed events are sent rather than read from the display. */
+        return (FALSE == event->any.send_event);
+    }
+
+    if (g_mode != TRACE_RECORDING)
+        return FALSE;
+
+    time = g_get_monotonic_time() - g_origin;
+
+    /* The pointer is recorded in view co-ordinates, so a trace replays whatever the window covers. */
+    ca_circular_application_menu_get_canvas(CA_CIRCULAR_APPLICATION_MENU(widget), &width, &height, &canvas);
+
+    switch (event->type)
+    {
+        case GDK_MOTION_NOTIFY:
+        {
+            gint x, y;
+            GdkModifierType state;
+
+            if (event->motion.is_hint)
+            {
+                /* Record where the widget will find the pointer. */
+                gdk_window_get_device_position(event->motion.window, gdk_event_get_device(event), &x, &y, &state);
+            }
+            else
+            {
+                x = (gint)event->motion.x;
+                y = (gint)event->motion.y;
+                state = event->motion.state;
+            }
+
+            g_string_append_printf(g_trace, "%" G_GINT64_FORMAT " %s %d %d %u\n", time, name, x + canvas.x, y + canvas.y, (guint)state);
+            break;
+        }
+        case GDK_BUTTON_PRESS:
+        case GDK_2BUTTON_PRESS:
+        case GDK_3BUTTON_PRESS:
+        case GDK_BUTTON_RELEASE:
+            g_string_append_printf(
+                g_trace,
+                "%" G_GINT64_FORMAT " %s %d %d %u %u\n",
+                time,
+                name,
+                (gint)event->button.x + canvas.x,
+                (gint)event->button.y + canvas.y,
+                event->button.button,
+                event->button.state);
+            break;
+        case GDK_KEY_PRESS:
+        case GDK_KEY_RELEASE:
+            g_string_append_printf(g_trace, "%" G_GINT64_FORMAT " %s 0x%x %u\n", time, name, event->key.keyval, event->key.state);
+            break;
+        default:
+            break;
+    }
+
+    return FALSE;
+}
+
+/**
+ * _ca_trace_begin:
+ * @widget: The widget to trace.
+ * @mode: Whether the widget is being recorded or replayed.
+ *
+ * Starts tracing the widget from now.
+ **/
+static void
+_ca_trace_begin(GtkWidget* widget, TraceMode mode)
+{
+    g_mode = mode;
+    g_widget = widget;
+    g_origin = g_get_monotonic_time();
+    g_fileleaves_built = 0;
+    g_damage_pixels = 0;
+    g_damage_frames = 0;
+
+    g_signal_connect (widget, "event", G_CALLBACK (_ca_trace_on_event), NULL);
+}
+
+/**
+ * ca_trace_record:
+ * @widget: The widget to record.
+ * @filename: The file to write the trace to.
+ * @error: A return location for errors.
+ *
+ * Starts recording the pointer and key events delivered to the widget, and the file-leaves built
+ * in response, as a timestamped trace.  The trace is written by ca_trace_finish().
+ *
+ * Returns: TRUE if recording has started; otherwise FALSE.
+ **/
+gboolean
+ca_trace_record(GtkWidget* widget, const gchar* filename, GError** error)
+{
+    GdkRectangle canvas;
+    gint width, height;
+
+    g_return_val_if_fail(g_mode == TRACE_OFF, FALSE);
+
+    ca_circular_application_menu_get_canvas(CA_CIRCULAR_APPLICATION_MENU(widget), &width, &height, &canvas);
+
+    g_filename = g_strdup(filename);
+    g_trace = g_string_new(NULL);
+
+    /* The environment which selects the menu snapshot is recorded so a replay can check it. */
+    g_string_append_printf(g_trace, "# cam-trace %d\n", TRACE_VERSION);
+    g_string_append_printf(g_trace, "# size %d %d\n", width, height);
+    g_string_append_printf(g_trace, "# XDG_CONFIG_DIRS=%s\n", g_getenv("XDG_CONFIG_DIRS") ? g_getenv("XDG_CONFIG_DIRS") : "");
+    g_string_append_printf(g_trace, "# XDG_DATA_DIRS=%s\n", g_getenv("XDG_DATA_DIRS") ? g_getenv("XDG_DATA_DIRS") : "");
+
+    _ca_trace_begin(widget, TRACE_RECORDING);
+
+    return TRUE;
+}
+
+/**
+ * _ca_trace_check_header:
+ * @widget: The widget being replayed.
+ * @line: A header line of the trace.
+ *
+ * Warns when the trace was recorded against a different window size or menu snapshot; the
+ * file-items would then be at different positions and the replay would not be comparable.
+ **/
+static void
+_ca_trace_check_header(GtkWidget* widget, const gchar* line)
+{
+    GdkRectangle canvas;
+    gint view_width, view_height;
+    gint width, height;
+    gint version;
+
+    if (sscanf(line, "# cam-trace %d", &version) == 1)
+    {
+        if (version != TRACE_VERSION)
+        {
+            g_warning ("The trace is version %d; version %d is expected.\n", version, TRACE_VERSION);
+        }
+    }
+    else if (sscanf(line, "# size %d %d", &width, &height) == 2)
+    {
+        ca_circular_application_menu_get_canvas(CA_CIRCULAR_APPLICATION_MENU(widget), &view_width, &view_height, &canvas);
+
+        if ((width != view_width) ||
+            (height != view_height))
+        {
+            g_warning ("The trace was recorded at %dx%d; the menu is %dx%d.\n", width, height, view_width, view_height);
+        }
+    }
+    else if ((g_str_has_prefix(line, "# XDG_CONFIG_DIRS=")) ||
+             (g_str_has_prefix(line, "# XDG_DATA_DIRS=")))
+    {
+        const gchar* variable;
+        gchar* name;
+
+        variable = line + strlen("# ");
+        name = g_strndup(variable, strchr(variable, '=') - variable);
+
+        if (g_strcmp0(strchr(variable, '=') + 1, g_getenv(name) ? g_getenv(name) : "") != 0)
+        {
+            g_warning ("The trace was recorded with a different %s; the menu may differ.\n", name);
+        }
+
+        g_free((gpointer)name);
+    }
+}
+
+/**
+ * _ca_trace_parse_entry:
+ * @line: An entry line of the trace.
+ * @entry: A return location for the entry.
+ *
+ * Parses a single entry of the trace.
+ *
+ * Returns: TRUE if the line is a valid entry; otherwise FALSE.
+ **/
+static gboolean
+_ca_trace_parse_entry(const gchar* line, CaTraceEntry* entry)
+{
+    gchar** tokens;
+    gint count;
+    gboolean valid;
+    guint i;
+
+    tokens = g_strsplit(line, " ", -1);
+    count = g_strv_length(tokens);
+    valid = FALSE;
+
+    memset(entry, 0, sizeof(CaTraceEntry));
+    entry->_handler = -1;
+
+    for (i = 0; (count >= 2) && (i < G_N_ELEMENTS(g_entry_names)); i++)
+    {
+        if (strcmp(tokens[1], g_entry_names[i]._name) == 0)
+            break;
+    }
+
+    if ((count >= 2) &&
+        (i < G_N_ELEMENTS(g_entry_names)))
+    {
+        entry->_time = g_ascii_strtoll(tokens[0], NULL, 10);
+        entry->_type = g_entry_names[i]._type;
+
+        switch (entry->_type)
+        {
+            case GDK_MOTION_NOTIFY:
+                if ((valid = (count == 5)))
+                {
+                    entry->_x = (gint)g_ascii_strtoll(tokens[2], NULL, 10);
+                    entry->_y = (gint)g_ascii_strtoll(tokens[3], NULL, 10);
+                    entry->_state = (guint)g_ascii_strtoull(tokens[4], NULL, 10);
+                }
+                break;
+            case GDK_BUTTON_PRESS:
+            case GDK_2BUTTON_PRESS:
+            case GDK_3BUTTON_PRESS:
+            case GDK_BUTTON_RELEASE:
+                if ((valid = (count == 6)))
+                {
+                    entry->_x = (gint)g_ascii_strtoll(tokens[2], NULL, 10);
+                    entry->_y = (gint)g_ascii_strtoll(tokens[3], NULL, 10);
+                    entry->_detail = (guint)g_ascii_strtoull(tokens[4], NULL, 10);
+                    entry->_state = (guint)g_ascii_strtoull(tokens[5], NULL, 10);
+                }
+                break;
+            case GDK_KEY_PRESS:
+            case GDK_KEY_RELEASE:
+                if ((valid = (count == 4)))
+                {
+                    entry->_detail = (guint)g_ascii_strtoull(tokens[2], NULL, 0);
+                    entry->_state = (guint)g_ascii_strtoull(tokens[3], NULL, 10);
+                }
+                break;
+            default:
+                if ((valid = (count == 3)))
+                {
+                    entry->_detail = (guint)g_ascii_strtoull(tokens[2], NULL, 10);
+                }
+                break;
+        }
+    }
+
+    g_strfreev(tokens);
+
+    return valid;
+}
+
+/**
+ * ca_trace_replay:
+ * @widget: The widget to replay the trace against.
+ * @filename: The trace written by ca_trace_record().
+ * @frame_budget: The p99 frame time in milliseconds which fails the replay; otherwise 0.
+ * @error: A return location for errors.
+ *
+ * Starts replaying a trace against the widget.  The events are sent at their recorded times
+ * and each built file-leaf in the trace holds back the following events until the replay has
+ * built it too, so the events reach the same file-leaves however long the builds take.  The
+ * replay quits the main loop once the trace has been replayed; ca_trace_finish() writes the
+ * report.
+ *
+ * Returns: TRUE if the replay has started; otherwise FALSE.
+ **/
+gboolean
+ca_trace_replay(GtkWidget* widget, const gchar* filename, gdouble frame_budget, GError** error)
+{
+    gchar* contents;
+    gchar** lines;
+    gint i;
+
+    g_return_val_if_fail(g_mode == TRACE_OFF, FALSE);
+
+    if (!g_file_get_contents(filename, &contents, NULL, error))
+        return FALSE;
+
+    lines = g_strsplit(contents, "\n", -1);
+    g_free((gpointer)contents);
+
+    g_entries = g_array_new(FALSE, FALSE, sizeof(CaTraceEntry));
+
+    for (i = 0; lines[i] != NULL; i++)
+    {
+        CaTraceEntry entry;
+
+        if (lines[i][0] == '\0')
+            continue;
+
+        if (lines[i][0] == '#')
+        {
+            _ca_trace_check_header(widget, lines[i]);
+
+            continue;
+        }
+
+        if (!_ca_trace_parse_entry(lines[i], &entry))
+        {
+            g_set_error(error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA, "%s:%d: not a trace entry", filename, i + 1);
+            g_strfreev(lines);
+            g_array_free(g_entries, TRUE);
+            g_entries = NULL;
+
+            return FALSE;
+        }
+
+        g_array_append_val(g_entries, entry);
+    }
+
+    g_strfreev(lines);
+
+    g_frames = g_array_new(FALSE, FALSE, sizeof(gint64));
+    g_qualities = g_array_new(FALSE, FALSE, sizeof(CaTraceQuality));
+    g_frame_budget = frame_budget;
+    g_next_entry = 0;
+
+    _ca_trace_begin(widget, TRACE_REPLAYING);
+
+    g_replay_source_id = g_idle_add(_ca_trace_on_replay_next, NULL);
+
+    return TRUE;
+}
+
+/**
+ * ca_trace_is_enabled:
+ *
+ * Retrieves whether a trace is being replayed, and the frames should therefore be timed.
+ *
+ * Returns: TRUE if a trace is being replayed; otherwise FALSE.
+ **/
+gboolean
+ca_trace_is_enabled(void)
+{
+    return (g_mode == TRACE_REPLAYING);
+}
+
+/**
+ * _ca_trace_replay_dispatch:
+ * @entry: The event to send.
+ *
+ * Sends a replayed event to the widget, timing its handler.  Motion is sent without the hint so
+ * the widget uses the recorded position rather than the real pointer.
+ **/
+static void
+_ca_trace_replay_dispatch(CaTraceEntry* entry)
+{
+    GdkDisplay* display;
+    GdkSeat* seat;
+    GdkEvent* event;
+    GdkRectangle canvas;
+    gint width, height;
+    gint64 start;
+
+    /* The pointer was recorded in view co-ordinates. */
+    ca_circular_application_menu_get_canvas(CA_CIRCULAR_APPLICATION_MENU(g_widget), &width, &height, &canvas);
+
+    display = gtk_widget_get_display(g_widget);
+    seat = gdk_display_get_default_seat(display);
+
+    event = gdk_event_new(entry->_type);
+    event->any.window = g_object_ref(gtk_widget_get_window(g_widget));
+    event->any.send_event = TRUE;
+
+    switch (entry->_type)
+    {
+        case GDK_MOTION_NOTIFY:
+            event->motion.time = GDK_CURRENT_TIME;
+            event->motion.x = entry->_x - canvas.x;
+            event->motion.y = entry->_y - canvas.y;
+            event->motion.state = entry->_state;
+            event->motion.is_hint = FALSE;
+            gdk_event_set_device(event, gdk_seat_get_pointer(seat));
+            break;
+        case GDK_KEY_PRESS:
+        case GDK_KEY_RELEASE:
+            event->key.time = GDK_CURRENT_TIME;
+            event->key.keyval = entry->_detail;
+            event->key.state = entry->_state;
+            gdk_event_set_device(event, gdk_seat_get_keyboard(seat));
+            break;
+        default:
+            event->button.time = GDK_CURRENT_TIME;
+            event->button.x = entry->_x - canvas.x;
+            event->button.y = entry->_y - canvas.y;
+            event->button.button = entry->_detail;
+            event->button.state = entry->_state;
+            gdk_event_set_device(event, gdk_seat_get_pointer(seat));
+            break;
+    }
+
+    start = g_get_monotonic_time();
+    gtk_widget_event(g_widget, event);
+    entry->_handler = g_get_monotonic_time() - start;
+
+    gdk_event_free(event);
+}
+
+/**
+ * _ca_trace_on_replay_finished:
+ * @data: Unused.
+ *
+ * Generated 'timeout' caused once the frames following the last event have been collected.
+ *
+ * Returns: FALSE so the timeout is removed.
+ **/
+static gboolean
+_ca_trace_on_replay_finished(gpointer data)
+{
+    g_replay_source_id = 0;
+
+    gtk_main_quit();
+
+    return FALSE;
+}
+
+/**
+ * _ca_trace_on_replay_next:
+ * @data: Unused.
+ *
+ * Generated 'timeout' or 'idle' caused when the next entry of the trace is due.  The events
+ * which are due are sent, then the replay waits for the next event or for a file-leaf to be
+ * built.  A wait for a file-leaf moves the following events later by the same amount.
+ *
+ * Returns: FALSE so the source is removed.
+ **/
+static gboolean
+_ca_trace_on_replay_next(gpointer data)
+{
+    g_replay_source_id = 0;
+
+    while (g_next_entry < g_entries->len)
+    {
+        CaTraceEntry* entry;
+        gint64 now;
+
+        entry = &g_array_index(g_entries, CaTraceEntry, g_next_entry);
+        now = g_get_monotonic_time();
+
+        if (entry->_type == GDK_NOTHING)
+        {
+            if (g_fileleaves_built < (gint)entry->_detail)
+            {
+                if (FALSE == g_waiting)
+                {
+                    g_waiting = TRUE;
+                    g_waiting_since = now;
+                }
+
+                if (now - g_waiting_since < (gint64)FILELEAF_BARRIER_TIMEOUT * 1000)
+                {
+                    /* ca_trace_fileleaf_built() continues the replay sooner. */
+                    g_replay_source_id = g_timeout_add(
+                        FILELEAF_BARRIER_TIMEOUT - (guint)((now - g_waiting_since) / 1000),
+                        _ca_trace_on_replay_next,
+                        NULL);
+
+                    return FALSE;
+                }
+
+                g_warning ("The replay did not build file-leaf %u; the replay has diverged from the trace.\n", entry->_detail);
+            }
+
+            g_waiting = FALSE;
+
+            /* Keep the recorded delay between the file-leaf and the following events. */
+            if (now - g_origin > entry->_time)
+            {
+                g_origin = now - entry->_time;
+            }
+
+            g_next_entry++;
+
+            continue;
+        }
+
+        if (g_origin + entry->_time > now)
+        {
+            g_replay_source_id = g_timeout_add(
+                (guint)((g_origin + entry->_time - now) / 1000),
+                _ca_trace_on_replay_next,
+                NULL);
+
+            return FALSE;
+        }
+
+        g_next_entry++;
+        _ca_trace_replay_dispatch(entry);
+    }
+
+    g_replay_source_id = g_timeout_add(REPLAY_SETTLE_INTERVAL, _ca_trace_on_replay_finished, NULL);
+
+    return FALSE;
+}
+
+/**
+ * ca_trace_timestamp:
+ *
+ * Retrieves the current monotonic time while a trace is being replayed.
+ *
+ * Returns: The monotonic time in microseconds; otherwise 0 when no trace is being replayed.
+ **/
+gint64
+ca_trace_timestamp(void)
+{
+    if (g_mode != TRACE_REPLAYING)
+        return 0;
+
+    return g_get_monotonic_time();
+}
+
+/**
+ * ca_trace_frame:
+ * @start: The timestamp returned by ca_trace_timestamp() when the frame started painting.
+ *
+ * Records the paint time of a frame.
+ **/
+void
+ca_trace_frame(gint64 start)
+{
+    gint64 elapsed;
+
+    if ((g_mode != TRACE_REPLAYING) ||
+        (start == 0))
+        return;
+
+    elapsed = g_get_monotonic_time() - start;
+    g_array_append_val(g_frames, elapsed);
+}
+
+/**
+ * ca_trace_damage:
+ * @pixels: The pixels of the window a frame has drawn.
+ *
+ * Records the damage of a frame; the pixels it pushes to the window.
+ **/
+void
+ca_trace_damage(gint64 pixels)
+{
+    if (g_mode != TRACE_REPLAYING)
+        return;
+
+    g_damage_pixels += pixels;
+    g_damage_frames++;
+}
+
+/**
+ * ca_trace_fileleaf_built:
+ *
+ * Records that the widget has built and attached a file-leaf.
+ **/
+void
+ca_trace_fileleaf_built(void)
+{
+    if (g_mode == TRACE_OFF)
+        return;
+
+    g_fileleaves_built++;
+
+    if (g_mode == TRACE_RECORDING)
+    {
+        g_string_append_printf(
+            g_trace,
+            "%" G_GINT64_FORMAT " %s %d\n",
+            g_get_monotonic_time() - g_origin,
+            _ca_trace_entry_name(GDK_NOTHING),
+            g_fileleaves_built);
+    }
+    else if ((TRUE == g_waiting) &&
+             (g_replay_source_id != 0))
+    {
+        /* Continue the replay which is waiting for this file-leaf. */
+        g_source_remove(g_replay_source_id);
+        g_replay_source_id = g_idle_add(_ca_trace_on_replay_next, NULL);
+    }
+}
+
+/**
+ * ca_trace_quality:
+ * @level: The quality level now rendered.
+ * @name: The static name of the level.
+ *
+ * Records a change of the render quality; the changes during a replay, and the level at its end,
+ * are written to the report.
+ **/
+void
+ca_trace_quality(gint level, const gchar* name)
+{
+    g_quality_level = level;
+    g_quality_name = name;
+
+    if (g_mode == TRACE_REPLAYING)
+    {
+        CaTraceQuality quality;
+
+        quality._time = g_get_monotonic_time() - g_origin;
+        quality._level = level;
+        quality._name = name;
+
+        g_array_append_val(g_qualities, quality);
+    }
+}
+
+/**
+ * _ca_trace_compare:
+ * @a: A gint64 pointer to the first time.
+ * @b: A gint64 pointer to the second time.
+ *
+ * Orders the times for the percentiles.
+ *
+ * Returns: A negative, zero or positive value as for qsort().
+ **/
+static int
+_ca_trace_compare(const void* a, const void* b)
+{
+    gint64 first;
+    gint64 second;
+
+    first = *(const gint64*)a;
+    second = *(const gint64*)b;
+
+    return (first > second) - (first < second);
+}
+
+/**
+ * _ca_trace_percentile:
+ * @samples: The sorted times.
+ * @count: The number of times.
+ * @percentile: The percentile to retrieve.
+ *
+ * Retrieves a percentile using the nearest rank.
+ *
+ * Returns: The time at the percentile; otherwise 0 when there are no times.
+ **/
+static gint64
+_ca_trace_percentile(const gint64* samples, gint count, gdouble percentile)
+{
+    gint rank;
+
+    if (count == 0)
+        return 0;
+
+    rank = (gint)((percentile / 100.0) * count + 0.5);
+    rank = CLAMP(rank, 1, count);
+
+    return samples[rank - 1];
+}
+
+/**
+ * _ca_trace_append_summary:
+ * @json: The report being written.
+ * @name: The name of the summary.
+ * @samples: The times to summarise; these are sorted.
+ * @count: The number of times.
+ *
+ * Writes the count and the p50, p90, p99 and maximum times.
+ **/
+static void
+_ca_trace_append_summary(GString* json, const gchar* name, gint64* samples, gint count)
+{
+    qsort(samples, count, sizeof(gint64), _ca_trace_compare);
+
+    g_string_append_printf(
+        json,
+        "  \"%s\": { \"count\": %d, \"p50\": %" G_GINT64_FORMAT ", \"p90\": %" G_GINT64_FORMAT ", \"p99\": %" G_GINT64_FORMAT ", \"max\": %" G_GINT64_FORMAT " },\n",
+        name,
+        count,
+        _ca_trace_percentile(samples, count, 50.0),
+        _ca_trace_percentile(samples, count, 90.0),
+        _ca_trace_percentile(samples, count, 99.0),
+        (count > 0) ? samples[count - 1] : 0);
+}
+
+/**
+ * _ca_trace_write_report:
+ *
+ * Writes the replay report as JSON to the standard output and checks the frame budget.  All
+ * times are in microseconds; the event times are relative to the start of the replay.
+ *
+ * Returns: 0 if the p99 frame time is within the budget; otherwise -1.
+ **/
+static gint
+_ca_trace_write_report(void)
+{
+    GString* json;
+    GArray* handlers;
+    gint64 duration;
+    gint64 p99;
+    gboolean passed;
+    guint i;
+
+    json = g_string_new("{\n");
+    g_string_append_printf(json, "  \"version\": %d,\n", TRACE_VERSION);
+    g_string_append(json, "  \"units\": \"us\",\n");
+
+    /* Per-event handler times. */
+    handlers = g_array_new(FALSE, FALSE, sizeof(gint64));
+    g_string_append(json, "  \"events\": [");
+
+    for (i = 0; i < g_next_entry; i++)
+    {
+        CaTraceEntry* entry;
+
+        entry = &g_array_index(g_entries, CaTraceEntry, i);
+
+        if (entry->_handler < 0)
+            continue;
+
+        g_string_append_printf(
+            json,
+            "%s\n    { \"time\": %" G_GINT64_FORMAT ", \"type\": \"%s\", \"handler\": %" G_GINT64_FORMAT " }",
+            (handlers->len == 0) ? "" : ",",
+            entry->_time,
+            _ca_trace_entry_name(entry->_type),
+            entry->_handler);
+
+        g_array_append_val(handlers, entry->_handler);
+    }
+
+    g_string_append(json, "\n  ],\n");
+
+    /* Per-frame paint times, in the order they were painted. */
+    g_string_append(json, "  \"frames\": [");
+
+    for (i = 0; i < g_frames->len; i++)
+    {
+        g_string_append_printf(json, "%s%" G_GINT64_FORMAT, (i == 0) ? "" : ", ", g_array_index(g_frames, gint64, i));
+    }
+
+    g_string_append(json, "],\n");
+
+    _ca_trace_append_summary(json, "handler", (gint64*)handlers->data, handlers->len);
+    _ca_trace_append_summary(json, "paint", (gint64*)g_frames->data, g_frames->len);
+
+    p99 = _ca_trace_percentile((gint64*)g_frames->data, g_frames->len, 99.0);
+    passed = ((g_frame_budget <= 0.0) || (p99 <= (gint64)(g_frame_budget * 1000.0)));
+
+    /* The changes of render quality made to keep within the paint budget. */
+    g_string_append(json, "  \"quality\": [");
+
+    for (i = 0; i < g_qualities->len; i++)
+    {
+        CaTraceQuality* quality;
+
+        quality = &g_array_index(g_qualities, CaTraceQuality, i);
+
+        g_string_append_printf(
+            json,
+            "%s\n    { \"time\": %" G_GINT64_FORMAT ", \"level\": %d, \"name\": \"%s\" }",
+            (i == 0) ? "" : ",",
+            quality->_time,
+            quality->_level,
+            quality->_name);
+    }
+
+    g_string_append(json, (g_qualities->len == 0) ? "],\n" : "\n  ],\n");
+    g_string_append_printf(
+        json,
+        "  \"quality_level\": { \"level\": %d, \"name\": \"%s\" },\n",
+        g_quality_level,
+        (g_quality_name != NULL) ? g_quality_name : "full");
+
+    /* The pixels pushed to the window, which are comparable across the render options. */
+    duration = MAX(g_get_monotonic_time() - g_origin, 1);
+
+    g_string_append_printf(
+        json,
+        "  \"damage\": { \"frames\": %d, \"pixels\": %" G_GINT64_FORMAT ", \"bytes\": %" G_GINT64_FORMAT ", \"pixels_per_second\": %" G_GINT64_FORMAT ", \"bytes_per_second\": %" G_GINT64_FORMAT " },\n",
+        g_damage_frames,
+        g_damage_pixels,
+        g_damage_pixels * DAMAGE_BYTES_PER_PIXEL,
+        (g_damage_pixels * G_USEC_PER_SEC) / duration,
+        (g_damage_pixels * DAMAGE_BYTES_PER_PIXEL * G_USEC_PER_SEC) / duration);
+
+    g_string_append_printf(json, "  \"fileleaves_built\": %d,\n", g_fileleaves_built);
+    g_string_append_printf(json, "  \"replayed\": %s,\n", (g_next_entry == g_entries->len) ? "true" : "false");
+    g_string_append_printf(json, "  \"frame_budget\": %" G_GINT64_FORMAT ",\n", (gint64)(g_frame_budget * 1000.0));
+    g_string_append_printf(json, "  \"passed\": %s\n}\n", passed ? "true" : "false");
+
+    fputs(json->str, stdout);
+    fflush(stdout);
+
+    if (FALSE == passed)
+    {
+        g_warning ("The p99 frame time of %" G_GINT64_FORMAT "us exceeds the budget of %gms.\n", p99, g_frame_budget);
+    }
+
+    g_string_free(json, TRUE);
+    g_array_free(handlers, TRUE);
+
+    return passed ? 0 : -1;
+}
+
+/**
+ * ca_trace_finish:
+ *
+ * Stops tracing.  A recording is written to its file; a replay writes its report.
+ *
+ * Returns: -1 if the trace could not be written or the replay exceeded its frame budget;
+ * otherwise 0.
+ **/
+gint
+ca_trace_finish(void)
+{
+    GError* error = NULL;
+    gint status;
+
+    status = 0;
+
+    if (g_mode == TRACE_RECORDING)
+    {
+        if (!g_file_set_contents(g_filename, g_trace->str, g_trace->len, &error))
+        {
+            g_warning ("Writing the trace failed: %s\n", error->message);
+            g_clear_error (&error); /* g_error_free */
+
+            status = -1;
+        }
+
+        g_string_free(g_trace, TRUE);
+        g_trace = NULL;
+        g_free((gpointer)g_filename);
+        g_filename = NULL;
+    }
+    else if (g_mode == TRACE_REPLAYING)
+    {
+        if (g_replay_source_id != 0)
+        {
+            g_source_remove(g_replay_source_id);
+            g_replay_source_id = 0;
+        }
+
+        status = _ca_trace_write_report();
+
+        g_array_free(g_entries, TRUE);
+        g_entries = NULL;
+        g_array_free(g_frames, TRUE);
+        g_frames = NULL;
+        g_array_free(g_qualities, TRUE);
+        g_qualities = NULL;
+    }
+
+    g_mode = TRACE_OFF;
+
+    return status;
+}
@@ -0,0 +1,43 @@
+/* circular-main-menu
+ * Copyright (C) 2008 - Cole Anstey
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ * See http://code.google.com/p/circular-application-menu/
+ */
+#ifndef __CA_TRACE_H__
+#define __CA_TRACE_H__
+
+#include <gtk/gtk.h>
+
+G_BEGIN_DECLS
+
+/* Construction */
+gboolean ca_trace_record(GtkWidget* widget, const gchar* filename, GError** error);
+gboolean ca_trace_replay(GtkWidget* widget, const gchar* filename, gdouble frame_budget, GError** error);
+gboolean ca_trace_is_enabled(void);
+
+/* Implementation */
+gint64 ca_trace_timestamp(void);
+void ca_trace_frame(gint64 start);
+void ca_trace_damage(gint64 pixels);
+void ca_trace_fileleaf_built(void);
+void ca_trace_quality(gint level, const gchar* name);
+gint ca_trace_finish(void);
+
+G_END_DECLS
+
+#endif
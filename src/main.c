@@ -31,9 +31,90 @@
 #define GMENU_I_KNOW_THIS_IS_UNSTABLE
 #include <gnome-menus-3.0/gmenu-tree.h>
 
+#include "cmmcache.h"
 #include "cmmcircularmainmenu.h"
+#include "cmmgeometry.h"
+#include "cmmprofiler.h"
+#include "cmmscheduler.h"
+#include "cmmtiles.h"
+#include "cmmtrace.h"
+
+/* The outstanding dependencies of the root file-leaf. */
+typedef enum
+{
+    STARTUP_MENU_TREE       = 1 << 0,   /* Worker thread. */
+    STARTUP_WINDOW          = 1 << 1    /* Main thread. */
+} StartupDependency;
+
+typedef struct _CaStartup CaStartup;
+
+/* The state shared between the startup tasks. */
+struct _CaStartup
+{
+    guint pending;
+    CaCache* cache;                     /* Shared by every menu; holds the loaded menu tree. */
+    CaScheduler* scheduler;             /* Shared by every menu; runs the jobs away from the main thread. */
+    GMenuTree* tree;
+    GMenuTreeDirectory* root;           /* Owned by the cache. */
+    GtkWidget* window;
+    GtkWidget* circular_application_menu;
+    gint exit_status;
+    gchar* record_trace;
+    gchar* replay_trace;
+    gdouble frame_budget;
+};
+
+static CaStartup g_startup = { STARTUP_MENU_TREE|STARTUP_WINDOW, NULL, NULL, NULL, NULL, NULL, NULL, 0, NULL, NULL, 0.0 };
+
+/**
+ * _ca_circular_application_menu_on_profile_startup:
+ * @option_name: The name of the parsed option.
+ * @value: The optional JSON filename; otherwise NULL.
+ * @data: User data.
+ * @error: A return location for errors.
+ *
+ * Generated 'option' caused when the --profile-startup option is parsed.
+ *
+ * Returns: TRUE if the option was handled.
+ **/
+static gboolean
+_ca_circular_application_menu_on_profile_startup(const gchar* option_name, const gchar* value, gpointer data, GError** error)
+{
+    /* The report is written to the standard output when no file is specified. */
+    ca_profiler_enable(value);
+
+    return TRUE;
+}
+
+/**
+ * _ca_circular_application_menu_on_after_paint:
+ * @frame_clock: The frame clock of the window.
+ * @data: a GtkWidget pointer to the window.
+ *
+ * Generated 'after-paint' caused when the frame clock has completed a frame.  The first frame
+ * shows the root file-leaf without its icons; the report is written once a frame has been
+ * completed with every icon resolved.
+ **/
+static void
+_ca_circular_application_menu_on_after_paint(GdkFrameClock* frame_clock, gpointer data)
+{
+    if (!ca_profiler_has_mark("first_frame"))
+    {
+        ca_profiler_mark("frame_clock_frame_time", gdk_frame_clock_get_frame_time(frame_clock));
+        ca_profiler_mark("first_frame", 0);
+    }
+
+    if (!ca_profiler_has_mark("icons_resolved"))
+        return;
+
+    /* Only the first frames are of interest. */
+    g_signal_handlers_disconnect_by_func(frame_clock, _ca_circular_application_menu_on_after_paint, data);
 
-static CaFileLeaf* root_fileleaf = NULL;
+    ca_profiler_mark("first_complete_frame", 0);
+
+    /* Stops recording and writes the report. */
+    ca_profiler_write();
+}
 
 /**
  * _ca_circular_application_menu_enable_blur:
@@ -62,6 +143,279 @@ _ca_circular_application_menu_enable_blur(GtkWidget* window)
         2);
 }
 
+/**
+ * _ca_circular_application_menu_on_map:
+ * @widget: a GtkWidget pointer to the window.
+ * @event: The map event.
+ * @data: User data.
+ *
+ * Generated 'map_event' caused when a bounded window is shown.  The pointer and keyboard are
+ * grabbed, so a click outside of the window is delivered to the menu, which closes as nothing
+ * was hit.
+ *
+ * Returns: FALSE so the event propagates.
+ **/
+static gboolean
+_ca_circular_application_menu_on_map(GtkWidget* widget, GdkEvent* event, gpointer data)
+{
+    GdkGrabStatus status;
+
+    status = gdk_seat_grab(
+        gdk_display_get_default_seat(gtk_widget_get_display(widget)),
+        gtk_widget_get_window(widget),
+        GDK_SEAT_CAPABILITY_ALL,
+        FALSE,
+        NULL,
+        event,
+        NULL,
+        NULL);
+
+    if (status != GDK_GRAB_SUCCESS)
+    {
+        g_warning(_("The pointer and keyboard could not be grabbed; clicking outside of the menu will not close it.\n"));
+    }
+
+    return FALSE;
+}
+
+/**
+ * _ca_circular_application_menu_start_trace:
+ *
+ * Starts recording or replaying the events delivered to the widget, if requested.
+ **/
+static void
+_ca_circular_application_menu_start_trace(void)
+{
+    GError* error = NULL;
+    gboolean started;
+
+    if (g_startup.record_trace != NULL)
+    {
+        started = ca_trace_record(g_startup.circular_application_menu, g_startup.record_trace, &error);
+    }
+    else if (g_startup.replay_trace != NULL)
+    {
+        started = ca_trace_replay(g_startup.circular_application_menu, g_startup.replay_trace, g_startup.frame_budget, &error);
+    }
+    else
+    {
+        return;
+    }
+
+    if (FALSE == started)
+    {
+        g_warning (_("Tracing failed: %s\n"), error->message);
+        g_clear_error (&error); /* g_error_free */
+
+        g_startup.exit_status = -1;
+        gtk_main_quit();
+    }
+}
+
+/**
+ * _ca_circular_application_menu_startup_complete:
+ * @dependency: The StartupDependency which has completed.
+ *
+ * Marks a startup dependency as completed; the root file-leaf is shown as soon as the menu tree
+ * and the window are both available.  Its icons are resolved over the following frames.
+ **/
+static void
+_ca_circular_application_menu_startup_complete(StartupDependency dependency)
+{
+    g_assert((g_startup.pending & dependency) != 0);
+
+    g_startup.pending &= ~dependency;
+
+    if ((g_startup.pending != 0) ||
+        (g_startup.root == NULL))
+        return;
+
+    /* Record the first completed frame, which also ends the startup recording. */
+    if (TRUE == ca_profiler_is_enabled())
+    {
+        g_signal_connect (
+            gtk_widget_get_frame_clock(g_startup.window),
+            "after-paint",
+            G_CALLBACK (_ca_circular_application_menu_on_after_paint),
+            g_startup.window);
+    }
+
+    /* Shows the menu tree directory which becomes the root file leaf. */
+    ca_profiler_phase_begin("root_fileleaf");
+    ca_circular_application_menu(CA_CIRCULAR_APPLICATION_MENU(g_startup.circular_application_menu), g_startup.root);
+    ca_profiler_phase_end("root_fileleaf");
+
+    /* A trace starts from the root file-leaf. */
+    _ca_circular_application_menu_start_trace();
+
+    /* Invalidate the widget. */
+    gtk_widget_queue_draw(g_startup.window);
+}
+
+/**
+ * _ca_circular_application_menu_load_tree_thread:
+ * @task: The GTask loading the menu tree.
+ * @source_object: Unused.
+ * @task_data: The GMenuTree pointer to load.
+ * @cancellable: Unused.
+ *
+ * Loads the menu tree on a worker thread.
+ **/
+static void
+_ca_circular_application_menu_load_tree_thread(GTask* task, gpointer source_object, gpointer task_data, GCancellable* cancellable)
+{
+    GMenuTree* tree;
+    GError* error = NULL;
+
+    tree = (GMenuTree*)task_data;
+
+    ca_profiler_phase_begin("menu_tree_load");
+
+    if (!gmenu_tree_load_sync (tree, &error))
+    {
+        ca_profiler_phase_end("menu_tree_load");
+        g_task_return_error(task, error);
+
+        return;
+    }
+
+    ca_profiler_phase_end("menu_tree_load");
+    g_task_return_boolean(task, TRUE);
+}
+
+/**
+ * _ca_circular_application_menu_on_tree_loaded:
+ * @source_object: Unused.
+ * @result: The GTask which loaded the menu tree.
+ * @data: Unused.
+ *
+ * Generated 'ready' caused when the menu tree has been loaded.
+ **/
+static void
+_ca_circular_application_menu_on_tree_loaded(GObject* source_object, GAsyncResult* result, gpointer data)
+{
+    GError* error = NULL;
+
+    if (!g_task_propagate_boolean(G_TASK(result), &error))
+    {
+        g_warning (_("Loading the tree failed: %s\n"), error->message);
+        g_clear_error (&error); /* g_error_free */
+
+        g_startup.exit_status = -1;
+        gtk_main_quit();
+
+        return;
+    }
+
+    /* Every menu shows the same snapshot of the tree. */
+    ca_cache_set_menu_tree(g_startup.cache, g_startup.tree);
+    g_startup.root = ca_cache_get_menu_root(g_startup.cache);
+
+    if (NULL == g_startup.root)
+    {
+        g_warning (_("The menu tree is empty."));
+
+        g_startup.exit_status = -1;
+        gtk_main_quit();
+
+        return;
+    }
+
+    _ca_circular_application_menu_startup_complete(STARTUP_MENU_TREE);
+}
+
+/**
+ * _ca_circular_application_menu_warm_icon_theme_job:
+ * @data: A NULL terminated array of icon theme cache filenames.
+ * @cancellable: Unused.
+ *
+ * Reads the icon theme caches on a worker thread so the icon lookups made on the main thread
+ * when the root file-leaf is shown do not stall on a cold page cache.  The GtkIconTheme itself
+ * is not thread safe so only the files it will map are touched here.
+ *
+ * Returns: NULL.
+ **/
+static gpointer
+_ca_circular_application_menu_warm_icon_theme_job(gpointer data, GCancellable* cancellable)
+{
+    gchar** filenames;
+    gint i;
+
+    filenames = (gchar**)data;
+
+    ca_profiler_phase_begin("icon_theme_warm");
+
+    for (i = 0; filenames[i] != NULL; i++)
+    {
+        GMappedFile* mapped_file;
+        const gchar* contents;
+        gsize length;
+        gsize offset;
+        volatile gchar touched;
+
+        if ((mapped_file = g_mapped_file_new(filenames[i], FALSE, NULL)) == NULL)
+            continue;   /* Not every search path has a cache. */
+
+        contents = g_mapped_file_get_contents(mapped_file);
+        length = g_mapped_file_get_length(mapped_file);
+
+        /* Fault in every page. */
+        for (offset = 0; offset < length; offset += 4096)
+        {
+            touched = contents[offset];
+        }
+
+        (void)touched;
+
+        g_mapped_file_unref(mapped_file);
+    }
+
+    ca_profiler_phase_end("icon_theme_warm");
+
+    return NULL;
+}
+
+/**
+ * _ca_circular_application_menu_icon_theme_cache_filenames:
+ *
+ * Retrieves the icon theme cache filenames of the current and fallback icon themes.
+ *
+ * Returns: A newly allocated NULL terminated array of filenames.
+ **/
+static gchar**
+_ca_circular_application_menu_icon_theme_cache_filenames(void)
+{
+    GPtrArray* filenames;
+    gchar** search_path;
+    gint search_path_count;
+    gchar* theme_name;
+    gint i;
+
+    theme_name = NULL;
+    g_object_get(gtk_settings_get_default(), "gtk-icon-theme-name", &theme_name, NULL);
+
+    gtk_icon_theme_get_search_path(gtk_icon_theme_get_default(), &search_path, &search_path_count);
+
+    filenames = g_ptr_array_new();
+
+    for (i = 0; i < search_path_count; i++)
+    {
+        if (theme_name != NULL)
+        {
+            g_ptr_array_add(filenames, g_build_filename(search_path[i], theme_name, "icon-theme.cache", NULL));
+        }
+
+        g_ptr_array_add(filenames, g_build_filename(search_path[i], "hicolor", "icon-theme.cache", NULL));
+    }
+
+    g_ptr_array_add(filenames, NULL);
+
+    g_strfreev(search_path);
+    g_free((gpointer)theme_name);
+
+    return (gchar**)g_ptr_array_free(filenames, FALSE);
+}
+
 int
 main (int argc, char **argv)
 {
@@ -71,8 +425,7 @@ main (int argc, char **argv)
     GtkWidget* circular_application_menu;
     GOptionContext* optioncontext;
     GError* error = NULL;
-    GMenuTree* tree;
-    GMenuTreeDirectory* root;
+    GTask* task;
     /* Default values. */
     gboolean hide_preview = FALSE;
     gboolean warp_mouse = FALSE;
@@ -82,6 +435,15 @@ main (int argc, char **argv)
     gchar* emblem = "/usr/share/circular-application-menu/pixmaps/gnome-emblem-normal.png:/usr/share/circular-application-menu/pixmaps/gnome-emblem-prelight.png";
     gboolean render_reflection = FALSE;
     gboolean render_tabbed_only = FALSE;
+    gint page_size = MAX_FILEITEMS_PER_FILELEAF;
+    gint motion_threshold = MOTION_FAST_THRESHOLD;
+    gint settle_interval = MOTION_SETTLE_INTERVAL;
+    gdouble paint_budget = PAINT_BUDGET;
+    gboolean bounded_canvas = FALSE;
+    gboolean shape_window = FALSE;
+    gboolean opaque = FALSE;
+    gboolean remote = FALSE;
+    gint tile_threads = 0;
 
     GOptionEntry options[] =
     {
@@ -92,54 +454,132 @@ main (int argc, char **argv)
         { "emblem", 'e', 0, G_OPTION_ARG_STRING, &emblem, "Specifies the (colon separated) emblems to use for the root menu [E: ./pixmaps/emblem-normal.png:./pixmaps/emblem-prelight.png].", NULL },
         { "render-reflection", 'r', 0, G_OPTION_ARG_NONE, &render_reflection, "Stops the reflection from being rendered.", NULL },
         { "render-tabbed-only", 't', 0, G_OPTION_ARG_NONE, &render_tabbed_only, "Only renders the currently tabbed menu.", NULL },
+        { "page-size", 0, 0, G_OPTION_ARG_INT, &page_size, "The most items shown at once by a menu, further items are paged [N: 0=unpaged 15 (default)].", "N" },
+        { "motion-threshold", 0, 0, G_OPTION_ARG_INT, &motion_threshold, "The pointer speed above which frames are rendered fast [PX: pixels per second, 0=never 1500 (default)].", "PX" },
+        { "settle-interval", 0, 0, G_OPTION_ARG_INT, &settle_interval, "The time after a fast motion before a full quality frame [MS: 120 (default)].", "MS" },
+        { "paint-budget", 0, 0, G_OPTION_ARG_DOUBLE, &paint_budget, "The time a frame may paint for before the reflection, overlap translucency, other menus and preview are turned off in turn [MS: 0=never 16 (default)].", "MS" },
         { "z-order", 'z', 0, G_OPTION_ARG_NONE, &z_order, "Overrides the z-order of CAM.", NULL },
+        { "bounded-canvas", 0, 0, G_OPTION_ARG_NONE, &bounded_canvas, "Sizes the window to the open menus rather than the screen; clicking outside of them closes the menu.", NULL },
+        { "shape-window", 0, 0, G_OPTION_ARG_NONE, &shape_window, "Shapes the window to the open menus so it only takes input and is only composited there.", NULL },
+        { "opaque", 0, 0, G_OPTION_ARG_NONE, &opaque, "Draws an opaque window shaped to the open menus, as is done without a compositor.", NULL },
+        { "remote", 0, 0, G_OPTION_ARG_NONE, &remote, "Only draws what changes, without animations or the reflection, for a remote display such as ssh -X or xrdp.", NULL },
+        { "tile-threads", 0, 0, G_OPTION_ARG_INT, &tile_threads, "Renders each full quality frame in tiles on N threads [N: 0=untiled (default), at most 64].", "N" },
+        { "profile-startup", 'p', G_OPTION_FLAG_OPTIONAL_ARG, G_OPTION_ARG_CALLBACK, _ca_circular_application_menu_on_profile_startup, "Writes the startup timings as JSON to a file or the standard output.", "FILE" },
+        { "record-trace", 0, 0, G_OPTION_ARG_FILENAME, &g_startup.record_trace, "Records the pointer and key events delivered to the menu as a trace.", "FILE" },
+        { "replay-trace", 0, 0, G_OPTION_ARG_FILENAME, &g_startup.replay_trace, "Replays a recorded trace and writes the handler and frame times as JSON to the standard output.", "FILE" },
+        { "frame-budget", 0, 0, G_OPTION_ARG_DOUBLE, &g_startup.frame_budget, "Fails a replay when the p99 frame time exceeds the budget.", "MS" },
         { NULL }
     };
 
-    /* Initialise. */
-    gtk_init(&argc, &argv);
+    /* Start recording the startup timings. */
+    ca_profiler_init();
 
     /*
     https://developer.gnome.org/menu-spec/
+    The menu tree does not depend on GTK+ so start loading it before anything else.
     */
     const gchar* application_menu =  "applications.menu";
     g_info(_("Loading menu tree '%s'."), XDG_CONFIG_DIRS"/menus/"XDG_MENU_PREFIX"applications.menu");
 
-    tree = gmenu_tree_new (application_menu, GMENU_TREE_FLAGS_NONE);
-    g_assert (NULL != tree);
+    g_startup.cache = ca_cache_get_default();
+    g_startup.scheduler = ca_scheduler_get_default();
+    g_startup.tree = gmenu_tree_new (application_menu, GMENU_TREE_FLAGS_NONE);
+    g_assert (NULL != g_startup.tree);
 
-    if (!gmenu_tree_load_sync (tree, &error))
+    task = g_task_new(NULL, NULL, _ca_circular_application_menu_on_tree_loaded, NULL);
+    g_task_set_task_data(task, g_startup.tree, NULL);
+    g_task_run_in_thread(task, _ca_circular_application_menu_load_tree_thread);
+    g_object_unref(task);
+
+    /* Initialise. */
+    ca_profiler_phase_begin("gtk_init");
+    gtk_init(&argc, &argv);
+    ca_profiler_phase_end("gtk_init");
+
+    /* Warm the icon theme whilst the window is being created. */
+    ca_scheduler_submit(
+        g_startup.scheduler,
+        JOB_SPECULATIVE,
+        NULL,
+        _ca_circular_application_menu_warm_icon_theme_job,
+        NULL,
+        (gpointer)_ca_circular_application_menu_icon_theme_cache_filenames(),
+        (GDestroyNotify)g_strfreev);
+
+    /* Parse the arguments. */
+    ca_profiler_phase_begin("option_parse");
+    optioncontext = g_option_context_new("- circular-application-menu.");
+    g_option_context_add_main_entries(optioncontext, options, "circular_applications");
+
+    if (!g_option_context_parse (optioncontext, &argc, &argv, &error))
     {
-        g_warning (_("Loading the tree failed: %s\n"), error->message);
+        g_warning(_("Option parsing failed: %s\n"), error->message);
+
         return -1;
     }
-            
-    root = gmenu_tree_get_root_directory (tree);
 
-    if (NULL == root)
+    if ((glyph_size < 1) ||
+        (glyph_size > 3))
     {
-        g_warning (_("The menu tree is empty."));
+        g_warning(_("Option parsing failed: %s\n"), "the glyph size must be 1, 2 or 3");
+
+        return -1;
     }
 
-    /* Parse the arguments. */
-    optioncontext = g_option_context_new("- circular-application-menu.");
-    g_option_context_add_main_entries(optioncontext, options, "circular_applications");
-    g_option_context_parse(optioncontext, &argc, &argv, NULL);
+    if ((page_size < 0) ||
+        (page_size == 1))
+    {
+        g_warning(_("Option parsing failed: %s\n"), "the page size must be 0 or at least 2");
 
-    if (!g_option_context_parse (optioncontext, &argc, &argv, &error) ||
-        (glyph_size < 1) ||
-        (glyph_size > 3))
+        return -1;
+    }
+
+    if ((motion_threshold < 0) ||
+        (settle_interval < 1))
     {
-        g_warning(_("Option parsing failed: %s\n"), error->message);
+        g_warning(_("Option parsing failed: %s\n"), "the motion threshold must be at least 0 and the settle interval at least 1");
+
+        return -1;
+    }
+
+    if (paint_budget < 0.0)
+    {
+        g_warning(_("Option parsing failed: %s\n"), "the paint budget must be at least 0");
+
+        return -1;
+    }
+
+    if ((tile_threads < 0) ||
+        (tile_threads > TILE_MAX_THREADS))
+    {
+        g_warning(_("Option parsing failed: %s\n"), "the tile threads must be between 0 and 64");
+
+        return -1;
+    }
+
+    if ((g_startup.record_trace != NULL) &&
+        (g_startup.replay_trace != NULL))
+    {
+        g_warning(_("Option parsing failed: %s\n"), "a trace cannot be recorded and replayed at once");
 
         return -1;
     }
 
     g_option_context_free(optioncontext);
+    ca_profiler_phase_end("option_parse");
+
+    /* Nothing more is recorded unless the report will be written. */
+    if (FALSE == ca_profiler_is_enabled())
+    {
+        ca_profiler_stop();
+    }
 
     if (FALSE == gdk_screen_is_composited(gdk_display_get_default_screen(gdk_display_get_default())))
     {
-        g_message(_("The circular-main-menu only displays correctly with composited desktops."));
+        /* Without a compositor an alpha channel is not blended; draw an opaque window shaped to the menus instead. */
+        g_message(_("The desktop is not composited; the circular-main-menu is drawn opaque and shaped to the menus."));
+
+        opaque = TRUE;
     }
 
     screen = gdk_screen_get_default ();
@@ -150,20 +590,25 @@ main (int argc, char **argv)
     */
     GtkWindowType type = GTK_WINDOW_TOPLEVEL;   /* I like Debian and XFCE! */
 
-    if (TRUE == z_order)
+    if ((TRUE == z_order) ||
+        (TRUE == bounded_canvas))
     {
-        /* Use the compiz blur plugin to blur underneath the menus which makes the rendering clearer. */
+        /* A bounded window is moved and resized by the menu without the window manager. */
         type = GTK_WINDOW_POPUP;
     }
 
+    ca_profiler_phase_begin("window_new");
     window = gtk_window_new (type);
 
     /* Required for Ubuntu; not for Debian. */
     gtk_widget_set_app_paintable(window, TRUE);
     
+    ca_profiler_phase_end("window_new");
+
     /* Assign an alpha colormap to the window. */
+    ca_profiler_phase_begin("visual_selection");
     screen = gtk_widget_get_screen (GTK_WIDGET (window)); // screen = gdk_screen_get_default ();
-    visual = gdk_screen_get_rgba_visual (screen);
+    visual = (FALSE == opaque) ? gdk_screen_get_rgba_visual (screen) : NULL;
 
     if (NULL == visual)
     {
@@ -171,45 +616,78 @@ main (int argc, char **argv)
     }
 
     gtk_widget_set_visual (window, visual);
+    ca_profiler_phase_end("visual_selection");
     /*
     Does not seem to be required.
     gdk_window_set_decorations(window->window, 0);
     */
+    ca_profiler_phase_begin("window_realize");
     gtk_widget_realize (window);    /* This is required otherwise gdk_pixmap_new() will assert. */
+    ca_profiler_phase_end("window_realize");
 
-    /* Constructs a new dockband widget. */
+    /* Constructs a new dockband widget; this also loads the emblems and glyph resources. */
+    ca_profiler_phase_begin("widget_new");
     circular_application_menu = ca_circular_application_menu_new (
         hide_preview,
         warp_mouse,
         glyph_size,
         emblem,
         render_reflection,
-        render_tabbed_only);
+        render_tabbed_only,
+        page_size,
+        motion_threshold,
+        settle_interval,
+        paint_budget,
+        bounded_canvas,
+        shape_window,
+        opaque,
+        remote,
+        tile_threads);
+    ca_profiler_phase_end("widget_new");
     gtk_container_add (GTK_CONTAINER (window), circular_application_menu);
 
     g_signal_connect (window, "destroy", G_CALLBACK (gtk_main_quit), NULL);
 
-    /* Make the application full screen, without this it will be below any top edged panel. */
-    gtk_window_fullscreen(GTK_WINDOW(window));
+    if (TRUE == bounded_canvas)
+    {
+        /* The menu places the window over its open file-leaves; clicks outside of it close the menu. */
+        g_signal_connect (window, "map-event", G_CALLBACK (_ca_circular_application_menu_on_map), NULL);
+    }
+    else
+    {
+        /* Make the application full screen, without this it will be below any top edged panel. */
+        gtk_window_fullscreen(GTK_WINDOW(window));
+    }
 
-    /* Check whether blur is enabled. */
-    if (FALSE == blur_off)
+    /* Check whether blur is enabled; nothing is seen beneath an opaque window. */
+    if ((FALSE == blur_off) &&
+        (FALSE == opaque))
     {
         /* Use the compiz blur plugin to blur underneath the menus which makes the rendering clearer. */
         _ca_circular_application_menu_enable_blur(window);
     }
 
+    ca_profiler_phase_begin("window_show");
     gtk_widget_show_all (window);
+    ca_profiler_phase_end("window_show");
 
-    /* Shows the menu tree directory which becomes the root file leaf. */
-    root_fileleaf = ca_circular_application_menu(CA_CIRCULAR_APPLICATION_MENU(circular_application_menu), root);
+    g_startup.window = window;
+    g_startup.circular_application_menu = circular_application_menu;
 
-    /* Invalidate the widget. */
-    gtk_widget_queue_draw(window);
+    /* The root file-leaf is shown once the menu tree has also loaded; the window is ready. */
+    _ca_circular_application_menu_startup_complete(STARTUP_WINDOW);
 
     gtk_main ();
 
-    gmenu_tree_item_unref (root);
+    /* Writes the recorded trace or the replay report. */
+    if (ca_trace_finish() != 0)
+    {
+        g_startup.exit_status = -1;
+    }
+
+    g_object_unref (g_startup.tree);
+    ca_cache_unref (g_startup.cache);
+    ca_scheduler_unref (g_startup.scheduler);
 
-    return 0;
+    return g_startup.exit_status;
 }
@@ -0,0 +1,418 @@
+/* circular-main-menu
+ * Copyright (C) 2008 - Cole Anstey
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ * See http://code.google.com/p/circular-application-menu/
+ *     https://specifications.freedesktop.org/menu-spec/latest/
+ *
+ * Writes a self-contained XDG menu tree of a given shape so the menu and the benchmarks can be
+ * run against reproducible workloads.
+ */
+#include <glib.h>
+#include <glib/gstdio.h>
+#include <gdk-pixbuf/gdk-pixbuf.h>
+
+#include <stdio.h>
+#include <string.h>
+
+/* Constants. */
+#define GENERATOR_ICON_SIZE             48
+#define GENERATOR_CATEGORY_PREFIX       "X-CamSynthetic"
+#define GENERATOR_NAME_PREFIX           "cam-synthetic"
+
+typedef struct _CaMenuGenerator CaMenuGenerator;
+typedef struct _CaMenuWorkload CaMenuWorkload;
+
+/* The shape of the generated tree and where it is written. */
+struct _CaMenuGenerator
+{
+    gint fan_out;
+    gint depth;
+    gint items;
+    gint svg_percent;
+    gchar* applications_path;
+    gchar* directories_path;
+    gchar* png_icons_path;
+    gchar* svg_icons_path;
+    gint entry_count;
+    gint directory_count;
+    gint icon_count;
+};
+
+/* A named tree shape. */
+struct _CaMenuWorkload
+{
+    gint _entries;
+    gint fan_out;
+    gint depth;
+    gint items;
+};
+
+/* The menus multiplied by the applications in each give exactly the named number of entries. */
+static const CaMenuWorkload g_workloads[] =
+{
+    { 10,   1,  1,  5 },
+    { 100,  3,  1,  25 },
+    { 5000, 3,  3,  125 },
+};
+
+/**
+ * _ca_menu_generator_write_file:
+ * @path: The path of the file to write.
+ * @contents: The contents of the file.
+ *
+ * Writes a file, warning on failure.
+ *
+ * Returns: TRUE if the file was written; otherwise FALSE.
+ **/
+static gboolean
+_ca_menu_generator_write_file(const gchar* path, const gchar* contents)
+{
+    GError* error = NULL;
+
+    if (!g_file_set_contents(path, contents, -1, &error))
+    {
+        g_warning("Writing '%s' failed: %s\n", path, error->message);
+        g_clear_error (&error); /* g_error_free */
+
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+/**
+ * _ca_menu_generator_write_icon:
+ * @generator: The generator state.
+ * @name: The icon name.
+ *
+ * Writes an icon into the hicolor theme, alternating between SVG and PNG in the requested
+ * proportion.  The colour is derived from the name so the tree is reproducible.
+ **/
+static void
+_ca_menu_generator_write_icon(CaMenuGenerator* generator, const gchar* name)
+{
+    guint hash;
+    gchar* path;
+
+    hash = g_str_hash(name);
+
+    if ((generator->icon_count % 100) < generator->svg_percent)
+    {
+        gchar* contents;
+
+        path = g_strdup_printf("%s/%s.svg", generator->svg_icons_path, name);
+        contents = g_strdup_printf(
+            "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"%d\" height=\"%d\">\n"
+            "  <circle cx=\"%d\" cy=\"%d\" r=\"%d\" fill=\"#%06x\" stroke=\"#000000\" stroke-width=\"2\"/>\n"
+            "</svg>\n",
+            GENERATOR_ICON_SIZE,
+            GENERATOR_ICON_SIZE,
+            GENERATOR_ICON_SIZE / 2,
+            GENERATOR_ICON_SIZE / 2,
+            (GENERATOR_ICON_SIZE / 2) - 2,
+            hash & 0xffffff);
+
+        _ca_menu_generator_write_file(path, contents);
+
+        g_free((gpointer)contents);
+    }
+    else
+    {
+        GdkPixbuf* pixbuf;
+        GError* error = NULL;
+
+        path = g_strdup_printf("%s/%s.png", generator->png_icons_path, name);
+
+        pixbuf = gdk_pixbuf_new(GDK_COLORSPACE_RGB, TRUE, 8, GENERATOR_ICON_SIZE, GENERATOR_ICON_SIZE);
+        gdk_pixbuf_fill(pixbuf, (hash << 8) | 0xff);
+
+        if (!gdk_pixbuf_save(pixbuf, path, "png", &error, NULL))
+        {
+            g_warning("Writing '%s' failed: %s\n", path, error->message);
+            g_clear_error (&error); /* g_error_free */
+        }
+
+        g_object_unref(pixbuf);
+    }
+
+    generator->icon_count++;
+
+    g_free((gpointer)path);
+}
+
+/**
+ * _ca_menu_generator_write_directory:
+ * @generator: The generator state.
+ * @menu: The menu file being built.
+ * @id: The identifier of the directory, its path of indices.
+ * @level: The depth of the directory.
+ *
+ * Writes the .directory file, the entries and the sub directories of a menu and appends the
+ * menu to the menu file.
+ **/
+static void
+_ca_menu_generator_write_directory(CaMenuGenerator* generator, GString* menu, const gchar* id, gint level)
+{
+    gchar* indent;
+    gchar* name;
+    gchar* contents;
+    gchar* path;
+    gint i;
+
+    indent = g_strnfill((level + 1) * 2, ' ');
+
+    /* The directory. */
+    name = g_strdup_printf(GENERATOR_NAME_PREFIX"-menu-%s", id);
+
+    contents = g_strdup_printf(
+        "[Desktop Entry]\n"
+        "Type=Directory\n"
+        "Name=Menu %s\n"
+        "Comment=A synthetic menu at depth %d\n"
+        "Icon=%s\n",
+        id,
+        level,
+        name);
+    path = g_strdup_printf("%s/%s.directory", generator->directories_path, name);
+    _ca_menu_generator_write_file(path, contents);
+    _ca_menu_generator_write_icon(generator, name);
+    generator->directory_count++;
+
+    g_string_append_printf(menu, "%s<Name>%s</Name>\n", indent, (level == 0) ? "Applications" : name);
+    g_string_append_printf(menu, "%s<Directory>%s.directory</Directory>\n", indent, name);
+    g_string_append_printf(menu, "%s<Include><Category>"GENERATOR_CATEGORY_PREFIX"-%s</Category></Include>\n", indent, id);
+
+    g_free((gpointer)path);
+    g_free((gpointer)contents);
+    g_free((gpointer)name);
+
+    /* The entries. */
+    for (i = 0; i < generator->items; i++)
+    {
+        name = g_strdup_printf(GENERATOR_NAME_PREFIX"-%s-%d", id, i);
+
+        contents = g_strdup_printf(
+            "[Desktop Entry]\n"
+            "Type=Application\n"
+            "Name=Application %s-%d\n"
+            "Comment=A synthetic application in menu %s\n"
+            "Exec=true\n"
+            "Icon=%s\n"
+            "Categories="GENERATOR_CATEGORY_PREFIX"-%s;\n",
+            id,
+            i,
+            id,
+            name,
+            id);
+        path = g_strdup_printf("%s/%s.desktop", generator->applications_path, name);
+        _ca_menu_generator_write_file(path, contents);
+        _ca_menu_generator_write_icon(generator, name);
+        generator->entry_count++;
+
+        g_free((gpointer)path);
+        g_free((gpointer)contents);
+        g_free((gpointer)name);
+    }
+
+    /* The sub directories. */
+    if (level < generator->depth)
+    {
+        for (i = 0; i < generator->fan_out; i++)
+        {
+            gchar* sub_id;
+
+            sub_id = g_strdup_printf("%s-%d", id, i);
+
+            g_string_append_printf(menu, "%s<Menu>\n", indent);
+            _ca_menu_generator_write_directory(generator, menu, sub_id, level + 1);
+            g_string_append_printf(menu, "%s</Menu>\n", indent);
+
+            g_free((gpointer)sub_id);
+        }
+    }
+
+    g_free((gpointer)indent);
+}
+
+int
+main (int argc, char **argv)
+{
+    GOptionContext* optioncontext;
+    GError* error = NULL;
+    CaMenuGenerator generator;
+    GString* menu;
+    const gchar* menu_prefix;
+    gchar* menus_path;
+    gchar* path;
+    gint i;
+    /* Default values. */
+    gchar* output = NULL;
+    gint fan_out = 3;
+    gint depth = 2;
+    gint items = 8;
+    gint svg_percent = 50;
+    gint workload = 0;
+
+    GOptionEntry options[] =
+    {
+        { "output", 'o', 0, G_OPTION_ARG_FILENAME, &output, "The directory the tree is written to [default: a new temporary directory].", "DIR" },
+        { "fan-out", 'f', 0, G_OPTION_ARG_INT, &fan_out, "The number of sub menus in each menu [default: 3].", "N" },
+        { "depth", 'd', 0, G_OPTION_ARG_INT, &depth, "The number of menu levels beneath the root menu [default: 2].", "N" },
+        { "items", 'i', 0, G_OPTION_ARG_INT, &items, "The number of applications in each menu [default: 8].", "N" },
+        { "svg-percent", 's', 0, G_OPTION_ARG_INT, &svg_percent, "The percentage of icons written as SVG rather than PNG [default: 50].", "P" },
+        { "workload", 'w', 0, G_OPTION_ARG_INT, &workload, "Uses the shape of a standard workload of 10, 100 or 5000 applications, overriding the other shape options.", "N" },
+        { NULL }
+    };
+
+    /* Parse the arguments. */
+    optioncontext = g_option_context_new("- writes a synthetic XDG menu tree.");
+    g_option_context_add_main_entries(optioncontext, options, NULL);
+
+    if (!g_option_context_parse (optioncontext, &argc, &argv, &error))
+    {
+        g_warning("Option parsing failed: %s\n", error->message);
+
+        return -1;
+    }
+
+    g_option_context_free(optioncontext);
+
+    if (workload != 0)
+    {
+        for (i = 0; i < G_N_ELEMENTS(g_workloads); i++)
+        {
+            if (g_workloads[i]._entries == workload)
+            {
+                fan_out = g_workloads[i].fan_out;
+                depth = g_workloads[i].depth;
+                items = g_workloads[i].items;
+
+                break;
+            }
+        }
+
+        if (i == G_N_ELEMENTS(g_workloads))
+        {
+            g_warning("Option parsing failed: %s\n", "the workload must be 10, 100 or 5000");
+
+            return -1;
+        }
+    }
+
+    if ((fan_out < 0) ||
+        (depth < 0) ||
+        (items < 0) ||
+        (svg_percent < 0) ||
+        (svg_percent > 100))
+    {
+        g_warning("Option parsing failed: %s\n", "the shape must not be negative and the SVG percentage must be 0 to 100");
+
+        return -1;
+    }
+
+    if (output == NULL)
+    {
+        output = g_dir_make_tmp("cam-menu-XXXXXX", &error);
+
+        if (output == NULL)
+        {
+            g_warning("Creating the output directory failed: %s\n", error->message);
+            g_clear_error (&error); /* g_error_free */
+
+            return -1;
+        }
+    }
+
+    memset(&generator, 0, sizeof(CaMenuGenerator));
+    generator.fan_out = fan_out;
+    generator.depth = depth;
+    generator.items = items;
+    generator.svg_percent = svg_percent;
+    generator.applications_path = g_build_filename(output, "share", "applications", NULL);
+    generator.directories_path = g_build_filename(output, "share", "desktop-directories", NULL);
+    generator.png_icons_path = g_build_filename(output, "share", "icons", "hicolor", "48x48", "apps", NULL);
+    generator.svg_icons_path = g_build_filename(output, "share", "icons", "hicolor", "scalable", "apps", NULL);
+    menus_path = g_build_filename(output, "xdg", "menus", NULL);
+
+    g_mkdir_with_parents(generator.applications_path, 0755);
+    g_mkdir_with_parents(generator.directories_path, 0755);
+    g_mkdir_with_parents(generator.png_icons_path, 0755);
+    g_mkdir_with_parents(generator.svg_icons_path, 0755);
+    g_mkdir_with_parents(menus_path, 0755);
+
+    /* A theme index so the icons are found through XDG_DATA_DIRS alone. */
+    path = g_build_filename(output, "share", "icons", "hicolor", "index.theme", NULL);
+    _ca_menu_generator_write_file(
+        path,
+        "[Icon Theme]\n"
+        "Name=Hicolor\n"
+        "Comment=Fallback icon theme\n"
+        "Directories=48x48/apps,scalable/apps\n"
+        "\n"
+        "[48x48/apps]\n"
+        "Size=48\n"
+        "Context=Applications\n"
+        "Type=Threshold\n"
+        "\n"
+        "[scalable/apps]\n"
+        "MinSize=1\n"
+        "Size=128\n"
+        "MaxSize=256\n"
+        "Context=Applications\n"
+        "Type=Scalable\n");
+    g_free((gpointer)path);
+
+    /* The menu file; the application and directory paths are absolute so the tree is self-contained. */
+    menu = g_string_new(
+        "<!DOCTYPE Menu PUBLIC \"-//freedesktop//DTD Menu 1.0//EN\"\n"
+        " \"http://www.freedesktop.org/standards/menu-spec/1.0/menu.dtd\">\n"
+        "<Menu>\n");
+    g_string_append_printf(menu, "  <AppDir>%s</AppDir>\n", generator.applications_path);
+    g_string_append_printf(menu, "  <DirectoryDir>%s</DirectoryDir>\n", generator.directories_path);
+
+    _ca_menu_generator_write_directory(&generator, menu, "0", 0);
+
+    g_string_append(menu, "</Menu>\n");
+
+    /* Named as the menu tree will look for it. */
+    menu_prefix = g_getenv("XDG_MENU_PREFIX");
+    path = g_strdup_printf("%s/%sapplications.menu", menus_path, (menu_prefix != NULL) ? menu_prefix : "");
+    _ca_menu_generator_write_file(path, menu->str);
+    g_free((gpointer)path);
+
+    g_string_free(menu, TRUE);
+
+    g_printerr("%d applications in %d menus with %d icons written to %s\n",
+        generator.entry_count,
+        generator.directory_count,
+        generator.icon_count,
+        output);
+
+    /* The environment, so the output can be evaluated by a shell; the system directories are kept for the fallback icons. */
+    g_print("export XDG_CONFIG_DIRS='%s/xdg':\"${XDG_CONFIG_DIRS:-/etc/xdg}\"\n", output);
+    g_print("export XDG_DATA_DIRS='%s/share':\"${XDG_DATA_DIRS:-/usr/local/share:/usr/share}\"\n", output);
+
+    g_free((gpointer)menus_path);
+    g_free((gpointer)generator.applications_path);
+    g_free((gpointer)generator.directories_path);
+    g_free((gpointer)generator.png_icons_path);
+    g_free((gpointer)generator.svg_icons_path);
+    g_free((gpointer)output);
+
+    return 0;
+}
@@ -0,0 +1,1171 @@
+/* circular-main-menu
+ * Copyright (C) 2008 - Cole Anstey
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ * See http://code.google.com/p/circular-application-menu/
+ *
+ * Renders a scripted menu state into an image surface without a display and reports the time
+ * taken per frame, so rendering changes can be measured on any machine.
+ */
+#include <glib.h>
+#include <glib/gstdio.h>
+#include <cairo.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cmmcore.h"
+#include "cmmfileleaf.h"
+#include "cmmgeometry.h"
+#include "cmmmenuleaf.h"
+#include "cmmraster.h"
+#include "cmmrender.h"
+#include "cmmscheduler.h"
+#include "cmmtiles.h"
+
+#include "../src/cmmstockpixbufs.c"
+
+#define RESOURCE_PATH   "/com/circular-application-menu/pixmaps/"
+
+/* Constants. */
+#define BENCH_DEFAULT_WIDTH             1920
+#define BENCH_DEFAULT_HEIGHT            1080
+#define BENCH_DEFAULT_DEPTH             2
+#define BENCH_DEFAULT_FRAMES            200
+#define BENCH_WARMUP_FRAMES             5
+#define BENCH_PLACEHOLDER_RGBA          0x7f9fbfff
+#define BENCH_HITTEST_STEP              8       /* The pixels between the hit tested points. */
+#define BENCH_RASTER_POLL               100     /* The microseconds between checks for rasterized surfaces. */
+#define BENCH_FIRST_FRAME_BUDGET        50.0    /* The milliseconds the root file-leaf may take to be built and first painted. */
+
+typedef struct _CaBenchConfiguration CaBenchConfiguration;
+typedef struct _CaBenchScene CaBenchScene;
+
+/* A combination of the render options being measured. */
+struct _CaBenchConfiguration
+{
+    const gchar* _name;
+    gboolean render_reflection_off;
+    gboolean render_tabbed_only;
+    gboolean render_fast;
+    gboolean render_opaque;         /* Also without the overlap translucency, as for a screen without a compositor. */
+};
+
+/* The file-leaves of the scripted menu state. */
+struct _CaBenchScene
+{
+    CaCore core;
+    gint page_size;
+    gint depth;
+    gint fileitem_count;
+};
+
+static const CaBenchConfiguration g_configurations[] =
+{
+    { "reflection-on-all",      FALSE,  FALSE,  FALSE,  FALSE },
+    { "reflection-on-tabbed",   FALSE,  TRUE,   FALSE,  FALSE },
+    { "reflection-off-all",     TRUE,   FALSE,  FALSE,  FALSE },
+    { "reflection-off-tabbed",  TRUE,   TRUE,   FALSE,  FALSE },
+    { "fast-all",               FALSE,  FALSE,  TRUE,   FALSE },
+    { "fast-tabbed",            FALSE,  TRUE,   TRUE,   FALSE },
+    { "opaque-all",             FALSE,  FALSE,  FALSE,  TRUE },
+};
+
+/**
+ * _ca_render_bench_load_resource:
+ * @resource: The path of the resource to load.
+ *
+ * Loads a pixbuf from the compiled-in resources.
+ *
+ * Returns: The newly created pixbuf; otherwise NULL.
+ **/
+static GdkPixbuf*
+_ca_render_bench_load_resource(const gchar* resource)
+{
+    GdkPixbuf* pixbuf;
+    GError* error = NULL;
+
+    if ((pixbuf = gdk_pixbuf_new_from_resource(resource, &error)) == NULL)
+    {
+        g_warning ("Resource not found: %s\n", error->message);
+        g_clear_error (&error); /* g_error_free */
+    }
+
+    return pixbuf;
+}
+
+/**
+ * _ca_render_bench_find_fileitem:
+ * @fileleaf: The file-leaf to search.
+ * @type: The glyph-type of the file-item to find.
+ *
+ * Retrieves the first file-item of a given glyph-type.
+ *
+ * Returns: The found file-item; otherwise NULL.
+ **/
+static CaFileItem*
+_ca_render_bench_find_fileitem(CaFileLeaf* fileleaf, GlyphType type)
+{
+    GList* list;
+
+    list = g_list_first(fileleaf->_fileitem_list);
+
+    while (list)
+    {
+        CaFileItem* fileitem;
+
+        fileitem = (CaFileItem*)list->data;
+
+        if (fileitem->_type == type)
+        {
+            return fileitem;
+        }
+
+        list = g_list_next(list);
+    }
+
+    return NULL;
+}
+
+/**
+ * _ca_render_bench_add_fileleaf:
+ * @scene: The scene the file-leaf is added to.
+ * @menutreedirectory: The menu tree directory of the file-leaf.
+ * @leaftype: The leaf-type of the file-leaf.
+ * @fileitem: The file-item the file-leaf is shown from; otherwise NULL for the root.
+ * @disassociated: Specifies whether the file-leaf is a preview.
+ * @placeholder_pixbuf: The pixbuf used in place of every icon.
+ *
+ * Creates and positions a file-leaf.  Icon themes need a display so every file-item is given the
+ * placeholder pixbuf, which costs the same to paint as a resolved icon of the same size.
+ *
+ * Returns: The newly created file-leaf.
+ **/
+static CaFileLeaf*
+_ca_render_bench_add_fileleaf(
+    CaBenchScene* scene,
+    GMenuTreeDirectory* menutreedirectory,
+    LeafType leaftype,
+    CaFileItem* fileitem,
+    gboolean disassociated,
+    GdkPixbuf* placeholder_pixbuf)
+{
+    CaFileLeaf* fileleaf;
+    GList* list;
+
+    fileleaf = ca_menu_fileleaf_new(menutreedirectory, leaftype, scene->page_size, NULL);
+    ca_core_attach_fileleaf(&scene->core, fileleaf, fileitem, disassociated);
+
+    list = g_list_first(fileleaf->_fileitem_list);
+
+    while (list)
+    {
+        CA_MENU_FILEITEM((CaFileItem*)list->data)->pixbuf = g_object_ref(placeholder_pixbuf);
+
+        list = g_list_next(list);
+    }
+
+    scene->fileitem_count += fileleaf->_fileitem_list_count;
+
+    return fileleaf;
+}
+
+/**
+ * _ca_render_bench_build_scene:
+ * @scene: The scene to build.
+ * @iconsize: The pixel size of the icons.
+ * @width: The width of the view.
+ * @height: The height of the view.
+ * @root: The root menu tree directory.
+ * @depth: The number of sub menus to open.
+ * @page_size: The most file-items shown at once; otherwise 0 if unpaged.
+ * @placeholder_pixbuf: The pixbuf used in place of every icon.
+ *
+ * Builds the scripted menu state; the root file-leaf, @depth sub menus opened from the first
+ * sub menu of each file-leaf, a preview of another sub menu and a prelit file-item.
+ **/
+static void
+_ca_render_bench_build_scene(
+    CaBenchScene* scene,
+    gint iconsize,
+    gint width,
+    gint height,
+    GMenuTreeDirectory* root,
+    gint depth,
+    gint page_size,
+    GdkPixbuf* placeholder_pixbuf)
+{
+    CaFileLeaf* fileleaf;
+    CaFileItem* fileitem;
+
+    memset(scene, 0, sizeof(CaBenchScene));
+    scene->page_size = page_size;
+
+    ca_core_init(&scene->core);
+    ca_geometry_init(&scene->core.geometry, iconsize, iconsize, CENTRE_ICONSIZE);
+    scene->core.view_width = width;
+    scene->core.view_height = height;
+
+    fileleaf = _ca_render_bench_add_fileleaf(scene, root, ROOT_LEAF, NULL, FALSE, placeholder_pixbuf);
+    ca_core_centre_view(&scene->core, fileleaf, -1, -1);
+
+    /* Open the sub menus. */
+    while (scene->depth < depth)
+    {
+        fileitem = _ca_render_bench_find_fileitem(scene->core.tabbed_fileleaf, GLYPH_FILE_MENU);
+
+        if (fileitem == NULL)
+        {
+            g_message("The menu is only %d sub menus deep.", scene->depth);
+
+            break;
+        }
+
+        fileleaf = _ca_render_bench_add_fileleaf(
+            scene,
+            CA_MENU_FILEITEM(fileitem)->menutreeitem,
+            FILE_LEAF,
+            fileitem,
+            FALSE,
+            placeholder_pixbuf);
+        ca_core_open_fileleaf(&scene->core, fileleaf);
+        scene->depth++;
+    }
+
+    /* Preview a sub menu of the tabbed file-leaf. */
+    fileitem = _ca_render_bench_find_fileitem(scene->core.tabbed_fileleaf, GLYPH_FILE_MENU);
+
+    if (fileitem != NULL)
+    {
+        _ca_render_bench_add_fileleaf(
+            scene,
+            CA_MENU_FILEITEM(fileitem)->menutreeitem,
+            FILE_LEAF,
+            fileitem,
+            TRUE,
+            placeholder_pixbuf);
+    }
+    else
+    {
+        /* Prelight an application instead. */
+        fileitem = _ca_render_bench_find_fileitem(scene->core.tabbed_fileleaf, GLYPH_FILE);
+    }
+
+    scene->core.current_fileleaf = scene->core.tabbed_fileleaf;
+    scene->core.current_fileitem = fileitem;
+    scene->core.current_type = (fileitem != NULL) ? fileitem->_type : GLYPH_UNKNOWN;
+}
+
+/**
+ * _ca_render_bench_free_scene:
+ * @scene: The scene to free.
+ *
+ * Frees the file-leaves of the scripted menu state.
+ **/
+static void
+_ca_render_bench_free_scene(CaBenchScene* scene)
+{
+    ca_core_clear(&scene->core);
+}
+
+/**
+ * _ca_render_bench_compare:
+ * @a: A pointer to the first frame time.
+ * @b: A pointer to the second frame time.
+ *
+ * Orders the frame times for the percentiles.
+ *
+ * Returns: A negative, zero or positive value as for qsort().
+ **/
+static int
+_ca_render_bench_compare(const void* a, const void* b)
+{
+    gdouble first;
+    gdouble second;
+
+    first = *(const gdouble*)a;
+    second = *(const gdouble*)b;
+
+    return (first > second) - (first < second);
+}
+
+/**
+ * _ca_render_bench_percentile:
+ * @samples: The sorted frame times.
+ * @count: The number of frame times.
+ * @percentile: The percentile to retrieve.
+ *
+ * Retrieves a percentile using the nearest rank.
+ *
+ * Returns: The frame time at the percentile.
+ **/
+static gdouble
+_ca_render_bench_percentile(const gdouble* samples, gint count, gdouble percentile)
+{
+    gint rank;
+
+    rank = (gint)((percentile / 100.0) * count + 0.5);
+    rank = CLAMP(rank, 1, count);
+
+    return samples[rank - 1];
+}
+
+/**
+ * _ca_render_bench_frame:
+ * @context: The state to render.
+ * @tiles: The tile renderer to render with; otherwise NULL to render directly.
+ * @cr: A cairo-context to render to.
+ *
+ * Renders a frame directly or in tiles.
+ **/
+static void
+_ca_render_bench_frame(const CaRenderContext* context, CaTiles* tiles, cairo_t* cr)
+{
+    if (tiles != NULL)
+    {
+        ca_tiles_render_frame(tiles, context, cr);
+    }
+    else
+    {
+        ca_render_frame(context, cr);
+    }
+}
+
+/**
+ * _ca_render_bench_run:
+ * @context: The state to render.
+ * @tiles: The tile renderer to render with; otherwise NULL to render directly.
+ * @surface: The image surface to render to.
+ * @frames: The number of frames to time.
+ * @samples: A return location for the @frames frame times in milliseconds.
+ *
+ * Renders the frames, timing each one until the surface has been flushed.
+ **/
+static void
+_ca_render_bench_run(const CaRenderContext* context, CaTiles* tiles, cairo_surface_t* surface, gint frames, gdouble* samples)
+{
+    cairo_t* cr;
+    gint frame;
+
+    cr = cairo_create(surface);
+
+    /* The first frames build the cached segment geometry. */
+    for (frame = 0; frame < BENCH_WARMUP_FRAMES; frame++)
+    {
+        cairo_save(cr);
+        _ca_render_bench_frame(context, tiles, cr);
+        cairo_restore(cr);
+    }
+
+    for (frame = 0; frame < frames; frame++)
+    {
+        gint64 start;
+
+        start = g_get_monotonic_time();
+
+        cairo_save(cr);
+        _ca_render_bench_frame(context, tiles, cr);
+        cairo_restore(cr);
+        cairo_surface_flush(surface);
+
+        samples[frame] = (g_get_monotonic_time() - start) / 1000.0;
+    }
+
+    cairo_destroy(cr);
+}
+
+/**
+ * _ca_render_bench_hittest:
+ * @core: The state to hit test.
+ * @sweeps: The number of sweeps to time.
+ * @samples: A return location for the @sweeps times in microseconds per hit test.
+ *
+ * Hit tests a grid of points covering the view, timing each sweep of the grid.
+ *
+ * Returns: The number of points in a sweep.
+ **/
+static gint
+_ca_render_bench_hittest(const CaCore* core, gint sweeps, gdouble* samples)
+{
+    CaFileLeaf* fileleaf;
+    CaFileItem* fileitem;
+    gint points;
+    gint sweep;
+    gint x;
+    gint y;
+
+    points = ((core->view_width + BENCH_HITTEST_STEP - 1) / BENCH_HITTEST_STEP) * ((core->view_height + BENCH_HITTEST_STEP - 1) / BENCH_HITTEST_STEP);
+
+    for (sweep = 0; sweep < sweeps; sweep++)
+    {
+        gint64 start;
+
+        start = g_get_monotonic_time();
+
+        for (y = 0; y < core->view_height; y += BENCH_HITTEST_STEP)
+        {
+            for (x = 0; x < core->view_width; x += BENCH_HITTEST_STEP)
+            {
+                ca_core_hittest(
+                    core,
+                    SCREEN_2_OFFSET(x, core->view_x_offset),
+                    SCREEN_2_OFFSET(y, core->view_y_offset),
+                    &fileleaf,
+                    &fileitem);
+            }
+        }
+
+        samples[sweep] = (gdouble)(g_get_monotonic_time() - start) / points;
+    }
+
+    return points;
+}
+
+/**
+ * _ca_render_bench_discard:
+ * @core: The scene whose file-leaves are discarded.
+ *
+ * Discards the render values of every file-leaf, so each is rendered as if it had just opened.
+ **/
+static void
+_ca_render_bench_discard(const CaCore* core)
+{
+    CaFileLeaf* fileleaf;
+
+    for (fileleaf = core->root_fileleaf; fileleaf != NULL; fileleaf = fileleaf->_child_fileleaf)
+    {
+        GList* sub_list;
+
+        ca_render_discard(fileleaf);
+
+        for (sub_list = fileleaf->_sub_fileleaves_list; sub_list != NULL; sub_list = g_list_next(sub_list))
+        {
+            ca_render_discard((CaFileLeaf*)sub_list->data);
+        }
+    }
+
+    if (core->disassociated_fileleaf != NULL)
+    {
+        ca_render_discard(core->disassociated_fileleaf);
+    }
+}
+
+/**
+ * _ca_render_bench_new_leaves:
+ * @context: The state to render.
+ * @core: The scene being rendered.
+ * @tiles: The tile renderer to render with; otherwise NULL to render directly.
+ * @surface: The image surface to render to.
+ * @frames: The number of frames to time.
+ * @samples: A return location for the @frames main thread frame times in milliseconds.
+ * @ready_samples: A return location for the @frames times in milliseconds until the workers have
+ * rasterized every file-leaf; only used with a raster.
+ *
+ * Renders frames in which every file-leaf is new, timing the main thread.  With a raster the
+ * segments are only submitted to the workers, which are then waited for.
+ **/
+static void
+_ca_render_bench_new_leaves(
+	const CaRenderContext* context,
+	const CaCore* core,
+	CaTiles* tiles,
+	cairo_surface_t* surface,
+	gint frames,
+	gdouble* samples,
+	gdouble* ready_samples)
+{
+    cairo_t* cr;
+    gint frame;
+
+    cr = cairo_create(surface);
+
+    for (frame = 0; frame < frames; frame++)
+    {
+        gint64 start;
+
+        _ca_render_bench_discard(core);
+
+        start = g_get_monotonic_time();
+
+        cairo_save(cr);
+        _ca_render_bench_frame(context, tiles, cr);
+        cairo_restore(cr);
+        cairo_surface_flush(surface);
+
+        samples[frame] = (g_get_monotonic_time() - start) / 1000.0;
+
+        if (context->raster != NULL)
+        {
+            for (;;)
+            {
+                ca_raster_collect(context->raster);
+
+                if (ca_raster_get_pending(context->raster) == 0)
+                    break;
+
+                g_usleep(BENCH_RASTER_POLL);
+            }
+
+            ready_samples[frame] = (g_get_monotonic_time() - start) / 1000.0;
+        }
+    }
+
+    cairo_destroy(cr);
+}
+
+/**
+ * _ca_render_bench_print:
+ * @name: The name of the row.
+ * @samples: The times; these are sorted.
+ * @count: The number of times.
+ *
+ * Prints the p50, p90, p99, maximum and mean of the times as a row.
+ **/
+static void
+_ca_render_bench_print(const gchar* name, gdouble* samples, gint count)
+{
+    gdouble total;
+    gint i;
+
+    total = 0.0;
+
+    for (i = 0; i < count; i++)
+    {
+        total += samples[i];
+    }
+
+    qsort(samples, count, sizeof(gdouble), _ca_render_bench_compare);
+
+    g_print("%-24s %9.3f %9.3f %9.3f %9.3f %9.3f\n",
+        name,
+        _ca_render_bench_percentile(samples, count, 50.0),
+        _ca_render_bench_percentile(samples, count, 90.0),
+        _ca_render_bench_percentile(samples, count, 99.0),
+        samples[count - 1],
+        total / count);
+}
+
+/**
+ * _ca_render_bench_open:
+ * @geometry: The glyph sizes to lay out with.
+ * @root: The root menu tree directory.
+ * @page_size: The most file-items shown at once; otherwise 0 if unpaged.
+ * @opens: The number of opens to time.
+ * @samples: A return location for the @opens times in milliseconds.
+ *
+ * Creates and positions the root file-leaf, timing each one; a paged file-leaf only creates the
+ * file-items of its first page.
+ **/
+static void
+_ca_render_bench_open(const CaGeometry* geometry, GMenuTreeDirectory* root, gint page_size, gint opens, gdouble* samples)
+{
+    CaFileLeaf* fileleaf;
+    gint open;
+
+    for (open = 0; open < opens; open++)
+    {
+        gint64 start;
+
+        start = g_get_monotonic_time();
+
+        fileleaf = ca_menu_fileleaf_new(root, ROOT_LEAF, page_size, NULL);
+        ca_fileleaf_attach(geometry, fileleaf, NULL, FALSE);
+
+        samples[open] = (g_get_monotonic_time() - start) / 1000.0;
+
+        ca_fileleaf_free(fileleaf);
+    }
+}
+
+/**
+ * _ca_render_bench_first_frame:
+ * @template: The render options to paint with.
+ * @root: The root menu tree directory.
+ * @page_size: The most file-items shown at once; otherwise 0 if unpaged.
+ * @surface: The image surface to render to.
+ * @frames: The number of first frames to time.
+ * @samples: A return location for the @frames times in milliseconds.
+ *
+ * Creates, positions and paints the root file-leaf as the menu does at startup, timing each one
+ * until the surface has been flushed.  The file-items are laid out from the menu entries alone
+ * and painted without their icons, which are resolved after the first frame.
+ **/
+static void
+_ca_render_bench_first_frame(
+	const CaRenderContext* template,
+	GMenuTreeDirectory* root,
+	gint page_size,
+	cairo_surface_t* surface,
+	gint frames,
+	gdouble* samples)
+{
+    CaRenderContext context;
+    CaFileLeaf* fileleaf;
+    CaCore core;
+    cairo_t* cr;
+    gint frame;
+
+    for (frame = 0; frame < frames; frame++)
+    {
+        gint64 start;
+
+        start = g_get_monotonic_time();
+
+        ca_core_init(&core);
+        core.geometry = *template->geometry;
+        core.view_width = template->view_width;
+        core.view_height = template->view_height;
+
+        fileleaf = ca_menu_fileleaf_new(root, ROOT_LEAF, page_size, NULL);
+        ca_core_attach_fileleaf(&core, fileleaf, NULL, FALSE);
+        ca_core_centre_view(&core, fileleaf, -1, -1);
+
+        context = *template;
+        context.geometry = &core.geometry;
+        context.view_x_offset = core.view_x_offset;
+        context.view_y_offset = core.view_y_offset;
+        context.root_fileleaf = core.root_fileleaf;
+        context.tabbed_fileleaf = core.tabbed_fileleaf;
+        context.disassociated_fileleaf = NULL;
+        context.current_fileleaf = NULL;
+        context.current_fileitem = NULL;
+        context.current_type = GLYPH_UNKNOWN;
+
+        cr = cairo_create(surface);
+        ca_render_frame(&context, cr);
+        cairo_destroy(cr);
+        cairo_surface_flush(surface);
+
+        samples[frame] = (g_get_monotonic_time() - start) / 1000.0;
+
+        ca_core_close_fileleaf(&core, core.root_fileleaf);
+    }
+}
+
+int
+main (int argc, char **argv)
+{
+    GOptionContext* optioncontext;
+    GError* error = NULL;
+    GMenuTree* tree;
+    GMenuTreeDirectory* root;
+    CaBenchScene scene;
+    CaRenderContext context;
+    cairo_surface_t* surface;
+    GdkPixbuf* placeholder_pixbuf;
+    gdouble* samples;
+    gint iconsize;
+    gint exit_status;
+    gint i;
+    /* Default values. */
+    gchar* menu = "applications.menu";
+    gint width = BENCH_DEFAULT_WIDTH;
+    gint height = BENCH_DEFAULT_HEIGHT;
+    gint depth = BENCH_DEFAULT_DEPTH;
+    gint frames = BENCH_DEFAULT_FRAMES;
+    gint glyph_size = 3;
+    gint page_size = MAX_FILEITEMS_PER_FILELEAF;
+    gchar* snapshot = NULL;
+    gint tile_threads = g_get_num_processors();
+    gint tile_size = TILE_DEFAULT_SIZE;
+    gdouble first_frame_budget = BENCH_FIRST_FRAME_BUDGET;
+
+    GOptionEntry options[] =
+    {
+        { "menu", 'm', 0, G_OPTION_ARG_FILENAME, &menu, "The menu file to render, either a basename found through XDG_CONFIG_DIRS or a path [default: applications.menu].", "FILE" },
+        { "width", 'x', 0, G_OPTION_ARG_INT, &width, "The width of the rendered frames [default: 1920].", "W" },
+        { "height", 'y', 0, G_OPTION_ARG_INT, &height, "The height of the rendered frames [default: 1080].", "H" },
+        { "depth", 'd', 0, G_OPTION_ARG_INT, &depth, "The number of sub menus opened beneath the root menu [default: 2].", "N" },
+        { "frames", 'f', 0, G_OPTION_ARG_INT, &frames, "The number of frames timed per configuration [default: 200].", "N" },
+        { "glyph-size", 'g', 0, G_OPTION_ARG_INT, &glyph_size, "The size of the glyphs [S: 1=small 2=medium 3=large (default)].", "S" },
+        { "page-size", 'p', 0, G_OPTION_ARG_INT, &page_size, "The most menu items shown at once, further items are paged [N: 0=unpaged 15 (default)].", "N" },
+        { "snapshot", 's', 0, G_OPTION_ARG_FILENAME, &snapshot, "Writes the last frame of each configuration as a PNG to a directory.", "DIR" },
+        { "tile-threads", 't', 0, G_OPTION_ARG_INT, &tile_threads, "The most threads the tiled rows render with [N: 0=no tiled rows, the number of processors (default)].", "N" },
+        { "tile-size", 0, 0, G_OPTION_ARG_INT, &tile_size, "The width and height of each tile [PX: 256 (default)].", "PX" },
+        { "first-frame-budget", 0, 0, G_OPTION_ARG_DOUBLE, &first_frame_budget, "Fails if the p99 time to build and first paint the root menu exceeds the milliseconds [MS: 0=unchecked 50 (default)].", "MS" },
+        { NULL }
+    };
+
+    /* Parse the arguments. */
+    optioncontext = g_option_context_new("- renders the circular-application-menu without a display.");
+    g_option_context_add_main_entries(optioncontext, options, NULL);
+
+    if (!g_option_context_parse (optioncontext, &argc, &argv, &error))
+    {
+        g_warning("Option parsing failed: %s\n", error->message);
+
+        return -1;
+    }
+
+    g_option_context_free(optioncontext);
+
+    if ((glyph_size < 1) ||
+        (glyph_size > 3) ||
+        (width <= 0) ||
+        (height <= 0) ||
+        (depth < 0) ||
+        (frames <= 0) ||
+        (page_size == 1) ||
+        (page_size < 0) ||
+        (tile_threads < 0) ||
+        (tile_threads > TILE_MAX_THREADS) ||
+        (tile_size <= 0) ||
+        (first_frame_budget < 0.0))
+    {
+        g_warning("Option parsing failed: %s\n", "the glyph size must be 1, 2 or 3, the page size 0 or at least 2, the tile threads at most 64, the first frame budget not negative and the other values positive");
+
+        return -1;
+    }
+
+    /* Load the menu tree. */
+    if (strchr(menu, G_DIR_SEPARATOR) != NULL)
+    {
+        tree = gmenu_tree_new_for_path(menu, GMENU_TREE_FLAGS_NONE);
+    }
+    else
+    {
+        tree = gmenu_tree_new(menu, GMENU_TREE_FLAGS_NONE);
+    }
+
+    if (!gmenu_tree_load_sync (tree, &error))
+    {
+        g_warning ("Loading the tree failed: %s\n", error->message);
+        g_clear_error (&error); /* g_error_free */
+        g_object_unref(tree);
+
+        return -1;
+    }
+
+    root = gmenu_tree_get_root_directory (tree);
+
+    if (NULL == root)
+    {
+        g_warning ("The menu tree is empty.");
+        g_object_unref(tree);
+
+        return -1;
+    }
+
+    /* The GtkIconSize pixel sizes of the glyph sizes. */
+    switch(glyph_size)
+    {
+        case 1:
+            iconsize = 16;
+        break;
+        case 2:
+            iconsize = 24;
+        break;
+        default:
+            iconsize = 32;
+        break;
+    }
+
+    placeholder_pixbuf = gdk_pixbuf_new(GDK_COLORSPACE_RGB, TRUE, 8, iconsize, iconsize);
+    gdk_pixbuf_fill(placeholder_pixbuf, BENCH_PLACEHOLDER_RGBA);
+
+    _ca_render_bench_build_scene(&scene, iconsize, width, height, root, depth, page_size, placeholder_pixbuf);
+
+    memset(&context, 0, sizeof(CaRenderContext));
+    context.geometry = &scene.core.geometry;
+    context.view_width = scene.core.view_width;
+    context.view_height = scene.core.view_height;
+    context.view_x_offset = scene.core.view_x_offset;
+    context.view_y_offset = scene.core.view_y_offset;
+    context.light_pixbuf = _ca_render_bench_load_resource(RESOURCE_PATH"reflection.png");
+    context.close_normal_pixbuf = _ca_render_bench_load_resource(RESOURCE_PATH"close-menu-normal.png");
+    context.close_prelight_pixbuf = _ca_render_bench_load_resource(RESOURCE_PATH"close-menu-prelight.png");
+    context.open_normal_pixbuf = _ca_render_bench_load_resource(RESOURCE_PATH"open-sub-menu-normal.png");
+    context.open_prelight_pixbuf = _ca_render_bench_load_resource(RESOURCE_PATH"open-sub-menu-prelight.png");
+    context.root_fileleaf = scene.core.root_fileleaf;
+    context.tabbed_fileleaf = scene.core.tabbed_fileleaf;
+    context.disassociated_fileleaf = scene.core.disassociated_fileleaf;
+    context.current_fileleaf = scene.core.current_fileleaf;
+    context.current_fileitem = scene.core.current_fileitem;
+    context.current_type = scene.core.current_type;
+
+    g_assert(context.light_pixbuf != NULL);
+
+    if (snapshot != NULL)
+    {
+        g_mkdir_with_parents(snapshot, 0755);
+    }
+
+    surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, width, height);
+    samples = g_new(gdouble, frames);
+    exit_status = 0;
+
+    g_print("menu: %s, %dx%d, %d sub menus, %s, %d file-items, page size %d, %d frames\n",
+        menu,
+        width,
+        height,
+        scene.depth,
+        (scene.core.disassociated_fileleaf != NULL) ? "preview" : "no preview",
+        scene.fileitem_count,
+        page_size,
+        frames);
+    g_print("%-24s %9s %9s %9s %9s %9s  (ms/frame)\n", "configuration", "p50", "p90", "p99", "max", "mean");
+
+    for (i = 0; i < G_N_ELEMENTS(g_configurations); i++)
+    {
+        gdouble total;
+        gint frame;
+
+        context.render_reflection_off = g_configurations[i].render_reflection_off;
+        context.render_tabbed_only = g_configurations[i].render_tabbed_only;
+        context.render_fast = g_configurations[i].render_fast;
+        context.render_opaque = g_configurations[i].render_opaque;
+        context.render_overlap_off = g_configurations[i].render_opaque;
+
+        _ca_render_bench_run(&context, NULL, surface, frames, samples);
+
+        total = 0.0;
+
+        for (frame = 0; frame < frames; frame++)
+        {
+            total += samples[frame];
+        }
+
+        qsort(samples, frames, sizeof(gdouble), _ca_render_bench_compare);
+
+        g_print("%-24s %9.3f %9.3f %9.3f %9.3f %9.3f\n",
+            g_configurations[i]._name,
+            _ca_render_bench_percentile(samples, frames, 50.0),
+            _ca_render_bench_percentile(samples, frames, 90.0),
+            _ca_render_bench_percentile(samples, frames, 99.0),
+            samples[frames - 1],
+            total / frames);
+
+        if (snapshot != NULL)
+        {
+            gchar* filename;
+            gchar* basename;
+
+            basename = g_strdup_printf("%s.png", g_configurations[i]._name);
+            filename = g_build_filename(snapshot, basename, NULL);
+
+            if (cairo_surface_write_to_png(surface, filename) != CAIRO_STATUS_SUCCESS)
+            {
+                g_warning("The snapshot '%s' could not be written.", filename);
+            }
+
+            g_free((gpointer)filename);
+            g_free((gpointer)basename);
+        }
+    }
+
+    context.render_opaque = FALSE;
+    context.render_overlap_off = FALSE;
+
+    /* The hit testing of the core, which the pointer drives on every motion. */
+    {
+        gdouble total;
+        gint points;
+        gint sweep;
+
+        points = _ca_render_bench_hittest(&scene.core, frames, samples);
+
+        total = 0.0;
+
+        for (sweep = 0; sweep < frames; sweep++)
+        {
+            total += samples[sweep];
+        }
+
+        qsort(samples, frames, sizeof(gdouble), _ca_render_bench_compare);
+
+        g_print("%-24s %9s %9s %9s %9s %9s  (us/hit test, %d points per sweep)\n", "", "p50", "p90", "p99", "max", "mean", points);
+        g_print("%-24s %9.3f %9.3f %9.3f %9.3f %9.3f\n",
+            "hittest",
+            _ca_render_bench_percentile(samples, frames, 50.0),
+            _ca_render_bench_percentile(samples, frames, 90.0),
+            _ca_render_bench_percentile(samples, frames, 99.0),
+            samples[frames - 1],
+            total / frames);
+    }
+
+    /* Opening the root file-leaf, which a large directory slows unless it is paged. */
+    {
+        gdouble total;
+        gint open;
+
+        _ca_render_bench_open(&scene.core.geometry, root, page_size, frames, samples);
+
+        total = 0.0;
+
+        for (open = 0; open < frames; open++)
+        {
+            total += samples[open];
+        }
+
+        qsort(samples, frames, sizeof(gdouble), _ca_render_bench_compare);
+
+        g_print("%-24s %9s %9s %9s %9s %9s  (ms/open)\n", "", "p50", "p90", "p99", "max", "mean");
+        g_print("%-24s %9.3f %9.3f %9.3f %9.3f %9.3f\n",
+            "open",
+            _ca_render_bench_percentile(samples, frames, 50.0),
+            _ca_render_bench_percentile(samples, frames, 90.0),
+            _ca_render_bench_percentile(samples, frames, 99.0),
+            samples[frames - 1],
+            total / frames);
+    }
+
+    /* The time to first visible frame; the root file-leaf built from its menu entries and painted before any icon has resolved. */
+    {
+        gdouble first_frame;
+
+        context.render_reflection_off = FALSE;
+        context.render_tabbed_only = FALSE;
+        context.render_fast = FALSE;
+
+        g_print("%-24s %9s %9s %9s %9s %9s  (ms/first frame, budget %.1f ms)\n", "", "p50", "p90", "p99", "max", "mean", first_frame_budget);
+
+        _ca_render_bench_first_frame(&context, root, page_size, surface, frames, samples);
+        _ca_render_bench_print("first-frame", samples, frames);
+
+        first_frame = _ca_render_bench_percentile(samples, frames, 99.0);
+
+        if ((first_frame_budget > 0.0) &&
+            (first_frame > first_frame_budget))
+        {
+            g_warning("The first frame took %.3f ms, over the budget of %.1f ms.", first_frame, first_frame_budget);
+
+            exit_status = 1;
+        }
+    }
+
+    /* The main thread paint time of a frame in which every file-leaf is new, with the segments rendered directly or by workers. */
+    {
+        CaScheduler* scheduler;
+        gdouble* ready_samples;
+        gint job_class;
+
+        ready_samples = g_new(gdouble, frames);
+
+        context.render_reflection_off = FALSE;
+        context.render_tabbed_only = FALSE;
+        context.render_fast = FALSE;
+
+        g_print("%-24s %9s %9s %9s %9s %9s  (ms/frame, every menu new)\n", "", "p50", "p90", "p99", "max", "mean");
+
+        context.raster = NULL;
+        _ca_render_bench_new_leaves(&context, &scene.core, NULL, surface, frames, samples, ready_samples);
+        _ca_render_bench_print("new-leaf-direct", samples, frames);
+
+        /* Without a main context the completed jobs are only delivered by ca_raster_collect(). */
+        scheduler = ca_scheduler_new((gint)g_get_num_processors() - 1, NULL);
+        context.raster = ca_raster_new(scheduler, NULL, NULL);
+        _ca_render_bench_new_leaves(&context, &scene.core, NULL, surface, frames, samples, ready_samples);
+        _ca_render_bench_print("new-leaf-raster", samples, frames);
+        _ca_render_bench_print("raster-ready", ready_samples, frames);
+
+        /* The segments of the last frame have been rasterized, so these frames only composite them. */
+        _ca_render_bench_run(&context, NULL, surface, frames, samples);
+        _ca_render_bench_print("raster-composited", samples, frames);
+
+        _ca_render_bench_discard(&scene.core);
+        ca_raster_free(context.raster);
+        context.raster = NULL;
+
+        /* The queue depth, wait and latency counters of each priority class of the scheduler. */
+        g_print("%-24s %9s %9s %9s %9s %9s %9s  (jobs, ms)\n", "", "depth", "completed", "cancelled", "wait", "latency", "max");
+
+        for (job_class = 0; job_class < JOB_CLASSES; job_class++)
+        {
+            CaJobStats stats;
+            gchar* name;
+
+            ca_scheduler_get_stats(scheduler, job_class, &stats);
+
+            if (stats.completed == 0)
+                continue;
+
+            name = g_strdup_printf("jobs-%s", ca_scheduler_get_class_name(job_class));
+            g_print("%-24s %9d %9u %9u %9.3f %9.3f %9.3f\n",
+                name,
+                stats.depth,
+                stats.completed,
+                stats.cancelled,
+                stats.wait_total / 1000.0 / stats.completed,
+                stats.latency_total / 1000.0 / stats.completed,
+                stats.latency_max / 1000.0);
+            g_free((gpointer)name);
+        }
+
+        ca_scheduler_unref(scheduler);
+
+        g_free((gpointer)ready_samples);
+    }
+
+    /* The full quality frame rendered in tiles by 1, 2, 4 ... threads up to --tile-threads; the new rows first discard every file-leaf. */
+    if (tile_threads > 0)
+    {
+        gint threads;
+
+        context.render_reflection_off = FALSE;
+        context.render_tabbed_only = FALSE;
+        context.render_fast = FALSE;
+
+        g_print("%-24s %9s %9s %9s %9s %9s  (ms/frame, %dx%d tiles)\n", "", "p50", "p90", "p99", "max", "mean", tile_size, tile_size);
+
+        for (threads = 1; ; threads = MIN(threads * 2, tile_threads))
+        {
+            CaTiles* tiles;
+            gchar* name;
+
+            tiles = ca_tiles_new(threads, tile_size);
+
+            name = g_strdup_printf("tiled-%d", threads);
+            _ca_render_bench_run(&context, tiles, surface, frames, samples);
+            _ca_render_bench_print(name, samples, frames);
+            g_free((gpointer)name);
+
+            name = g_strdup_printf("tiled-%d-new", threads);
+            _ca_render_bench_new_leaves(&context, &scene.core, tiles, surface, frames, samples, NULL);
+            _ca_render_bench_print(name, samples, frames);
+            g_free((gpointer)name);
+
+            ca_tiles_free(tiles);
+
+            if (threads == tile_threads)
+                break;
+        }
+    }
+
+    /* The full quality frame rendered to the whole view and to a canvas bounded to what it renders; a compositor also only blends the canvas, or the shape of a shaped window. */
+    {
+        cairo_rectangle_int_t canvas;
+        cairo_surface_t* canvas_surface;
+        cairo_region_t* shape;
+        gint64 shape_area;
+
+        context.render_reflection_off = FALSE;
+        context.render_tabbed_only = FALSE;
+        context.render_fast = FALSE;
+
+        ca_render_get_canvas(&context, &canvas);
+
+        shape = cairo_region_create();
+        ca_render_get_shape(&context, shape);
+        shape_area = 0;
+
+        for (i = 0; i < cairo_region_num_rectangles(shape); i++)
+        {
+            cairo_rectangle_int_t rectangle;
+
+            cairo_region_get_rectangle(shape, i, &rectangle);
+            shape_area += (gint64)rectangle.width * rectangle.height;
+        }
+
+        cairo_region_destroy(shape);
+
+        canvas_surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, canvas.width, canvas.height);
+        cairo_surface_set_device_offset(canvas_surface, -canvas.x, -canvas.y);
+
+        g_print("%-24s %9s %9s %9s %9s %9s  (ms/frame, %dx%d canvas, %.1f%% of the view pixels, shape %.1f%%)\n",
+            "", "p50", "p90", "p99", "max", "mean",
+            canvas.width,
+            canvas.height,
+            (100.0 * canvas.width * canvas.height) / ((gdouble)width * height),
+            (100.0 * shape_area) / ((gdouble)width * height));
+
+        _ca_render_bench_run(&context, NULL, surface, frames, samples);
+        _ca_render_bench_print("view", samples, frames);
+
+        _ca_render_bench_run(&context, NULL, canvas_surface, frames, samples);
+        _ca_render_bench_print("canvas", samples, frames);
+
+        cairo_surface_destroy(canvas_surface);
+    }
+
+    /* A change of prelight on a remote display; the other file-leaves are composited from their surfaces and only the damage is drawn, within its extents. */
+    {
+        cairo_region_t* damage;
+        cairo_rectangle_int_t extents;
+        cairo_surface_t* damage_surface;
+        gint64 damage_area;
+
+        context.render_reflection_off = TRUE;
+        context.render_overlap_off = TRUE;
+        context.render_tabbed_only = FALSE;
+        context.render_fast = FALSE;
+
+        damage = cairo_region_create();
+        ca_render_add_current_damage(&context, damage);
+        cairo_region_get_extents(damage, &extents);
+        damage_area = 0;
+
+        for (i = 0; i < cairo_region_num_rectangles(damage); i++)
+        {
+            cairo_rectangle_int_t rectangle;
+
+            cairo_region_get_rectangle(damage, i, &rectangle);
+            damage_area += (gint64)rectangle.width * rectangle.height;
+        }
+
+        cairo_region_destroy(damage);
+
+        g_print("%-24s %9s %9s %9s %9s %9s  (ms/frame, prelight damage %" G_GINT64_FORMAT " pixels, %.1f%% of the view pixels, %" G_GINT64_FORMAT " KiB)\n",
+            "", "p50", "p90", "p99", "max", "mean",
+            damage_area,
+            (100.0 * damage_area) / ((gdouble)width * height),
+            (damage_area * DAMAGE_BYTES_PER_PIXEL) / 1024);
+
+        _ca_render_bench_run(&context, NULL, surface, frames, samples);
+        _ca_render_bench_print("remote-view", samples, frames);
+
+        context.render_leaf_surfaces = TRUE;
+
+        _ca_render_bench_run(&context, NULL, surface, frames, samples);
+        _ca_render_bench_print("remote-surfaces", samples, frames);
+
+        if ((extents.width > 0) &&
+            (extents.height > 0))
+        {
+            damage_surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, extents.width, extents.height);
+            cairo_surface_set_device_offset(damage_surface, -extents.x, -extents.y);
+
+            _ca_render_bench_run(&context, NULL, damage_surface, frames, samples);
+            _ca_render_bench_print("remote-damage", samples, frames);
+
+            cairo_surface_destroy(damage_surface);
+        }
+
+        _ca_render_bench_discard(&scene.core);
+
+        context.render_leaf_surfaces = FALSE;
+        context.render_reflection_off = FALSE;
+        context.render_overlap_off = FALSE;
+    }
+
+    g_free((gpointer)samples);
+    cairo_surface_destroy(surface);
+
+    _ca_render_bench_free_scene(&scene);
+
+    g_object_unref(context.light_pixbuf);
+    g_object_unref(context.close_normal_pixbuf);
+    g_object_unref(context.close_prelight_pixbuf);
+    g_object_unref(context.open_normal_pixbuf);
+    g_object_unref(context.open_prelight_pixbuf);
+    g_object_unref(placeholder_pixbuf);
+
+    gmenu_tree_item_unref (root);
+    g_object_unref(tree);
+
+    return exit_status;
+}